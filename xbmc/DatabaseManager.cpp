@@ -16,6 +16,7 @@
 #include "pvr/epg/EpgDatabase.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/TaskGraph.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 #include "view/ViewDatabase.h"
@@ -24,6 +25,12 @@
 
 using namespace PVR;
 
+namespace
+{
+// the updates mostly wait for I/O, so they run concurrently even on single core devices
+constexpr unsigned int MAX_UPDATE_THREADS = 4;
+} // unnamed namespace
+
 CDatabaseManager::CDatabaseManager() :
   m_bIsUpgrading(false)
 {
@@ -44,18 +51,68 @@ void CDatabaseManager::Initialize()
 
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
 
-  // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
-  //       before CVideoDatabase.
+  // The databases are updated concurrently. NOTE: CTextureDatabase has to be updated before
+  // CVideoDatabase. The status of the databases is set once all are done, m_section is held until
+  // then anyway.
+  std::map<std::string, bool> results;
+  CCriticalSection resultsSection;
+  auto update = [this, &results, &resultsSection](CDatabase& db, DatabaseSettings* settings)
   {
-    ADDON::CAddonDatabase db;
-    UpdateDatabase(db);
-  }
-  { CViewDatabase db; UpdateDatabase(db); }
-  { CTextureDatabase db; UpdateDatabase(db); }
-  { CMusicDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseMusic); }
-  { CVideoDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseVideo); }
-  { CPVRDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseTV); }
-  { CPVREpgDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseEpg); }
+    const bool success = Update(db, settings ? *settings : DatabaseSettings());
+    std::unique_lock<CCriticalSection> lock(resultsSection);
+    results[db.GetBaseDBName()] = success;
+    return success;
+  };
+
+  CTaskGraph graph("DatabaseUpdate");
+  graph.AddTask("CAddonDatabase",
+                [&update]()
+                {
+                  ADDON::CAddonDatabase db;
+                  return update(db, nullptr);
+                });
+  graph.AddTask("CViewDatabase",
+                [&update]()
+                {
+                  CViewDatabase db;
+                  return update(db, nullptr);
+                });
+  graph.AddTask("CTextureDatabase",
+                [&update]()
+                {
+                  CTextureDatabase db;
+                  return update(db, nullptr);
+                });
+  graph.AddTask("CMusicDatabase",
+                [&update, &advancedSettings]()
+                {
+                  CMusicDatabase db;
+                  return update(db, &advancedSettings->m_databaseMusic);
+                });
+  graph.AddTask(
+      "CVideoDatabase",
+      [&update, &advancedSettings]()
+      {
+        CVideoDatabase db;
+        return update(db, &advancedSettings->m_databaseVideo);
+      },
+      {"CTextureDatabase"});
+  graph.AddTask("CPVRDatabase",
+                [&update, &advancedSettings]()
+                {
+                  CPVRDatabase db;
+                  return update(db, &advancedSettings->m_databaseTV);
+                });
+  graph.AddTask("CPVREpgDatabase",
+                [&update, &advancedSettings]()
+                {
+                  CPVREpgDatabase db;
+                  return update(db, &advancedSettings->m_databaseEpg);
+                });
+  graph.Run(MAX_UPDATE_THREADS);
+
+  for (const auto& [name, success] : results)
+    UpdateStatus(name, success ? DBStatus::READY : DBStatus::FAILED);
 
   CLog::Log(LOGDEBUG, "{}, updating databases... DONE", __FUNCTION__);
 
@@ -758,7 +758,7 @@ void CFileItem::Serialize(CVariant& value) const
   {
     auto& customProperties = value["customproperties"];
     for (const auto& prop : m_mapProperties)
-      customProperties[prop.first] = prop.second;
+      customProperties[*prop.first] = prop.second;
   }
 }
 
@@ -1496,8 +1496,9 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
     SetLabel(item.GetLabel());
   if (replaceLabels && !item.GetLabel2().empty())
     SetLabel2(item.GetLabel2());
-  if (!item.GetArt().empty())
-    SetArt(item.GetArt());
+  const ArtMap art = item.GetArt();
+  if (!art.empty())
+    SetArt(art);
   AppendProperties(item);
 
   SetContentLookup(item.m_doContentLookup);
@@ -1569,12 +1570,13 @@ void CFileItem::MergeInfo(const CFileItem& item)
     SetLabel(item.GetLabel());
   if (!item.GetLabel2().empty())
     SetLabel2(item.GetLabel2());
-  if (!item.GetArt().empty())
+  const ArtMap art = item.GetArt();
+  if (!art.empty())
   {
     if (VIDEO::IsVideo(item))
-      AppendArt(item.GetArt());
+      AppendArt(art);
     else
-      SetArt(item.GetArt());
+      SetArt(art);
   }
   AppendProperties(item);
 
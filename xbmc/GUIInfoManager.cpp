@@ -1644,6 +1644,15 @@ const infomap weather[] =        {{ "isfetched",        WEATHER_IS_FETCHED },
 ///     @return The current rendering speed (frames per second).
 ///     <p>
 ///   }
+///   \table_row3{   <b>`System.FramesOverBudget`</b>,
+///                  \anchor System_FramesOverBudget
+///                  _string_,
+///     @return The percentage of the recently rendered frames of the current window
+///     which missed at least one refresh of the display.
+///     <p><hr>
+///     @skinning_v22 **[New Infolabel]** \link System_FramesOverBudget `System.FramesOverBudget`\endlink
+///     <p>
+///   }
 ///   \table_row3{   <b>`System.FreeMemory`</b>,
 ///                  \anchor System_FreeMemory
 ///                  _string_,
@@ -1836,6 +1845,21 @@ const infomap weather[] =        {{ "isfetched",        WEATHER_IS_FETCHED },
 ///       - <b>total</b>
 ///     <p>
 ///   }
+///   \table_row3{   <b>`System.FrameTime(type)`</b>,
+///                  \anchor System_FrameTime
+///                  _string_,
+///     @return The time in milliseconds the recently rendered frames of the current
+///     window took.
+///     @param type - Can be one of the following:
+///       - <b>p50</b>\, <b>p95</b> or <b>p99</b> - the percentile of the time spent
+///         processing and rendering a frame
+///       - <b>process</b> - the 95th percentile of the time spent processing a frame
+///       - <b>render</b> - the 95th percentile of the time spent rendering a frame
+///       - <b>present</b> - the 95th percentile of the time spent presenting a frame
+///     <p><hr>
+///     @skinning_v22 **[New Infolabel]** \link System_FrameTime `System.FrameTime(type)`\endlink
+///     <p>
+///   }
 ///   \table_row3{   <b>`System.AddonTitle(id)`</b>,
 ///                  \anchor System_AddonTitle
 ///                  _string_,
@@ -1941,6 +1965,7 @@ const infomap system_labels[] = {
     {"buildversiongit", SYSTEM_BUILD_VERSION_GIT},
     {"builddate", SYSTEM_BUILD_DATE},
     {"fps", SYSTEM_FPS},
+    {"framesoverbudget", SYSTEM_FRAMES_OVER_BUDGET},
     {"freememory", SYSTEM_FREE_MEMORY},
     {"language", SYSTEM_LANGUAGE},
     {"temperatureunits", SYSTEM_TEMPERATURE_UNITS},
@@ -10404,6 +10429,21 @@ int CGUIInfoManager::TranslateSingleString(const std::string &strCondition, bool
           else if (param == "total")
             return SYSTEM_TOTAL_MEMORY;
         }
+        else if (prop.name == "frametime")
+        {
+          if (param == "p50")
+            return SYSTEM_FRAME_TIME_P50;
+          else if (param == "p95")
+            return SYSTEM_FRAME_TIME_P95;
+          else if (param == "p99")
+            return SYSTEM_FRAME_TIME_P99;
+          else if (param == "process")
+            return SYSTEM_FRAME_TIME_PROCESS;
+          else if (param == "render")
+            return SYSTEM_FRAME_TIME_RENDER;
+          else if (param == "present")
+            return SYSTEM_FRAME_TIME_PRESENT;
+        }
         else if (prop.name == "addontitle")
         {
           // Example: System.AddonTitle(Skin.String(HomeVideosButton1)) => skin string HomeVideosButton1 holds an addon identifier string
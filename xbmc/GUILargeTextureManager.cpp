@@ -21,6 +21,7 @@
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <exception>
@@ -176,6 +177,40 @@ void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
     else
       ++it;
   }
+
+  if (immediately && m_statistics.loaded + m_statistics.prefetched > 0)
+  {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    CLog::Log(LOGDEBUG,
+              "{} - {} images loaded before they came on screen, {} waited for (average {:.1f} "
+              "ms, max {:.1f} ms)",
+              __FUNCTION__, m_statistics.prefetched, m_statistics.loaded,
+              m_statistics.loaded ? Milliseconds(m_statistics.total).count() / m_statistics.loaded
+                                  : 0.0,
+              Milliseconds(m_statistics.max).count());
+    m_statistics = {};
+  }
+}
+
+void CGUILargeTextureManager::SetRequestPriority(unsigned int priority)
+{
+  std::unique_lock<CCriticalSection> lock(m_listSection);
+  m_requestPriority = priority;
+}
+
+unsigned int CGUILargeTextureManager::GetRequestPriority() const
+{
+  std::unique_lock<CCriticalSection> lock(m_listSection);
+  return m_requestPriority;
+}
+
+CGUILargeTextureManager::Statistics CGUILargeTextureManager::GetStatistics(bool reset)
+{
+  std::unique_lock<CCriticalSection> lock(m_listSection);
+  Statistics statistics = m_statistics;
+  if (reset)
+    m_statistics = {};
+  return statistics;
 }
 
 // if available, increment reference count, and return the image.
@@ -203,7 +238,24 @@ bool CGUILargeTextureManager::GetImage(const std::string& path,
   }
 
   if (firstRequest)
+  {
     QueueImage(path, width, height, aspectRatio, useCache);
+  }
+  else
+  {
+    // still waiting - the requesting item may have moved closer to or further from the viewport
+    for (auto& queued : m_queued)
+    {
+      const CLargeTexture* image = queued.image;
+      if (image->GetPath() == path && image->GetTargetWidth() == width &&
+          image->GetTargetHeight() == height && image->GetAspectRatio() == aspectRatio)
+      {
+        UpdatePriority(queued);
+        LoadQueuedImages();
+        break;
+      }
+    }
+  }
 
   return true;
 }
@@ -228,15 +280,17 @@ void CGUILargeTextureManager::ReleaseImage(const std::string& path,
   }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    unsigned int id = it->first;
-    CLargeTexture *image = it->second;
+    unsigned int id = it->jobID;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path && image->GetTargetWidth() == width &&
         image->GetTargetHeight() == height && image->GetAspectRatio() == aspectRatio &&
         image->DecrRef(true))
     {
-      // cancel this job
-      CServiceBroker::GetJobManager()->CancelJob(id);
+      // cancel this job, or drop the image if it's not being loaded yet
+      if (id)
+        CServiceBroker::GetJobManager()->CancelJob(id);
       m_queued.erase(it);
+      LoadQueuedImages();
       return;
     }
   }
@@ -255,20 +309,73 @@ void CGUILargeTextureManager::QueueImage(const std::string& path,
   std::unique_lock<CCriticalSection> lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    CLargeTexture *image = it->second;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path && image->GetTargetWidth() == width &&
         image->GetTargetHeight() == height && image->GetAspectRatio() == aspectRatio)
     {
       image->AddRef();
+      UpdatePriority(*it);
+      LoadQueuedImages();
       return; // already queued
     }
   }
 
   // queue the item
-  CLargeTexture* image = new CLargeTexture(path, width, height, aspectRatio);
-  unsigned int jobID = CServiceBroker::GetJobManager()->AddJob(
-      new CImageLoader(path, width, height, aspectRatio, useCache), this, CJob::PRIORITY_NORMAL);
-  m_queued.emplace_back(jobID, image);
+  CQueuedImage queued{};
+  queued.image = new CLargeTexture(path, width, height, aspectRatio);
+  queued.useCache = useCache;
+  queued.priority = m_requestPriority;
+  queued.priorityTime = CTimeUtils::GetFrameTime();
+  UpdatePriority(queued);
+  m_queued.push_back(std::move(queued));
+  LoadQueuedImages();
+}
+
+void CGUILargeTextureManager::UpdatePriority(CQueuedImage& queued) const
+{
+  // an image may be requested by several textures, the one closest to the viewport counts
+  const unsigned int frameTime = CTimeUtils::GetFrameTime();
+  if (queued.priorityTime != frameTime || m_requestPriority < queued.priority)
+  {
+    queued.priority = m_requestPriority;
+    queued.priorityTime = frameTime;
+  }
+
+  if (queued.priority == PRIORITY_VISIBLE && !queued.visible)
+    queued.visible = std::chrono::steady_clock::now();
+}
+
+void CGUILargeTextureManager::LoadQueuedImages()
+{
+  unsigned int loading = 0;
+  for (const auto& queued : m_queued)
+  {
+    if (queued.jobID)
+      loading++;
+  }
+
+  while (loading < MAX_LOADING)
+  {
+    // images with the same priority are loaded in the order they were requested
+    auto next = m_queued.end();
+    for (auto it = m_queued.begin(); it != m_queued.end(); ++it)
+    {
+      if (!it->jobID && (next == m_queued.end() || it->priority < next->priority))
+        next = it;
+    }
+
+    if (next == m_queued.end())
+      return;
+
+    const CLargeTexture* image = next->image;
+    next->jobID = CServiceBroker::GetJobManager()->AddJob(
+        new CImageLoader(image->GetPath(), image->GetTargetWidth(), image->GetTargetHeight(),
+                         image->GetAspectRatio(), next->useCache),
+        this, CJob::PRIORITY_NORMAL);
+    if (!next->jobID)
+      return; // not accepting jobs
+    loading++;
+  }
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -277,14 +384,26 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
   std::unique_lock<CCriticalSection> lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    if (it->first == jobID)
+    if (it->jobID == jobID)
     { // found our job
       CImageLoader *loader = static_cast<CImageLoader*>(job);
-      CLargeTexture *image = it->second;
+      CLargeTexture *image = it->image;
       image->SetTexture(std::move(loader->m_texture));
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
+
+      if (it->visible)
+      {
+        const auto waited = std::chrono::steady_clock::now() - *it->visible;
+        m_statistics.loaded++;
+        m_statistics.total += waited;
+        m_statistics.max = std::max(m_statistics.max, waited);
+      }
+      else
+        m_statistics.prefetched++;
+
       m_queued.erase(it);
       m_allocated.push_back(image);
+      LoadQueuedImages();
       return;
     }
   }
@@ -13,7 +13,9 @@
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -60,11 +62,27 @@ private:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Only a few images are loaded at the same time. Waiting images are loaded in the order of their
+ priority, which containers set to the distance of their items from the viewport, so that images
+ on screen are loaded before those of items scrolled past or preloaded ahead of the scroll.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
 {
 public:
+  //! priority of images on screen, higher values are loaded later
+  static constexpr unsigned int PRIORITY_VISIBLE = 0;
+
+  //! time from an image coming on screen until its texture was ready
+  struct Statistics
+  {
+    unsigned int loaded{0}; ///< images loaded after they came on screen
+    unsigned int prefetched{0}; ///< images loaded before they came on screen
+    std::chrono::steady_clock::duration total{}; ///< total time the loaded images were waited for
+    std::chrono::steady_clock::duration max{}; ///< longest time an image was waited for
+  };
+
   CGUILargeTextureManager();
   ~CGUILargeTextureManager() override;
 
@@ -131,6 +149,30 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Set the priority of images requested from now on.
+
+   Containers set the priority while processing their items and restore the previous one
+   afterwards. A request for an image that is still waiting to be loaded updates its priority.
+
+   \param priority distance of the requesting item from the viewport, PRIORITY_VISIBLE if it's
+   on screen.
+   \sa GetRequestPriority
+   */
+  void SetRequestPriority(unsigned int priority);
+
+  /*!
+   \brief Get the priority of images requested from now on.
+   \sa SetRequestPriority
+   */
+  unsigned int GetRequestPriority() const;
+
+  /*!
+   \brief Get the time images on screen were waited for since the statistics were last reset.
+   \param reset whether to reset the statistics
+   */
+  Statistics GetStatistics(bool reset = false);
+
 private:
   class CLargeTexture
   {
@@ -164,17 +206,34 @@ private:
     unsigned int m_timeToDelete;
   };
 
+  struct CQueuedImage
+  {
+    unsigned int jobID; ///< id of the loading job, 0 while waiting to be loaded
+    CLargeTexture* image;
+    bool useCache;
+    unsigned int priority;
+    unsigned int priorityTime; ///< frame time the priority was set
+    std::optional<std::chrono::steady_clock::time_point> visible; ///< when it came on screen
+  };
+
+  static constexpr unsigned int MAX_LOADING = 4;
+
   void QueueImage(const std::string& path,
                   unsigned int width,
                   unsigned int height,
                   CAspectRatio::AspectRatio aspectRatio,
                   bool useCache = true);
+  void UpdatePriority(CQueuedImage& queued) const;
+  void LoadQueuedImages();
 
-  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CQueuedImage> m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
-  typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
+  typedef std::vector<CQueuedImage>::iterator queueIterator;
+
+  unsigned int m_requestPriority = PRIORITY_VISIBLE;
+  Statistics m_statistics;
 
-  CCriticalSection m_listSection;
+  mutable CCriticalSection m_listSection;
 };
 
@@ -153,6 +153,11 @@ PLAYLIST::CPlayListPlayer& CServiceBroker::GetPlaylistPlayer()
   return g_application.m_ServiceManager->GetPlaylistPlayer();
 }
 
+PLAYLIST::CSmartPlaylistResultCache& CServiceBroker::GetSmartPlaylistResultCache()
+{
+  return g_application.m_ServiceManager->GetSmartPlaylistResultCache();
+}
+
 void CServiceBroker::RegisterSettingsComponent(const std::shared_ptr<CSettingsComponent>& settings)
 {
   g_serviceBroker.m_pSettingsComponent = settings;
@@ -193,6 +198,11 @@ CFavouritesService& CServiceBroker::GetFavouritesService()
   return g_application.m_ServiceManager->GetFavouritesService();
 }
 
+CDirectoryProviderCache& CServiceBroker::GetDirectoryProviderCache()
+{
+  return g_application.m_ServiceManager->GetDirectoryProviderCache();
+}
+
 ADDON::CServiceAddonManager& CServiceBroker::GetServiceAddons()
 {
   return g_application.m_ServiceManager->GetServiceAddons();
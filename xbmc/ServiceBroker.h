@@ -40,6 +40,7 @@ class CPVRManager;
 namespace KODI::PLAYLIST
 {
 class CPlayListPlayer;
+class CSmartPlaylistResultCache;
 }
 
 namespace KODI
@@ -54,6 +55,7 @@ class CAppParams;
 template<class T>
 class CComponentContainer;
 class CContextMenuManager;
+class CDirectoryProviderCache;
 class XBPython;
 class CDataCacheCore;
 class IAE;
@@ -153,12 +155,14 @@ public:
   static CDataCacheCore& GetDataCacheCore();
   static CPlatform& GetPlatform();
   static KODI::PLAYLIST::CPlayListPlayer& GetPlaylistPlayer();
+  static KODI::PLAYLIST::CSmartPlaylistResultCache& GetSmartPlaylistResultCache();
   static CSlideShowDelegator& GetSlideShowDelegator();
   static KODI::GAME::CControllerManager& GetGameControllerManager();
   static KODI::GAME::CGameServices& GetGameServices();
   static KODI::RETRO::CGUIGameRenderManager& GetGameRenderManager();
   static PERIPHERALS::CPeripherals& GetPeripherals();
   static CFavouritesService& GetFavouritesService();
+  static CDirectoryProviderCache& GetDirectoryProviderCache();
   static ADDON::CServiceAddonManager& GetServiceAddons();
   static ADDON::CRepositoryUpdater& GetRepositoryUpdater();
   static CInputManager& GetInputManager();
@@ -24,6 +24,7 @@
 #include "favourites/FavouritesService.h"
 #include "games/GameServices.h"
 #include "games/controllers/ControllerManager.h"
+#include "guilib/listproviders/DirectoryProviderCache.h"
 #include "input/InputManager.h"
 #include "interfaces/generic/ScriptInvocationManager.h"
 #include "interfaces/python/XBPython.h"
@@ -44,8 +45,11 @@
 #include "storage/DetectDVDType.h"
 #endif
 #include "pictures/SlideShowDelegator.h"
+#include "playlists/SmartPlaylistResultCache.h"
 #include "storage/MediaManager.h"
+#include "threads/TaskGraph.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/StartupTrace.h"
 #include "utils/log.h"
 #include "weather/WeatherManager.h"
 
@@ -70,6 +74,7 @@ bool CServiceManager::InitForTesting()
   m_network = CNetworkBase::GetNetwork();
 
   m_databaseManager = std::make_unique<CDatabaseManager>();
+  m_smartPlaylistResultCache = std::make_unique<PLAYLIST::CSmartPlaylistResultCache>();
 
   m_binaryAddonManager = std::make_unique<ADDON::CBinaryAddonManager>();
   m_addonMgr = std::make_unique<ADDON::CAddonMgr>();
@@ -93,12 +98,15 @@ void CServiceManager::DeinitTesting()
   m_extsMimeSupportList.reset();
   m_binaryAddonManager.reset();
   m_addonMgr.reset();
+  m_smartPlaylistResultCache.reset();
   m_databaseManager.reset();
   m_network.reset();
 }
 
 bool CServiceManager::InitStageOne()
 {
+  CStartupTrace::CScope trace("CServiceManager::InitStageOne");
+
   m_Platform.reset(CPlatform::CreateInstance());
   if (!m_Platform->InitStageOne())
     return false;
@@ -120,6 +128,8 @@ bool CServiceManager::InitStageOne()
 
 bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
 {
+  CStartupTrace::CScope trace("CServiceManager::InitStageTwo");
+
   // Initialize the addon database (must be before the addon manager is init'd)
   m_databaseManager = std::make_unique<CDatabaseManager>();
 
@@ -127,7 +137,32 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
       ADDON::
           CBinaryAddonManager>(); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
   m_addonMgr = std::make_unique<ADDON::CAddonMgr>();
-  if (!m_addonMgr->Init())
+  m_powerManager = std::make_unique<CPowerManager>();
+  m_mediaManager = std::make_unique<CMediaManager>();
+
+  // scanning the add-ons and probing the platform's power and storage services are independent of
+  // each other, the latter may wait for system services on start. Power and storage stay on this
+  // thread, as their platform implementations register with its run loop, e.g. on macOS.
+  CTaskGraph graph("ServiceInit");
+  graph.AddTask("CAddonMgr::Init", [this]() { return m_addonMgr->Init(); });
+  graph.AddTask(
+      "CPowerManager::Initialize",
+      [this]()
+      {
+        m_powerManager->Initialize();
+        m_powerManager->SetDefaults();
+        return true;
+      },
+      {}, CTaskGraph::TaskThread::CALLER);
+  graph.AddTask(
+      "CMediaManager::Initialize",
+      [this]()
+      {
+        m_mediaManager->Initialize();
+        return true;
+      },
+      {}, CTaskGraph::TaskThread::CALLER);
+  if (!graph.Run(2))
   {
     CLog::Log(LOGFATAL, "CServiceManager::{}: Unable to start CAddonMgr", __FUNCTION__);
     return false;
@@ -138,14 +173,20 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
   m_extsMimeSupportList = std::make_unique<ADDONS::CExtsMimeSupportList>(*m_addonMgr);
 
   m_vfsAddonCache = std::make_unique<ADDON::CVFSAddonCache>();
-  m_vfsAddonCache->Init();
+  {
+    CStartupTrace::CScope vfsTrace("CVFSAddonCache::Init");
+    m_vfsAddonCache->Init();
+  }
 
   m_PVRManager = std::make_unique<PVR::CPVRManager>();
 
   m_dataCacheCore = std::make_unique<CDataCacheCore>();
 
   m_binaryAddonCache = std::make_unique<ADDON::CBinaryAddonCache>();
-  m_binaryAddonCache->Init();
+  {
+    CStartupTrace::CScope binaryTrace("CBinaryAddonCache::Init");
+    m_binaryAddonCache->Init();
+  }
 
   m_favouritesService = std::make_unique<CFavouritesService>(profilesUserDataFolder);
 
@@ -155,7 +196,10 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
 
   m_gameControllerManager = std::make_unique<GAME::CControllerManager>(*m_addonMgr);
   m_inputManager = std::make_unique<CInputManager>();
-  m_inputManager->InitializeInputs();
+  {
+    CStartupTrace::CScope inputTrace("CInputManager::InitializeInputs");
+    m_inputManager->InitializeInputs();
+  }
 
   m_peripherals =
       std::make_unique<PERIPHERALS::CPeripherals>(*m_inputManager, *m_gameControllerManager);
@@ -164,14 +208,10 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
 
   m_fileExtensionProvider = std::make_unique<CFileExtensionProvider>(*m_addonMgr);
 
-  m_powerManager = std::make_unique<CPowerManager>();
-  m_powerManager->Initialize();
-  m_powerManager->SetDefaults();
-
   m_weatherManager = std::make_unique<CWeatherManager>();
 
-  m_mediaManager = std::make_unique<CMediaManager>();
-  m_mediaManager->Initialize();
+  m_directoryProviderCache = std::make_unique<CDirectoryProviderCache>();
+  m_directoryProviderCache->Initialize();
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_OPTICAL_DRIVE)
   m_DetectDVDType = std::make_unique<MEDIA_DETECT::CDetectDVDMedia>();
@@ -191,6 +231,8 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
 // stage 3 is called after successful initialization of WindowManager
 bool CServiceManager::InitStageThree(const std::shared_ptr<CProfileManager>& profileManager)
 {
+  CStartupTrace::CScope trace("CServiceManager::InitStageThree");
+
 #if !defined(TARGET_WINDOWS) && defined(HAS_OPTICAL_DRIVE)
   // Start Thread for DVD Mediatype detection
   CLog::Log(LOGINFO, "[Media Detection] starting service for optical media detection");
@@ -198,7 +240,10 @@ bool CServiceManager::InitStageThree(const std::shared_ptr<CProfileManager>& pro
 #endif
 
   // Peripherals depends on strings being loaded before stage 3
-  m_peripherals->Initialise();
+  {
+    CStartupTrace::CScope peripheralsTrace("CPeripherals::Initialise");
+    m_peripherals->Initialise();
+  }
 
   m_gameServices =
       std::make_unique<GAME::CGameServices>(*m_gameControllerManager, *m_gameRenderManager,
@@ -208,7 +253,10 @@ bool CServiceManager::InitStageThree(const std::shared_ptr<CProfileManager>& pro
 
   // Init PVR manager after login, not already on login screen
   if (!profileManager->UsingLoginScreen())
+  {
+    CStartupTrace::CScope pvrTrace("CPVRManager::Init");
     m_PVRManager->Init();
+  }
 
   m_playerCoreFactory = std::make_unique<CPlayerCoreFactory>(*profileManager);
 
@@ -239,6 +287,9 @@ void CServiceManager::DeinitStageTwo()
 {
   init_level = 1;
 
+  m_directoryProviderCache->Deinitialize();
+  m_directoryProviderCache.reset();
+
 #if defined(HAS_FILESYSTEM_SMB)
   m_WSDiscovery.reset();
 #endif
@@ -366,6 +417,11 @@ PLAYLIST::CPlayListPlayer& CServiceManager::GetPlaylistPlayer()
   return *m_playlistPlayer;
 }
 
+PLAYLIST::CSmartPlaylistResultCache& CServiceManager::GetSmartPlaylistResultCache()
+{
+  return *m_smartPlaylistResultCache;
+}
+
 GAME::CControllerManager& CServiceManager::GetGameControllerManager()
 {
   return *m_gameControllerManager;
@@ -391,6 +447,11 @@ CFavouritesService& CServiceManager::GetFavouritesService()
   return *m_favouritesService;
 }
 
+CDirectoryProviderCache& CServiceManager::GetDirectoryProviderCache()
+{
+  return *m_directoryProviderCache;
+}
+
 CInputManager& CServiceManager::GetInputManager()
 {
   return *m_inputManager;
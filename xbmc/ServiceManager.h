@@ -30,9 +30,11 @@ class CPVRManager;
 namespace KODI::PLAYLIST
 {
 class CPlayListPlayer;
+class CSmartPlaylistResultCache;
 }
 
 class CContextMenuManager;
+class CDirectoryProviderCache;
 #ifdef HAS_PYTHON
 class XBPython;
 #endif
@@ -128,10 +130,12 @@ public:
   PERIPHERALS::CPeripherals& GetPeripherals();
 
   KODI::PLAYLIST::CPlayListPlayer& GetPlaylistPlayer();
+  KODI::PLAYLIST::CSmartPlaylistResultCache& GetSmartPlaylistResultCache();
   CSlideShowDelegator& GetSlideShowDelegator();
   int init_level = 0;
 
   CFavouritesService& GetFavouritesService();
+  CDirectoryProviderCache& GetDirectoryProviderCache();
   CInputManager& GetInputManager();
   CFileExtensionProvider& GetFileExtensionProvider();
 
@@ -168,11 +172,13 @@ protected:
   std::unique_ptr<CDataCacheCore> m_dataCacheCore;
   std::unique_ptr<CPlatform> m_Platform;
   std::unique_ptr<KODI::PLAYLIST::CPlayListPlayer> m_playlistPlayer;
+  std::unique_ptr<KODI::PLAYLIST::CSmartPlaylistResultCache> m_smartPlaylistResultCache;
   std::unique_ptr<KODI::GAME::CControllerManager> m_gameControllerManager;
   std::unique_ptr<KODI::GAME::CGameServices> m_gameServices;
   std::unique_ptr<KODI::RETRO::CGUIGameRenderManager> m_gameRenderManager;
   std::unique_ptr<PERIPHERALS::CPeripherals> m_peripherals;
   std::unique_ptr<CFavouritesService> m_favouritesService;
+  std::unique_ptr<CDirectoryProviderCache> m_directoryProviderCache;
   std::unique_ptr<CInputManager> m_inputManager;
   std::unique_ptr<CFileExtensionProvider> m_fileExtensionProvider;
   std::unique_ptr<CNetworkBase> m_network;
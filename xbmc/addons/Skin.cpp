@@ -8,10 +8,12 @@
 
 #include "Skin.h"
 
+#include "CompileInfo.h"
 #include "FileItem.h"
 #include "FileItemList.h"
 #include "ServiceBroker.h"
 #include "Util.h"
+#include "addons/AddonVersion.h"
 #include "addons/addoninfo/AddonType.h"
 #include "dialogs/GUIDialogKaiToast.h"
 #include "filesystem/Directory.h"
@@ -27,6 +29,7 @@
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "threads/Timer.h"
+#include "utils/Crc32.h"
 #include "utils/FileUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -34,6 +37,7 @@
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <charconv>
 #include <memory>
 
@@ -283,6 +287,34 @@ void CSkinInfo::LoadIncludes()
   CLog::Log(LOGINFO, "Loading skin includes from {}", includesPath);
   m_includes.Clear();
   m_includes.Load(includesPath);
+
+  m_windowCache.Open(ID(), GetWindowCacheState());
+}
+
+uint32_t CSkinInfo::GetWindowCacheState() const
+{
+  std::string state = CCompileInfo::GetSCMID();
+  state += "|" + Version().asString();
+
+  std::vector<std::string> paths;
+  GetSkinPaths(paths);
+  for (const auto& path : paths)
+  {
+    std::vector<std::string> files;
+    CFileItemList items;
+    CDirectory::GetDirectory(path, items, ".xml", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE);
+    for (const auto& item : items)
+      files.emplace_back(StringUtils::Format("{}:{}:{}", item->GetPath(), item->m_dwSize,
+                                             item->m_dateTime.GetAsDBDateTime()));
+
+    std::sort(files.begin(), files.end());
+    state += "|" + path + "|" + StringUtils::Join(files, "|");
+  }
+
+  // include files loaded depending on conditions
+  state += "|" + StringUtils::Join(m_includes.GetFiles(), "|");
+
+  return Crc32::Compute(state);
 }
 
 void CSkinInfo::LoadTimers()
@@ -423,6 +455,7 @@ void CSkinInfo::OnPostInstall(bool update, bool modal)
 void CSkinInfo::Unload()
 {
   m_skinTimerManager->Stop();
+  m_windowCache.Close();
 }
 
 bool CSkinInfo::TimerIsRunning(const std::string& timer) const
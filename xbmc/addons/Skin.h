@@ -11,6 +11,7 @@
 #include "addons/Addon.h"
 #include "addons/gui/skin/SkinTimerManager.h"
 #include "guilib/GUIIncludes.h" // needed for the GUIInclude member
+#include "guilib/GUIWindowCache.h" // needed for the GUIWindowCache member
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 
 #include <map>
@@ -173,6 +174,11 @@ public:
 
   void LoadIncludes();
 
+  /*! \brief Get the cache of the skin's windows with their includes resolved
+   \details Valid from loading the includes of the skin until unloading it.
+   */
+  CGUIWindowCache& GetWindowCache() { return m_windowCache; }
+
   /*! \brief Load the defined skin timers
    \details Skin timers are defined in Timers.xml \sa Skin_Timers
    */
@@ -265,6 +271,11 @@ public:
 protected:
   bool LoadStartupWindows(const AddonInfoPtr& addonInfo);
 
+  /*! \brief Get the state of everything the resolved windows of the skin depend on,
+   except the include conditions checked for every window.
+   */
+  uint32_t GetWindowCacheState() const;
+
   static CSkinSettingPtr ParseSetting(const TiXmlElement* element);
 
   bool SettingsLoaded(AddonInstanceId id = ADDON_SETTINGS_ID) const override;
@@ -278,6 +289,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIWindowCache m_windowCache;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
@@ -127,6 +127,7 @@
 #include "settings/SettingsComponent.h"
 #include "speech/ISpeechRecognition.h"
 #include "storage/MediaManager.h"
+#include "threads/LockProfiler.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/AlarmClock.h"
@@ -139,6 +140,7 @@
 #include "utils/PlayerUtils.h"
 #include "utils/RegExp.h"
 #include "utils/Screenshot.h"
+#include "utils/StartupTrace.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/TimeUtils.h"
@@ -256,6 +258,8 @@ extern "C" void __stdcall cleanup_emu_environ();
 
 bool CApplication::Create()
 {
+  CStartupTrace::CScope trace("CApplication::Create");
+
   m_bStop = false;
 
   RegisterSettings();
@@ -318,8 +322,11 @@ bool CApplication::Create()
 
   CLog::Log(LOGINFO, "loading settings");
   const auto settingsComponent = CServiceBroker::GetSettingsComponent();
-  if (!settingsComponent->Load())
-    return false;
+  {
+    CStartupTrace::CScope settingsTrace("CSettingsComponent::Load");
+    if (!settingsComponent->Load())
+      return false;
+  }
 
   // Log Cache GUI settings (replacement of cache in advancedsettings.xml)
   const auto settings = settingsComponent->GetSettings();
@@ -395,6 +402,8 @@ bool CApplication::Create()
 
 bool CApplication::CreateGUI()
 {
+  CStartupTrace::CScope trace("CApplication::CreateGUI");
+
   m_frameMoveGuard.lock();
 
   const auto appPower = GetComponent<CApplicationPowerHandling>();
@@ -540,6 +549,8 @@ bool CApplication::InitWindow(RESOLUTION res)
 
 bool CApplication::Initialize()
 {
+  CStartupTrace::CScope trace("CApplication::Initialize");
+
   m_pActiveAE->Start();
   // restore AE's previous volume state
 
@@ -556,8 +567,11 @@ bool CApplication::Initialize()
 #endif
 
   // load the language and its translated strings
-  if (!LoadLanguage(false))
-    return false;
+  {
+    CStartupTrace::CScope languageTrace("CApplication::LoadLanguage");
+    if (!LoadLanguage(false))
+      return false;
+  }
 
   // load media manager sources (e.g. root addon type sources depend on language strings to be available)
   CServiceBroker::GetMediaManager().LoadSources();
@@ -569,16 +583,37 @@ bool CApplication::Initialize()
       StringUtils::Format(g_localizeStrings.Get(178), g_sysinfo.GetAppName()),
       "special://xbmc/media/icon256x256.png", EventLevel::Basic)));
 
-  m_ServiceManager->GetNetwork().WaitForNet();
+  // Initialize GUI font manager to build/update fonts cache, it is independent of the network and
+  // the databases
+  //! @todo Move GUIFontManager into service broker and drop the global reference
+  CEvent fontsEvent(true);
+  GUIFontManager& guiFontManager = g_fontManager;
+  CServiceBroker::GetJobManager()->Submit(
+      [&guiFontManager, &fontsEvent]()
+      {
+        CStartupTrace::CScope trace("GUIFontManager::Initialize");
+        guiFontManager.Initialize();
+        fontsEvent.Set();
+      },
+      CJob::PRIORITY_DEDICATED);
+
+  {
+    CStartupTrace::CScope trace("CNetworkBase::WaitForNet");
+    m_ServiceManager->GetNetwork().WaitForNet();
+  }
 
   // initialize (and update as needed) our databases
   CDatabaseManager &databaseManager = m_ServiceManager->GetDatabaseManager();
 
   CEvent event(true);
-  CServiceBroker::GetJobManager()->Submit([&databaseManager, &event]() {
-    databaseManager.Initialize();
-    event.Set();
-  });
+  CServiceBroker::GetJobManager()->Submit(
+      [&databaseManager, &event]()
+      {
+        CStartupTrace::CScope trace("CDatabaseManager::Initialize");
+        databaseManager.Initialize();
+        event.Set();
+      },
+      CJob::PRIORITY_DEDICATED);
 
   std::string localizedStr = g_localizeStrings.Get(24150);
   int iDots = 1;
@@ -594,17 +629,10 @@ bool CApplication::Initialize()
   }
   CServiceBroker::GetRenderSystem()->ShowSplash("");
 
-  // Initialize GUI font manager to build/update fonts cache
-  //! @todo Move GUIFontManager into service broker and drop the global reference
-  event.Reset();
-  GUIFontManager& guiFontManager = g_fontManager;
-  CServiceBroker::GetJobManager()->Submit([&guiFontManager, &event]() {
-    guiFontManager.Initialize();
-    event.Set();
-  });
+  // wait for the fonts cache
   localizedStr = g_localizeStrings.Get(39175);
   iDots = 1;
-  while (!event.Wait(1000ms))
+  while (!fontsEvent.Wait(1000ms))
   {
     if (g_fontManager.IsUpdating())
       CServiceBroker::GetRenderSystem()->ShowSplash(std::string(iDots, ' ') + localizedStr +
@@ -628,7 +656,10 @@ bool CApplication::Initialize()
   {
     const auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
 
-    CServiceBroker::GetGUI()->GetWindowManager().CreateWindows();
+    {
+      CStartupTrace::CScope windowsTrace("CGUIWindowManager::CreateWindows");
+      CServiceBroker::GetGUI()->GetWindowManager().CreateWindows();
+    }
 
     skinHandling->m_confirmSkinChange = false;
 
@@ -684,15 +715,18 @@ bool CApplication::Initialize()
     CServiceBroker::RegisterTextureCache(std::make_shared<CTextureCache>());
 
     std::string skinId = settings->GetString(CSettings::SETTING_LOOKANDFEEL_SKIN);
-    if (!skinHandling->LoadSkin(skinId))
     {
-      CLog::Log(LOGERROR, "Failed to load skin '{}'", skinId);
-      std::string defaultSkin =
-          std::static_pointer_cast<const CSettingString>(setting)->GetDefault();
-      if (!skinHandling->LoadSkin(defaultSkin))
+      CStartupTrace::CScope skinTrace("CApplicationSkinHandling::LoadSkin");
+      if (!skinHandling->LoadSkin(skinId))
       {
-        CLog::Log(LOGFATAL, "Default skin '{}' could not be loaded! Terminating..", defaultSkin);
-        return false;
+        CLog::Log(LOGERROR, "Failed to load skin '{}'", skinId);
+        std::string defaultSkin =
+            std::static_pointer_cast<const CSettingString>(setting)->GetDefault();
+        if (!skinHandling->LoadSkin(defaultSkin))
+        {
+          CLog::Log(LOGFATAL, "Default skin '{}' could not be loaded! Terminating..", defaultSkin);
+          return false;
+        }
       }
     }
 
@@ -717,7 +751,10 @@ bool CApplication::Initialize()
     {
       // activate the configured start window
       int firstWindow = g_SkinInfo->GetFirstWindow();
-      CServiceBroker::GetGUI()->GetWindowManager().ActivateWindow(firstWindow);
+      {
+        CStartupTrace::CScope windowTrace("CGUIWindowManager::ActivateWindow");
+        CServiceBroker::GetGUI()->GetWindowManager().ActivateWindow(firstWindow);
+      }
 
       if (CServiceBroker::GetGUI()->GetWindowManager().IsWindowActive(WINDOW_STARTUP_ANIM))
       {
@@ -855,8 +892,23 @@ void CApplication::Render()
     infoMgr.GetInfoProviders().GetSystemInfoProvider().UpdateFPS();
   }
 
-  CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered,
-                                                       appPlayer->IsRenderingVideoLayer());
+  CGUIWindowManager& windowManager = CServiceBroker::GetGUI()->GetWindowManager();
+  CGUIFrameStatistics& frameStatistics = windowManager.GetFrameStatistics();
+  {
+    CGUIFrameStatistics::CStageTimer stageTimer(frameStatistics,
+                                                CGUIFrameStatistics::Stage::PRESENT);
+    CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered,
+                                                         appPlayer->IsRenderingVideoLayer());
+  }
+
+  const CRenderSystemBase::DrawStatistics& drawStatistics =
+      CServiceBroker::GetRenderSystem()->GetDrawStatistics();
+  frameStatistics.AddDrawCalls(drawStatistics.drawCalls, drawStatistics.quads);
+
+  const float fps = CServiceBroker::GetWinSystem()->GetGfxContext().GetFPS();
+  frameStatistics.EndFrame(windowManager.GetActiveWindowOrDialog(), hasRendered,
+                           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<double>(fps > 0.0f ? 1.0 / fps : 0.0)));
 
   CTimeUtils::UpdateFrameTime(hasRendered);
 }
@@ -2136,6 +2188,8 @@ bool CApplication::Stop(int exitCode)
     m_pActiveAE->Shutdown();
     m_pActiveAE.reset();
 
+    XbmcThreads::CLockProfiler::LogReport(20);
+
     CLog::Log(LOGINFO, "Application stopped");
   }
   catch (...)
@@ -15,6 +15,7 @@
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "video/VideoFileItemClassify.h"
@@ -839,6 +840,9 @@ void CApplicationPlayer::FrameMove()
 
 void CApplicationPlayer::Render(bool clear, uint32_t alpha, bool gui)
 {
+  // the video is drawn past the render system, the GUI queued so far goes first
+  CServiceBroker::GetRenderSystem()->FlushBatch();
+
   std::shared_ptr<IPlayer> player = GetInternal();
   if (player)
     player->Render(clear, alpha, gui);
@@ -191,7 +191,7 @@ private:
   void CloseFile(bool reopen = false);
 
   std::shared_ptr<IPlayer> m_pPlayer;
-  mutable CCriticalSection m_playerLock;
+  mutable CCriticalSection m_playerLock{"ApplicationPlayer"};
   CSeekHandler m_seekHandler;
 
   // cache player state
@@ -20,6 +20,7 @@
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/Trace.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
@@ -36,6 +37,7 @@ namespace
 constexpr float MAX_CACHE_LEVEL = 0.4f; // total cache time of stream in seconds;
 constexpr float MAX_WATER_LEVEL = 0.2f; // buffered time after stream stages in seconds;
 constexpr double MAX_BUFFER_TIME = 0.1; // max time of a buffer in seconds;
+constexpr auto STEADY_STATE_DELAY = 5s; // time after configure until processing must not allocate
 } // unnamed namespace
 
 void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
@@ -126,11 +128,10 @@ void CEngineStats::UpdateStream(CActiveAEStream *stream)
       }
 
       std::unique_lock<CCriticalSection> lock(stream->m_statsLock);
-      std::deque<CSampleBuffer*>::iterator itBuf;
-      for(itBuf=stream->m_processingSamples.begin(); itBuf!=stream->m_processingSamples.end(); ++itBuf)
+      for (const auto& buf : stream->m_processingSamples)
       {
         if (m_pcmOutput)
-          delay += (float)(*itBuf)->pkt->nb_samples / (*itBuf)->pkt->config.sample_rate;
+          delay += (float)buf->pkt->nb_samples / buf->pkt->config.sample_rate;
         else
           delay += static_cast<float>(m_sinkFormat.m_streamInfo.GetDuration() / 1000.0);
       }
@@ -1006,11 +1007,15 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
             m_extTimeout = 100ms;
             return;
           }
+          // once buffers have settled after configure, processing must not allocate
+          CActiveAEAllocationTracer::SetSteady(m_steadyTimer.IsTimePast());
           if (RunStages())
           {
+            CActiveAEAllocationTracer::SetSteady(false);
             m_extTimeout = 0ms;
             return;
           }
+          CActiveAEAllocationTracer::SetSteady(false);
           if (!m_extDrain && HasWork())
           {
             ClearDiscardedBuffers();
@@ -1170,6 +1175,8 @@ AEAudioFormat CActiveAE::GetInputFormat(AEAudioFormat *desiredFmt)
 
 void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 {
+  KODI_TRACE_SCOPE("audio", "CActiveAE::Configure");
+
   bool initSink = false;
 
   AEAudioFormat sinkInputFormat, inputFormat;
@@ -1178,6 +1185,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
   inputFormat = GetInputFormat(desiredFmt);
 
+  m_steadyTimer.Set(STEADY_STATE_DELAY);
+
   m_sinkRequestFormat = inputFormat;
   ApplySettingsToFormat(m_sinkRequestFormat, m_settings, (int*)&m_mode);
   m_extKeepConfig = 0ms;
@@ -1215,7 +1224,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
   if (m_silenceBuffers)
   {
-    m_discardBufferPools.push_back(std::move(m_silenceBuffers));
+    DiscardBufferPool(std::move(m_silenceBuffers));
     m_silenceBuffers = NULL;
   }
 
@@ -1231,8 +1240,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     inputFormat.m_dataFormat = AE_FMT_FLOAT;
     inputFormat.m_frameSize = inputFormat.m_channelLayout.Count() *
                               (CAEUtil::DataFormatToBits(inputFormat.m_dataFormat) >> 3);
-    m_silenceBuffers = std::make_unique<CActiveAEBufferPool>(inputFormat);
-    m_silenceBuffers->Create(MAX_WATER_LEVEL*1000);
+    m_silenceBuffers = m_bufferPoolCache.Get(inputFormat, MAX_WATER_LEVEL * 1000);
     sinkInputFormat = inputFormat;
     m_internalFormat = inputFormat;
 
@@ -1244,15 +1252,15 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
     if (m_encoderBuffers)
     {
-      m_discardBufferPools.push_back(std::move(m_encoderBuffers));
+      DiscardBufferPool(std::move(m_encoderBuffers));
     }
     if (m_vizBuffers)
     {
-      m_discardBufferPools.push_back(std::move(m_vizBuffers));
+      DiscardBufferPool(std::move(m_vizBuffers));
     }
     if (m_vizBuffersInput)
     {
-      m_discardBufferPools.push_back(std::move(m_vizBuffersInput));
+      DiscardBufferPool(std::move(m_vizBuffersInput));
     }
   }
   // resample buffers for streams
@@ -1303,12 +1311,11 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         //! @todo implement
         if (m_encoderBuffers && initSink)
         {
-          m_discardBufferPools.push_back(std::move(m_encoderBuffers));
+          DiscardBufferPool(std::move(m_encoderBuffers));
         }
         if (!m_encoderBuffers)
         {
-          m_encoderBuffers = std::make_unique<CActiveAEBufferPool>(format);
-          m_encoderBuffers->Create(MAX_WATER_LEVEL*1000);
+          m_encoderBuffers = m_bufferPoolCache.Get(format, MAX_WATER_LEVEL * 1000);
         }
       }
 
@@ -1349,8 +1356,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         (*it)->m_format.m_frames = m_internalFormat.m_frames * ((float)(*it)->m_format.m_sampleRate / m_internalFormat.m_sampleRate);
 
         // create buffer pool
-        (*it)->m_inputBuffers = std::make_unique<CActiveAEBufferPool>((*it)->m_format);
-        (*it)->m_inputBuffers->Create(MAX_CACHE_LEVEL*1000);
+        (*it)->m_inputBuffers = m_bufferPoolCache.Get((*it)->m_format, MAX_CACHE_LEVEL * 1000);
         (*it)->m_streamSpace = (*it)->m_format.m_frameSize * (*it)->m_format.m_frames;
 
         // if input format does not follow ffmpeg channel mask, we may need to remap channels
@@ -1359,8 +1365,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
       if (initSink && (*it)->m_processingBuffers)
       {
         (*it)->m_processingBuffers->Flush();
-        m_discardBufferPools.push_back((*it)->m_processingBuffers->GetResampleBuffers());
-        m_discardBufferPools.push_back((*it)->m_processingBuffers->GetAtempoBuffers());
+        DiscardBufferPool((*it)->m_processingBuffers->GetResampleBuffers());
+        DiscardBufferPool((*it)->m_processingBuffers->GetAtempoBuffers());
         (*it)->m_processingBuffers.reset();
       }
       if (!(*it)->m_processingBuffers)
@@ -1387,8 +1393,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     {
       if (initSink && m_vizBuffers)
       {
-        m_discardBufferPools.push_back(std::move(m_vizBuffers));
-        m_discardBufferPools.push_back(std::move(m_vizBuffersInput));
+        DiscardBufferPool(std::move(m_vizBuffers));
+        DiscardBufferPool(std::move(m_vizBuffersInput));
       }
       if (!m_vizBuffers && !m_audioCallback.empty())
       {
@@ -1401,21 +1407,21 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
             (static_cast<float>(vizFormat.m_sampleRate) / m_internalFormat.m_sampleRate);
 
         // input buffers
-        m_vizBuffersInput = std::make_unique<CActiveAEBufferPool>(m_internalFormat);
-        m_vizBuffersInput->Create(2000 + m_stats.GetMaxDelay() * 1000);
+        m_vizBuffersInput =
+            m_bufferPoolCache.Get(m_internalFormat, 2000 + m_stats.GetMaxDelay() * 1000);
 
         // resample buffers
         m_vizBuffers = std::make_unique<CActiveAEBufferPoolResample>(m_internalFormat, vizFormat,
                                                                      m_settings.resampleQuality);
         //! @todo use cache of sync + water level
+        m_bufferPoolCache.Acquire(*m_vizBuffers, 2000 + m_stats.GetMaxDelay() * 1000);
         m_vizBuffers->Create(2000 + m_stats.GetMaxDelay() * 1000, false, false);
         m_vizInitialized = false;
       }
     }
 
     // buffers need to sync
-    m_silenceBuffers = std::make_unique<CActiveAEBufferPool>(outputFormat);
-    m_silenceBuffers->Create(500);
+    m_silenceBuffers = m_bufferPoolCache.Get(outputFormat, 500);
   }
 
   // resample buffers for sink
@@ -1424,12 +1430,13 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
       !CompareFormat(m_sinkBuffers->m_inputFormat, sinkInputFormat) ||
       m_sinkBuffers->m_format.m_frames != m_sinkFormat.m_frames))
   {
-    m_discardBufferPools.push_back(std::move(m_sinkBuffers));
+    DiscardBufferPool(std::move(m_sinkBuffers));
   }
   if (!m_sinkBuffers)
   {
     m_sinkBuffers = std::make_unique<CActiveAEBufferPoolResample>(sinkInputFormat, m_sinkFormat,
                                                                   m_settings.resampleQuality);
+    m_bufferPoolCache.Acquire(*m_sinkBuffers, MAX_WATER_LEVEL * 1000);
     m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
   }
 
@@ -1515,12 +1522,12 @@ void CActiveAE::DiscardStream(CActiveAEStream *stream)
         (*it)->m_processingSamples.pop_front();
       }
       if ((*it)->m_inputBuffers)
-        m_discardBufferPools.push_back(std::move((*it)->m_inputBuffers));
+        DiscardBufferPool(std::move((*it)->m_inputBuffers));
       if ((*it)->m_processingBuffers)
       {
         (*it)->m_processingBuffers->Flush();
-        m_discardBufferPools.push_back((*it)->m_processingBuffers->GetResampleBuffers());
-        m_discardBufferPools.push_back((*it)->m_processingBuffers->GetAtempoBuffers());
+        DiscardBufferPool((*it)->m_processingBuffers->GetResampleBuffers());
+        DiscardBufferPool((*it)->m_processingBuffers->GetAtempoBuffers());
       }
       CLog::Log(LOGDEBUG, "CActiveAE::DiscardStream - audio stream deleted");
       m_stats.RemoveStream((*it)->m_id);
@@ -1595,10 +1602,11 @@ void CActiveAE::ClearDiscardedBuffers()
     {
       rbuf->Flush();
     }
-    // if all buffers have returned, we can delete the buffer pool
-    if ((*it)->m_allSamples.size() == (*it)->m_freeSamples.size())
+    // if all buffers have returned, we can reuse or delete the buffer pool
+    if ((*it)->IsIdle())
     {
-      CLog::Log(LOGDEBUG, "CActiveAE::ClearDiscardedBuffers - buffer pool deleted");
+      if (!m_bufferPoolCache.Recycle(*it))
+        CLog::Log(LOGDEBUG, "CActiveAE::ClearDiscardedBuffers - buffer pool deleted");
       it = m_discardBufferPools.erase(it);
     }
     else
@@ -1606,6 +1614,16 @@ void CActiveAE::ClearDiscardedBuffers()
   }
 }
 
+void CActiveAE::DiscardBufferPool(std::unique_ptr<CActiveAEBufferPool> pool)
+{
+  if (!pool)
+    return;
+
+  // idle pools can go to the cache right away, others wait for their buffers
+  if (!m_bufferPoolCache.Recycle(pool))
+    m_discardBufferPools.push_back(std::move(pool));
+}
+
 void CActiveAE::SStopSound(CActiveAESound *sound)
 {
   std::list<SoundState>::iterator it;
@@ -1786,6 +1804,8 @@ bool CActiveAE::NeedReconfigureSink()
 
 bool CActiveAE::InitSink()
 {
+  KODI_TRACE_SCOPE("audio", "CActiveAE::InitSink");
+
   SinkConfig config;
   config.format = m_sinkRequestFormat;
   config.stats = &m_stats;
@@ -1891,6 +1911,8 @@ void CActiveAE::UnconfigureSink()
 
 bool CActiveAE::RunStages()
 {
+  KODI_TRACE_SCOPE("audio", "CActiveAE::RunStages");
+
   bool busy = false;
 
   // serve input streams
@@ -2118,15 +2140,7 @@ bool CActiveAE::RunStages()
 
               for(int j=0; j<out->pkt->planes; j++)
               {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
+                CAEUtil::MulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
               }
             }
           }
@@ -2187,24 +2201,9 @@ bool CActiveAE::RunStages()
               {
                 float *dst = (float*)out->pkt->data[j]+i*nb_floats;
                 float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                CAEUtil::MulAddArray(dst, src, volume, nb_floats);
+                if (!needClamp && CAEUtil::PeakArray(dst, nb_floats) > 1.0f)
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2579,7 +2578,11 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
   for (it = m_sounds_playing.begin(); it != m_sounds_playing.end(); )
   {
     if (!it->sound->IsConverted())
+    {
+      // converting a sound on first use is expected to allocate
+      CActiveAEAllocationTracer::SetSteady(false);
       ResampleSound(it->sound);
+    }
     int available_samples = it->sound->GetSound(false)->nb_samples - it->samples_played;
     int mix_samples = std::min(max_samples, available_samples);
     int start = it->samples_played *
@@ -2593,12 +2596,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEUtil::MulAddArray(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2623,13 +2621,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEUtil::MulArray(buffer, volume, nb_floats);
     }
   }
 }
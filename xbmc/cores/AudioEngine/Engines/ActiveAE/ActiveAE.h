@@ -322,6 +322,7 @@ protected:
   void SFlushStream(CActiveAEStream *stream);
   void FlushEngine();
   void ClearDiscardedBuffers();
+  void DiscardBufferPool(std::unique_ptr<CActiveAEBufferPool> pool);
   void SStopSound(CActiveAESound *sound);
   void DiscardSound(CActiveAESound *sound);
   void ChangeResamplers();
@@ -347,6 +348,7 @@ protected:
   bool m_extError;
   bool m_extDrain;
   XbmcThreads::EndTime<> m_extDrainTimer;
+  XbmcThreads::EndTime<> m_steadyTimer;
   std::chrono::milliseconds m_extKeepConfig;
   bool m_extDeferData;
   std::queue<time_t> m_extLastDeviceChange;
@@ -383,6 +385,7 @@ protected:
   // streams
   std::list<CActiveAEStream*> m_streams;
   std::list<std::unique_ptr<CActiveAEBufferPool>> m_discardBufferPools;
+  CActiveAEBufferPoolCache m_bufferPoolCache;
   unsigned int m_streamIdGen;
 
   // gui sounds
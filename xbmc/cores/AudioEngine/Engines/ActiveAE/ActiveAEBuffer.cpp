@@ -12,13 +12,17 @@
 #include "ActiveAEFilter.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
+#include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
+#include <typeinfo>
 
 using namespace ActiveAE;
 
 CSoundPacket::CSoundPacket(const SampleConfig& conf, int samples) : config(conf)
 {
+  CActiveAEAllocationTracer::OnAllocation("sound packet");
   data = CActiveAE::AllocSoundSample(config, samples, bytes_per_sample, planes, linesize);
   max_nb_samples = samples;
   nb_samples = 0;
@@ -44,36 +48,106 @@ void CSampleBuffer::Return()
     pool->ReturnBuffer(this);
 }
 
-CActiveAEBufferPool::CActiveAEBufferPool(const AEAudioFormat& format) : m_format(format)
+thread_local bool CActiveAEAllocationTracer::m_steady = false;
+std::atomic_uint CActiveAEAllocationTracer::m_steadyAllocations{0};
+std::atomic_uint CActiveAEAllocationTracer::m_steadyHeapAllocations{0};
+
+void CActiveAEAllocationTracer::SetSteady(bool steady)
+{
+  m_steady = steady;
+}
+
+bool CActiveAEAllocationTracer::IsSteady()
+{
+  return m_steady;
+}
+
+void CActiveAEAllocationTracer::OnAllocation(const char* what)
+{
+  if (!m_steady)
+    return;
+
+  // only report the first one, logging allocates as well
+  if (m_steadyAllocations++ == 0)
+    CLog::Log(LOGWARNING, "CActiveAEAllocationTracer::{} - {} allocated in steady state",
+              __FUNCTION__, what);
+}
+
+unsigned int CActiveAEAllocationTracer::GetSteadyAllocations()
+{
+  return m_steadyAllocations;
+}
+
+unsigned int CActiveAEAllocationTracer::GetSteadyHeapAllocations()
+{
+  return m_steadyHeapAllocations;
+}
+
+void CActiveAEAllocationTracer::Reset()
+{
+  m_steadyAllocations = 0;
+  m_steadyHeapAllocations = 0;
+}
+
+void CSampleBufferQueue::reserve(size_t capacity)
+{
+  if (capacity <= m_slots.size())
+    return;
+
+  CActiveAEAllocationTracer::OnAllocation("sample queue");
+
+  std::vector<CSampleBuffer*> slots(capacity, nullptr);
+  for (size_t i = 0; i < m_size; ++i)
+    slots[i] = At(i);
+  m_slots.swap(slots);
+  m_head = 0;
+}
+
+void CSampleBufferQueue::push_back(CSampleBuffer* buffer)
+{
+  if (m_size == m_slots.size())
+    reserve(std::max<size_t>(8, m_slots.size() * 2));
+
+  m_slots[(m_head + m_size) % m_slots.size()] = buffer;
+  m_size++;
+}
+
+void CSampleBufferQueue::pop_front()
+{
+  m_slots[m_head] = nullptr;
+  m_head = (m_head + 1) % m_slots.size();
+  m_size--;
+}
+
+CActiveAEBufferPool::CActiveAEBufferPool(const AEAudioFormat& format)
+  : m_format(GetPoolFormat(format))
 {
-  if (m_format.m_dataFormat == AE_FMT_RAW)
-  {
-    m_format.m_frameSize = 1;
-    m_format.m_frames = 61440;
-    m_format.m_channelLayout.Reset();
-    m_format.m_channelLayout += AE_CH_FC;
-  }
 }
 
-CActiveAEBufferPool::~CActiveAEBufferPool()
+AEAudioFormat CActiveAEBufferPool::GetPoolFormat(const AEAudioFormat& format)
 {
-  CSampleBuffer *buffer;
-  while(!m_allSamples.empty())
+  AEAudioFormat poolFormat = format;
+  if (poolFormat.m_dataFormat == AE_FMT_RAW)
   {
-    buffer = m_allSamples.front();
-    m_allSamples.pop_front();
-    delete buffer;
+    poolFormat.m_frameSize = 1;
+    poolFormat.m_frames = 61440;
+    poolFormat.m_channelLayout.Reset();
+    poolFormat.m_channelLayout += AE_CH_FC;
   }
+  return poolFormat;
 }
 
+CActiveAEBufferPool::~CActiveAEBufferPool() = default;
+
 CSampleBuffer* CActiveAEBufferPool::GetFreeBuffer()
 {
   CSampleBuffer* buf = NULL;
 
   if (!m_freeSamples.empty())
   {
-    buf = m_freeSamples.front();
-    m_freeSamples.pop_front();
+    // most recently returned buffer is most likely still in cache
+    buf = m_freeSamples.back();
+    m_freeSamples.pop_back();
     buf->refCount = 1;
     buf->centerMixLevel = M_SQRT1_2;
   }
@@ -89,7 +163,6 @@ void CActiveAEBufferPool::ReturnBuffer(CSampleBuffer *buffer)
 
 bool CActiveAEBufferPool::Create(unsigned int totaltime)
 {
-  CSampleBuffer *buffer;
   SampleConfig config;
   config.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
   config.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
@@ -107,19 +180,105 @@ bool CActiveAEBufferPool::Create(unsigned int totaltime)
   unsigned int n = 0;
   while (time < totaltime || n < 5)
   {
-    buffer = new CSampleBuffer();
+    auto buffer = std::make_unique<CSampleBuffer>();
     buffer->pool = this;
     buffer->pkt = std::make_unique<CSoundPacket>(config, m_format.m_frames);
 
-    m_allSamples.push_back(buffer);
-    m_freeSamples.push_back(buffer);
+    m_freeSamples.push_back(buffer.get());
+    m_allSamples.push_back(std::move(buffer));
     time += buffertime;
     n++;
   }
+  m_totalTime = totaltime;
+
+  // returning buffers must never grow the free list
+  m_freeSamples.reserve(m_allSamples.size());
+
+  return true;
+}
+
+void CActiveAEBufferPool::TakeBuffers(CActiveAEBufferPool& other)
+{
+  m_allSamples = std::move(other.m_allSamples);
+  m_freeSamples = std::move(other.m_freeSamples);
+  m_totalTime = other.m_totalTime;
+  other.m_allSamples.clear();
+  other.m_freeSamples.clear();
+
+  for (auto& buffer : m_allSamples)
+    buffer->pool = this;
+}
+
+// ----------------------------------------------------------------------------------
+// Pool cache
+// ----------------------------------------------------------------------------------
+
+std::unique_ptr<CActiveAEBufferPool> CActiveAEBufferPoolCache::Get(const AEAudioFormat& format,
+                                                                   unsigned int totaltime)
+{
+  // apply the same adjustments the pool applies to its format before comparing
+  const auto it = Find(CActiveAEBufferPool::GetPoolFormat(format), totaltime);
+  if (it != m_pools.end())
+  {
+    std::unique_ptr<CActiveAEBufferPool> pool = std::move(*it);
+    m_pools.erase(it);
+    return pool;
+  }
+
+  auto pool = std::make_unique<CActiveAEBufferPool>(format);
+  pool->Create(totaltime);
+  return pool;
+}
+
+bool CActiveAEBufferPoolCache::Acquire(CActiveAEBufferPool& pool, unsigned int totaltime)
+{
+  const auto it = Find(pool.m_format, totaltime);
+  if (it == m_pools.end())
+    return false;
+
+  pool.TakeBuffers(**it);
+  m_pools.erase(it);
+  return true;
+}
+
+bool CActiveAEBufferPoolCache::Recycle(std::unique_ptr<CActiveAEBufferPool>& pool)
+{
+  // raw pools depend on stream info
+  if (!pool || !pool->IsIdle() || pool->m_allSamples.empty() ||
+      pool->m_format.m_dataFormat == AE_FMT_RAW)
+    return false;
+
+  // resample and atempo pools carry processing state, only their sample buffers are kept
+  if (typeid(*pool) != typeid(CActiveAEBufferPool))
+  {
+    auto plain = std::make_unique<CActiveAEBufferPool>(pool->m_format);
+    plain->TakeBuffers(*pool);
+    pool = std::move(plain);
+  }
+
+  m_pools.insert(m_pools.begin(), std::move(pool));
+  if (m_pools.size() > MAX_CACHED_POOLS)
+    m_pools.pop_back();
 
   return true;
 }
 
+std::vector<std::unique_ptr<CActiveAEBufferPool>>::iterator CActiveAEBufferPoolCache::Find(
+    const AEAudioFormat& format, unsigned int totaltime)
+{
+  return std::find_if(m_pools.begin(), m_pools.end(),
+                      [&format, totaltime](const auto& pool)
+                      {
+                        const AEAudioFormat& cached = pool->m_format;
+                        return cached.m_dataFormat == format.m_dataFormat &&
+                               cached.m_sampleRate == format.m_sampleRate &&
+                               cached.m_channelLayout == format.m_channelLayout &&
+                               cached.m_frames == format.m_frames &&
+                               cached.m_frameSize == format.m_frameSize &&
+                               pool->m_totalTime >= totaltime;
+                      });
+}
+
 // ----------------------------------------------------------------------------------
 // Resample
 // ----------------------------------------------------------------------------------
@@ -147,7 +306,9 @@ CActiveAEBufferPoolResample::~CActiveAEBufferPoolResample()
 bool CActiveAEBufferPoolResample::Create(
     unsigned int totaltime, bool remap, bool upmix, bool normalize, float sublevel)
 {
-  CActiveAEBufferPool::Create(totaltime);
+  // the sample buffers may have been taken over from CActiveAEBufferPoolCache
+  if (m_allSamples.empty())
+    CActiveAEBufferPool::Create(totaltime);
 
   m_remap = remap;
   m_stereoUpmix = upmix;
@@ -371,19 +532,18 @@ void CActiveAEBufferPoolResample::ConfigureResampler(bool normalizelevels,
 float CActiveAEBufferPoolResample::GetDelay()
 {
   float delay = 0;
-  std::deque<CSampleBuffer*>::iterator itBuf;
 
   if (m_procSample)
     delay += (float)m_procSample->pkt->nb_samples / m_procSample->pkt->config.sample_rate;
 
-  for(itBuf=m_inputSamples.begin(); itBuf!=m_inputSamples.end(); ++itBuf)
+  for (const auto& buf : m_inputSamples)
   {
-    delay += (float)(*itBuf)->pkt->nb_samples / (*itBuf)->pkt->config.sample_rate;
+    delay += (float)buf->pkt->nb_samples / buf->pkt->config.sample_rate;
   }
 
-  for(itBuf=m_outputSamples.begin(); itBuf!=m_outputSamples.end(); ++itBuf)
+  for (const auto& buf : m_outputSamples)
   {
-    delay += (float)(*itBuf)->pkt->nb_samples / (*itBuf)->pkt->config.sample_rate;
+    delay += (float)buf->pkt->nb_samples / buf->pkt->config.sample_rate;
   }
 
   if (m_resampler)
@@ -10,9 +10,11 @@
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
+
+#include <atomic>
 #include <cmath>
-#include <deque>
 #include <memory>
+#include <vector>
 
 extern "C" {
 #include <libavutil/avutil.h>
@@ -57,17 +59,145 @@ public:
   double centerMixLevel;
 };
 
+/**
+ * Counts sample buffer allocations made by a thread after it declared its
+ * processing steady. The audio thread arms it once playback has settled,
+ * any allocation from pools or queues after that point is a bug.
+ *
+ * Sound packets come from av_malloc, so pools and queues report them with
+ * OnAllocation. Builds that replace operator new, like the unit tests, also
+ * report every heap allocation with OnHeapAllocation.
+ */
+class CActiveAEAllocationTracer
+{
+public:
+  static void SetSteady(bool steady);
+  static bool IsSteady();
+  static void OnAllocation(const char* what);
+  static unsigned int GetSteadyAllocations();
+
+  /*! \brief count a heap allocation of the calling thread if it is steady,
+   called from operator new and therefore must not allocate itself
+   */
+  static void OnHeapAllocation()
+  {
+    if (m_steady)
+      m_steadyHeapAllocations++;
+  }
+  static unsigned int GetSteadyHeapAllocations();
+
+  static void Reset();
+
+private:
+  static thread_local bool m_steady;
+  static std::atomic_uint m_steadyAllocations;
+  static std::atomic_uint m_steadyHeapAllocations;
+};
+
+/**
+ * FIFO of sample buffers stored in a ring of slots. Unlike std::deque it
+ * does not allocate on push/pop once it has grown to the number of buffers
+ * in flight, which keeps the audio thread off the heap in steady state.
+ */
+class CSampleBufferQueue
+{
+public:
+  class const_iterator
+  {
+  public:
+    const_iterator(const CSampleBufferQueue& queue, size_t pos) : m_queue(queue), m_pos(pos) {}
+    CSampleBuffer* const& operator*() const { return m_queue.At(m_pos); }
+    const_iterator& operator++()
+    {
+      ++m_pos;
+      return *this;
+    }
+    bool operator!=(const const_iterator& rhs) const { return m_pos != rhs.m_pos; }
+
+  private:
+    const CSampleBufferQueue& m_queue;
+    size_t m_pos;
+  };
+
+  void reserve(size_t capacity);
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+  size_t capacity() const { return m_slots.size(); }
+  CSampleBuffer* front() const { return m_slots[m_head]; }
+  void push_back(CSampleBuffer* buffer);
+  void pop_front();
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, m_size); }
+
+private:
+  CSampleBuffer* const& At(size_t pos) const { return m_slots[(m_head + pos) % m_slots.size()]; }
+
+  std::vector<CSampleBuffer*> m_slots;
+  size_t m_head = 0;
+  size_t m_size = 0;
+};
+
 class CActiveAEBufferPool
 {
 public:
   explicit CActiveAEBufferPool(const AEAudioFormat& format);
+
+  /*! \brief get format with the adjustments a pool applies to it, e.g. for raw streams
+   */
+  static AEAudioFormat GetPoolFormat(const AEAudioFormat& format);
+
   virtual ~CActiveAEBufferPool();
   virtual bool Create(unsigned int totaltime);
   CSampleBuffer *GetFreeBuffer();
   void ReturnBuffer(CSampleBuffer *buffer);
+  bool IsIdle() const { return m_allSamples.size() == m_freeSamples.size(); }
+
+  /*! \brief move all sample buffers of the idle pool other into this pool, which has none
+   */
+  void TakeBuffers(CActiveAEBufferPool& other);
+
   AEAudioFormat m_format;
-  std::deque<CSampleBuffer*> m_allSamples;
-  std::deque<CSampleBuffer*> m_freeSamples;
+  unsigned int m_totalTime = 0;
+  std::vector<std::unique_ptr<CSampleBuffer>> m_allSamples;
+  std::vector<CSampleBuffer*> m_freeSamples;
+};
+
+/**
+ * Keeps the sample buffers of idle pools around so that a reconfiguration to
+ * a format that was used before does not allocate new sample buffers.
+ */
+class CActiveAEBufferPoolCache
+{
+public:
+  CActiveAEBufferPoolCache() { m_pools.reserve(MAX_CACHED_POOLS + 1); }
+
+  /*! \brief get a created pool for format holding at least totaltime ms,
+   reusing a cached pool if there is one
+   */
+  std::unique_ptr<CActiveAEBufferPool> Get(const AEAudioFormat& format, unsigned int totaltime);
+
+  /*! \brief move the sample buffers of a cached pool matching the format of pool into it,
+   e.g. for a resample pool before its Create
+   \return false if no cached pool matches, pool still needs to create its buffers then
+   */
+  bool Acquire(CActiveAEBufferPool& pool, unsigned int totaltime);
+
+  /*! \brief take over pool if it is idle. Only the sample buffers of resample and
+   atempo pools are kept, their processing state is dropped.
+   \return true if the pool was moved into the cache
+   */
+  bool Recycle(std::unique_ptr<CActiveAEBufferPool>& pool);
+
+  size_t Size() const { return m_pools.size(); }
+  void Clear() { m_pools.clear(); }
+
+private:
+  std::vector<std::unique_ptr<CActiveAEBufferPool>>::iterator Find(
+      const AEAudioFormat& format, unsigned int totaltime);
+
+  static constexpr size_t MAX_CACHED_POOLS = 6;
+  // most recently recycled first, reserved so that moving pools in and out never allocates
+  std::vector<std::unique_ptr<CActiveAEBufferPool>> m_pools;
 };
 
 class IAEResample;
@@ -94,8 +224,8 @@ public:
   bool DoesNormalize() const;
   void ForceResampler(bool force);
   AEAudioFormat m_inputFormat;
-  std::deque<CSampleBuffer*> m_inputSamples;
-  std::deque<CSampleBuffer*> m_outputSamples;
+  CSampleBufferQueue m_inputSamples;
+  CSampleBufferQueue m_outputSamples;
 
 protected:
   void ChangeResampler();
@@ -133,8 +263,8 @@ public:
   float GetTempo() const;
   void FillBuffer();
   void SetDrain(bool drain);
-  std::deque<CSampleBuffer*> m_inputSamples;
-  std::deque<CSampleBuffer*> m_outputSamples;
+  CSampleBufferQueue m_inputSamples;
+  CSampleBufferQueue m_outputSamples;
 
 protected:
   void ChangeFilter();
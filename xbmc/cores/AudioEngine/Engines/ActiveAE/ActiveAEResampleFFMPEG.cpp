@@ -22,6 +22,7 @@ CActiveAEResampleFFMPEG::CActiveAEResampleFFMPEG()
 {
   m_pContext = NULL;
   m_doesResample = false;
+  m_packingOnly = false;
 }
 
 CActiveAEResampleFFMPEG::~CActiveAEResampleFFMPEG()
@@ -191,6 +192,24 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig,
     CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Init - init resampler failed");
     return false;
   }
+
+  // converting between planar and packed float is a plain copy, see Resample. The sink stage
+  // always sets a remap matrix, which is the identity if the sink takes our layout as it is.
+  bool copyChannels = m_src_channels == m_dst_channels;
+  if (hasMatrix)
+  {
+    for (int out = 0; out < m_dst_channels && copyChannels; out++)
+    {
+      for (int in = 0; in < m_src_channels && copyChannels; in++)
+        copyChannels = m_rematrix[out][in] == (out == in ? 1.0 : 0.0);
+    }
+  }
+  else
+    copyChannels = copyChannels && m_src_chan_layout == m_dst_chan_layout;
+
+  m_packingOnly = copyChannels && m_src_rate == m_dst_rate &&
+                  ((m_src_fmt == AV_SAMPLE_FMT_FLTP && m_dst_fmt == AV_SAMPLE_FMT_FLT) ||
+                   (m_src_fmt == AV_SAMPLE_FMT_FLT && m_dst_fmt == AV_SAMPLE_FMT_FLTP));
   return true;
 }
 
@@ -205,6 +224,25 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
     m_doesResample = true;
   }
 
+  if (m_packingOnly)
+  {
+    if (!m_doesResample && src_samples <= dst_samples)
+    {
+      if (src_samples > 0 && m_src_fmt == AV_SAMPLE_FMT_FLTP)
+        CAEUtil::InterleaveFloat(reinterpret_cast<float*>(dst_buffer[0]),
+                                 reinterpret_cast<const float* const*>(src_buffer), m_src_channels,
+                                 src_samples);
+      else if (src_samples > 0)
+        CAEUtil::DeinterleaveFloat(reinterpret_cast<float* const*>(dst_buffer),
+                                   reinterpret_cast<const float*>(src_buffer[0]), m_src_channels,
+                                   src_samples);
+      return src_samples;
+    }
+
+    // swr buffers samples from here on, stay with it
+    m_packingOnly = false;
+  }
+
   if (m_doesResample)
   {
     if (swr_set_compensation(m_pContext, delta, distance) < 0)
@@ -16,7 +16,6 @@
 #include "threads/Event.h"
 
 #include <atomic>
-#include <deque>
 
 namespace ActiveAE
 {
@@ -119,8 +118,8 @@ public:
   std::unique_ptr<CActiveAEBufferPool> GetAtempoBuffers();
 
   AEAudioFormat m_inputFormat;
-  std::deque<CSampleBuffer*> m_outputSamples;
-  std::deque<CSampleBuffer*> m_inputSamples;
+  CSampleBufferQueue m_outputSamples;
+  CSampleBufferQueue m_inputSamples;
 
 protected:
   std::unique_ptr<CActiveAEBufferPoolResample> m_resampleBuffers;
@@ -218,7 +217,7 @@ protected:
   // only accessed by engine
   std::unique_ptr<CActiveAEBufferPool> m_inputBuffers;
   std::unique_ptr<CActiveAEStreamBuffers> m_processingBuffers;
-  std::deque<CSampleBuffer*> m_processingSamples;
+  CSampleBufferQueue m_processingSamples;
   std::unique_ptr<CActiveAEDataProtocol> m_streamPort;
   CEvent m_inMsgEvent;
   bool m_drain;
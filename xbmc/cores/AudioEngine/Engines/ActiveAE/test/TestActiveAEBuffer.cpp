@@ -0,0 +1,243 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+// count the heap allocations of threads that declared themselves steady, for the whole test binary
+void* operator new(std::size_t size)
+{
+  CActiveAEAllocationTracer::OnHeapAllocation();
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+AEAudioFormat MakeFormat(unsigned int sampleRate, const CAEChannelInfo& layout)
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOATP;
+  format.m_sampleRate = sampleRate;
+  format.m_channelLayout = layout;
+  format.m_frames = sampleRate / 50;
+  format.m_frameSize = layout.Count() * (CAEUtil::DataFormatToBits(AE_FMT_FLOAT) >> 3);
+  return format;
+}
+
+class TestActiveAEBuffer : public ::testing::Test
+{
+protected:
+  void SetUp() override { CActiveAEAllocationTracer::Reset(); }
+  void TearDown() override { CActiveAEAllocationTracer::SetSteady(false); }
+};
+} // namespace
+
+TEST_F(TestActiveAEBuffer, QueueKeepsOrder)
+{
+  std::vector<CSampleBuffer> buffers(20);
+  CSampleBufferQueue queue;
+
+  // wrap around the ring a few times while it grows
+  for (int round = 0; round < 3; ++round)
+  {
+    for (auto& buffer : buffers)
+      queue.push_back(&buffer);
+    EXPECT_EQ(buffers.size(), queue.size());
+
+    size_t i = 0;
+    for (const auto& buffer : queue)
+      EXPECT_EQ(&buffers[i++], buffer);
+
+    for (auto& buffer : buffers)
+    {
+      ASSERT_FALSE(queue.empty());
+      EXPECT_EQ(&buffer, queue.front());
+      queue.pop_front();
+    }
+    EXPECT_TRUE(queue.empty());
+  }
+}
+
+TEST_F(TestActiveAEBuffer, QueueSteadyStateDoesNotAllocate)
+{
+  std::vector<CSampleBuffer> buffers(8);
+  CSampleBufferQueue queue;
+  queue.reserve(buffers.size());
+
+  CActiveAEAllocationTracer::SetSteady(true);
+  for (int i = 0; i < 10000; ++i)
+  {
+    queue.push_back(&buffers[i % buffers.size()]);
+    if (queue.size() > 4)
+      queue.pop_front();
+  }
+  CActiveAEAllocationTracer::SetSteady(false);
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyAllocations());
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyHeapAllocations());
+  CActiveAEAllocationTracer::SetSteady(true);
+
+  // growing beyond the reserved size is reported
+  for (auto& buffer : buffers)
+    queue.push_back(&buffer);
+  EXPECT_EQ(1u, CActiveAEAllocationTracer::GetSteadyAllocations());
+}
+
+TEST_F(TestActiveAEBuffer, PoolSteadyStateDoesNotAllocate)
+{
+  CActiveAEBufferPool pool(MakeFormat(48000, AE_CH_LAYOUT_2_0));
+  pool.Create(200);
+  ASSERT_FALSE(pool.m_allSamples.empty());
+
+  CSampleBufferQueue queue;
+  queue.reserve(pool.m_allSamples.size());
+
+  CActiveAEAllocationTracer::SetSteady(true);
+  for (int i = 0; i < 1000; ++i)
+  {
+    while (CSampleBuffer* buffer = pool.GetFreeBuffer())
+      queue.push_back(buffer);
+    while (!queue.empty())
+    {
+      queue.front()->Return();
+      queue.pop_front();
+    }
+  }
+  CActiveAEAllocationTracer::SetSteady(false);
+  EXPECT_TRUE(pool.IsIdle());
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyAllocations());
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyHeapAllocations());
+}
+
+TEST_F(TestActiveAEBuffer, FormatSwitchReusesPools)
+{
+  CActiveAEBufferPoolCache cache;
+  const AEAudioFormat stereo44 = MakeFormat(44100, AE_CH_LAYOUT_2_0);
+  const AEAudioFormat surround48 = MakeFormat(48000, AE_CH_LAYOUT_5_1);
+
+  // first use of each format allocates
+  std::unique_ptr<CActiveAEBufferPool> pool = cache.Get(stereo44, 200);
+  const CActiveAEBufferPool* stereoPool = pool.get();
+  EXPECT_TRUE(cache.Recycle(pool));
+  EXPECT_EQ(nullptr, pool);
+
+  pool = cache.Get(surround48, 200);
+  const CActiveAEBufferPool* surroundPool = pool.get();
+  EXPECT_NE(stereoPool, surroundPool);
+  EXPECT_TRUE(cache.Recycle(pool));
+  EXPECT_EQ(2u, cache.Size());
+
+  // switching back and forth afterwards only moves pools in and out of the cache
+  std::vector<const CActiveAEBufferPool*> pools;
+  pools.reserve(20);
+  CActiveAEAllocationTracer::SetSteady(true);
+  for (int i = 0; i < 10; ++i)
+  {
+    pool = cache.Get(stereo44, 200);
+    pools.push_back(pool.get());
+    CSampleBuffer* buffer = pool->GetFreeBuffer();
+    if (buffer)
+      buffer->Return();
+    cache.Recycle(pool);
+
+    pool = cache.Get(surround48, 100);
+    pools.push_back(pool.get());
+    cache.Recycle(pool);
+  }
+  CActiveAEAllocationTracer::SetSteady(false);
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyAllocations());
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyHeapAllocations());
+  for (size_t i = 0; i < pools.size(); i += 2)
+  {
+    EXPECT_EQ(stereoPool, pools[i]);
+    EXPECT_EQ(surroundPool, pools[i + 1]);
+  }
+  EXPECT_EQ(2u, cache.Size());
+
+  // a pool holding less than requested is not reused
+  pool = cache.Get(stereo44, 1000);
+  EXPECT_NE(stereoPool, pool.get());
+}
+
+TEST_F(TestActiveAEBuffer, BusyPoolIsNotRecycled)
+{
+  CActiveAEBufferPoolCache cache;
+  std::unique_ptr<CActiveAEBufferPool> pool = cache.Get(MakeFormat(48000, AE_CH_LAYOUT_2_0), 200);
+
+  CSampleBuffer* buffer = pool->GetFreeBuffer();
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_FALSE(cache.Recycle(pool));
+  ASSERT_NE(nullptr, pool);
+
+  buffer->Return();
+  EXPECT_TRUE(cache.Recycle(pool));
+}
+
+TEST_F(TestActiveAEBuffer, ReconfigureReusesResampleBuffers)
+{
+  CActiveAEBufferPoolCache cache;
+  const AEAudioFormat format = MakeFormat(48000, AE_CH_LAYOUT_2_0);
+
+  // the first configuration of the sink stage allocates
+  auto sink = std::make_unique<CActiveAEBufferPoolResample>(format, format, AE_QUALITY_MID);
+  EXPECT_FALSE(cache.Acquire(*sink, 200));
+  sink->Create(200, true, false);
+  const size_t buffers = sink->m_allSamples.size();
+  ASSERT_GT(buffers, 0u);
+
+  // reconfiguring to the same output format only moves the sample buffers around. Configure
+  // constructs new pools, so only sound packets and queues are counted here, not the heap.
+  CActiveAEAllocationTracer::SetSteady(true);
+  for (int i = 0; i < 10; ++i)
+  {
+    std::unique_ptr<CActiveAEBufferPool> discarded = std::move(sink);
+    ASSERT_TRUE(cache.Recycle(discarded));
+    EXPECT_EQ(1u, cache.Size());
+
+    sink = std::make_unique<CActiveAEBufferPoolResample>(format, format, AE_QUALITY_MID);
+    EXPECT_TRUE(cache.Acquire(*sink, 200));
+    sink->Create(200, true, false);
+    EXPECT_EQ(buffers, sink->m_allSamples.size());
+    EXPECT_EQ(0u, cache.Size());
+
+    CSampleBuffer* buffer = sink->GetFreeBuffer();
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(sink.get(), buffer->pool);
+    buffer->Return();
+    EXPECT_TRUE(sink->IsIdle());
+  }
+  EXPECT_EQ(0u, CActiveAEAllocationTracer::GetSteadyAllocations());
+  CActiveAEAllocationTracer::SetSteady(false);
+
+  // the buffers of a resample pool serve plain pools as well
+  std::unique_ptr<CActiveAEBufferPool> discarded = std::move(sink);
+  ASSERT_TRUE(cache.Recycle(discarded));
+  std::unique_ptr<CActiveAEBufferPool> pool = cache.Get(format, 200);
+  EXPECT_EQ(buffers, pool->m_allSamples.size());
+  EXPECT_EQ(0u, cache.Size());
+}
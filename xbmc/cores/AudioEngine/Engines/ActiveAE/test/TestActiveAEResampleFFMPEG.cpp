@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+constexpr int FRAMES = 1000;
+
+SampleConfig MakeConfig(AEDataFormat format, const CAEChannelInfo& layout)
+{
+  SampleConfig config;
+  config.fmt = CAEUtil::GetAVSampleFormat(format);
+  config.channel_layout = CAEUtil::GetAVChannelLayout(layout);
+  config.channels = layout.Count();
+  config.sample_rate = 48000;
+  config.bits_per_sample = CAEUtil::DataFormatToUsedBits(format);
+  config.dither_bits = CAEUtil::DataFormatToDitherBits(format);
+  return config;
+}
+
+float Sample(int channel, int frame)
+{
+  return static_cast<float>(channel * FRAMES + frame) / (8 * FRAMES);
+}
+} // namespace
+
+TEST(TestActiveAEResampleFFMPEG, PlanarToPacked)
+{
+  CAEChannelInfo layout(AE_CH_LAYOUT_5_1);
+  const int channels = layout.Count();
+
+  // the sink stage remaps to the layout of the sink
+  CActiveAEResampleFFMPEG resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(AE_FMT_FLOAT, layout), MakeConfig(AE_FMT_FLOATP, layout),
+                             false, true, 1.0, &layout, AE_QUALITY_MID, false, 0.0f));
+
+  std::vector<std::vector<float>> planes(channels, std::vector<float>(FRAMES));
+  std::vector<uint8_t*> src;
+  for (int ch = 0; ch < channels; ch++)
+  {
+    for (int i = 0; i < FRAMES; i++)
+      planes[ch][i] = Sample(ch, i);
+    src.push_back(reinterpret_cast<uint8_t*>(planes[ch].data()));
+  }
+
+  std::vector<float> packed(channels * FRAMES);
+  uint8_t* dst = reinterpret_cast<uint8_t*>(packed.data());
+  ASSERT_EQ(FRAMES, resampler.Resample(&dst, FRAMES, src.data(), FRAMES, 1.0));
+  EXPECT_EQ(0, resampler.GetBufferedSamples());
+
+  for (int i = 0; i < FRAMES; i++)
+  {
+    for (int ch = 0; ch < channels; ch++)
+      ASSERT_EQ(Sample(ch, i), packed[i * channels + ch]);
+  }
+}
+
+TEST(TestActiveAEResampleFFMPEG, PackedToPlanar)
+{
+  CAEChannelInfo layout(AE_CH_LAYOUT_2_0);
+  const int channels = layout.Count();
+
+  CActiveAEResampleFFMPEG resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(AE_FMT_FLOATP, layout), MakeConfig(AE_FMT_FLOAT, layout),
+                             false, true, 1.0, nullptr, AE_QUALITY_MID, false, 0.0f));
+
+  std::vector<float> packed(channels * FRAMES);
+  for (int i = 0; i < FRAMES; i++)
+  {
+    for (int ch = 0; ch < channels; ch++)
+      packed[i * channels + ch] = Sample(ch, i);
+  }
+  uint8_t* src = reinterpret_cast<uint8_t*>(packed.data());
+
+  // a smaller output buffer leaves the rest to swr, which has to deliver the same samples
+  std::vector<std::vector<float>> planes(channels, std::vector<float>(FRAMES));
+  std::vector<uint8_t*> dst;
+  for (auto& plane : planes)
+    dst.push_back(reinterpret_cast<uint8_t*>(plane.data()));
+
+  ASSERT_EQ(FRAMES / 2, resampler.Resample(dst.data(), FRAMES / 2, &src, FRAMES, 1.0));
+  for (int ch = 0; ch < channels; ch++)
+  {
+    for (int i = 0; i < FRAMES / 2; i++)
+      ASSERT_EQ(Sample(ch, i), planes[ch][i]);
+  }
+}
@@ -18,13 +18,17 @@
 #include "utils/log.h"
 #include "utils/MemUtils.h"
 
+#include <atomic>
 #include <string.h>
 
 /**
  * This buffer can be used by one read and one write thread at any one time
  * without the risk of data corruption.
  * If you intend to call the Reset() method, please use Locks.
- * All other operations are thread-safe.
+ * All other operations are thread-safe and wait-free: the reader and the
+ * writer each own one cursor and publish their progress through an atomic
+ * counter, so neither side ever blocks the other. This makes it safe to use
+ * from realtime audio callbacks.
  */
 class AERingBuffer {
 
@@ -33,6 +37,18 @@ public:
 
   AERingBuffer(unsigned int size, unsigned int planes = 1) { Create(size, planes); }
 
+  /**
+   * A range of one plane, split into two parts when it wraps around
+   * the end of the buffer. size2 is 0 if the range is contiguous.
+   */
+  struct Region
+  {
+    unsigned char* data1 = nullptr;
+    unsigned int size1 = 0;
+    unsigned char* data2 = nullptr;
+    unsigned int size2 = 0;
+  };
+
   ~AERingBuffer()
   {
 #ifdef AE_RING_BUFFER_DEBUG
@@ -72,8 +88,8 @@ public:
 #ifdef AE_RING_BUFFER_DEBUG
     CLog::Log(LOGDEBUG, "AERingBuffer::Reset: Buffer reset.");
 #endif
-    m_iWritten = 0;
-    m_iRead = 0;
+    m_iWritten.store(0, std::memory_order_relaxed);
+    m_iRead.store(0, std::memory_order_relaxed);
     m_iReadPos = 0;
     m_iWritePos = 0;
   }
@@ -188,6 +204,54 @@ public:
     return AE_RING_BUFFER_OK;
   }
 
+  /**
+   * Gives direct access to the space of a plane that can be written,
+   * e.g. to let a decoder or mixer render straight into the buffer.
+   * Call CommitWrite() once all planes have been filled.
+   *
+   * @return false if less than size bytes are free
+   */
+  bool GetWriteRegion(Region& region, unsigned int size, unsigned int plane = 0)
+  {
+    if (size > GetWriteSize() || plane >= m_planes)
+      return false;
+
+    region = MakeRegion(m_Buffer[plane], m_iWritePos, size);
+    return true;
+  }
+
+  /**
+   * Publishes size bytes written to all planes through GetWriteRegion().
+   */
+  void CommitWrite(unsigned int size)
+  {
+    WriteFinished(size);
+  }
+
+  /**
+   * Gives direct access to the data of a plane that can be read,
+   * e.g. to hand it to a sink callback without copying.
+   * Call CommitRead() once all planes have been consumed.
+   *
+   * @return false if less than size bytes are available
+   */
+  bool GetReadRegion(Region& region, unsigned int size, unsigned int plane = 0) const
+  {
+    if (size > GetReadSize() || plane >= m_planes)
+      return false;
+
+    region = MakeRegion(m_Buffer[plane], m_iReadPos, size);
+    return true;
+  }
+
+  /**
+   * Releases size bytes read from all planes through GetReadRegion().
+   */
+  void CommitRead(unsigned int size)
+  {
+    ReadFinished(size);
+  }
+
   /**
    * Dumps the buffer.
    */
@@ -214,24 +278,25 @@ public:
    * Returns available space for writing to buffer.
    * Attempt to write more bytes than available results in AE_RING_BUFFER_FULL.
    */
-  unsigned int GetWriteSize()
+  unsigned int GetWriteSize() const
   {
-    return m_iSize - ( m_iWritten - m_iRead );
+    return m_iSize - (m_iWritten.load(std::memory_order_relaxed) -
+                      m_iRead.load(std::memory_order_acquire));
   }
 
   /**
    * Returns available space for reading from buffer.
    * Attempt to read more bytes than available results in AE_RING_BUFFER_EMPTY.
    */
-  unsigned int GetReadSize()
+  unsigned int GetReadSize() const
   {
-    return m_iWritten - m_iRead;
+    return m_iWritten.load(std::memory_order_acquire) - m_iRead.load(std::memory_order_relaxed);
   }
 
   /**
    * Returns the buffer size.
    */
-  unsigned int GetMaxSize()
+  unsigned int GetMaxSize() const
   {
     return m_iSize;
   }
@@ -244,6 +309,23 @@ public:
     return m_planes;
   }
 private:
+  Region MakeRegion(unsigned char* plane, unsigned int pos, unsigned int size) const
+  {
+    Region region;
+    region.data1 = plane + pos;
+    if (pos + size <= m_iSize)
+    {
+      region.size1 = size;
+    }
+    else
+    {
+      region.size1 = m_iSize - pos;
+      region.data2 = plane;
+      region.size2 = size - region.size1;
+    }
+    return region;
+  }
+
   /**
    * Increments the write pointer.
    * Called at the end of writing to all planes.
@@ -255,8 +337,9 @@ private:
     else // wrapping
       m_iWritePos = size - (m_iSize - m_iWritePos);
 
-    //we can increase the write count now
-    m_iWritten+=size;
+    //we can increase the write count now, this publishes the data to the reader
+    m_iWritten.store(m_iWritten.load(std::memory_order_relaxed) + size,
+                     std::memory_order_release);
   }
 
   /**
@@ -270,15 +353,19 @@ private:
     else
       m_iReadPos = size - (m_iSize - m_iReadPos);
 
-    //we can increase the read count now
-    m_iRead+=size;
+    //we can increase the read count now, this hands the space back to the writer
+    m_iRead.store(m_iRead.load(std::memory_order_relaxed) + size, std::memory_order_release);
   }
 
-  unsigned int m_iReadPos = 0;
-  unsigned int m_iWritePos = 0;
-  unsigned int m_iRead = 0;
-  unsigned int m_iWritten = 0;
-  unsigned int m_iSize = 0;
+  // reader and writer state live on separate cache lines so that the two
+  // threads do not invalidate each other's cursors on every update
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  alignas(CACHE_LINE_SIZE) unsigned int m_iReadPos = 0;
+  std::atomic<unsigned int> m_iRead{0};
+  alignas(CACHE_LINE_SIZE) unsigned int m_iWritePos = 0;
+  std::atomic<unsigned int> m_iWritten{0};
+  alignas(CACHE_LINE_SIZE) unsigned int m_iSize = 0;
   unsigned int m_planes = 0;
   unsigned char** m_Buffer = nullptr;
 };
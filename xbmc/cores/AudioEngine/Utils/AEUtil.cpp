@@ -13,12 +13,391 @@
 #include "utils/log.h"
 #include "utils/TimeUtils.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #if defined(HAVE_SSE) && defined(__SSE__)
 #include <xmmintrin.h>
 #endif
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AE_HAVE_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || (defined(__arm__) && defined(HAS_NEON))
+#define AE_HAVE_NEON_KERNELS
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+/*
+   This is a rational function to approximate a tanh-like soft clipper.
+   It is based on the pade-approximation of the tanh function with tweaked coefficients.
+   See: http://www.musicdsp.org/showone.php?id=238
+*/
+inline float SoftClampPade(const float x)
+{
+  if (x < -3.0f)
+    return -1.0f;
+  else if (x > 3.0f)
+    return 1.0f;
+  float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+void MulArrayC(float* data, const float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAddArrayC(float* data, const float* add, const float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+void ClampArrayC(float* data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] = SoftClampPade(data[i]);
+}
+
+float PeakArrayC(const float* data, uint32_t count)
+{
+  float peak = 0.0f;
+  for (uint32_t i = 0; i < count; ++i)
+    peak = std::max(peak, std::fabs(data[i]));
+  return peak;
+}
+
+void InterleaveFloatC(float* dst,
+                      const float* const* src,
+                      unsigned int channels,
+                      unsigned int frames,
+                      unsigned int start)
+{
+  for (unsigned int i = start; i < frames; ++i)
+    for (unsigned int ch = 0; ch < channels; ++ch)
+      dst[i * channels + ch] = src[ch][i];
+}
+
+void DeinterleaveFloatC(float* const* dst,
+                        const float* src,
+                        unsigned int channels,
+                        unsigned int frames,
+                        unsigned int start)
+{
+  for (unsigned int i = start; i < frames; ++i)
+    for (unsigned int ch = 0; ch < channels; ++ch)
+      dst[ch][i] = src[i * channels + ch];
+}
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+void MulArraySSE(float* data, const float mul, uint32_t count)
+{
+  CAEUtil::SSEMulArray(data, mul, count);
+}
+
+void MulAddArraySSE(float* data, const float* add, const float mul, uint32_t count)
+{
+  CAEUtil::SSEMulAddArray(data, const_cast<float*>(add), mul, count);
+}
+
+void ClampArraySSE(float* data, uint32_t count)
+{
+  const __m128 c1 = _mm_set_ps1(27.0f);
+  const __m128 c9 = _mm_set_ps1(9.0f);
+  const __m128 lo = _mm_set_ps1(-3.0f);
+  const __m128 hi = _mm_set_ps1(3.0f);
+
+  /* work around invalid alignment */
+  while (((uintptr_t)data & 0xF) && count > 0)
+  {
+    data[0] = SoftClampPade(data[0]);
+    ++data;
+    --count;
+  }
+
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i+=4, data+=4)
+  {
+    /* tanh approx clamp, limited to +-3 like SoftClampPade */
+    const __m128 dt = _mm_min_ps(_mm_max_ps(_mm_load_ps(data), lo), hi);
+    const __m128 sq = _mm_mul_ps(dt, dt);
+    const __m128 num = _mm_mul_ps(dt, _mm_add_ps(c1, sq));
+    const __m128 den = _mm_add_ps(c1, _mm_mul_ps(c9, sq));
+    _mm_store_ps(data, _mm_div_ps(num, den));
+  }
+
+  ClampArrayC(data, count - even);
+}
+#endif
+
+#if defined(AE_HAVE_AVX2_KERNELS)
+__attribute__((target("avx2"))) void MulArrayAVX2(float* data, const float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+
+  MulArrayC(data + i, mul, count - i);
+}
+
+__attribute__((target("avx2"))) void MulAddArrayAVX2(float* data,
+                                                     const float* add,
+                                                     const float mul,
+                                                     uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 ad = _mm256_mul_ps(_mm256_loadu_ps(add + i), m);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), ad));
+  }
+
+  MulAddArrayC(data + i, add + i, mul, count - i);
+}
+
+__attribute__((target("avx2"))) void ClampArrayAVX2(float* data, uint32_t count)
+{
+  const __m256 c1 = _mm256_set1_ps(27.0f);
+  const __m256 c9 = _mm256_set1_ps(9.0f);
+  const __m256 lo = _mm256_set1_ps(-3.0f);
+  const __m256 hi = _mm256_set1_ps(3.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    // limiting the input to +-3 makes the approximation hit exactly +-1 like the scalar version
+    const __m256 dt = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lo), hi);
+    const __m256 sq = _mm256_mul_ps(dt, dt);
+    const __m256 num = _mm256_mul_ps(dt, _mm256_add_ps(c1, sq));
+    const __m256 den = _mm256_add_ps(c1, _mm256_mul_ps(c9, sq));
+    _mm256_storeu_ps(data + i, _mm256_div_ps(num, den));
+  }
+
+  ClampArrayC(data + i, count - i);
+}
+
+__attribute__((target("avx2"))) float PeakArrayAVX2(const float* data, uint32_t count)
+{
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  __m256 peak = _mm256_setzero_ps();
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    peak = _mm256_max_ps(peak, _mm256_and_ps(_mm256_loadu_ps(data + i), absMask));
+
+  __m128 p = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+  p = _mm_max_ps(p, _mm_movehl_ps(p, p));
+  p = _mm_max_ss(p, _mm_shuffle_ps(p, p, 0x1));
+
+  return std::max(_mm_cvtss_f32(p), PeakArrayC(data + i, count - i));
+}
+
+__attribute__((target("avx2"))) void InterleaveFloatAVX2(float* dst,
+                                                         const float* const* src,
+                                                         unsigned int channels,
+                                                         unsigned int frames)
+{
+  unsigned int i = 0;
+  if (channels == 2)
+  {
+    for (; i + 8 <= frames; i += 8)
+    {
+      const __m256 l = _mm256_loadu_ps(src[0] + i);
+      const __m256 r = _mm256_loadu_ps(src[1] + i);
+      const __m256 lo = _mm256_unpacklo_ps(l, r);
+      const __m256 hi = _mm256_unpackhi_ps(l, r);
+      _mm256_storeu_ps(dst + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(dst + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+  }
+
+  InterleaveFloatC(dst, src, channels, frames, i);
+}
+
+__attribute__((target("avx2"))) void DeinterleaveFloatAVX2(float* const* dst,
+                                                           const float* src,
+                                                           unsigned int channels,
+                                                           unsigned int frames)
+{
+  unsigned int i = 0;
+  if (channels == 2)
+  {
+    for (; i + 8 <= frames; i += 8)
+    {
+      const __m256 a = _mm256_loadu_ps(src + i * 2);
+      const __m256 b = _mm256_loadu_ps(src + i * 2 + 8);
+      const __m256 p0 = _mm256_permute2f128_ps(a, b, 0x20);
+      const __m256 p1 = _mm256_permute2f128_ps(a, b, 0x31);
+      _mm256_storeu_ps(dst[0] + i, _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm256_storeu_ps(dst[1] + i, _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+  }
+
+  DeinterleaveFloatC(dst, src, channels, frames, i);
+}
+#endif
+
+#if defined(AE_HAVE_NEON_KERNELS)
+void MulArrayNEON(float* data, const float mul, uint32_t count)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), mul));
+
+  MulArrayC(data + i, mul, count - i);
+}
+
+void MulAddArrayNEON(float* data, const float* add, const float mul, uint32_t count)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmlaq_n_f32(vld1q_f32(data + i), vld1q_f32(add + i), mul));
+
+  MulAddArrayC(data + i, add + i, mul, count - i);
+}
+
+void ClampArrayNEON(float* data, uint32_t count)
+{
+  const float32x4_t c1 = vdupq_n_f32(27.0f);
+  const float32x4_t lo = vdupq_n_f32(-3.0f);
+  const float32x4_t hi = vdupq_n_f32(3.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t dt = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+    const float32x4_t sq = vmulq_f32(dt, dt);
+    const float32x4_t num = vmulq_f32(dt, vaddq_f32(c1, sq));
+    const float32x4_t den = vmlaq_n_f32(c1, sq, 9.0f);
+#if defined(__aarch64__)
+    vst1q_f32(data + i, vdivq_f32(num, den));
+#else
+    // armv7 has no vector divide, refine the reciprocal estimate twice
+    float32x4_t rcp = vrecpeq_f32(den);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    vst1q_f32(data + i, vmulq_f32(num, rcp));
+#endif
+  }
+
+  ClampArrayC(data + i, count - i);
+}
+
+float PeakArrayNEON(const float* data, uint32_t count)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(data + i)));
+
+  float32x2_t p = vpmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+  p = vpmax_f32(p, p);
+
+  return std::max(vget_lane_f32(p, 0), PeakArrayC(data + i, count - i));
+}
+
+void InterleaveFloatNEON(float* dst,
+                         const float* const* src,
+                         unsigned int channels,
+                         unsigned int frames)
+{
+  unsigned int i = 0;
+  if (channels == 2)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      float32x4x2_t lr;
+      lr.val[0] = vld1q_f32(src[0] + i);
+      lr.val[1] = vld1q_f32(src[1] + i);
+      vst2q_f32(dst + i * 2, lr);
+    }
+  }
+
+  InterleaveFloatC(dst, src, channels, frames, i);
+}
+
+void DeinterleaveFloatNEON(float* const* dst,
+                           const float* src,
+                           unsigned int channels,
+                           unsigned int frames)
+{
+  unsigned int i = 0;
+  if (channels == 2)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const float32x4x2_t lr = vld2q_f32(src + i * 2);
+      vst1q_f32(dst[0] + i, lr.val[0]);
+      vst1q_f32(dst[1] + i, lr.val[1]);
+    }
+  }
+
+  DeinterleaveFloatC(dst, src, channels, frames, i);
+}
+#endif
+
+void InterleaveFloatGeneric(float* dst,
+                            const float* const* src,
+                            unsigned int channels,
+                            unsigned int frames)
+{
+  InterleaveFloatC(dst, src, channels, frames, 0);
+}
+
+void DeinterleaveFloatGeneric(float* const* dst,
+                              const float* src,
+                              unsigned int channels,
+                              unsigned int frames)
+{
+  DeinterleaveFloatC(dst, src, channels, frames, 0);
+}
+
+struct AEKernels
+{
+  const char* name;
+  void (*mul)(float*, const float, uint32_t);
+  void (*mulAdd)(float*, const float*, const float, uint32_t);
+  void (*clamp)(float*, uint32_t);
+  float (*peak)(const float*, uint32_t);
+  void (*interleave)(float*, const float* const*, unsigned int, unsigned int);
+  void (*deinterleave)(float* const*, const float*, unsigned int, unsigned int);
+};
+
+AEKernels SelectKernels()
+{
+#if defined(AE_HAVE_AVX2_KERNELS)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return {"AVX2",         MulArrayAVX2,      MulAddArrayAVX2,
+            ClampArrayAVX2, PeakArrayAVX2,     InterleaveFloatAVX2,
+            DeinterleaveFloatAVX2};
+#endif
+
+#if defined(AE_HAVE_NEON_KERNELS)
+  return {"NEON",         MulArrayNEON,  MulAddArrayNEON,      ClampArrayNEON,
+          PeakArrayNEON,  InterleaveFloatNEON, DeinterleaveFloatNEON};
+#elif defined(HAVE_SSE) && defined(__SSE__)
+  return {"SSE",         MulArraySSE,  MulAddArraySSE,          ClampArraySSE,
+          PeakArrayC,    InterleaveFloatGeneric, DeinterleaveFloatGeneric};
+#else
+  return {"C",        MulArrayC,  MulAddArrayC,           ClampArrayC,
+          PeakArrayC, InterleaveFloatGeneric, DeinterleaveFloatGeneric};
+#endif
+}
+
+const AEKernels& GetKernels()
+{
+  static const AEKernels kernels = SelectKernels();
+  return kernels;
+}
+} // unnamed namespace
+
 void AEDelayStatus::SetDelay(double d)
 {
   delay = d;
@@ -313,120 +692,45 @@ void CAEUtil::SSEMulAddArray(float *data, float *add, const float mul, uint32_t
 }
 #endif
 
-inline float CAEUtil::SoftClamp(const float x)
-{
-#if 1
-    /*
-       This is a rational function to approximate a tanh-like soft clipper.
-       It is based on the pade-approximation of the tanh function with tweaked coefficients.
-       See: http://www.musicdsp.org/showone.php?id=238
-    */
-    if (x < -3.0f)
-      return -1.0f;
-    else if (x >  3.0f)
-      return 1.0f;
-    float y = x * x;
-    return x * (27.0f + y) / (27.0f + 9.0f * y);
-#else
-    /* slower method using tanh, but more accurate */
-
-    static const double k = 0.9f;
-    /* perform a soft clamp */
-    if (x >  k)
-      x = (float) (tanh((x - k) / (1 - k)) * (1 - k) + k);
-    else if (x < -k)
-      x = (float) (tanh((x + k) / (1 - k)) * (1 - k) - k);
-
-    /* hard clamp anything still outside the bounds */
-    if (x >  1.0f)
-      return  1.0f;
-    if (x < -1.0f)
-      return -1.0f;
-
-    /* return the final sample */
-    return x;
-#endif
+void CAEUtil::MulArray(float* data, const float mul, uint32_t count)
+{
+  GetKernels().mul(data, mul, count);
+}
+
+void CAEUtil::MulAddArray(float* data, const float* add, const float mul, uint32_t count)
+{
+  GetKernels().mulAdd(data, add, mul, count);
 }
 
 void CAEUtil::ClampArray(float *data, uint32_t count)
 {
-#if !defined(HAVE_SSE) || !defined(__SSE__)
-  for (uint32_t i = 0; i < count; ++i)
-    data[i] = SoftClamp(data[i]);
+  GetKernels().clamp(data, count);
+}
 
-#else
-  const __m128 c1 = _mm_set_ps1(27.0f);
-  const __m128 c2 = _mm_set_ps1(27.0f + 9.0f);
+float CAEUtil::PeakArray(const float* data, uint32_t count)
+{
+  return GetKernels().peak(data, count);
+}
 
-  /* work around invalid alignment */
-  while (((uintptr_t)data & 0xF) && count > 0)
-  {
-    data[0] = SoftClamp(data[0]);
-    ++data;
-    --count;
-  }
+void CAEUtil::InterleaveFloat(float* dst,
+                              const float* const* src,
+                              unsigned int channels,
+                              unsigned int frames)
+{
+  GetKernels().interleave(dst, src, channels, frames);
+}
 
-  uint32_t even = count & ~0x3;
-  for (uint32_t i = 0; i < even; i+=4, data+=4)
-  {
-    /* tanh approx clamp */
-    __m128 dt = _mm_load_ps(data);
-    __m128 tmp     = _mm_mul_ps(dt, dt);
-    *(__m128*)data = _mm_div_ps(
-      _mm_mul_ps(
-        dt,
-        _mm_add_ps(c1, tmp)
-      ),
-      _mm_add_ps(c2, tmp)
-    );
-  }
+void CAEUtil::DeinterleaveFloat(float* const* dst,
+                                const float* src,
+                                unsigned int channels,
+                                unsigned int frames)
+{
+  GetKernels().deinterleave(dst, src, channels, frames);
+}
 
-  if (even != count)
-  {
-    uint32_t odd = count - even;
-    if (odd == 1)
-      data[0] = SoftClamp(data[0]);
-    else
-    {
-      __m128 dt;
-      __m128 tmp;
-      __m128 out;
-      if (odd == 2)
-      {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], 0, 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
-      }
-      else
-      {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], data[2], 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
-        data[2] = ((float*)&out)[2];
-      }
-    }
-  }
-#endif
+const char* CAEUtil::GetSIMDName()
+{
+  return GetKernels().name;
 }
 
 bool CAEUtil::S16NeedsByteSwap(AEDataFormat in, AEDataFormat out)
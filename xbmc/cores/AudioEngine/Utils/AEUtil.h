@@ -93,10 +93,6 @@ private:
 
 class CAEUtil
 {
-private:
-
-  static float SoftClamp(const float x);
-
 public:
   static CAEChannelInfo          GuessChLayout     (const unsigned int channels);
   static const char*             GetStdChLayoutName(const enum AEStdChLayout layout);
@@ -168,8 +164,50 @@ public:
   static void SSEMulArray     (float *data, const float mul, uint32_t count);
   static void SSEMulAddArray  (float *data, float *add, const float mul, uint32_t count);
   #endif
+
+  /*! \brief multiply count samples by mul in place
+   Uses the widest vector unit detected at runtime (AVX2, SSE or NEON) and
+   falls back to a scalar loop otherwise.
+   */
+  static void MulArray(float* data, const float mul, uint32_t count);
+
+  /*! \brief add count samples of add, scaled by mul, to data in place
+   \sa MulArray
+   */
+  static void MulAddArray(float* data, const float* add, const float mul, uint32_t count);
+
+  /*! \brief soft clamp count samples to the range -1..1
+   \sa MulArray
+   */
   static void ClampArray(float *data, uint32_t count);
 
+  /*! \brief get the highest absolute sample value of count samples
+   \sa MulArray
+   */
+  static float PeakArray(const float* data, uint32_t count);
+
+  /*! \brief interleave planar float samples
+   \param dst buffer receiving frames * channels interleaved samples
+   \param src array of channels planes, each holding frames samples
+   */
+  static void InterleaveFloat(float* dst,
+                              const float* const* src,
+                              unsigned int channels,
+                              unsigned int frames);
+
+  /*! \brief split interleaved float samples into planes
+   \param dst array of channels planes, each receiving frames samples
+   \param src buffer holding frames * channels interleaved samples
+   */
+  static void DeinterleaveFloat(float* const* dst,
+                                const float* src,
+                                unsigned int channels,
+                                unsigned int frames);
+
+  /*! \brief get the name of the vector instruction set used by the array helpers
+   */
+  static const char* GetSIMDName();
+
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
 
   static uint64_t GetAVChannelLayout(const CAEChannelInfo &info);
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AERingBuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int SAMPLE_SIZE = sizeof(uint32_t);
+
+void CopyFromRegion(unsigned char* dest, const AERingBuffer::Region& region)
+{
+  memcpy(dest, region.data1, region.size1);
+  if (region.size2)
+    memcpy(dest + region.size1, region.data2, region.size2);
+}
+
+void CopyToRegion(const AERingBuffer::Region& region, const unsigned char* src)
+{
+  memcpy(region.data1, src, region.size1);
+  if (region.size2)
+    memcpy(region.data2, src + region.size1, region.size2);
+}
+} // namespace
+
+TEST(TestAERingBuffer, WrapAround)
+{
+  AERingBuffer buffer(10);
+  unsigned char data[10];
+
+  EXPECT_EQ(10u, buffer.GetWriteSize());
+  EXPECT_EQ(0, buffer.Write(reinterpret_cast<unsigned char*>(const_cast<char*>("abcdefg")), 7));
+  EXPECT_EQ(7u, buffer.GetReadSize());
+  EXPECT_EQ(0, buffer.Read(data, 5));
+  EXPECT_EQ(0, memcmp(data, "abcde", 5));
+
+  // the next write wraps around the end of the buffer
+  EXPECT_EQ(0, buffer.Write(reinterpret_cast<unsigned char*>(const_cast<char*>("hijklm")), 6));
+  EXPECT_EQ(8u, buffer.GetReadSize());
+
+  AERingBuffer::Region region;
+  ASSERT_TRUE(buffer.GetReadRegion(region, 8));
+  EXPECT_EQ(5u, region.size1);
+  EXPECT_EQ(3u, region.size2);
+  CopyFromRegion(data, region);
+  EXPECT_EQ(0, memcmp(data, "fghijklm", 8));
+  buffer.CommitRead(8);
+
+  EXPECT_EQ(0u, buffer.GetReadSize());
+  EXPECT_EQ(10u, buffer.GetWriteSize());
+  EXPECT_FALSE(buffer.GetReadRegion(region, 1));
+}
+
+TEST(TestAERingBuffer, PlanarRegions)
+{
+  AERingBuffer buffer(16, 2);
+  AERingBuffer::Region left;
+  AERingBuffer::Region right;
+
+  ASSERT_TRUE(buffer.GetWriteRegion(left, 12, 0));
+  ASSERT_TRUE(buffer.GetWriteRegion(right, 12, 1));
+  EXPECT_NE(left.data1, right.data1);
+  memset(left.data1, 'L', left.size1);
+  memset(right.data1, 'R', right.size1);
+
+  // nothing is visible before the commit
+  EXPECT_EQ(0u, buffer.GetReadSize());
+  buffer.CommitWrite(12);
+  EXPECT_EQ(12u, buffer.GetReadSize());
+
+  AERingBuffer::Region region;
+  ASSERT_TRUE(buffer.GetReadRegion(region, 12, 1));
+  EXPECT_EQ(right.data1, region.data1);
+  EXPECT_EQ('R', region.data1[11]);
+  EXPECT_FALSE(buffer.GetReadRegion(region, 13, 1));
+  EXPECT_FALSE(buffer.GetReadRegion(region, 4, 2));
+}
+
+TEST(TestAERingBuffer, ConcurrentReadWrite)
+{
+  constexpr unsigned int planes = 2;
+  constexpr uint32_t total = 2000000;
+  AERingBuffer buffer(SAMPLE_SIZE * 1000, planes);
+
+  // failures are only recorded by the threads, gtest assertions don't work across them. Each side
+  // gives up once the other one stopped, so a failure can't hang the test.
+  std::atomic<bool> stop{false};
+  std::atomic<bool> writerFailed{false};
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+  // writer alternates between copying writes and zero-copy regions,
+  // plane 1 carries the inverted sequence of plane 0
+  std::thread writer([&] {
+    std::vector<uint32_t> chunk[planes];
+    uint32_t next = 0;
+    unsigned int round = 0;
+    while (next < total && !stop)
+    {
+      const unsigned int frames = std::min<uint32_t>(1 + (round++ * 7) % 97, total - next);
+      const unsigned int bytes = frames * SAMPLE_SIZE;
+      if (buffer.GetWriteSize() < bytes)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      for (unsigned int p = 0; p < planes; ++p)
+      {
+        chunk[p].resize(frames);
+        for (unsigned int i = 0; i < frames; ++i)
+          chunk[p][i] = p ? ~(next + i) : next + i;
+      }
+
+      if (round % 2)
+      {
+        for (unsigned int p = 0; p < planes; ++p)
+          buffer.Write(reinterpret_cast<unsigned char*>(chunk[p].data()), bytes, p);
+      }
+      else
+      {
+        AERingBuffer::Region region;
+        for (unsigned int p = 0; p < planes; ++p)
+        {
+          if (!buffer.GetWriteRegion(region, bytes, p))
+          {
+            writerFailed = true;
+            return;
+          }
+          CopyToRegion(region, reinterpret_cast<unsigned char*>(chunk[p].data()));
+        }
+        buffer.CommitWrite(bytes);
+      }
+      next += frames;
+    }
+  });
+
+  std::vector<uint32_t> chunk(128);
+  uint32_t expected = 0;
+  unsigned int round = 0;
+  bool ok = true;
+  bool timedOut = false;
+  while (expected < total && ok && !writerFailed)
+  {
+    const unsigned int available = buffer.GetReadSize() / SAMPLE_SIZE;
+    if (available == 0)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        timedOut = true;
+        break;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+
+    const unsigned int frames = std::min<unsigned int>(available, chunk.size());
+    const unsigned int bytes = frames * SAMPLE_SIZE;
+    for (unsigned int p = 0; p < planes && ok; ++p)
+    {
+      if (round % 2)
+      {
+        buffer.Read(reinterpret_cast<unsigned char*>(chunk.data()), bytes, p);
+      }
+      else
+      {
+        AERingBuffer::Region region;
+        ok = buffer.GetReadRegion(region, bytes, p);
+        if (ok)
+          CopyFromRegion(reinterpret_cast<unsigned char*>(chunk.data()), region);
+      }
+
+      for (unsigned int i = 0; i < frames && ok; ++i)
+        ok = chunk[i] == (p ? ~(expected + i) : expected + i);
+    }
+    if (round++ % 2 == 0)
+      buffer.CommitRead(bytes);
+    expected += frames;
+  }
+
+  stop = true;
+  writer.join();
+  EXPECT_FALSE(writerFailed);
+  EXPECT_FALSE(timedOut);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(total, expected);
+  EXPECT_EQ(0u, buffer.GetReadSize());
+}
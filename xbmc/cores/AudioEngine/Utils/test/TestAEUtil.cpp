@@ -0,0 +1,178 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "test/Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using ::testing::Combine;
+using ::testing::Test;
+using ::testing::Values;
+using ::testing::WithParamInterface;
+
+namespace
+{
+std::vector<float> MakeSamples(size_t count, float range)
+{
+  std::mt19937 gen(static_cast<unsigned int>(count));
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> samples(count);
+  std::generate(samples.begin(), samples.end(), [&] { return dist(gen); });
+  return samples;
+}
+
+float SoftClampReference(float x)
+{
+  if (x < -3.0f)
+    return -1.0f;
+  if (x > 3.0f)
+    return 1.0f;
+  const float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+} // namespace
+
+// parameters are channel count and frame count
+class TestAEUtilArrays : public Test, public WithParamInterface<std::tuple<unsigned int, unsigned int>>
+{
+protected:
+  unsigned int Channels() const { return std::get<0>(GetParam()); }
+  unsigned int Frames() const { return std::get<1>(GetParam()); }
+  unsigned int Samples() const { return Channels() * Frames(); }
+};
+
+TEST_P(TestAEUtilArrays, MulArray)
+{
+  std::vector<float> data = MakeSamples(Samples() + 1, 1.0f);
+  const std::vector<float> ref = data;
+
+  // start at an odd offset to exercise unaligned heads
+  CAEUtil::MulArray(data.data() + 1, 0.5f, Samples());
+
+  EXPECT_EQ(ref[0], data[0]);
+  for (unsigned int i = 1; i < data.size(); ++i)
+    EXPECT_FLOAT_EQ(ref[i] * 0.5f, data[i]);
+}
+
+TEST_P(TestAEUtilArrays, MulAddArray)
+{
+  std::vector<float> data = MakeSamples(Samples(), 1.0f);
+  const std::vector<float> add = MakeSamples(Samples() + 3, 1.0f);
+  const std::vector<float> ref = data;
+
+  CAEUtil::MulAddArray(data.data(), add.data() + 3, 0.25f, Samples());
+
+  for (unsigned int i = 0; i < data.size(); ++i)
+    EXPECT_NEAR(ref[i] + add[i + 3] * 0.25f, data[i], 1e-6f);
+}
+
+TEST_P(TestAEUtilArrays, ClampArray)
+{
+  std::vector<float> data = MakeSamples(Samples(), 2.5f);
+  const std::vector<float> ref = data;
+
+  CAEUtil::ClampArray(data.data(), Samples());
+
+  for (unsigned int i = 0; i < data.size(); ++i)
+  {
+    EXPECT_NEAR(SoftClampReference(ref[i]), data[i], 1e-5f);
+    EXPECT_LE(std::fabs(data[i]), 1.0f);
+  }
+}
+
+TEST_P(TestAEUtilArrays, PeakArray)
+{
+  std::vector<float> data = MakeSamples(Samples(), 1.0f);
+  if (!data.empty())
+    data[data.size() / 2] = -1.5f;
+
+  float ref = 0.0f;
+  for (float sample : data)
+    ref = std::max(ref, std::fabs(sample));
+
+  EXPECT_EQ(ref, CAEUtil::PeakArray(data.data(), Samples()));
+}
+
+TEST_P(TestAEUtilArrays, InterleaveRoundTrip)
+{
+  std::vector<std::vector<float>> planes;
+  std::vector<const float*> src;
+  for (unsigned int ch = 0; ch < Channels(); ++ch)
+  {
+    planes.emplace_back(MakeSamples(Frames() + ch, 1.0f));
+    src.emplace_back(planes.back().data());
+  }
+
+  std::vector<float> interleaved(Samples());
+  CAEUtil::InterleaveFloat(interleaved.data(), src.data(), Channels(), Frames());
+
+  for (unsigned int i = 0; i < Frames(); ++i)
+    for (unsigned int ch = 0; ch < Channels(); ++ch)
+      ASSERT_EQ(planes[ch][i], interleaved[i * Channels() + ch]);
+
+  std::vector<std::vector<float>> out(Channels(), std::vector<float>(Frames()));
+  std::vector<float*> dst;
+  for (auto& plane : out)
+    dst.emplace_back(plane.data());
+
+  CAEUtil::DeinterleaveFloat(dst.data(), interleaved.data(), Channels(), Frames());
+
+  for (unsigned int ch = 0; ch < Channels(); ++ch)
+    for (unsigned int i = 0; i < Frames(); ++i)
+      ASSERT_EQ(planes[ch][i], out[ch][i]);
+}
+
+INSTANTIATE_TEST_SUITE_P(ChannelsFrames,
+                         TestAEUtilArrays,
+                         Combine(Values(1u, 2u, 6u, 8u), Values(0u, 1u, 7u, 33u, 1024u)));
+
+// compare the output against a build without the vector paths
+class TestAEUtilBenchmark : public TestAEUtilArrays
+{
+protected:
+  template<typename F>
+  void Measure(const char* name, F&& func)
+  {
+    const Benchmark::Duration perCall = Benchmark::TimePerCall(2000, func);
+    Benchmark::Report(fmt::format("{} {} {}ch x {}", CAEUtil::GetSIMDName(), name, Channels(),
+                                  Frames()),
+                      Benchmark::Nanoseconds(perCall) / Samples(), "ns/sample");
+  }
+};
+
+TEST_P(TestAEUtilBenchmark, DISABLED_Kernels)
+{
+  std::vector<float> data = MakeSamples(Samples(), 1.0f);
+  const std::vector<float> add = MakeSamples(Samples(), 1.0f);
+  std::vector<std::vector<float>> planes(Channels(), std::vector<float>(Frames()));
+  std::vector<float*> dst;
+  for (auto& plane : planes)
+    dst.emplace_back(plane.data());
+
+  Measure("MulArray", [&] { CAEUtil::MulArray(data.data(), 0.999f, Samples()); });
+  Measure("MulAddArray",
+          [&] { CAEUtil::MulAddArray(data.data(), add.data(), 0.001f, Samples()); });
+  Measure("ClampArray", [&] { CAEUtil::ClampArray(data.data(), Samples()); });
+  Measure("PeakArray", [&] { data[0] = CAEUtil::PeakArray(data.data(), Samples()); });
+  Measure("DeinterleaveFloat", [&] {
+    CAEUtil::DeinterleaveFloat(dst.data(), data.data(), Channels(), Frames());
+  });
+  Measure("InterleaveFloat", [&] {
+    CAEUtil::InterleaveFloat(data.data(), dst.data(), Channels(), Frames());
+  });
+}
+
+INSTANTIATE_TEST_SUITE_P(ChannelsFrames,
+                         TestAEUtilBenchmark,
+                         Combine(Values(2u, 6u, 8u), Values(256u, 1024u, 4096u)));
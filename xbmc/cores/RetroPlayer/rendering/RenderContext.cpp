@@ -66,6 +66,11 @@ void CRenderContext::ApplyStateBlock()
   m_rendering->ApplyStateBlock();
 }
 
+void CRenderContext::FlushBatch()
+{
+  m_rendering->FlushBatch();
+}
+
 bool CRenderContext::IsExtSupported(const char* extension)
 {
   return m_rendering->IsExtSupported(extension);
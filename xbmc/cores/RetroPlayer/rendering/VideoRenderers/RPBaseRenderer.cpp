@@ -215,6 +215,9 @@ void CRPBaseRenderer::PreRender(bool clear)
   if (!m_bConfigured)
     return;
 
+  // Draw the GUI queued so far, the game is rendered past the render system
+  m_context.FlushBatch();
+
   // Clear screen
   if (clear)
     m_context.Clear(m_context.UseLimitedColor() ? UTILS::COLOR::LIMITED_BLACK
@@ -12,6 +12,9 @@
 #include "DVDSubtitleLineCollection.h"
 #include "DVDSubtitleStream.h"
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 #include <stdio.h>
 #include <string>
@@ -59,13 +62,22 @@ public:
   {
   }
 
-  ~CDVDSubtitleParserText() override = default;
+  ~CDVDSubtitleParserText() override { StopParsing(); }
 
   /*
    * \brief Returns parser name
    */
   const std::string& GetName() const override { return m_parserName; }
 
+  /*
+   * \brief Block until a parse started by ParseAsync has completed
+   */
+  void WaitForParsing()
+  {
+    if (m_parseTask.valid())
+      m_parseTask.wait();
+  }
+
 protected:
   using CDVDSubtitleParserCollection::Open;
   bool Open()
@@ -81,6 +93,31 @@ protected:
     return m_pStream->Open(m_filename);
   }
 
+  /*
+   * \brief Run the parsing of the stream on a separate thread, so that opening a large
+   * subtitle file does not stall the player. Lines become available as soon as they
+   * are parsed. Parsers using it must call StopParsing in their destructor, before
+   * their members go away.
+   */
+  void ParseAsync(std::function<void()> parse)
+  {
+    StopParsing();
+    m_abortParsing = false;
+    m_parseTask = std::async(std::launch::async, std::move(parse));
+  }
+
+  void StopParsing()
+  {
+    m_abortParsing = true;
+    WaitForParsing();
+  }
+
+  bool IsParsingAborted() const { return m_abortParsing; }
+
   std::unique_ptr<CDVDSubtitleStream> m_pStream;
   std::string m_parserName;
+
+private:
+  std::future<void> m_parseTask;
+  std::atomic_bool m_abortParsing{false};
 };
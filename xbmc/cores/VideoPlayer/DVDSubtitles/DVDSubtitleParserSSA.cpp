@@ -13,9 +13,20 @@
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "settings/SettingsComponent.h"
 #include "settings/SubtitlesSettings.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
 
 using namespace KODI;
 
+namespace
+{
+// events are handed to libass in parts of about this size
+constexpr size_t EVENTS_CHUNK_SIZE = 64 * 1024;
+
+constexpr const char* UTF8_BOM = "\xEF\xBB\xBF";
+} // namespace
+
 CDVDSubtitleParserSSA::CDVDSubtitleParserSSA(std::unique_ptr<CDVDSubtitleStream>&& pStream,
                                              const std::string& strFile)
   : CDVDSubtitleParserText(std::move(pStream), strFile, "SSA Subtitle Parser"),
@@ -30,8 +41,14 @@ bool CDVDSubtitleParserSSA::Open(CDVDStreamInfo& hints)
   if (!CDVDSubtitleParserText::Open())
     return false;
 
+  // only the header is loaded here, the events are added to the track in the background
+  // so that large files don't delay the start of playback
   const std::string& data = m_pStream->GetData();
-  if (!m_libass->CreateTrack(const_cast<char*>(data.c_str()), data.length()))
+  const size_t bomSize = StringUtils::StartsWith(data, UTF8_BOM) ? 3 : 0;
+  const size_t headerSize = GetHeaderSize(data);
+  //! @bug libass isn't const correct
+  if (!m_libass->CreateTrackFromHeader(const_cast<char*>(data.data()) + bomSize,
+                                       headerSize - bomSize))
     return false;
 
   auto overlay = std::make_shared<CDVDOverlaySSA>(m_libass);
@@ -43,5 +60,43 @@ bool CDVDSubtitleParserSSA::Open(CDVDStreamInfo& hints)
                             overrideStyles != SUBTITLES::OverrideStyles::POSITIONS);
   m_collection.Add(overlay);
 
+  if (headerSize < data.size())
+    ParseAsync([this, headerSize]() { ParseEvents(headerSize); });
+
   return true;
 }
+
+size_t CDVDSubtitleParserSSA::GetHeaderSize(const std::string& data)
+{
+  bool inEvents = false;
+  size_t pos = 0;
+  while (pos < data.size())
+  {
+    size_t end = data.find('\n', pos);
+    end = end == std::string::npos ? data.size() : end + 1;
+
+    std::string line = data.substr(pos, end - pos);
+    StringUtils::Trim(line);
+    if (StringUtils::StartsWith(line, "["))
+      inEvents = StringUtils::EqualsNoCase(line, "[Events]");
+    else if (inEvents && StringUtils::StartsWithNoCase(line, "Format:"))
+      return end;
+
+    pos = end;
+  }
+  return data.size();
+}
+
+void CDVDSubtitleParserSSA::ParseEvents(size_t offset)
+{
+  const std::string& data = m_pStream->GetData();
+  while (offset < data.size() && !IsParsingAborted())
+  {
+    // libass parses whole lines only, so each part ends after a line break
+    size_t end = data.find('\n', std::min(offset + EVENTS_CHUNK_SIZE, data.size()) - 1);
+    end = end == std::string::npos ? data.size() : end + 1;
+
+    m_libass->AddData(const_cast<char*>(data.data()) + offset, end - offset);
+    offset = end;
+  }
+}
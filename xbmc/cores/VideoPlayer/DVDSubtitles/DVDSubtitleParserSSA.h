@@ -12,15 +12,24 @@
 #include "DVDSubtitlesLibass.h"
 
 #include <memory>
+#include <string>
 
 class CDVDSubtitleParserSSA : public CDVDSubtitleParserText
 {
 public:
   CDVDSubtitleParserSSA(std::unique_ptr<CDVDSubtitleStream>&& pStream, const std::string& strFile);
-  ~CDVDSubtitleParserSSA() = default;
+  ~CDVDSubtitleParserSSA() override { StopParsing(); }
 
   bool Open(CDVDStreamInfo& hints) override;
 
+  /*!
+   * \brief Get the size of the header of an SSA/ASS file, up to and including the
+   * Format line of the [Events] section. The whole data when it has no events.
+   */
+  static size_t GetHeaderSize(const std::string& data);
+
 private:
+  void ParseEvents(size_t offset);
+
   std::shared_ptr<CDVDSubtitlesLibass> m_libass;
 };
@@ -26,13 +26,22 @@ bool CDVDSubtitleParserSubrip::Open(CDVDStreamInfo& hints)
   if (!Initialize())
     return false;
 
-  CDVDSubtitleTagSami TagConv;
-  if (!TagConv.Init())
+  if (!m_tagConv.Init())
     return false;
 
+  // the overlay renders the lines parsed so far
+  m_collection.Add(CreateOverlay());
+
+  ParseAsync([this]() { ParseStream(); });
+
+  return true;
+}
+
+void CDVDSubtitleParserSubrip::ParseStream()
+{
   std::string line;
 
-  while (m_pStream->ReadLine(line))
+  while (!IsParsingAborted() && m_pStream->ReadLine(line))
   {
     StringUtils::Trim(line);
 
@@ -65,20 +74,16 @@ bool CDVDSubtitleParserSubrip::Open(CDVDStreamInfo& hints)
 
           if (convText.size() > 0)
             convText += "\n";
-          TagConv.ConvertLine(line);
+          m_tagConv.ConvertLine(line);
           convText += line;
         }
 
         if (!convText.empty())
         {
-          TagConv.CloseTag(convText);
+          m_tagConv.CloseTag(convText);
           AddSubtitle(convText, iPTSStartTime, iPTSStopTime);
         }
       }
     }
   }
-
-  m_collection.Add(CreateOverlay());
-
-  return true;
 }
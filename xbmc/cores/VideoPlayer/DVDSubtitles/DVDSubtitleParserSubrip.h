@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDSubtitleParser.h"
+#include "DVDSubtitleTagSami.h"
 #include "SubtitlesAdapter.h"
 
 #include <memory>
@@ -18,7 +19,12 @@ class CDVDSubtitleParserSubrip : public CDVDSubtitleParserText, private CSubtitl
 public:
   CDVDSubtitleParserSubrip(std::unique_ptr<CDVDSubtitleStream>&& pStream,
                            const std::string& strFile);
-  ~CDVDSubtitleParserSubrip() = default;
+  ~CDVDSubtitleParserSubrip() override { StopParsing(); }
 
   bool Open(CDVDStreamInfo& hints) override;
+
+private:
+  void ParseStream();
+
+  CDVDSubtitleTagSami m_tagConv;
 };
@@ -251,6 +251,43 @@ bool CDVDSubtitlesLibass::CreateTrack(char* buf, size_t size)
   return true;
 }
 
+bool CDVDSubtitlesLibass::CreateTrackFromHeader(char* buf, size_t size)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (!m_library)
+  {
+    CLog::Log(LOGERROR, "{} - No ASS library struct (m_library)", __FUNCTION__);
+    return false;
+  }
+
+  CLog::Log(LOGINFO, "CDVDSubtitlesLibass: Creating m_track from SSA header");
+
+  m_track = ass_new_track(m_library);
+  if (m_track == NULL)
+    return false;
+
+  ass_process_codec_private(m_track, buf, static_cast<int>(size));
+
+  // same check as ass_read_memory, the buffer has no [Script Info] section
+  if (m_track->track_type == m_track->TRACK_TYPE_UNKNOWN)
+  {
+    ass_free_track(m_track);
+    m_track = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+void CDVDSubtitlesLibass::AddData(char* buf, size_t size)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (!m_track)
+    return;
+
+  ass_process_data(m_track, buf, static_cast<int>(size));
+}
+
 ASS_Image* CDVDSubtitlesLibass::RenderImage(double pts,
                                             renderOpts opts,
                                             bool updateStyle,
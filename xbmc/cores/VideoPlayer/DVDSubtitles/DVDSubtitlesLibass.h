@@ -72,6 +72,19 @@ public:
   */
   bool CreateTrack(char* buf, size_t size);
 
+  /*!
+  * \brief Create a new ASS track from the header of an SSA buffer,
+  * the events can then be added with AddData
+  * \return True if success, false if error
+  */
+  bool CreateTrackFromHeader(char* buf, size_t size);
+
+  /*!
+  * \brief Add a part of an SSA buffer to the track created with
+  * CreateTrackFromHeader, the part must end with a complete line
+  */
+  void AddData(char* buf, size_t size);
+
   /*!
   * \brief Flush buffered events
   */
@@ -32,8 +32,6 @@ bool CSubtitleParserWebVTT::Open(CDVDStreamInfo& hints)
   if (!Initialize())
     return false;
 
-  CWebVTTHandler m_webvttHandler;
-
   if (!m_webvttHandler.Initialize())
     return false;
 
@@ -42,21 +40,47 @@ bool CSubtitleParserWebVTT::Open(CDVDStreamInfo& hints)
     return false;
   m_pStream->Seek(0);
 
+  // the overlay renders the cues decoded so far
+  std::shared_ptr<CDVDOverlay> overlay = CreateOverlay();
+  overlay->SetForcedMargins(m_webvttHandler.IsForcedMargins());
+  m_collection.Add(overlay);
+
+  ParseAsync([this]() { ParseStream(); });
+
+  return true;
+}
+
+void CSubtitleParserWebVTT::ParseStream()
+{
   // Start decoding all lines
   std::vector<subtitleData> subtitleList;
   std::string line;
 
-  while (m_pStream->ReadLine(line))
+  while (!IsParsingAborted() && m_pStream->ReadLine(line))
   {
     m_webvttHandler.DecodeLine(line, &subtitleList);
+
+    // the handler may still replace the last cue with a duplicate, send all the others
+    if (subtitleList.size() > 1)
+      AddSubtitles(subtitleList, subtitleList.size() - 1);
   }
 
+  if (IsParsingAborted())
+    return;
+
   // We send an empty line to mark the end of the last Cue
   m_webvttHandler.DecodeLine("", &subtitleList);
 
+  AddSubtitles(subtitleList, subtitleList.size());
+}
+
+void CSubtitleParserWebVTT::AddSubtitles(std::vector<subtitleData>& subtitleList, size_t count)
+{
   // Send decoded lines to the renderer
-  for (auto& subData : subtitleList)
+  for (size_t i = 0; i < count; i++)
   {
+    subtitleData& subData = subtitleList[i];
+
     SUBTITLES::STYLE::subtitleOpts opts;
     opts.useMargins = subData.useMargins;
     opts.marginLeft = subData.marginLeft;
@@ -65,10 +89,5 @@ bool CSubtitleParserWebVTT::Open(CDVDStreamInfo& hints)
 
     AddSubtitle(subData.text, subData.startTime, subData.stopTime, &opts);
   }
-
-  std::shared_ptr<CDVDOverlay> overlay = CreateOverlay();
-  overlay->SetForcedMargins(m_webvttHandler.IsForcedMargins());
-  m_collection.Add(overlay);
-
-  return true;
+  subtitleList.erase(subtitleList.begin(), subtitleList.begin() + count);
 }
@@ -10,6 +10,7 @@
 
 #include "DVDSubtitleParser.h"
 #include "SubtitlesAdapter.h"
+#include "cores/VideoPlayer/DVDSubtitles/webvtt/WebVTTHandler.h"
 
 #include <memory>
 
@@ -17,7 +18,13 @@ class CSubtitleParserWebVTT : public CDVDSubtitleParserText, public CSubtitlesAd
 {
 public:
   CSubtitleParserWebVTT(std::unique_ptr<CDVDSubtitleStream>&& pStream, const std::string& strFile);
-  ~CSubtitleParserWebVTT() = default;
+  ~CSubtitleParserWebVTT() override { StopParsing(); }
 
   bool Open(CDVDStreamInfo& hints) override;
+
+private:
+  void ParseStream();
+  void AddSubtitles(std::vector<subtitleData>& subtitleList, size_t count);
+
+  CWebVTTHandler m_webvttHandler;
 };
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDStreamInfo.h"
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleParserSSA.h"
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleParserSubrip.h"
+#include "filesystem/File.h"
+#include "test/Benchmark.h"
+#include "test/TestUtils.h"
+
+#include <memory>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::string SSA_HEADER = "[Script Info]\n"
+                               "ScriptType: v4.00+\n"
+                               "\n"
+                               "[V4+ Styles]\n"
+                               "Format: Name, Fontname, Fontsize\n"
+                               "Style: Default,Arial,20\n"
+                               "\n"
+                               "[Events]\n"
+                               "Format: Layer, Start, End, Style, Name, MarginL, MarginR, MarginV, "
+                               "Effect, Text\n";
+
+std::string SsaTime(int ms)
+{
+  return fmt::format("{}:{:02}:{:02}.{:02}", ms / 3600000, ms / 60000 % 60, ms / 1000 % 60,
+                     ms % 1000 / 10);
+}
+
+std::string SubripTime(int ms)
+{
+  return fmt::format("{:02}:{:02}:{:02},{:03}", ms / 3600000, ms / 60000 % 60, ms / 1000 % 60,
+                     ms % 1000);
+}
+
+// write a file with the given number of lines, each line written by writeLine
+template<typename F>
+XFILE::CFile* CreateFile(const char* suffix, const std::string& header, int lines, F&& writeLine)
+{
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(suffix);
+  if (!file)
+    return nullptr;
+  file->Close();
+  if (!file->OpenForWrite(XBMC_TEMPFILEPATH(file), true))
+    return nullptr;
+
+  std::string data = header;
+  for (int i = 0; i < lines; i++)
+    data += writeLine(i);
+  file->Write(data.data(), data.size());
+  file->Close();
+  return file;
+}
+
+template<typename Parser>
+void BenchmarkParser(const std::string& name, XFILE::CFile* file)
+{
+  CDVDStreamInfo hints;
+  Parser parser(nullptr, XBMC_TEMPFILEPATH(file));
+  bool opened = false;
+  const auto open = Benchmark::Time([&] { opened = parser.Open(hints); });
+  ASSERT_TRUE(opened);
+  const auto parse = Benchmark::Time([&] { parser.WaitForParsing(); });
+
+  Benchmark::Report(name + " open", Benchmark::Milliseconds(open), "ms");
+  Benchmark::Report(name + " open and parse", Benchmark::Milliseconds(open + parse), "ms");
+}
+} // namespace
+
+TEST(TestDVDSubtitleParserSSA, GetHeaderSize)
+{
+  const std::string events = "Dialogue: 0,0:00:01.00,0:00:02.00,Default,,0,0,0,,Hello\n"
+                             "Dialogue: 0,0:00:03.00,0:00:04.00,Default,,0,0,0,,World\n";
+
+  EXPECT_EQ(SSA_HEADER.size(), CDVDSubtitleParserSSA::GetHeaderSize(SSA_HEADER + events));
+  EXPECT_EQ(SSA_HEADER.size(), CDVDSubtitleParserSSA::GetHeaderSize(SSA_HEADER));
+}
+
+TEST(TestDVDSubtitleParserSSA, GetHeaderSizeFormatInOtherSections)
+{
+  // only the Format line of the [Events] section ends the header, in any case and line ending
+  const std::string header = "[Script Info]\r\n"
+                             "ScriptType: v4.00\r\n"
+                             "[V4 Styles]\r\n"
+                             "Format: Name, Fontname, Fontsize\r\n"
+                             "Style: Default,Arial,20\r\n"
+                             "[EVENTS]\r\n"
+                             "format: Marked, Start, End, Style, Name, MarginL, MarginR, MarginV, "
+                             "Effect, Text\r\n";
+  const std::string events = "Dialogue: Marked=0,0:00:01.00,0:00:02.00,Default,,0,0,0,,Hello\r\n";
+
+  EXPECT_EQ(header.size(), CDVDSubtitleParserSSA::GetHeaderSize(header + events));
+}
+
+TEST(TestDVDSubtitleParserSSA, GetHeaderSizeWithoutEvents)
+{
+  const std::string data = "[Script Info]\nScriptType: v4.00+\n\n[Events]\n";
+
+  EXPECT_EQ(data.size(), CDVDSubtitleParserSSA::GetHeaderSize(data));
+  EXPECT_EQ(0u, CDVDSubtitleParserSSA::GetHeaderSize(""));
+}
+
+TEST(TestDVDSubtitleParserSSA, DISABLED_Benchmark)
+{
+  constexpr int LINES = 200000;
+
+  XFILE::CFile* ssa = CreateFile(".ass", SSA_HEADER, LINES,
+                                 [](int i)
+                                 {
+                                   return fmt::format(
+                                       "Dialogue: 0,{},{},Default,,0,0,0,,{{\\i1}}Line{{\\i0}} "
+                                       "number {}\n",
+                                       SsaTime(i * 100), SsaTime(i * 100 + 90), i);
+                                 });
+  ASSERT_NE(nullptr, ssa);
+  BenchmarkParser<CDVDSubtitleParserSSA>(fmt::format("SSA with {} events", LINES), ssa);
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(ssa));
+
+  XFILE::CFile* srt = CreateFile(".srt", "", LINES,
+                                 [](int i)
+                                 {
+                                   return fmt::format(
+                                       "{}\n{} --> {}\n<i>Line</i> number {}\n\n", i + 1,
+                                       SubripTime(i * 100), SubripTime(i * 100 + 90), i);
+                                 });
+  ASSERT_NE(nullptr, srt);
+  BenchmarkParser<CDVDSubtitleParserSubrip>(fmt::format("SubRip with {} cues", LINES), srt);
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(srt));
+}
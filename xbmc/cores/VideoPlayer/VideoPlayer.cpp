@@ -56,6 +56,7 @@
 #include "utils/StreamDetails.h"
 #include "utils/StreamUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -874,6 +875,8 @@ void CVideoPlayer::OnStartup()
 
 bool CVideoPlayer::OpenInputStream()
 {
+  KODI_TRACE_SCOPE("video", "CVideoPlayer::OpenInputStream");
+
   if (m_pInputStream.use_count() > 1)
     throw std::runtime_error("m_pInputStream reference count is greater than 1");
   m_pInputStream.reset();
@@ -938,6 +941,8 @@ bool CVideoPlayer::OpenInputStream()
 
 bool CVideoPlayer::OpenDemuxStream()
 {
+  KODI_TRACE_SCOPE("video", "CVideoPlayer::OpenDemuxStream");
+
   CloseDemuxer();
 
   CLog::Log(LOGINFO, "Creating Demuxer");
@@ -1136,6 +1141,7 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
 
 bool CVideoPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
+  KODI_TRACE_SCOPE("video", "CVideoPlayer::ReadPacket");
 
   // check if we should read from subtitle demuxer
   if (m_pSubtitleDemuxer && m_VideoPlayerSubtitle->AcceptsData())
@@ -1754,6 +1760,8 @@ bool CVideoPlayer::CheckIsCurrent(const CCurrentStream& current,
 
 void CVideoPlayer::ProcessPacket(CDemuxStream* pStream, DemuxPacket* pPacket)
 {
+  KODI_TRACE_SCOPE("video", "CVideoPlayer::ProcessPacket");
+
   // process packet if it belongs to selected stream.
   // for dvd's don't allow automatic opening of streams*/
 
@@ -60,6 +60,7 @@ public:
   unsigned int GetChannels();
   // Data management
   unsigned int GetDataSize(bool checkPktSize);
+  unsigned int GetBufferSize() { return m_pcmBuffer.getSize(); }
   void *GetData(unsigned int samples);
   uint8_t* GetRawData(int &size);
   ICodec *GetCodec() const { return m_codec; }
@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AudioDecoderPrefetcher.h"
+
+#include "AudioDecoder.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "utils/XTimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+CAudioDecoderPrefetcher::~CAudioDecoderPrefetcher()
+{
+  Clear();
+}
+
+void CAudioDecoderPrefetcher::SetLimits(unsigned int maxTracks, size_t memoryBudget)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_maxTracks = maxTracks;
+  m_memoryBudget = memoryBudget;
+}
+
+bool CAudioDecoderPrefetcher::IsEnabled() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_maxTracks > 0 && m_memoryBudget > 0;
+}
+
+int64_t CAudioDecoderPrefetcher::GetDecoderStartOffset(const CFileItem& file)
+{
+  // music from cuesheet => "item_start" and offset match, the decoder starts at the
+  // offset of the song within the file. Otherwise the offset is a resume point and
+  // applied by the player after the decoder has been created.
+  if (file.HasProperty("item_start") &&
+      file.GetProperty("item_start").asInteger() == file.GetStartOffset())
+    return file.GetStartOffset();
+
+  return 0;
+}
+
+std::vector<CAudioDecoderPrefetcher::Entry>::iterator CAudioDecoderPrefetcher::Find(
+    const std::string& path, int64_t startOffset)
+{
+  return std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+    return entry.m_startOffset == startOffset && entry.m_path == path;
+  });
+}
+
+void CAudioDecoderPrefetcher::Prefetch(const std::vector<CFileItem>& items)
+{
+  std::vector<const CFileItem*> pending;
+  std::vector<Entry> dropped;
+  unsigned int generation;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (!m_maxTracks || !m_memoryBudget)
+      return;
+
+    generation = m_generation;
+
+    // release tracks which are not upcoming anymore, e.g. after the playlist changed
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      const auto upcoming =
+          std::find_if(items.begin(), items.end(), [&it](const CFileItem& item) {
+            return item.GetDynPath() == it->m_path &&
+                   GetDecoderStartOffset(item) == it->m_startOffset;
+          });
+      if (upcoming != items.end() &&
+          static_cast<unsigned int>(upcoming - items.begin()) < m_maxTracks)
+      {
+        ++it;
+        continue;
+      }
+      m_memoryUsed -= it->m_size;
+      dropped.emplace_back(std::move(*it));
+      it = m_entries.erase(it);
+    }
+
+    for (unsigned int i = 0; i < items.size() && i < m_maxTracks; i++)
+    {
+      const int64_t startOffset = GetDecoderStartOffset(items[i]);
+      if (Find(items[i].GetDynPath(), startOffset) != m_entries.end())
+        continue;
+
+      // placeholder, so concurrent requests don't open the same track twice
+      Entry entry;
+      entry.m_path = items[i].GetDynPath();
+      entry.m_startOffset = startOffset;
+      m_entries.emplace_back(std::move(entry));
+      pending.emplace_back(&items[i]);
+    }
+  }
+  // decoders of dropped tracks are destroyed here, outside of the lock
+  dropped.clear();
+
+  for (const CFileItem* item : pending)
+  {
+    if (!PrefetchTrack(*item, GetDecoderStartOffset(*item), generation))
+      break;
+  }
+}
+
+bool CAudioDecoderPrefetcher::PrefetchTrack(const CFileItem& file,
+                                            int64_t startOffset,
+                                            unsigned int generation)
+{
+  const std::string path = file.GetDynPath();
+
+  // removes our placeholder unless someone else already did
+  auto discard = [this, &path, startOffset, generation]() {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (generation != m_generation)
+      return;
+    auto it = Find(path, startOffset);
+    if (it != m_entries.end() && !it->m_decoder)
+    {
+      m_memoryUsed -= it->m_size;
+      m_entries.erase(it);
+    }
+  };
+
+  auto decoder = std::make_unique<CAudioDecoder>();
+  if (!decoder->Create(file, startOffset))
+  {
+    CLog::Log(LOGDEBUG, "CAudioDecoderPrefetcher::{} - failed to open {}", __FUNCTION__,
+              CURL::GetRedacted(path));
+    discard();
+    return true;
+  }
+
+  // account for the pcm buffer before filling it
+  const size_t size = decoder->GetBufferSize();
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    auto it = Find(path, startOffset);
+    if (generation != m_generation || it == m_entries.end())
+      return generation == m_generation;
+
+    if (m_memoryUsed + size > m_memoryBudget)
+    {
+      CLog::Log(LOGDEBUG,
+                "CAudioDecoderPrefetcher::{} - memory budget of {} bytes exhausted, not "
+                "prefetching {}",
+                __FUNCTION__, m_memoryBudget, CURL::GetRedacted(path));
+      m_entries.erase(it);
+      return false;
+    }
+    it->m_size = size;
+    m_memoryUsed += size;
+  }
+
+  // pre-decode until the decoder reports the stream as queued
+  while (decoder->GetStatus() == STATUS_QUEUING)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      if (generation != m_generation || Find(path, startOffset) == m_entries.end())
+        return generation == m_generation;
+    }
+
+    const int ret = decoder->ReadSamples(PACKET_SIZE);
+    if (ret == RET_ERROR)
+    {
+      CLog::Log(LOGDEBUG, "CAudioDecoderPrefetcher::{} - error decoding {}", __FUNCTION__,
+                CURL::GetRedacted(path));
+      discard();
+      return true;
+    }
+    if (ret == RET_SLEEP)
+      KODI::TIME::Sleep(1ms);
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  auto it = Find(path, startOffset);
+  if (generation != m_generation || it == m_entries.end())
+    return generation == m_generation;
+
+  it->m_decoder = std::move(decoder);
+  CLog::Log(LOGDEBUG, "CAudioDecoderPrefetcher::{} - prefetched {} ({} bytes)", __FUNCTION__,
+            CURL::GetRedacted(path), size);
+  return true;
+}
+
+std::unique_ptr<CAudioDecoder> CAudioDecoderPrefetcher::Take(const CFileItem& file,
+                                                             int64_t startOffset)
+{
+  std::unique_ptr<CAudioDecoder> decoder;
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!m_maxTracks || !m_memoryBudget)
+    return decoder;
+
+  auto it = Find(file.GetDynPath(), startOffset);
+  if (it != m_entries.end())
+  {
+    // a track still being opened counts as a miss, the player opens it itself
+    decoder = std::move(it->m_decoder);
+    m_memoryUsed -= it->m_size;
+    m_entries.erase(it);
+  }
+
+  if (decoder)
+    m_hits++;
+  else
+    m_misses++;
+
+  CLog::Log(LOGDEBUG, "CAudioDecoderPrefetcher::{} - prefetch {} for {}", __FUNCTION__,
+            decoder ? "hit" : "miss", CURL::GetRedacted(file.GetDynPath()));
+  return decoder;
+}
+
+void CAudioDecoderPrefetcher::Clear()
+{
+  std::vector<Entry> entries;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_generation++;
+    m_memoryUsed = 0;
+    entries.swap(m_entries);
+  }
+}
+
+unsigned int CAudioDecoderPrefetcher::GetHits() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_hits;
+}
+
+unsigned int CAudioDecoderPrefetcher::GetMisses() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_misses;
+}
+
+size_t CAudioDecoderPrefetcher::GetMemoryUsage() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_memoryUsed;
+}
+
+void CAudioDecoderPrefetcher::LogStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const unsigned int total = m_hits + m_misses;
+  if (!total)
+    return;
+
+  CLog::Log(LOGINFO, "CAudioDecoderPrefetcher: {} of {} tracks prefetched ({:.1f}% hit rate)",
+            m_hits, total, 100.0 * m_hits / total);
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class CAudioDecoder;
+class CFileItem;
+
+/*!
+ * \brief Decode-ahead stage for PAPlayer.
+ *
+ * Opens, probes and pre-decodes upcoming tracks so that the open latency of slow
+ * sources (network shares, usb disks) is paid long before the track is queued for
+ * gapless playback or crossfading. Prefetched decoders are kept until they are
+ * taken by the player or dropped because they are no longer upcoming.
+ */
+class CAudioDecoderPrefetcher
+{
+public:
+  CAudioDecoderPrefetcher() = default;
+  ~CAudioDecoderPrefetcher();
+
+  /*!
+   * \brief Set how many tracks are decoded ahead and how much PCM memory they may use.
+   * \param maxTracks number of upcoming tracks to keep ready, 0 disables prefetching
+   * \param memoryBudget maximum size in bytes of all prefetched PCM buffers
+   */
+  void SetLimits(unsigned int maxTracks, size_t memoryBudget);
+  bool IsEnabled() const;
+
+  /*!
+   * \brief Prefetch the given upcoming tracks, in playback order.
+   *
+   * Prefetched tracks that are not part of the list anymore are released. Blocks while
+   * decoders are opened, so it is meant to be run from a job.
+   */
+  void Prefetch(const std::vector<CFileItem>& items);
+
+  /*!
+   * \brief Hand over the prefetched decoder of a track.
+   * \return the decoder, ready to be started, or nullptr if the track was not prefetched
+   */
+  std::unique_ptr<CAudioDecoder> Take(const CFileItem& file, int64_t startOffset);
+
+  /*!
+   * \brief Release all prefetched decoders and abort prefetches in progress.
+   */
+  void Clear();
+
+  unsigned int GetHits() const;
+  unsigned int GetMisses() const;
+  size_t GetMemoryUsage() const;
+  void LogStats() const;
+
+  /*!
+   * \brief Offset the decoder of a track has to be created with.
+   */
+  static int64_t GetDecoderStartOffset(const CFileItem& file);
+
+private:
+  struct Entry
+  {
+    std::string m_path;
+    int64_t m_startOffset = 0;
+    std::unique_ptr<CAudioDecoder> m_decoder; // nullptr while still being opened
+    size_t m_size = 0;
+  };
+
+  std::vector<Entry>::iterator Find(const std::string& path, int64_t startOffset);
+  /*!
+   * \brief Open and pre-decode a single track.
+   * \return false if the memory budget is exhausted or prefetching was cleared
+   */
+  bool PrefetchTrack(const CFileItem& file, int64_t startOffset, unsigned int generation);
+
+  mutable CCriticalSection m_critSection;
+  std::vector<Entry> m_entries;
+  unsigned int m_maxTracks = 0;
+  size_t m_memoryBudget = 0;
+  size_t m_memoryUsed = 0;
+  unsigned int m_generation = 0;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+};
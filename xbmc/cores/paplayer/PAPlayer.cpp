@@ -10,6 +10,7 @@
 
 #include "FileItem.h"
 #include "ICodec.h"
+#include "PlayListPlayer.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
@@ -22,13 +23,16 @@
 #include "messaging/ApplicationMessenger.h"
 #include "music/MusicFileItemClassify.h"
 #include "music/tags/MusicInfoTag.h"
+#include "playlists/PlayList.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SystemClock.h"
 #include "utils/JobManager.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "video/Bookmark.h"
+#include "video/VideoFileItemClassify.h"
 
 #include <memory>
 #include <mutex>
@@ -172,7 +176,7 @@ void PAPlayer::CloseAllStreams(bool fade/* = true */)
         si->m_stream.reset();
       }
 
-      si->m_decoder.Destroy();
+      si->m_decoder->Destroy();
       delete si;
     }
 
@@ -187,7 +191,7 @@ void PAPlayer::CloseAllStreams(bool fade/* = true */)
         si->m_stream.reset();
       }
 
-      si->m_decoder.Destroy();
+      si->m_decoder->Destroy();
       delete si;
     }
     m_currentStream = nullptr;
@@ -205,6 +209,10 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   m_defaultCrossfadeMS = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_MUSICPLAYER_CROSSFADE) * 1000;
   m_fullScreen = options.fullscreen;
 
+  const auto& advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  m_prefetcher.SetLimits(advancedSettings->m_audioPrefetchTracks,
+                         static_cast<size_t>(advancedSettings->m_audioPrefetchMemory) * 1024 * 1024);
+
   if (m_streams.size() > 1 || !m_defaultCrossfadeMS || m_isPaused)
   {
     CloseAllStreams(!m_isPaused);
@@ -218,6 +226,7 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   }
   CServiceBroker::GetJobManager()->Submit([=, this]() { QueueNextFileEx(file, false); }, this,
                                           CJob::PRIORITY_NORMAL);
+  PrefetchUpcoming(file, 0);
 
   std::unique_lock<CCriticalSection> lock(m_streamsLock);
   if (m_streams.size() == 2)
@@ -283,10 +292,58 @@ bool PAPlayer::QueueNextFile(const CFileItem &file)
   }
   CServiceBroker::GetJobManager()->Submit([this, file]() { QueueNextFileEx(file, true); }, this,
                                           CJob::PRIORITY_NORMAL);
+  PrefetchUpcoming(file, 1);
 
   return true;
 }
 
+void PAPlayer::PrefetchUpcoming(const CFileItem& file, int offset)
+{
+  if (!m_prefetcher.IsEnabled())
+    return;
+
+  // only decode ahead if we are playing the current playlist, called from the thread
+  // that owns the playlist player
+  const auto& playlistPlayer = CServiceBroker::GetPlaylistPlayer();
+  int index = playlistPlayer.GetNextItemIdx(offset);
+  if (index < 0)
+    return;
+
+  const PLAYLIST::CPlayList& playlist =
+      playlistPlayer.GetPlaylist(playlistPlayer.GetCurrentPlaylist());
+  if (index >= playlist.size() || playlist[index]->GetDynPath() != file.GetDynPath())
+    return;
+
+  const unsigned int tracks =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioPrefetchTracks;
+  std::vector<CFileItem> items;
+  for (unsigned int i = 1; i <= tracks; i++)
+  {
+    index = playlistPlayer.GetNextItemIdx(offset + i);
+    if (index < 0 || index >= playlist.size())
+      break;
+
+    // plugin and upnp items get resolved when they are queued, cd drives don't like
+    // to be read ahead and tracks of the same cue sheet share our stream
+    const CFileItem& item = *playlist[index];
+    if (item.IsPlugin() || URIUtils::IsUPnP(item.GetDynPath()) || !MUSIC::IsAudio(item) ||
+        VIDEO::IsVideo(item) || MUSIC::IsCDDA(item) || item.GetDynPath() == file.GetDynPath())
+      continue;
+
+    items.emplace_back(item);
+  }
+
+  if (items.empty())
+    return;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_streamsLock);
+    m_jobCounter++;
+  }
+  CServiceBroker::GetJobManager()->Submit([this, items]() { m_prefetcher.Prefetch(items); }, this,
+                                          CJob::PRIORITY_LOW);
+}
+
 bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
 {
   if (m_currentStream)
@@ -324,7 +381,10 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     starttime = 0; // No resume point
   }
 
-  if (!si->m_decoder.Create(file, si->m_startOffset))
+  std::unique_ptr<CAudioDecoder> prefetched = m_prefetcher.Take(file, si->m_startOffset);
+  if (prefetched)
+    si->m_decoder = std::move(prefetched);
+  else if (!si->m_decoder->Create(file, si->m_startOffset))
   {
     CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
 
@@ -337,17 +397,17 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   }
 
   /* decode until there is data-available */
-  si->m_decoder.Start();
-  while (si->m_decoder.GetDataSize(true) == 0)
+  si->m_decoder->Start();
+  while (si->m_decoder->GetDataSize(true) == 0)
   {
-    int status = si->m_decoder.GetStatus();
+    int status = si->m_decoder->GetStatus();
     if (status == STATUS_ENDED   ||
         status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+        si->m_decoder->ReadSamples(PACKET_SIZE) == RET_ERROR)
     {
       CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error reading samples");
 
-      si->m_decoder.Destroy();
+      si->m_decoder->Destroy();
       // advance playlist
       AdvancePlaylistOnError(*si->m_fileItem);
       m_callback.OnQueueNextItem();
@@ -363,7 +423,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   UpdateCrossfadeTime(*si->m_fileItem);
 
   /* init the streaminfo struct */
-  si->m_audioFormat = si->m_decoder.GetFormat();
+  si->m_audioFormat = si->m_decoder->GetFormat();
   // si->m_startOffset already initialized
   si->m_endOffset = file.GetEndOffset();
   si->m_bytesPerSample = CAEUtil::DataFormatToBits(si->m_audioFormat.m_dataFormat) >> 3;
@@ -378,7 +438,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   si->m_fadeOutTriggered = false;
   si->m_isSlaved = false;
 
-  si->m_decoderTotal = si->m_decoder.TotalTime();
+  si->m_decoderTotal = si->m_decoder->TotalTime();
   int64_t streamTotalTime = si->m_decoderTotal;
   if (si->m_endOffset)
     streamTotalTime = si->m_endOffset - si->m_startOffset;
@@ -413,7 +473,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     m_currentStream->m_prepareTriggered = false;
     m_currentStream->m_waitOnDrain = true;
     m_currentStream->m_prepareNextAtFrame = 0;
-    si->m_decoder.Destroy();
+    si->m_decoder->Destroy();
     delete si;
     return false;
   }
@@ -427,7 +487,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   {
     CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error preparing stream");
 
-    si->m_decoder.Destroy();
+    si->m_decoder->Destroy();
     // advance playlist
     AdvancePlaylistOnError(*si->m_fileItem);
     m_callback.OnQueueNextItem();
@@ -449,7 +509,7 @@ void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int cros
   // if no crossfading or cue sheet, wait for eof
   if (si && (crossFadingTime || si->m_endOffset))
   {
-    int64_t streamTotalTime = si->m_decoder.TotalTime();
+    int64_t streamTotalTime = si->m_decoder->TotalTime();
     if (si->m_endOffset)
       streamTotalTime = si->m_endOffset - si->m_startOffset;
     if (streamTotalTime < crossFadingTime)
@@ -480,7 +540,7 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
 
   si->m_stream->SetVolume(si->m_volume);
   float peak = 1.0;
-  float gain = si->m_decoder.GetReplayGain(peak);
+  float gain = si->m_decoder->GetReplayGain(peak);
   if (peak * gain <= 1.0f)
     // No clipping protection needed
     si->m_stream->SetReplayGain(gain);
@@ -502,10 +562,10 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
   /* fill the stream's buffer */
   while(si->m_stream->IsBuffering())
   {
-    int status = si->m_decoder.GetStatus();
+    int status = si->m_decoder->GetStatus();
     if (status == STATUS_ENDED   ||
         status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+        si->m_decoder->ReadSamples(PACKET_SIZE) == RET_ERROR)
     {
       CLog::Log(LOGINFO, "PAPlayer::PrepareStream - Stream Finished");
       break;
@@ -532,6 +592,10 @@ bool PAPlayer::CloseFile(bool reopen)
     SoftStop(true, true);
   CloseAllStreams(false);
 
+  // stop decoding ahead, pending prefetch jobs bail out
+  m_prefetcher.SetLimits(0, 0);
+  m_prefetcher.Clear();
+
   /* wait for the thread to terminate */
   StopThread(true);//true - wait for end of thread
 
@@ -545,6 +609,8 @@ bool PAPlayer::CloseFile(bool reopen)
       lock.lock();
     }
   }
+  m_prefetcher.Clear();
+  m_prefetcher.LogStats();
   CServiceBroker::GetDataCacheCore().Reset();
   return true;
 }
@@ -677,7 +743,7 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
 
       /* unregister the audio callback */
       si->m_stream->UnRegisterAudioCallback();
-      si->m_decoder.Destroy();
+      si->m_decoder->Destroy();
       si->m_stream->Drain(false);
       m_finishing.push_back(si);
       return;
@@ -780,13 +846,13 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
       SetSpeed(1);
     }
 
-    si->m_decoder.Seek(time);
+    si->m_decoder->Seek(time);
   }
 
-  int status = si->m_decoder.GetStatus();
+  int status = si->m_decoder->GetStatus();
   if (status == STATUS_ENDED   ||
       status == STATUS_NO_FILE ||
-      si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR ||
+      si->m_decoder->ReadSamples(PACKET_SIZE) == RET_ERROR ||
       ((si->m_endOffset) && (si->m_framesSent / si->m_audioFormat.m_sampleRate >= (si->m_endOffset - si->m_startOffset) / 1000)))
   {
     if (si == m_currentStream && si->m_nextFileItem)
@@ -804,7 +870,7 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
       *si->m_fileItem = *si->m_nextFileItem;
       si->m_nextFileItem.reset();
 
-      int64_t streamTotalTime = si->m_decoder.TotalTime() - si->m_startOffset;
+      int64_t streamTotalTime = si->m_decoder->TotalTime() - si->m_startOffset;
       if (si->m_endOffset)
         streamTotalTime = si->m_endOffset - si->m_startOffset;
 
@@ -866,14 +932,14 @@ bool PAPlayer::QueueData(StreamInfo *si)
 
   if (si->m_audioFormat.m_dataFormat != AE_FMT_RAW)
   {
-    unsigned int samples = std::min(si->m_decoder.GetDataSize(false), space / si->m_bytesPerSample);
+    unsigned int samples = std::min(si->m_decoder->GetDataSize(false), space / si->m_bytesPerSample);
     if (!samples)
       return true;
 
     // we want complete frames
     samples -= samples % si->m_audioFormat.m_channelLayout.Count();
 
-    uint8_t* data = (uint8_t*)si->m_decoder.GetData(samples);
+    uint8_t* data = (uint8_t*)si->m_decoder->GetData(samples);
     if (!data)
     {
       CLog::Log(LOGERROR, "PAPlayer::QueueData - Failed to get data from the decoder");
@@ -890,7 +956,7 @@ bool PAPlayer::QueueData(StreamInfo *si)
       return true;
 
     int size;
-    uint8_t *data = si->m_decoder.GetRawData(size);
+    uint8_t *data = si->m_decoder->GetRawData(size);
     if (data && size)
     {
       int added = si->m_stream->AddData(&data, 0, size, nullptr);
@@ -905,7 +971,7 @@ bool PAPlayer::QueueData(StreamInfo *si)
     }
   }
 
-  const ICodec* codec = si->m_decoder.GetCodec();
+  const ICodec* codec = si->m_decoder->GetCodec();
   m_playerGUIData.m_cacheLevel = codec ? codec->GetCacheLevel() : 0; //update for GUI
 
   return true;
@@ -996,7 +1062,7 @@ bool PAPlayer::SetTotalTimeInternal(int64_t time)
     return false;
   }
 
-  m_currentStream->m_decoder.SetTotalTime(time);
+  m_currentStream->m_decoder->SetTotalTime(time);
   UpdateGUIData(m_currentStream);
 
   return true;
@@ -1027,7 +1093,7 @@ int64_t PAPlayer::GetTotalTime64()
   if (!m_currentStream)
     return 0;
 
-  int64_t total = m_currentStream->m_decoder.TotalTime();
+  int64_t total = m_currentStream->m_decoder->TotalTime();
   if (m_currentStream->m_endOffset)
     total = m_currentStream->m_endOffset;
   total -= m_currentStream->m_startOffset;
@@ -1128,16 +1194,16 @@ void PAPlayer::UpdateGUIData(StreamInfo *si)
 
   m_playerGUIData.m_sampleRate    = si->m_audioFormat.m_sampleRate;
   m_playerGUIData.m_channelCount  = si->m_audioFormat.m_channelLayout.Count();
-  m_playerGUIData.m_canSeek       = si->m_decoder.CanSeek();
+  m_playerGUIData.m_canSeek       = si->m_decoder->CanSeek();
 
-  const ICodec* codec = si->m_decoder.GetCodec();
+  const ICodec* codec = si->m_decoder->GetCodec();
 
   m_playerGUIData.m_audioBitrate = codec ? codec->m_bitRate : 0;
   strncpy(m_playerGUIData.m_codec,codec ? codec->m_CodecName.c_str() : "",20);
   m_playerGUIData.m_cacheLevel   = codec ? codec->GetCacheLevel() : 0;
   m_playerGUIData.m_bitsPerSample = (codec && codec->m_bitsPerCodedSample) ? codec->m_bitsPerCodedSample : si->m_bytesPerSample << 3;
 
-  int64_t total = si->m_decoder.TotalTime();
+  int64_t total = si->m_decoder->TotalTime();
   if (si->m_endOffset)
     total = m_currentStream->m_endOffset;
   total -= m_currentStream->m_startOffset;
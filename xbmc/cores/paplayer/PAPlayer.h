@@ -9,6 +9,7 @@
 #pragma once
 
 #include "AudioDecoder.h"
+#include "AudioDecoderPrefetcher.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
 #include "cores/IPlayer.h"
@@ -18,6 +19,7 @@
 
 #include <atomic>
 #include <list>
+#include <memory>
 #include <vector>
 
 class IAEStream;
@@ -83,7 +85,8 @@ private:
   {
     std::unique_ptr<CFileItem> m_fileItem;
     std::unique_ptr<CFileItem> m_nextFileItem;
-    CAudioDecoder m_decoder;             /* the stream decoder */
+    std::unique_ptr<CAudioDecoder> m_decoder =
+        std::make_unique<CAudioDecoder>(); /* the stream decoder */
     int64_t m_startOffset;               /* the stream start offset */
     int64_t m_endOffset;                 /* the stream end offset */
     int64_t m_decoderTotal = 0;
@@ -132,8 +135,10 @@ private:
   int64_t m_newForcedPlayerTime = -1;
   int64_t m_newForcedTotalTime = -1;
   std::unique_ptr<CProcessInfo> m_processInfo;
+  CAudioDecoderPrefetcher m_prefetcher; /* decode-ahead of upcoming playlist tracks */
 
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn);
+  void PrefetchUpcoming(const CFileItem& file, int offset);
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
   void CloseAllStreams(bool fade = true);
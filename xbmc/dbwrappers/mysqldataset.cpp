@@ -12,11 +12,14 @@
 #include "network/DNSNameCache.h"
 #include "network/WakeOnAccess.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/log.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <string>
 #ifdef HAS_MYSQL
@@ -172,6 +175,10 @@ int MysqlDatabase::connect(bool create_new)
 
     if (conn == NULL)
     {
+      // mysql_init() initializes the library on first use, which isn't thread safe
+      static std::once_flag libraryInitialized;
+      std::call_once(libraryInitialized, []() { mysql_library_init(0, nullptr, nullptr); });
+
       conn = mysql_init(conn);
       mysql_ssl_set(conn, key.empty() ? NULL : key.c_str(), cert.empty() ? NULL : cert.c_str(),
                     ca.empty() ? NULL : ca.c_str(), capath.empty() ? NULL : capath.c_str(),
@@ -185,12 +192,11 @@ int MysqlDatabase::connect(bool create_new)
     if (mysql_real_connect(conn, host.c_str(), login.c_str(), passwd.c_str(), NULL,
                            atoi(port.c_str()), NULL, compression ? CLIENT_COMPRESS : 0) != NULL)
     {
-      static bool showed_ver_info = false;
-      if (!showed_ver_info)
+      static std::atomic<bool> showed_ver_info = false;
+      if (!showed_ver_info.exchange(true))
       {
         std::string version_string = mysql_get_server_info(conn);
         CLog::Log(LOGINFO, "MYSQL: Connected to version {}", version_string);
-        showed_ver_info = true;
         unsigned long version = mysql_get_server_version(conn);
         // Minimum for MySQL: 5.6 (5.5 is EOL)
         unsigned long min_version = 50600;
@@ -1826,6 +1832,8 @@ static size_t ci_find(const std::string& where, const std::string& what)
 
 int MysqlDataset::exec(const std::string& sql)
 {
+  KODI_TRACE_SCOPE("database", "MysqlDataset::exec");
+
   if (!handle())
     throw DbErrors("No Database Connection");
   std::string qry = sql;
@@ -1888,6 +1896,8 @@ const void* MysqlDataset::getExecRes()
 
 bool MysqlDataset::query(const std::string& query)
 {
+  KODI_TRACE_SCOPE("database", "MysqlDataset::query");
+
   if (!handle())
     throw DbErrors("No Database Connection");
   std::string qry = query;
@@ -13,6 +13,7 @@
 #include "sqlitedataset.h"
 
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
@@ -830,6 +831,8 @@ bool SqliteDataset::dropIndex(const char* table, const char* index)
 
 int SqliteDataset::exec(const std::string& sql)
 {
+  KODI_TRACE_SCOPE("database", "SqliteDataset::exec");
+
   if (!handle())
     throw DbErrors("No Database Connection");
   std::string qry = sql;
@@ -916,6 +919,8 @@ const void* SqliteDataset::getExecRes()
 
 bool SqliteDataset::query(const std::string& query)
 {
+  KODI_TRACE_SCOPE("database", "SqliteDataset::query");
+
   if (!handle())
     throw DbErrors("No Database Connection");
   const std::string& qry = query;
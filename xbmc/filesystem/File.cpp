@@ -24,6 +24,7 @@
 #include "settings/SettingsComponent.h"
 #include "utils/BitstreamStats.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
@@ -245,6 +246,8 @@ bool CFile::Open(const std::string& strFileName, const unsigned int flags)
 
 bool CFile::Open(const CURL& file, const unsigned int flags)
 {
+  KODI_TRACE_SCOPE("file", "CFile::Open");
+
   if (m_pFile)
   {
     if ((flags & READ_REOPEN) == 0)
@@ -409,6 +412,8 @@ bool CFile::OpenForWrite(const std::string& strFileName, bool bOverWrite)
 
 bool CFile::OpenForWrite(const CURL& file, bool bOverWrite)
 {
+  KODI_TRACE_SCOPE("file", "CFile::OpenForWrite");
+
   try
   {
     CURL url = URIUtils::SubstitutePath(file);
@@ -594,6 +599,8 @@ int CFile::Stat(const CURL& file, struct __stat64* buffer)
 
 ssize_t CFile::Read(void *lpBuf, size_t uiBufSize)
 {
+  KODI_TRACE_SCOPE("file", "CFile::Read");
+
   if (!m_pFile)
     return -1;
   if (lpBuf == NULL && uiBufSize != 0)
@@ -698,6 +705,8 @@ void CFile::Flush()
 //*********************************************************************************************
 int64_t CFile::Seek(int64_t iFilePosition, int iWhence)
 {
+  KODI_TRACE_SCOPE("file", "CFile::Seek");
+
   if (!m_pFile)
     return -1;
 
@@ -865,6 +874,8 @@ XFILE::CFile::ReadLineResult XFILE::CFile::ReadLine(char* buffer, std::size_t bu
 
 ssize_t CFile::Write(const void* lpBuf, size_t uiBufSize)
 {
+  KODI_TRACE_SCOPE("file", "CFile::Write");
+
   if (!m_pFile)
     return -1;
   if (lpBuf == NULL && uiBufSize != 0)
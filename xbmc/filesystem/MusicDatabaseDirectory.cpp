@@ -28,6 +28,25 @@
 using namespace XFILE;
 using namespace MUSICDATABASEDIRECTORY;
 
+namespace
+{
+void PrepareItems(const CDirectoryNode& node, CFileItemList& items)
+{
+  for (int i=0;i<items.Size();++i)
+  {
+    CFileItemPtr item = items[i];
+    if (item->m_bIsFolder && !item->HasArt("icon") && !item->HasArt("thumb"))
+    {
+      std::string strImage = CMusicDatabaseDirectory::GetIcon(item->GetPath());
+      if (!strImage.empty() && CServiceBroker::GetGUI()->GetTextureManager().HasTexture(strImage))
+        item->SetArt("icon", strImage);
+    }
+  }
+  if (items.GetLabel().empty())
+    items.SetLabel(node.GetLocalizedName());
+}
+} // unnamed namespace
+
 CMusicDatabaseDirectory::CMusicDatabaseDirectory(void) = default;
 
 CMusicDatabaseDirectory::~CMusicDatabaseDirectory(void) = default;
@@ -83,22 +102,27 @@ bool CMusicDatabaseDirectory::GetDirectory(const CURL& url, CFileItemList &items
     return false;
 
   bool bResult = pNode->GetChilds(items);
-  for (int i=0;i<items.Size();++i)
-  {
-    CFileItemPtr item = items[i];
-    if (item->m_bIsFolder && !item->HasArt("icon") && !item->HasArt("thumb"))
-    {
-      std::string strImage = GetIcon(item->GetPath());
-      if (!strImage.empty() && CServiceBroker::GetGUI()->GetTextureManager().HasTexture(strImage))
-        item->SetArt("icon", strImage);
-    }
-  }
-  if (items.GetLabel().empty())
-    items.SetLabel(pNode->GetLocalizedName());
+  PrepareItems(*pNode, items);
 
   return bResult;
 }
 
+bool CMusicDatabaseDirectory::GetDirectoryPage(const CURL& url,
+                                               const SortDescription& sorting,
+                                               CFileItemList& items)
+{
+  std::string path = CLegacyPathTranslation::TranslateMusicDbPath(url);
+  items.SetPath(path);
+  items.m_dwSize = -1;  // No size
+
+  std::unique_ptr<CDirectoryNode> pNode(CDirectoryNode::ParseURL(path));
+  if (!pNode || !pNode->GetChildsPage(sorting, items))
+    return false;
+
+  PrepareItems(*pNode, items);
+  return true;
+}
+
 NodeType CMusicDatabaseDirectory::GetDirectoryChildType(const std::string& strPath)
 {
   std::string path = CLegacyPathTranslation::TranslateMusicDbPath(strPath);
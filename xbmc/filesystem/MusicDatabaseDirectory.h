@@ -10,6 +10,8 @@
 
 #include "IDirectory.h"
 
+struct SortDescription;
+
 namespace XFILE
 {
 
@@ -25,6 +27,20 @@ class CQueryParams;
     CMusicDatabaseDirectory(void);
     ~CMusicDatabaseDirectory(void) override;
     bool GetDirectory(const CURL& url, CFileItemList &items) override;
+
+    /*!
+     \brief Get one page of the items of a library node, sorted and limited by the database
+     instead of retrieving all items of the node.
+     \param url the library node, e.g. musicdb://songs/
+     \param sorting sort method and order, and the range of items (limitStart, limitEnd) to get
+     \param items the items of the page. Their "total" property holds the number of items of the
+     whole node.
+     \return false if the items of the node can't be paged or on error
+     */
+    static bool GetDirectoryPage(const CURL& url,
+                                 const SortDescription& sorting,
+                                 CFileItemList& items);
+
     bool AllowAll() const override { return true; }
     bool Exists(const CURL& url) override;
     static MUSICDATABASEDIRECTORY::NodeType GetDirectoryChildType(const std::string& strPath);
@@ -11,6 +11,7 @@
 #include "utils/UrlOptions.h"
 
 class CFileItemList;
+struct SortDescription;
 
 namespace XFILE
 {
@@ -62,6 +63,15 @@ namespace XFILE
       NodeType GetType() const;
 
       bool GetChilds(CFileItemList& items);
+
+      /*!
+       \brief Get one page of the child items, sorted and limited by the database.
+       \param sorting sort method and order, and the range of child items to get
+       \param items the page of child items
+       \return false if the child items can't be paged or on error
+       */
+      bool GetChildsPage(const SortDescription& sorting, CFileItemList& items);
+
       virtual NodeType GetChildType() const;
       virtual std::string GetLocalizedName() const;
 
@@ -84,6 +94,7 @@ namespace XFILE
       void RemoveParent();
 
       virtual bool GetContent(CFileItemList& items) const;
+      virtual bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const;
 
     private:
       NodeType m_Type;
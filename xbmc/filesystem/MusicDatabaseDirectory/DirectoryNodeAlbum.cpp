@@ -11,6 +11,7 @@
 #include "QueryParams.h"
 #include "guilib/LocalizeStrings.h"
 #include "music/MusicDatabase.h"
+#include "utils/SortUtils.h"
 
 using namespace XFILE::MUSICDATABASEDIRECTORY;
 
@@ -36,6 +37,11 @@ std::string CDirectoryNodeAlbum::GetLocalizedName() const
 }
 
 bool CDirectoryNodeAlbum::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeAlbum::GetContentPage(const SortDescription& sorting, CFileItemList& items) const
 {
   CMusicDatabase musicdatabase;
   if (!musicdatabase.Open())
@@ -44,7 +50,8 @@ bool CDirectoryNodeAlbum::GetContent(CFileItemList& items) const
   CQueryParams params;
   CollectQueryParams(params);
 
-  bool bSuccess=musicdatabase.GetAlbumsNav(BuildPath(), items, params.GetGenreId(), params.GetArtistId());
+  bool bSuccess = musicdatabase.GetAlbumsNav(BuildPath(), items, params.GetGenreId(),
+                                             params.GetArtistId(), CDatabase::Filter(), sorting);
 
   musicdatabase.Close();
 
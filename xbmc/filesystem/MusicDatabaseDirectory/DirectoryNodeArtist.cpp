@@ -15,6 +15,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/SortUtils.h"
 
 using namespace XFILE::MUSICDATABASEDIRECTORY;
 
@@ -45,6 +46,12 @@ std::string CDirectoryNodeArtist::GetLocalizedName() const
 }
 
 bool CDirectoryNodeArtist::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeArtist::GetContentPage(const SortDescription& sorting,
+                                          CFileItemList& items) const
 {
   CMusicDatabase musicdatabase;
   if (!musicdatabase.Open())
@@ -53,7 +60,11 @@ bool CDirectoryNodeArtist::GetContent(CFileItemList& items) const
   CQueryParams params;
   CollectQueryParams(params);
 
-  bool bSuccess = musicdatabase.GetArtistsNav(BuildPath(), items, !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MUSICLIBRARY_SHOWCOMPILATIONARTISTS), params.GetGenreId());
+  bool bSuccess = musicdatabase.GetArtistsNav(
+      BuildPath(), items,
+      !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+          CSettings::SETTING_MUSICLIBRARY_SHOWCOMPILATIONARTISTS),
+      params.GetGenreId(), -1, -1, CDatabase::Filter(), sorting);
 
   musicdatabase.Close();
 
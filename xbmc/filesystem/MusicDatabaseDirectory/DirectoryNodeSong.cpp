@@ -10,6 +10,7 @@
 
 #include "QueryParams.h"
 #include "music/MusicDatabase.h"
+#include "utils/SortUtils.h"
 
 using namespace XFILE::MUSICDATABASEDIRECTORY;
 
@@ -20,6 +21,11 @@ CDirectoryNodeSong::CDirectoryNodeSong(const std::string& strName, CDirectoryNod
 }
 
 bool CDirectoryNodeSong::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeSong::GetContentPage(const SortDescription& sorting, CFileItemList& items) const
 {
   CMusicDatabase musicdatabase;
   if (!musicdatabase.Open())
@@ -29,7 +35,7 @@ bool CDirectoryNodeSong::GetContent(CFileItemList& items) const
   CollectQueryParams(params);
 
   std::string strBaseDir=BuildPath();
-  bool bSuccess=musicdatabase.GetSongsNav(strBaseDir, items, params.GetGenreId(), params.GetArtistId(), params.GetAlbumId());
+  bool bSuccess=musicdatabase.GetSongsNav(strBaseDir, items, params.GetGenreId(), params.GetArtistId(), params.GetAlbumId(), sorting);
 
   musicdatabase.Close();
 
@@ -18,6 +18,7 @@
 #include "music/MusicDbUrl.h"
 #include "playlists/PlayListTypes.h"
 #include "playlists/SmartPlayList.h"
+#include "playlists/SmartPlaylistResultCache.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/SortUtils.h"
@@ -27,6 +28,7 @@
 #include "video/VideoDbUrl.h"
 
 #include <memory>
+#include <set>
 
 #define PROPERTY_PATH_DB            "path.db"
 #define PROPERTY_SORT_ORDER         "sort.order"
@@ -36,6 +38,34 @@
 
 using namespace KODI;
 
+namespace
+{
+/*!
+ * @brief Get the items of a smart playlist from the database, using the cached result if possible.
+ */
+template<class TDatabase>
+bool GetPlaylistItems(TDatabase& db,
+                      const PLAYLIST::CSmartPlaylist& playlist,
+                      const std::string& baseDir,
+                      const MediaType& itemType,
+                      CFileItemList& items,
+                      const SortDescription& sorting)
+{
+  const auto fetcher = [&db](const std::string& baseDir, CFileItemList& items,
+                             const CDatabase::Filter& filter, const SortDescription& sorting)
+  { return db.GetItems(baseDir, items, filter, sorting); };
+
+  // results of playlists referencing other playlists also depend on the referenced files
+  std::set<std::string> referencedPlaylists;
+  playlist.GetWhereClause(db, referencedPlaylists);
+  if (!referencedPlaylists.empty())
+    return fetcher(baseDir, items, CDatabase::Filter(), sorting);
+
+  return CServiceBroker::GetSmartPlaylistResultCache().GetItems(baseDir, itemType, sorting, items,
+                                                                fetcher);
+}
+} // unnamed namespace
+
 namespace XFILE
 {
   CSmartPlaylistDirectory::CSmartPlaylistDirectory() = default;
@@ -146,8 +176,8 @@ namespace XFILE
         else
           videoUrl.RemoveOption(option);
 
-        CDatabase::Filter dbfilter;
-        success = db.GetItems(videoUrl.ToString(), items, dbfilter, sorting);
+        success = GetPlaylistItems(db, playlist, videoUrl.ToString(),
+                                   CMediaTypes::FromString(videoUrl.GetItemType()), items, sorting);
         db.Close();
 
         // if we retrieve a list of episodes and we didn't receive
@@ -207,8 +237,8 @@ namespace XFILE
         else
           musicUrl.RemoveOption(option);
 
-        CDatabase::Filter dbfilter;
-        success = db.GetItems(musicUrl.ToString(), items, dbfilter, sorting);
+        success = GetPlaylistItems(db, plist, musicUrl.ToString(),
+                                   CMediaTypes::FromString(musicUrl.GetType()), items, sorting);
         db.Close();
 
         items.SetProperty(PROPERTY_PATH_DB, musicUrl.ToString());
@@ -264,8 +294,9 @@ namespace XFILE
           videoUrl.RemoveOption(option);
 
         CFileItemList items2;
-        CDatabase::Filter dbfilter;
-        success2 = db.GetItems(videoUrl.ToString(), items2, dbfilter, sorting);
+        success2 = GetPlaylistItems(db, mvidPlaylist, videoUrl.ToString(),
+                                    CMediaTypes::FromString(videoUrl.GetItemType()), items2,
+                                    sorting);
 
         db.Close();
         if (items.Size() <= 0)
@@ -85,25 +85,14 @@ std::string GetChildContentType(const std::unique_ptr<CDirectoryNode>& node)
   return {};
 }
 
-} // unnamed namespace
-
-bool CVideoDatabaseDirectory::GetDirectory(const CURL& url, CFileItemList &items)
+void PrepareItems(const std::unique_ptr<CDirectoryNode>& node, CFileItemList& items)
 {
-  std::string path = CLegacyPathTranslation::TranslateVideoDbPath(url);
-  items.SetPath(path);
-  items.m_dwSize = -1;  // No size
-  std::unique_ptr<CDirectoryNode> pNode(CDirectoryNode::ParseURL(path));
-
-  if (!pNode)
-    return false;
-
-  bool bResult = pNode->GetChilds(items);
   for (int i=0;i<items.Size();++i)
   {
     CFileItemPtr item = items[i];
     if (item->m_bIsFolder && !item->HasArt("icon") && !item->HasArt("thumb"))
     {
-      std::string strImage = GetIcon(item->GetPath());
+      std::string strImage = CVideoDatabaseDirectory::GetIcon(item->GetPath());
       if (!strImage.empty() && CServiceBroker::GetGUI()->GetTextureManager().HasTexture(strImage))
         item->SetArt("icon", strImage);
     }
@@ -115,13 +104,45 @@ bool CVideoDatabaseDirectory::GetDirectory(const CURL& url, CFileItemList &items
   if (items.HasProperty("customtitle"))
     items.SetLabel(items.GetProperty("customtitle").asString());
   else
-    items.SetLabel(pNode->GetLocalizedName());
+    items.SetLabel(node->GetLocalizedName());
+
+  items.SetContent(GetChildContentType(node));
+}
+
+} // unnamed namespace
+
+bool CVideoDatabaseDirectory::GetDirectory(const CURL& url, CFileItemList &items)
+{
+  std::string path = CLegacyPathTranslation::TranslateVideoDbPath(url);
+  items.SetPath(path);
+  items.m_dwSize = -1;  // No size
+  std::unique_ptr<CDirectoryNode> pNode(CDirectoryNode::ParseURL(path));
+
+  if (!pNode)
+    return false;
 
-  items.SetContent(GetChildContentType(pNode));
+  bool bResult = pNode->GetChilds(items);
+  PrepareItems(pNode, items);
 
   return bResult;
 }
 
+bool CVideoDatabaseDirectory::GetDirectoryPage(const CURL& url,
+                                               const SortDescription& sorting,
+                                               CFileItemList& items)
+{
+  std::string path = CLegacyPathTranslation::TranslateVideoDbPath(url);
+  items.SetPath(path);
+  items.m_dwSize = -1;  // No size
+
+  std::unique_ptr<CDirectoryNode> pNode(CDirectoryNode::ParseURL(path));
+  if (!pNode || !pNode->GetChildsPage(sorting, items))
+    return false;
+
+  PrepareItems(pNode, items);
+  return true;
+}
+
 NodeType CVideoDatabaseDirectory::GetDirectoryChildType(const std::string& strPath)
 {
   std::string path = CLegacyPathTranslation::TranslateVideoDbPath(strPath);
@@ -181,6 +181,12 @@ bool CDirectoryNode::GetContent(CFileItemList& items) const
   return false;
 }
 
+//  Should be overloaded by a derived class whose items can be sorted and limited by the database.
+bool CDirectoryNode::GetContentPage(const SortDescription& sorting, CFileItemList& items) const
+{
+  return false;
+}
+
 //  Creates a videodb url
 std::string CDirectoryNode::BuildPath() const
 {
@@ -267,6 +273,25 @@ bool CDirectoryNode::GetChilds(CFileItemList& items)
   return bSuccess;
 }
 
+//  Get one page of the child fileitems of this node, sorted and limited by the database
+bool CDirectoryNode::GetChildsPage(const SortDescription& sorting, CFileItemList& items)
+{
+  std::unique_ptr<CDirectoryNode> pNode(CDirectoryNode::CreateNode(GetChildType(), "", this));
+
+  bool bSuccess = false;
+  if (pNode)
+  {
+    pNode->m_options = m_options;
+    bSuccess = pNode->GetContentPage(sorting, items);
+    if (!bSuccess)
+      items.Clear();
+
+    pNode->RemoveParent();
+  }
+
+  return bSuccess;
+}
+
 bool CDirectoryNode::CanCache() const
 {
   // no caching is required - the list is cached in CGUIMediaWindow::GetDirectory
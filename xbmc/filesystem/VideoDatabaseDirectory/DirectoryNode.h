@@ -13,6 +13,7 @@
 #include <string>
 
 class CFileItemList;
+struct SortDescription;
 
 namespace XFILE
 {
@@ -65,6 +66,15 @@ namespace XFILE
       NodeType GetType() const;
 
       bool GetChilds(CFileItemList& items);
+
+      /*!
+       \brief Get one page of the child items, sorted and limited by the database.
+       \param sorting sort method and order, and the range of child items to get
+       \param items the page of child items
+       \return false if the child items can't be paged or on error
+       */
+      bool GetChildsPage(const SortDescription& sorting, CFileItemList& items);
+
       virtual NodeType GetChildType() const;
       virtual std::string GetLocalizedName() const;
       void CollectQueryParams(CQueryParams& params) const;
@@ -88,6 +98,7 @@ namespace XFILE
       void RemoveParent();
 
       virtual bool GetContent(CFileItemList& items) const;
+      virtual bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const;
 
 
     private:
@@ -22,6 +22,12 @@ CDirectoryNodeEpisodes::CDirectoryNodeEpisodes(const std::string& strName, CDire
 }
 
 bool CDirectoryNodeEpisodes::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeEpisodes::GetContentPage(const SortDescription& sorting,
+                                            CFileItemList& items) const
 {
   CVideoDatabase videodatabase;
   if (!videodatabase.Open())
@@ -40,7 +46,7 @@ bool CDirectoryNodeEpisodes::GetContent(CFileItemList& items) const
 
   bool bSuccess = videodatabase.GetEpisodesNav(
       BuildPath(), items, params.GetGenreId(), params.GetYear(), params.GetActorId(),
-      params.GetDirectorId(), params.GetTvShowId(), season, SortDescription(), details);
+      params.GetDirectorId(), params.GetTvShowId(), season, sorting, details);
 
   videodatabase.Close();
 
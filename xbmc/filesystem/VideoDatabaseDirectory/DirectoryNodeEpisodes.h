@@ -21,6 +21,7 @@ namespace XFILE
 
     protected:
       bool GetContent(CFileItemList& items) const override;
+      bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const override;
       NodeType GetChildType() const override;
     };
   }
@@ -23,6 +23,12 @@ CDirectoryNodeTitleMovies::CDirectoryNodeTitleMovies(const std::string& strName,
 }
 
 bool CDirectoryNodeTitleMovies::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeTitleMovies::GetContentPage(const SortDescription& sorting,
+                                               CFileItemList& items) const
 {
   CVideoDatabase videodatabase;
   if (!videodatabase.Open())
@@ -38,7 +44,7 @@ bool CDirectoryNodeTitleMovies::GetContent(CFileItemList& items) const
   bool bSuccess = videodatabase.GetMoviesNav(
       BuildPath(), items, params.GetGenreId(), params.GetYear(), params.GetActorId(),
       params.GetDirectorId(), params.GetStudioId(), params.GetCountryId(), params.GetSetId(),
-      params.GetTagId(), SortDescription(), details);
+      params.GetTagId(), sorting, details);
 
   videodatabase.Close();
 
@@ -20,6 +20,7 @@ namespace XFILE
       CDirectoryNodeTitleMovies(const std::string& strEntryName, CDirectoryNode* pParent);
     protected:
       bool GetContent(CFileItemList& items) const override;
+      bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const override;
     };
   }
 }
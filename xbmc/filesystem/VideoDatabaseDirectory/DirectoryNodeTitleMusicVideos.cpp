@@ -23,6 +23,12 @@ CDirectoryNodeTitleMusicVideos::CDirectoryNodeTitleMusicVideos(const std::string
 }
 
 bool CDirectoryNodeTitleMusicVideos::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeTitleMusicVideos::GetContentPage(const SortDescription& sorting,
+                                                    CFileItemList& items) const
 {
   CVideoDatabase videodatabase;
   if (!videodatabase.Open())
@@ -37,7 +43,7 @@ bool CDirectoryNodeTitleMusicVideos::GetContent(CFileItemList& items) const
   bool bSuccess = videodatabase.GetMusicVideosNav(
       BuildPath(), items, params.GetGenreId(), params.GetYear(), params.GetActorId(),
       params.GetDirectorId(), params.GetStudioId(), params.GetAlbumId(), params.GetTagId(),
-      SortDescription(), details);
+      sorting, details);
 
   videodatabase.Close();
 
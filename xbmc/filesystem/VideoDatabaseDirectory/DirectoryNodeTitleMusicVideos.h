@@ -20,6 +20,7 @@ namespace XFILE
       CDirectoryNodeTitleMusicVideos(const std::string& strEntryName, CDirectoryNode* pParent);
     protected:
       bool GetContent(CFileItemList& item) const override;
+      bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const override;
     };
   }
 }
@@ -36,6 +36,12 @@ std::string CDirectoryNodeTitleTvShows::GetLocalizedName() const
 }
 
 bool CDirectoryNodeTitleTvShows::GetContent(CFileItemList& items) const
+{
+  return GetContentPage(SortDescription(), items);
+}
+
+bool CDirectoryNodeTitleTvShows::GetContentPage(const SortDescription& sorting,
+                                                CFileItemList& items) const
 {
   CVideoDatabase videodatabase;
   if (!videodatabase.Open())
@@ -50,7 +56,7 @@ bool CDirectoryNodeTitleTvShows::GetContent(CFileItemList& items) const
 
   bool bSuccess = videodatabase.GetTvShowsNav(
       BuildPath(), items, params.GetGenreId(), params.GetYear(), params.GetActorId(),
-      params.GetDirectorId(), params.GetStudioId(), params.GetTagId(), SortDescription(), details);
+      params.GetDirectorId(), params.GetStudioId(), params.GetTagId(), sorting, details);
 
   videodatabase.Close();
 
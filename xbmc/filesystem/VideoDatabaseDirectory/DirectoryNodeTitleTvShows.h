@@ -22,6 +22,7 @@ namespace XFILE
     protected:
       NodeType GetChildType() const override;
       bool GetContent(CFileItemList& items) const override;
+      bool GetContentPage(const SortDescription& sorting, CFileItemList& items) const override;
       std::string GetLocalizedName() const override;
     };
   }
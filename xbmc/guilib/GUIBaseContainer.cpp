@@ -10,7 +10,9 @@
 
 #include "FileItem.h"
 #include "FileItemList.h"
+#include "GUIComponent.h"
 #include "GUIInfoManager.h"
+#include "GUILargeTextureManager.h"
 #include "GUIListItemLayout.h"
 #include "GUIMessage.h"
 #include "ServiceBroker.h"
@@ -28,9 +30,11 @@
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/TimeUtils.h"
+#include "utils/Variant.h"
 #include "utils/XBMCTinyXML.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace KODI;
@@ -199,6 +203,8 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   // to have same behaviour when scrolling down, we need to set page control to offset+1
   UpdatePageControl(offset + (m_scroller.IsScrollingDown() ? 1 : 0));
 
+  RequestMoreItems(offset + m_itemsPerPage + cacheAfter);
+
   m_lastRenderTime = currentTime;
 
   CGUIControl::Process(currentTime, dirtyregions);
@@ -213,6 +219,12 @@ void CGUIBaseContainer::ProcessItem(float posX,
 {
   if (!m_focusedLayout || !m_layout) return;
 
+  // load the images of items on screen first, also within items of other containers
+  CGUILargeTextureManager& largeTextureManager =
+      CServiceBroker::GetGUI()->GetLargeTextureManager();
+  const unsigned int priority = largeTextureManager.GetRequestPriority();
+  largeTextureManager.SetRequestPriority(std::max(priority, GetLoadPriority(posX, posY)));
+
   // set the origin
   CServiceBroker::GetWinSystem()->GetGfxContext().SetOrigin(posX, posY);
 
@@ -258,6 +270,25 @@ void CGUIBaseContainer::ProcessItem(float posX,
   }
 
   CServiceBroker::GetWinSystem()->GetGfxContext().RestoreOrigin();
+  largeTextureManager.SetRequestPriority(priority);
+}
+
+unsigned int CGUIBaseContainer::GetLoadPriority(float posX, float posY) const
+{
+  const float size = m_layout->Size(m_orientation);
+  const float pos = (m_orientation == VERTICAL) ? posY : posX;
+  const float start =
+      (m_orientation == VERTICAL) ? m_posY + m_renderOffset.y : m_posX + m_renderOffset.x;
+  const float end = start + ((m_orientation == VERTICAL) ? m_height : m_width);
+  if (size <= 0 || (pos + size > start && pos < end))
+    return CGUILargeTextureManager::PRIORITY_VISIBLE;
+
+  // distance from the viewport in items, items scrolled past are loaded after the ones ahead
+  const bool before = pos + size <= start;
+  const unsigned int distance =
+      1 + static_cast<unsigned int>((before ? start - pos - size : pos - end) / size);
+  const bool behind = before ? m_scroller.IsScrollingDown() : m_scroller.IsScrollingUp();
+  return behind ? distance + m_cacheItems + 1 : distance;
 }
 
 void CGUIBaseContainer::Render()
@@ -506,11 +537,24 @@ bool CGUIBaseContainer::OnMessage(CGUIMessage& message)
         CFileItemList *items = static_cast<CFileItemList*>(message.GetPointer());
         for (int i = 0; i < items->Size(); i++)
           m_items.push_back(items->Get(i));
+        m_moreItems = items->GetProperty("moreitems").asBoolean();
         UpdateLayout(true); // true to refresh all items
         UpdateScrollByLetter();
         SelectItem(message.GetParam1());
         return true;
       }
+      else if (message.GetMessage() == GUI_MSG_LABEL_APPEND && message.GetPointer())
+      { // add the items we don't have yet, the offset and the selected item stay as they are
+        CFileItemList* items = static_cast<CFileItemList*>(message.GetPointer());
+        for (int i = static_cast<int>(m_items.size()); i < items->Size(); i++)
+          m_items.push_back(items->Get(i));
+        m_moreItems = items->GetProperty("moreitems").asBoolean();
+        m_moreItemsRequested = false;
+        SetPageControlRange();
+        UpdateScrollByLetter();
+        MarkDirtyRegion();
+        return true;
+      }
       else if (message.GetMessage() == GUI_MSG_LABEL_RESET)
       {
         Reset();
@@ -1311,9 +1355,28 @@ void CGUIBaseContainer::Reset()
   m_wasReset = true;
   m_items.clear();
   m_lastItem.reset();
+  m_moreItems = false;
+  m_moreItemsRequested = false;
   ResetAutoScrolling();
 }
 
+/*!
+ \brief Ask the window for the next items of a partially loaded list.
+ Sent once the given row is within a page of the end of the list, the window answers with
+ GUI_MSG_LABEL_APPEND.
+ \param offset the last row that is or is about to be shown
+ */
+void CGUIBaseContainer::RequestMoreItems(int offset)
+{
+  if (!m_moreItems || m_moreItemsRequested || offset + m_itemsPerPage < static_cast<int>(GetRows()))
+    return;
+
+  m_moreItemsRequested = true;
+  CGUIMessage msg(GUI_MSG_LOAD_MORE_ITEMS, GetID(), GetParentID(),
+                  static_cast<int>(m_items.size()));
+  SendWindowMessage(msg);
+}
+
 void CGUIBaseContainer::LoadLayout(TiXmlElement *layout)
 {
   TiXmlElement *itemElement = layout->FirstChildElement("itemlayout");
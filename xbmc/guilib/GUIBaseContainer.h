@@ -131,6 +131,7 @@ protected:
   void OnFocus() override;
   void OnUnFocus() override;
   void UpdateListProvider(bool forceRefresh = false);
+  void RequestMoreItems(int offset);
 
   int ScrollCorrectionRange() const;
   inline float Size() const;
@@ -168,6 +169,9 @@ protected:
 
   std::unique_ptr<IListProvider> m_listProvider;
 
+  bool m_moreItems = false; ///< \brief the bound list is partially loaded \sa RequestMoreItems
+  bool m_moreItemsRequested = false;
+
   bool m_wasReset;  // true if we've received a Reset message until we've rendered once.  Allows
                     // us to make sure we don't tell the infomanager that we've been moving when
                     // the "movement" was simply due to the list being repopulated (thus cursor position
@@ -175,6 +179,14 @@ protected:
 
   void UpdateScrollByLetter();
   void GetCacheOffsets(int &cacheBefore, int &cacheAfter) const;
+  /*!
+   \brief Get the priority for loading the images of an item.
+   \param posX horizontal position of the item
+   \param posY vertical position of the item
+   \return the distance of the item from the viewport, 0 if it's on screen
+   \sa CGUILargeTextureManager::SetRequestPriority
+   */
+  unsigned int GetLoadPriority(float posX, float posY) const;
   int GetCacheCount() const { return m_cacheItems; }
   bool ScrollingDown() const { return m_scroller.IsScrollingDown(); }
   bool ScrollingUp() const { return m_scroller.IsScrollingUp(); }
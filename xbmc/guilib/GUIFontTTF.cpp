@@ -21,6 +21,8 @@
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
+#include <array>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -60,6 +62,22 @@ constexpr int GLYPH_STRENGTH_BOLD = 24;
 constexpr int GLYPH_STRENGTH_LIGHT = -48;
 constexpr int TAB_SPACE_LENGTH = 4;
 
+CRect GetBounds(const std::vector<SVertex>& vertices)
+{
+  if (vertices.empty())
+    return {};
+
+  CRect bounds(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+  for (const auto& vertex : vertices)
+  {
+    bounds.x1 = std::min(bounds.x1, vertex.x);
+    bounds.y1 = std::min(bounds.y1, vertex.y);
+    bounds.x2 = std::max(bounds.x2, vertex.x);
+    bounds.y2 = std::max(bounds.y2, vertex.y);
+  }
+  return bounds;
+}
+
 // \brief Check for conflicting alignments
 void ValidateAlignments(uint32_t& aligns)
 {
@@ -709,6 +727,7 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
           m_dynamicCache.Lookup(context, dynamicPos, colors, text, rawAlignment, maxPixelWidth,
                                 scrolling, std::chrono::steady_clock::now(), dirtyCache);
       CVertexBuffer newVertexBuffer = CreateVertexBuffer(*tempVertices);
+      newVertexBuffer.bounds = GetBounds(*tempVertices);
       vertexBuffer = newVertexBuffer;
 #if not defined(HAS_DX)
       m_vertexTrans.emplace_back(x, y, 0.0f, &vertexBuffer, context.GetClipRegion(), dx, dy);
@@ -742,6 +761,35 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
   End();
 }
 
+bool CGUIFontTTF::GetTranslatedBounds(const CGraphicContext& context,
+                                      const CTranslatedVertices& vertices,
+                                      float fractX,
+                                      float fractY,
+                                      CRect& bounds) const
+{
+  // gui * scroll * translation * scaling * correction factor, as drawn by LastEnd()
+  const CRect& raw = vertices.m_vertexBuffer->bounds;
+  const TransformMatrix& matrix = context.GetGUIMatrix();
+  std::array<float, 4> x{raw.x1, raw.x2, raw.x2, raw.x1};
+  std::array<float, 4> y{raw.y1, raw.y1, raw.y2, raw.y2};
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    const float scaledX = vertices.m_offsetX + vertices.m_translateX +
+                          (x[i] + fractX) * context.GetGUIScaleX();
+    const float scaledY = vertices.m_offsetY + vertices.m_translateY +
+                          (y[i] + fractY) * context.GetGUIScaleY();
+    if (matrix.TransformZCoord(scaledX, scaledY, 0.0f) != 0.0f)
+      return false;
+
+    x[i] = matrix.TransformXCoord(scaledX, scaledY, 0.0f);
+    y[i] = matrix.TransformYCoord(scaledX, scaledY, 0.0f);
+  }
+
+  const auto [x1, x2] = std::minmax_element(x.begin(), x.end());
+  const auto [y1, y2] = std::minmax_element(y.begin(), y.end());
+  bounds = CRect(*x1, *y1, *x2, *y2);
+  return true;
+}
 
 float CGUIFontTTF::GetTextWidthInternal(const vecText& text)
 {
@@ -264,6 +264,18 @@ protected:
   std::vector<CTranslatedVertices> m_vertexTrans;
   std::vector<SVertex> m_vertex;
 
+  /*!
+   * \brief Get the bounds of translated vertices in the coordinates of the GUI textures, i.e. with
+   * the GUI matrix applied.
+   * \param fractX, fractY the correction to whole pixels, applied before scaling
+   * \return false if the vertices have a depth then, e.g. from a 3D transform
+   */
+  bool GetTranslatedBounds(const CGraphicContext& context,
+                           const CTranslatedVertices& vertices,
+                           float fractX,
+                           float fractY,
+                           CRect& bounds) const;
+
   float m_textureScaleX{0.0f};
   float m_textureScaleY{0.0f};
 
@@ -22,8 +22,10 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <array>
 #include <cassert>
 #include <memory>
+#include <vector>
 
 // stuff for freetype
 #include <ft2build.h>
@@ -34,6 +36,114 @@
 namespace
 {
 constexpr size_t ELEMENT_ARRAY_MAX_CHAR_INDEX = 1000;
+
+// the vertices of a call to DrawText, translated to their position on screen
+struct TranslatedDraw
+{
+  GLuint vertexBuffer;
+  size_t characters;
+  CRect scissor;
+  std::array<GLfloat, 4> clip;
+  CMatrixGL matrix;
+  GLfloat depth;
+};
+
+// the text drawn between FirstBegin() and LastEnd(), queued with the GUI textures
+struct TextDraw
+{
+  ShaderMethodGLES shader;
+  GLuint texture;
+  GLuint elementArray;
+  std::array<GLfloat, 4> textureSteps;
+  std::vector<TranslatedDraw> translated;
+};
+
+void DrawTranslated(const TextDraw& text)
+{
+  CRenderSystemGLES* renderSystem =
+      dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+
+  renderSystem->EnableGUIShader(text.shader);
+
+  // Turn Blending On
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+  glEnable(GL_BLEND);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, text.texture);
+
+  GLint posLoc = renderSystem->GUIShaderGetPos();
+  GLint colLoc = renderSystem->GUIShaderGetCol();
+  GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
+  GLint clipUniformLoc = renderSystem->GUIShaderGetClip();
+  GLint coordStepUniformLoc = renderSystem->GUIShaderGetCoordStep();
+  GLint matrixUniformLoc = renderSystem->GUIShaderGetMatrix();
+  GLint depthLoc = renderSystem->GUIShaderGetDepth();
+
+  // Enable the attributes used by this shader
+  glEnableVertexAttribArray(posLoc);
+  glEnableVertexAttribArray(colLoc);
+  glEnableVertexAttribArray(tex0Loc);
+
+  // Bind our pre-calculated array to GL_ELEMENT_ARRAY_BUFFER
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, text.elementArray);
+
+  for (const auto& translated : text.translated)
+  {
+    if (text.shader == ShaderMethodGLES::SM_FONTS)
+    {
+      // clip using scissors
+      renderSystem->SetScissors(translated.scissor);
+    }
+    else
+    {
+      // clip using vertex shader
+      renderSystem->ResetScissors();
+      glUniform4fv(clipUniformLoc, 1, translated.clip.data());
+      glUniform4fv(coordStepUniformLoc, 1, text.textureSteps.data());
+    }
+
+    glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, translated.matrix);
+    glUniform1f(depthLoc, translated.depth);
+
+    // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
+    glBindBuffer(GL_ARRAY_BUFFER, translated.vertexBuffer);
+
+    // Do the actual drawing operation, split into groups of characters no
+    // larger than the pre-determined size of the element array
+    for (size_t character = 0; translated.characters > character;
+         character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
+    {
+      size_t count = translated.characters - character;
+      count = std::min<size_t>(count, ELEMENT_ARRAY_MAX_CHAR_INDEX);
+
+      // Set up the offsets of the various vertex attributes within the buffer
+      // object bound to GL_ARRAY_BUFFER
+      glVertexAttribPointer(
+          posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+          reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, x)));
+      glVertexAttribPointer(
+          colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
+          reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, r)));
+      glVertexAttribPointer(
+          tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+          reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
+
+      glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+      renderSystem->AddDrawCalls(1, count);
+    }
+  }
+
+  // Unbind GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  // Disable the attributes used by this shader
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(colLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  renderSystem->DisableGUIShader();
+}
 } /* namespace */
 
 CGUIFontTTF* CGUIFontTTF::CreateGUIFontTTF(const std::string& fontIdent)
@@ -145,147 +255,99 @@ void CGUIFontTTFGLES::LastEnd()
   CRenderSystemGLES* renderSystem =
       dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
 
-  GLint posLoc = renderSystem->GUIShaderGetPos();
-  GLint colLoc = renderSystem->GUIShaderGetCol();
-  GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
-  GLint clipUniformLoc = renderSystem->GUIShaderGetClip();
-  GLint coordStepUniformLoc = renderSystem->GUIShaderGetCoordStep();
-  GLint matrixUniformLoc = renderSystem->GUIShaderGetMatrix();
-  GLint depthLoc = renderSystem->GUIShaderGetDepth();
-
   CreateStaticVertexBuffers();
 
-  // Enable the attributes used by this shader
-  glEnableVertexAttribArray(posLoc);
-  glEnableVertexAttribArray(colLoc);
-  glEnableVertexAttribArray(tex0Loc);
-
-  if (!m_vertexTrans.empty())
+  auto text = std::make_shared<TextDraw>();
+  text->shader =
+      m_scissorClip ? ShaderMethodGLES::SM_FONTS : ShaderMethodGLES::SM_FONTS_SHADER_CLIP;
+  text->texture = m_nTexture;
+  text->elementArray = m_elementArrayHandle;
+  text->textureSteps = {1.f / static_cast<float>(m_textureWidth),
+                        1.f / static_cast<float>(m_textureHeight), 1.f, 1.f};
+
+  // Store current scissor
+  CGraphicContext& context = winSystem->GetGfxContext();
+  CRect scissor = context.StereoCorrection(context.GetScissors());
+
+  CRect bounds;
+  bool flat = true;
+  for (const auto& vertices : m_vertexTrans)
   {
-    // Deal with the vertices that can be hardware clipped and therefore translated
-
-    // Bind our pre-calculated array to GL_ELEMENT_ARRAY_BUFFER
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
-    // Store current scissor
-    CGraphicContext& context = winSystem->GetGfxContext();
-    CRect scissor = context.StereoCorrection(context.GetScissors());
+    if (vertices.m_vertexBuffer->bufferHandle == 0)
+    {
+      continue;
+    }
 
-    for (size_t i = 0; i < m_vertexTrans.size(); i++)
+    // Apply the clip rectangle
+    CRect clip = renderSystem->ClipRectToScissorRect(vertices.m_clip);
+    if (!clip.IsEmpty())
     {
-      if (m_vertexTrans[i].m_vertexBuffer->bufferHandle == 0)
-      {
+      // intersect with current scissor
+      clip.Intersect(scissor);
+      // skip empty clip
+      if (clip.IsEmpty())
         continue;
-      }
-
-      // Apply the clip rectangle
-      CRect clip = renderSystem->ClipRectToScissorRect(m_vertexTrans[i].m_clip);
-      if (!clip.IsEmpty())
-      {
-        // intersect with current scissor
-        clip.Intersect(scissor);
-        // skip empty clip
-        if (clip.IsEmpty())
-          continue;
-      }
-      if (m_scissorClip)
-      {
-        // clip using scissors
-        renderSystem->SetScissors(clip);
-      }
-      else
-      {
-        // clip using vertex shader
-        renderSystem->ResetScissors();
-
-        const float clipBoundaries[4] = {
-            (m_vertexTrans[i].m_clip.x1 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y1 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY(),
-            (m_vertexTrans[i].m_clip.x2 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y2 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY()};
-
-        glUniform4fv(clipUniformLoc, 1, clipBoundaries);
-
-        const float textureSteps[4] = {1.f / static_cast<float>(m_textureWidth),
-                                       1.f / static_cast<float>(m_textureHeight), 1.f, 1.f};
-
-        glUniform4fv(coordStepUniformLoc, 1, textureSteps);
-      }
-
-      // calculate the fractional offset to the ideal position
-      float fractX =
-          context.ScaleFinalXCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      float fractY =
-          context.ScaleFinalYCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      fractX = -fractX + std::round(fractX);
-      fractY = -fractY + std::round(fractY);
-
-      // proj * model * gui * scroll * translation * scaling * correction factor
-      CMatrixGL matrix = glMatrixProject.Get();
-      matrix.MultMatrixf(glMatrixModview.Get());
-      matrix.MultMatrixf(CMatrixGL(context.GetGUIMatrix()));
-      matrix.Translatef(m_vertexTrans[i].m_offsetX, m_vertexTrans[i].m_offsetY, 0.0f);
-      matrix.Translatef(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY, 0.0f);
-      // the gui matrix messes with the scale. correct it here for now.
-      matrix.Scalef(context.GetGUIScaleX(), context.GetGUIScaleY(), 1.0f);
-      // the gui matrix doesn't align to exact pixel coords atm. correct it here for now.
-      matrix.Translatef(fractX, fractY, 0.0f);
-
-      // Apply the depth value of the layer
-      float depth = CServiceBroker::GetWinSystem()->GetGfxContext().GetTransformDepth();
-      glUniform1f(depthLoc, depth);
-
-      glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, matrix);
-
-      // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
-      glBindBuffer(GL_ARRAY_BUFFER, m_vertexTrans[i].m_vertexBuffer->bufferHandle);
-
-      // Do the actual drawing operation, split into groups of characters no
-      // larger than the pre-determined size of the element array
-      for (size_t character = 0; m_vertexTrans[i].m_vertexBuffer->size > character;
-           character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
-      {
-        size_t count = m_vertexTrans[i].m_vertexBuffer->size - character;
-        count = std::min<size_t>(count, ELEMENT_ARRAY_MAX_CHAR_INDEX);
-
-        // Set up the offsets of the various vertex attributes within the buffer
-        // object bound to GL_ARRAY_BUFFER
-        glVertexAttribPointer(
-            posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, x)));
-        glVertexAttribPointer(
-            colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, r)));
-        glVertexAttribPointer(
-            tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
-
-        glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
-      }
-
-      glMatrixModview.Pop();
     }
+
+    // the boundaries for clipping in the vertex shader
+    const std::array<GLfloat, 4> clipBoundaries{
+        (vertices.m_clip.x1 - vertices.m_translateX - vertices.m_offsetX) / context.GetGUIScaleX(),
+        (vertices.m_clip.y1 - vertices.m_translateY - vertices.m_offsetY) / context.GetGUIScaleY(),
+        (vertices.m_clip.x2 - vertices.m_translateX - vertices.m_offsetX) / context.GetGUIScaleX(),
+        (vertices.m_clip.y2 - vertices.m_translateY - vertices.m_offsetY) /
+            context.GetGUIScaleY()};
+
+    // calculate the fractional offset to the ideal position
+    float fractX = context.ScaleFinalXCoord(vertices.m_translateX, vertices.m_translateY);
+    float fractY = context.ScaleFinalYCoord(vertices.m_translateX, vertices.m_translateY);
+    fractX = -fractX + std::round(fractX);
+    fractY = -fractY + std::round(fractY);
+
+    CRect translatedBounds;
+    flat = flat && GetTranslatedBounds(context, vertices, fractX, fractY, translatedBounds);
+    bounds.Union(translatedBounds);
+
+    // proj * model * gui * scroll * translation * scaling * correction factor
+    CMatrixGL matrix = glMatrixProject.Get();
+    matrix.MultMatrixf(glMatrixModview.Get());
+    matrix.MultMatrixf(CMatrixGL(context.GetGUIMatrix()));
+    matrix.Translatef(vertices.m_offsetX, vertices.m_offsetY, 0.0f);
+    matrix.Translatef(vertices.m_translateX, vertices.m_translateY, 0.0f);
+    // the gui matrix messes with the scale. correct it here for now.
+    matrix.Scalef(context.GetGUIScaleX(), context.GetGUIScaleY(), 1.0f);
+    // the gui matrix doesn't align to exact pixel coords atm. correct it here for now.
+    matrix.Translatef(fractX, fractY, 0.0f);
+
+    // Apply the depth value of the layer
+    const float depth = context.GetTransformDepth();
+
+    text->translated.push_back({static_cast<GLuint>(vertices.m_vertexBuffer->bufferHandle),
+                                vertices.m_vertexBuffer->size, clip, clipBoundaries, matrix,
+                                depth});
+
+    glMatrixModview.Pop();
+  }
+
+  if (text->translated.empty())
+  {
+    renderSystem->DisableGUIShader();
+  }
+  else if (flat)
+  {
+    // drawn with the GUI textures, only the ones it overlaps have to be drawn before it
+    renderSystem->DrawGUICustom(bounds, [text] { DrawTranslated(*text); });
+    renderSystem->DisableGUIShader();
+  }
+  else
+  {
+    // where text with a depth ends up on screen depends on the projection
+    renderSystem->FlushBatch();
+    DrawTranslated(*text);
+
     // Restore the original scissor rectangle
     if (m_scissorClip)
       renderSystem->SetScissors(scissor);
-    // Unbind GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
   }
-
-  // Disable the attributes used by this shader
-  glDisableVertexAttribArray(posLoc);
-  glDisableVertexAttribArray(colLoc);
-  glDisableVertexAttribArray(tex0Loc);
-
-  renderSystem->DisableGUIShader();
 }
 
 CVertexBuffer CGUIFontTTFGLES::CreateVertexBuffer(const std::vector<SVertex>& vertices) const
@@ -316,6 +378,10 @@ void CGUIFontTTFGLES::DestroyVertexBuffer(CVertexBuffer& buffer) const
 {
   if (buffer.bufferHandle != 0)
   {
+    // queued text may still draw from it
+    if (CRenderSystemBase* renderSystem = CServiceBroker::GetRenderSystem())
+      renderSystem->FlushBatch();
+
     // Release the buffer name for reuse
     glDeleteBuffers(1, static_cast<GLuint*>(&buffer.bufferHandle));
     buffer.bufferHandle = 0;
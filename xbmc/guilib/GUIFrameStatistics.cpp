@@ -0,0 +1,235 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFrameStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace
+{
+constexpr double BUCKETS_PER_OCTAVE = 8.0;
+// the last bucket starts at about 30 seconds
+constexpr size_t BUCKET_COUNT = 200;
+
+uint8_t ToBucket(std::chrono::steady_clock::duration duration)
+{
+  const double microseconds = std::chrono::duration<double, std::micro>(duration).count();
+  if (microseconds <= 1.0)
+    return 0;
+
+  const double bucket = std::ceil(std::log2(microseconds) * BUCKETS_PER_OCTAVE);
+  return static_cast<uint8_t>(std::min(bucket, static_cast<double>(BUCKET_COUNT - 1)));
+}
+
+double ToMilliseconds(size_t bucket)
+{
+  // the upper bound of the bucket
+  return std::exp2(static_cast<double>(bucket) / BUCKETS_PER_OCTAVE) / 1000.0;
+}
+} // unnamed namespace
+
+class CGUIFrameStatistics::CHistory
+{
+public:
+  static constexpr size_t FRAME_COST = STAGE_COUNT;
+
+  using Buckets = std::array<uint8_t, STAGE_COUNT + 1>;
+
+  void Add(const Buckets& buckets, bool overBudget, unsigned int drawCalls, unsigned int quads)
+  {
+    Frame& frame = m_frames[m_next];
+    if (m_size == HISTORY_SIZE)
+    {
+      for (size_t i = 0; i < frame.buckets.size(); i++)
+        m_counts[i][frame.buckets[i]]--;
+      if (frame.overBudget)
+        m_overBudget--;
+      m_drawCalls -= frame.drawCalls;
+      m_quads -= frame.quads;
+    }
+    else
+      m_size++;
+
+    frame.buckets = buckets;
+    frame.overBudget = overBudget;
+    frame.drawCalls = drawCalls;
+    frame.quads = quads;
+    for (size_t i = 0; i < buckets.size(); i++)
+      m_counts[i][buckets[i]]++;
+    if (overBudget)
+      m_overBudget++;
+    m_drawCalls += drawCalls;
+    m_quads += quads;
+
+    m_next = (m_next + 1) % HISTORY_SIZE;
+  }
+
+  Summary GetSummary() const
+  {
+    Summary summary;
+    summary.frames = m_size;
+    summary.framesOverBudget = m_overBudget;
+    summary.process = GetPercentiles(m_counts[static_cast<size_t>(Stage::PROCESS)]);
+    summary.render = GetPercentiles(m_counts[static_cast<size_t>(Stage::RENDER)]);
+    summary.present = GetPercentiles(m_counts[static_cast<size_t>(Stage::PRESENT)]);
+    summary.frameCost = GetPercentiles(m_counts[FRAME_COST]);
+    if (m_size > 0)
+    {
+      summary.drawCalls = static_cast<double>(m_drawCalls) / static_cast<double>(m_size);
+      summary.quads = static_cast<double>(m_quads) / static_cast<double>(m_size);
+    }
+    return summary;
+  }
+
+private:
+  using Counts = std::array<uint16_t, BUCKET_COUNT>;
+
+  Percentiles GetPercentiles(const Counts& counts) const
+  {
+    Percentiles percentiles;
+    percentiles.p50 = GetPercentile(counts, 0.50);
+    percentiles.p95 = GetPercentile(counts, 0.95);
+    percentiles.p99 = GetPercentile(counts, 0.99);
+    return percentiles;
+  }
+
+  double GetPercentile(const Counts& counts, double percentile) const
+  {
+    if (m_size == 0)
+      return 0.0;
+
+    const size_t rank =
+        std::max<size_t>(1, static_cast<size_t>(std::ceil(percentile * static_cast<double>(m_size))));
+    size_t count = 0;
+    for (size_t bucket = 0; bucket < counts.size(); bucket++)
+    {
+      count += counts[bucket];
+      if (count >= rank)
+        return ToMilliseconds(bucket);
+    }
+    return ToMilliseconds(counts.size() - 1);
+  }
+
+  struct Frame
+  {
+    Buckets buckets{};
+    bool overBudget = false;
+    unsigned int drawCalls = 0;
+    unsigned int quads = 0;
+  };
+
+  std::array<Frame, HISTORY_SIZE> m_frames;
+  std::array<Counts, STAGE_COUNT + 1> m_counts{};
+  size_t m_size = 0;
+  size_t m_next = 0;
+  size_t m_overBudget = 0;
+  uint64_t m_drawCalls = 0;
+  uint64_t m_quads = 0;
+};
+
+CGUIFrameStatistics::CStageTimer::CStageTimer(CGUIFrameStatistics& statistics, Stage stage)
+  : m_statistics(statistics), m_stage(stage), m_start(std::chrono::steady_clock::now())
+{
+}
+
+CGUIFrameStatistics::CStageTimer::~CStageTimer()
+{
+  m_statistics.AddStageTime(m_stage, std::chrono::steady_clock::now() - m_start);
+}
+
+CGUIFrameStatistics::CGUIFrameStatistics() : m_all(std::make_unique<CHistory>())
+{
+}
+
+CGUIFrameStatistics::~CGUIFrameStatistics() = default;
+
+void CGUIFrameStatistics::AddStageTime(Stage stage, std::chrono::steady_clock::duration duration)
+{
+  m_stageTimes[static_cast<size_t>(stage)] += duration;
+}
+
+void CGUIFrameStatistics::AddDrawCalls(unsigned int drawCalls, unsigned int quads)
+{
+  m_drawCalls += drawCalls;
+  m_quads += quads;
+}
+
+void CGUIFrameStatistics::EndFrame(int windowId,
+                                   bool rendered,
+                                   std::chrono::steady_clock::duration budget)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto stageTimes = m_stageTimes;
+  m_stageTimes.fill(std::chrono::steady_clock::duration::zero());
+  const unsigned int drawCalls = m_drawCalls;
+  const unsigned int quads = m_quads;
+  m_drawCalls = 0;
+  m_quads = 0;
+
+  if (!rendered)
+  {
+    // the next rendered frame isn't late, the display simply didn't need to be updated
+    m_lastFrameEnd = {};
+    return;
+  }
+
+  const bool overBudget = m_lastFrameEnd != std::chrono::steady_clock::time_point() &&
+                          budget > std::chrono::steady_clock::duration::zero() &&
+                          (now - m_lastFrameEnd) * 2 > budget * 3;
+  m_lastFrameEnd = now;
+
+  CHistory::Buckets buckets;
+  for (size_t i = 0; i < STAGE_COUNT; i++)
+    buckets[i] = ToBucket(stageTimes[i]);
+  buckets[CHistory::FRAME_COST] = ToBucket(stageTimes[static_cast<size_t>(Stage::PROCESS)] +
+                                           stageTimes[static_cast<size_t>(Stage::RENDER)]);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_all->Add(buckets, overBudget, drawCalls, quads);
+
+  auto& window = m_windows[windowId];
+  if (!window)
+    window = std::make_unique<CHistory>();
+  window->Add(buckets, overBudget, drawCalls, quads);
+}
+
+CGUIFrameStatistics::Summary CGUIFrameStatistics::GetSummary() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_all->GetSummary();
+}
+
+bool CGUIFrameStatistics::GetSummary(int windowId, Summary& summary) const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto it = m_windows.find(windowId);
+  if (it == m_windows.end())
+    return false;
+
+  summary = it->second->GetSummary();
+  return true;
+}
+
+std::vector<int> CGUIFrameStatistics::GetWindows() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  std::vector<int> windows;
+  windows.reserve(m_windows.size());
+  for (const auto& window : m_windows)
+    windows.push_back(window.first);
+  return windows;
+}
+
+void CGUIFrameStatistics::Reset()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_all = std::make_unique<CHistory>();
+  m_windows.clear();
+}
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/*!
+ \ingroup winman
+ \brief Frame time distributions of the GUI render loop, per window.
+
+ The time spent in each stage of a rendered frame is kept in a rolling histogram over the last
+ HISTORY_SIZE frames, for the window or dialog which was active at the end of the frame and for
+ all windows together. Frames which didn't render anything, e.g. because no region was dirty,
+ aren't recorded. Percentiles are estimated from logarithmic buckets, 8 per octave, so they are
+ accurate to about 9%.
+
+ The stages are recorded on the application thread only, the statistics can be read from any
+ thread.
+ */
+class CGUIFrameStatistics
+{
+public:
+  static constexpr size_t HISTORY_SIZE = 1024;
+
+  enum class Stage
+  {
+    PROCESS, //!< CGUIWindowManager::Process
+    RENDER, //!< CGUIWindowManager::Render, including solving the dirty regions
+    PRESENT, //!< presenting the frame, which may include waiting for the vertical blank
+  };
+
+  /*!
+   \brief Adds the time from its construction to its destruction to a stage of the current frame.
+   */
+  class CStageTimer
+  {
+  public:
+    CStageTimer(CGUIFrameStatistics& statistics, Stage stage);
+    ~CStageTimer();
+
+  private:
+    CStageTimer(const CStageTimer&) = delete;
+    CStageTimer& operator=(const CStageTimer&) = delete;
+
+    CGUIFrameStatistics& m_statistics;
+    const Stage m_stage;
+    const std::chrono::steady_clock::time_point m_start;
+  };
+
+  struct Percentiles
+  {
+    double p50 = 0.0; //!< in milliseconds
+    double p95 = 0.0;
+    double p99 = 0.0;
+  };
+
+  struct Summary
+  {
+    size_t frames = 0; //!< the number of frames in the history
+    size_t framesOverBudget = 0; //!< frames which missed at least one refresh of the display
+    Percentiles process;
+    Percentiles render;
+    Percentiles present;
+    Percentiles frameCost; //!< process and render, the work the application does per frame
+    double drawCalls = 0.0; //!< the average number of draw calls per frame
+    double quads = 0.0; //!< the average number of quads drawn per frame
+  };
+
+  CGUIFrameStatistics();
+  ~CGUIFrameStatistics();
+
+  void AddStageTime(Stage stage, std::chrono::steady_clock::duration duration);
+
+  /*!
+   \brief Adds the draw calls the render system issued to the current frame.
+   */
+  void AddDrawCalls(unsigned int drawCalls, unsigned int quads);
+
+  /*!
+   \brief Finish the current frame.
+   \param windowId the window or dialog the frame is accounted to
+   \param rendered whether anything was rendered, the frame is discarded otherwise
+   \param budget the time per refresh of the display. A frame is over budget if it was presented
+          more than one and a half budgets after the previous rendered frame
+   */
+  void EndFrame(int windowId, bool rendered, std::chrono::steady_clock::duration budget);
+
+  /*!
+   \brief Get the statistics of all windows together.
+   */
+  Summary GetSummary() const;
+
+  /*!
+   \brief Get the statistics of a window.
+   \return false if no frame was recorded for the window
+   */
+  bool GetSummary(int windowId, Summary& summary) const;
+
+  /*!
+   \brief Get the ids of the windows frames were recorded for, in ascending order.
+   */
+  std::vector<int> GetWindows() const;
+
+  void Reset();
+
+private:
+  CGUIFrameStatistics(const CGUIFrameStatistics&) = delete;
+  CGUIFrameStatistics& operator=(const CGUIFrameStatistics&) = delete;
+
+  class CHistory;
+
+  static constexpr size_t STAGE_COUNT = 3;
+
+  // only used on the application thread
+  std::array<std::chrono::steady_clock::duration, STAGE_COUNT> m_stageTimes{};
+  unsigned int m_drawCalls = 0;
+  unsigned int m_quads = 0;
+  std::chrono::steady_clock::time_point m_lastFrameEnd;
+
+  mutable CCriticalSection m_critSection;
+  std::unique_ptr<CHistory> m_all;
+  std::map<int, std::unique_ptr<CHistory>> m_windows;
+};
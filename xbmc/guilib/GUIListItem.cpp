@@ -14,11 +14,146 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
 #include <utility>
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+/*!
+ \brief Get the shared copy of a well-known key.
+ \return the shared copy, or nullptr if the key is not a well-known one.
+ */
+const std::string* FindSharedKey(const std::string& key)
+{
+  // the art types and properties set on library items. The set is never changed, so looking up
+  // a key needs no lock.
+  static const std::unordered_set<std::string> keys{
+      "thumb", "icon", "poster", "fanart", "banner", "clearlogo", "clearart", "landscape",
+      "discart", "keyart", "characterart", "album.thumb", "album.fanart", "artist.thumb",
+      "artist.fanart", "albumartist.thumb", "albumartist.fanart", "tvshow.poster", "tvshow.fanart",
+      "tvshow.banner", "tvshow.clearlogo", "tvshow.landscape", "season.poster", "season.fanart",
+      "season.banner", "set.poster", "set.fanart", "total", "totalepisodes", "watchedepisodes",
+      "unwatchedepisodes", "inprogressepisodes", "watchedepisodepercent", "numepisodes",
+      "totalseasons", "original_listitem_url", "hasvideoversions", "hasvideoextras",
+      "libraryartfilled", "icon_never_overlay", "item_start", "IsPlayable", "playlist_type_hint",
+      "musicvideomediatype"};
+
+  const auto it = keys.find(key);
+  return it != keys.end() ? &*it : nullptr;
+}
+
+// properties are sorted ignoring case, art is sorted like an ArtMap
+struct PropertyKey
+{
+  static int Compare(const std::string& key1, const std::string& key2)
+  {
+    return StringUtils::CompareNoCase(key1, key2);
+  }
+};
+
+struct ArtKey
+{
+  static int Compare(const std::string& key1, const std::string& key2)
+  {
+    return key1.compare(key2);
+  }
+};
+
+template<typename KeyType, typename Storage>
+auto LowerBound(Storage& storage, const std::string& key)
+{
+  return std::lower_bound(storage.begin(), storage.end(), key,
+                          [](const auto& entry, const std::string& key)
+                          { return KeyType::Compare(*entry.first, key) < 0; });
+}
+
+template<typename KeyType, typename Storage>
+auto Find(Storage& storage, const std::string& key)
+{
+  const auto it = LowerBound<KeyType>(storage, key);
+  if (it != storage.end() && KeyType::Compare(*it->first, key) == 0)
+    return it;
+  return storage.end();
+}
+
+/*!
+ \brief Set the value of a key.
+ \return true if the value was changed, false if the key already had that value.
+ */
+template<typename KeyType, typename Storage, typename Value>
+bool SetValue(Storage& storage, const std::string& key, const Value& value)
+{
+  const auto it = LowerBound<KeyType>(storage, key);
+  if (it != storage.end() && KeyType::Compare(*it->first, key) == 0)
+  {
+    if (it->second == value)
+      return false;
+    it->second = value;
+    return true;
+  }
+  storage.emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                  std::forward_as_tuple(value));
+  return true;
+}
+} // unnamed namespace
+
+static_assert(alignof(std::string) > 1, "the lowest bit of a key pointer must be free");
+
+CGUIListItem::Key::Key(const std::string& key)
+{
+  const std::string* shared = FindSharedKey(key);
+  if (shared)
+    m_key = reinterpret_cast<uintptr_t>(shared);
+  else
+    m_key = reinterpret_cast<uintptr_t>(new std::string(key)) | OWNED;
+}
+
+CGUIListItem::Key::Key(const Key& other) : m_key(Copy(other.m_key))
+{
+}
+
+CGUIListItem::Key::Key(Key&& other) noexcept : m_key(std::exchange(other.m_key, 0))
+{
+}
+
+CGUIListItem::Key::~Key()
+{
+  Release(m_key);
+}
+
+CGUIListItem::Key& CGUIListItem::Key::operator=(const Key& other)
+{
+  if (this != &other)
+  {
+    const uintptr_t key = Copy(other.m_key);
+    Release(m_key);
+    m_key = key;
+  }
+  return *this;
+}
+
+CGUIListItem::Key& CGUIListItem::Key::operator=(Key&& other) noexcept
+{
+  std::swap(m_key, other.m_key);
+  return *this;
+}
+
+uintptr_t CGUIListItem::Key::Copy(uintptr_t key)
+{
+  if (key & OWNED)
+  {
+    const auto* owned = reinterpret_cast<const std::string*>(key & ~OWNED);
+    return reinterpret_cast<uintptr_t>(new std::string(*owned)) | OWNED;
+  }
+  return key;
+}
+
+void CGUIListItem::Key::Release(uintptr_t key)
+{
+  if (key & OWNED)
+    delete reinterpret_cast<std::string*>(key & ~OWNED);
 }
 
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
@@ -97,23 +232,23 @@ const std::wstring& CGUIListItem::GetSortLabel() const
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 {
-  ArtMap::iterator i = m_art.find(type);
-  if (i == m_art.end() || i->second != url)
-  {
-    m_art[type] = url;
+  if (SetValue<ArtKey>(m_art, type, url))
     SetInvalid();
-  }
 }
 
 void CGUIListItem::SetArt(const ArtMap &art)
 {
-  m_art = art;
+  // an ArtMap is already sorted by type
+  m_art.clear();
+  m_art.reserve(art.size());
+  for (const auto& i : art)
+    m_art.emplace_back(Key(i.first), i.second);
   SetInvalid();
 }
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  SetValue<ArtKey>(m_artFallbacks, from, to);
 }
 
 void CGUIListItem::ClearArt()
@@ -131,22 +266,30 @@ void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
 
 std::string CGUIListItem::GetArt(const std::string &type) const
 {
-  ArtMap::const_iterator i = m_art.find(type);
+  auto i = Find<ArtKey>(m_art, type);
   if (i != m_art.end())
     return i->second;
-  i = m_artFallbacks.find(type);
+  i = Find<ArtKey>(m_artFallbacks, type);
   if (i != m_artFallbacks.end())
   {
-    ArtMap::const_iterator j = m_art.find(i->second);
+    const auto j = Find<ArtKey>(m_art, i->second);
     if (j != m_art.end())
       return j->second;
   }
   return "";
 }
 
-const CGUIListItem::ArtMap &CGUIListItem::GetArt() const
+bool CGUIListItem::HasArt() const
+{
+  return !m_art.empty();
+}
+
+CGUIListItem::ArtMap CGUIListItem::GetArt() const
 {
-  return m_art;
+  ArtMap art;
+  for (const auto& i : m_art)
+    art.emplace_hint(art.end(), *i.first, i.second);
+  return art;
 }
 
 bool CGUIListItem::HasArt(const std::string &type) const
@@ -228,19 +371,19 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << (int)m_mapProperties.size();
     for (const auto& it : m_mapProperties)
     {
-      ar << it.first;
+      ar << *it.first;
       ar << it.second;
     }
     ar << (int)m_art.size();
     for (const auto& i : m_art)
     {
-      ar << i.first;
+      ar << *i.first;
       ar << i.second;
     }
     ar << (int)m_artFallbacks.size();
     for (const auto& i : m_artFallbacks)
     {
-      ar << i.first;
+      ar << *i.first;
       ar << i.second;
     }
   }
@@ -272,7 +415,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_art.insert(make_pair(key, value));
+      SetValue<ArtKey>(m_art, key, value);
     }
     ar >> mapSize;
     for (int i = 0; i < mapSize; i++)
@@ -280,7 +423,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      SetValue<ArtKey>(m_artFallbacks, key, value);
     }
     SetInvalid();
   }
@@ -295,10 +438,10 @@ void CGUIListItem::Serialize(CVariant &value)
 
   for (const auto& it : m_mapProperties)
   {
-    value["properties"][it.first] = it.second;
+    value["properties"][*it.first] = it.second;
   }
   for (const auto& it : m_art)
-    value["art"][it.first] = it.second;
+    value["art"][*it.first] = it.second;
 }
 
 void CGUIListItem::FreeIcons()
@@ -350,22 +493,13 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-  {
-    m_mapProperties.insert(make_pair(strKey, value));
-    SetInvalid();
-  }
-  else if (iter->second != value)
-  {
-    iter->second = value;
+  if (SetValue<PropertyKey>(m_mapProperties, strKey, value))
     SetInvalid();
-  }
 }
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  const auto iter = Find<PropertyKey>(m_mapProperties, strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
   if (iter == m_mapProperties.end())
@@ -376,16 +510,21 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  const auto iter = Find<PropertyKey>(m_mapProperties, strKey);
   if (iter == m_mapProperties.end())
     return false;
 
   return true;
 }
 
+bool CGUIListItem::HasProperties() const
+{
+  return !m_mapProperties.empty();
+}
+
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  const auto iter = Find<PropertyKey>(m_mapProperties, strKey);
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -426,7 +565,7 @@ void CGUIListItem::IncrementProperty(const std::string &strKey, double dVal)
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
   for (const auto& i : item.m_mapProperties)
-    SetProperty(i.first, i.second);
+    SetProperty(*i.first, i.second);
 }
 
 void CGUIListItem::SetCurrentItem(unsigned int position)
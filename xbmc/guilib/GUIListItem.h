@@ -13,9 +13,12 @@
 \brief
 */
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -101,11 +104,17 @@ public:
   std::string GetArt(const std::string &type) const;
 
   /*! \brief get artwork for an item
-   Retrieves artwork in a type:url map
+   Retrieves a copy of the artwork in a type:url map
    \return a type:url map for artwork
    \sa SetArt
    */
-  const ArtMap &GetArt() const;
+  ArtMap GetArt() const;
+
+  /*! \brief Check whether an item has any art
+   Cheaper than !GetArt().empty(), which copies the art
+   \return true if the item has art set, false otherwise.
+   */
+  bool HasArt() const;
 
   /*! \brief Check whether an item has a particular piece of art
    Equivalent to !GetArt(type).empty()
@@ -155,7 +164,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool HasProperties() const { return !m_mapProperties.empty(); }
+  bool HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -183,18 +192,46 @@ protected:
   bool m_bSelected;     // item is selected or not
   unsigned int m_currentItem; // current item number within container (starting at 1)
 
-  struct icompare
+  /*! \brief Key of a property or art type. Well-known keys, which the items of large lists use
+   over and over, point to a single shared copy. Any other key is allocated for the item. Both are
+   kept in a single pointer, the lowest bit tells which one it is.
+   */
+  class Key
   {
-    bool operator()(const std::string &s1, const std::string &s2) const;
+  public:
+    explicit Key(const std::string& key);
+    Key(const Key& other);
+    Key(Key&& other) noexcept;
+    ~Key();
+    Key& operator=(const Key& other);
+    Key& operator=(Key&& other) noexcept;
+
+    const std::string& operator*() const
+    {
+      return *reinterpret_cast<const std::string*>(m_key & ~OWNED);
+    }
+
+  private:
+    static constexpr uintptr_t OWNED = 1;
+
+    static uintptr_t Copy(uintptr_t key);
+    static void Release(uintptr_t key);
+
+    uintptr_t m_key;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  /*! \brief Properties sorted case-insensitively by key. A flat vector needs much less memory than
+   a map for the handful of properties an item usually has.
+   */
+  typedef std::vector<std::pair<Key, CVariant>> PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  typedef std::vector<std::pair<Key, std::string>> ArtStorage; // sorted by key
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
-  ArtMap m_art;
-  ArtMap m_artFallbacks;
+  ArtStorage m_art;
+  ArtStorage m_artFallbacks;
 };
 
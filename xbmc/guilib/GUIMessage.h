@@ -164,6 +164,18 @@ constexpr const int GUI_MSG_SUBTITLE_DOWNLOADED = 52;
  */
 constexpr const int GUI_MSG_RESET_MULTI_IMAGE = 53;
 
+/*!
+ * \brief A container got near the end of a bound list that has the "moreitems" property set, so
+ * its window should load the next items. param1 holds the number of items of the container.
+ */
+constexpr const int GUI_MSG_LOAD_MORE_ITEMS = 54;
+
+/*!
+ * \brief Add the items of the bound list that follow the ones the container already has, keeping
+ * its position. The list is in the pointer, like with GUI_MSG_LABEL_BIND.
+ */
+constexpr const int GUI_MSG_LABEL_APPEND = 55;
+
 constexpr const int GUI_MSG_USER = 1000;
 
 /*!
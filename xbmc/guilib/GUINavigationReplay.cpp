@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUINavigationReplay.h"
+
+#include "GUIFrameStatistics.h"
+#include "ServiceBroker.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIWindowManager.h"
+#include "guilib/WindowIDs.h"
+#include "input/WindowTranslator.h"
+#include "input/actions/Action.h"
+#include "input/actions/ActionTranslator.h"
+#include "messaging/ApplicationMessenger.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+// time for the window to load its content before the navigation starts
+constexpr unsigned int OPEN_FRAMES = 120;
+} // unnamed namespace
+
+bool CGUINavigationReplay::Start(const std::string& window,
+                                 const std::vector<std::string>& actions,
+                                 unsigned int repeat,
+                                 unsigned int framesPerAction)
+{
+  const int windowId = CWindowTranslator::TranslateWindow(window);
+  if (windowId == WINDOW_INVALID)
+  {
+    CLog::Log(LOGERROR, "CGUINavigationReplay: unknown window {}", window);
+    return false;
+  }
+
+  std::vector<unsigned int> actionIds;
+  for (const auto& action : actions)
+  {
+    unsigned int actionId;
+    if (!KODI::ACTION::CActionTranslator::TranslateString(action, actionId))
+    {
+      CLog::Log(LOGERROR, "CGUINavigationReplay: unknown action {}", action);
+      return false;
+    }
+    actionIds.push_back(actionId);
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_windowId = windowId;
+  m_actions.clear();
+  for (unsigned int i = 0; i < repeat; i++)
+    m_actions.insert(m_actions.end(), actionIds.begin(), actionIds.end());
+  m_nextAction = 0;
+  m_framesPerAction = std::max(framesPerAction, 1u);
+  m_framesUntilNext = 0;
+  m_activationRequested = false;
+  m_state = State::OPENING;
+
+  CLog::Log(LOGINFO, "CGUINavigationReplay: replaying {} actions in {}", m_actions.size(), window);
+  return true;
+}
+
+bool CGUINavigationReplay::IsRunning() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_state != State::IDLE;
+}
+
+void CGUINavigationReplay::FrameMove(CGUIFrameStatistics& statistics)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_state == State::IDLE)
+    return;
+
+  if (m_framesUntilNext > 0)
+  {
+    m_framesUntilNext--;
+    return;
+  }
+
+  CGUIWindowManager& windowManager = CServiceBroker::GetGUI()->GetWindowManager();
+  if (m_state == State::OPENING)
+  {
+    if (windowManager.GetActiveWindow() != m_windowId)
+    {
+      if (m_activationRequested)
+      {
+        CLog::Log(LOGERROR, "CGUINavigationReplay: {} couldn't be activated",
+                  CWindowTranslator::TranslateWindow(m_windowId));
+        m_state = State::IDLE;
+        return;
+      }
+
+      m_activationRequested = true;
+      m_framesUntilNext = OPEN_FRAMES;
+      const int windowId = m_windowId;
+      CSingleExit exit(m_critSection);
+      windowManager.ActivateWindow(windowId);
+      return;
+    }
+
+    statistics.Reset();
+    m_state = State::NAVIGATING;
+  }
+
+  if (m_nextAction == m_actions.size())
+  {
+    Finish(statistics);
+    m_state = State::IDLE;
+    return;
+  }
+
+  // actions may open modal dialogs, which run their own render loop calling back into here
+  const unsigned int actionId = m_actions[m_nextAction++];
+  m_framesUntilNext = m_framesPerAction - 1;
+  CSingleExit exit(m_critSection);
+  CServiceBroker::GetAppMessenger()->SendMsg(TMSG_GUI_ACTION, WINDOW_INVALID, -1,
+                                             static_cast<void*>(new CAction(actionId)));
+}
+
+void CGUINavigationReplay::Finish(const CGUIFrameStatistics& statistics)
+{
+  const CGUIFrameStatistics::Summary summary = statistics.GetSummary();
+  CLog::Log(LOGINFO,
+            "CGUINavigationReplay: {} finished, {} frames rendered, {} over budget, frame cost "
+            "p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms",
+            CWindowTranslator::TranslateWindow(m_windowId), summary.frames,
+            summary.framesOverBudget, summary.frameCost.p50, summary.frameCost.p95,
+            summary.frameCost.p99);
+
+  const auto logStage = [](const char* stage, const CGUIFrameStatistics::Percentiles& percentiles)
+  {
+    CLog::Log(LOGINFO, "CGUINavigationReplay:   {} p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms",
+              stage, percentiles.p50, percentiles.p95, percentiles.p99);
+  };
+  logStage("process", summary.process);
+  logStage("render", summary.render);
+  logStage("present", summary.present);
+  CLog::Log(LOGINFO, "CGUINavigationReplay:   {:.1f} draw calls, {:.1f} quads per frame",
+            summary.drawCalls, summary.quads);
+}
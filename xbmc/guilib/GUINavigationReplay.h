@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <string>
+#include <vector>
+
+class CGUIFrameStatistics;
+
+/*!
+ \ingroup winman
+ \brief Replays scripted navigation through a window to measure its frame cost.
+
+ The window is activated and given time to load, then the frame statistics are reset and the
+ actions are sent one by one, a fixed number of frames apart. Once the last action settled the
+ percentiles of the frame cost are logged, and the frame statistics hold the last frames of the
+ replay until the next frame is rendered. Together with a software renderer like llvmpipe this
+ allows comparing the cost of skins and changes to the GUI on machines without a GPU. Kodi still
+ needs a windowing system to render into, e.g. a virtual X server like Xvfb, a headless Wayland
+ compositor or a DRM device for GBM.
+ */
+class CGUINavigationReplay
+{
+public:
+  /*!
+   \brief Start a replay, a running replay is stopped.
+   \param window the window to navigate through
+   \param actions the names of the actions to send, see CActionTranslator
+   \param repeat how many times to send the actions
+   \param framesPerAction the number of frames between two actions
+   \return false if the window or an action is unknown
+   */
+  bool Start(const std::string& window,
+             const std::vector<std::string>& actions,
+             unsigned int repeat,
+             unsigned int framesPerAction);
+
+  bool IsRunning() const;
+
+  /*!
+   \brief Advance the replay by one frame, called from the application thread.
+   \param statistics the frame statistics of the window manager
+   */
+  void FrameMove(CGUIFrameStatistics& statistics);
+
+private:
+  enum class State
+  {
+    IDLE,
+    OPENING,
+    NAVIGATING,
+  };
+
+  void Finish(const CGUIFrameStatistics& statistics);
+
+  mutable CCriticalSection m_critSection;
+  State m_state = State::IDLE;
+  int m_windowId = 0;
+  bool m_activationRequested = false;
+  std::vector<unsigned int> m_actions;
+  size_t m_nextAction = 0;
+  unsigned int m_framesPerAction = 1;
+  unsigned int m_framesUntilNext = 0;
+};
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/Geometry.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Collects the textured quads of a frame to draw them with as few draw calls as possible.
+
+ Every quad is added with the render state it needs, e.g. its textures, shader and blending. A quad
+ joins the most recent batch with the same state, as long as none of the batches added after that
+ one overlaps the quad: drawing it earlier can't change the result of blending then. Otherwise a new
+ batch is started, so quads of the same texture or atlas end up together while the order of
+ overlapping quads is kept.
+
+ Only the x and y coordinates are compared, so quads with a depth, e.g. from a 3D transform drawn
+ with a perspective projection, are kept in a batch of their own between two barriers.
+
+ Draws the renderer issues itself, e.g. of text, are queued with their bounds only. They are kept
+ in order with the quads they overlap, but never joined.
+
+ On a flush the batches are copied into a single vertex stream and handed to the renderer in
+ order, split into draws of at most MAX_QUADS_PER_DRAW quads so their vertices can be indexed
+ with 16 bits. A draw of the renderer's own is handed over with no quads.
+
+ \tparam State the render state of a batch, compared with operator==
+ \tparam Vertex a vertex with the coordinates x, y and z, four per quad
+ */
+template<typename State, typename Vertex>
+class CGUIQuadBatch
+{
+public:
+  static constexpr size_t MAX_QUADS_PER_DRAW = 16384;
+  //! batches searched for a matching state before a new batch is started
+  static constexpr size_t MAX_LOOKBEHIND = 16;
+
+  struct Draw
+  {
+    const State* state;
+    size_t firstVertex;
+    size_t quads;
+  };
+
+  /*!
+   \brief The indices of the triangles of MAX_QUADS_PER_DRAW quads, relative to the first vertex
+   of a draw.
+   */
+  static std::vector<uint16_t> GetIndices()
+  {
+    std::vector<uint16_t> indices;
+    indices.reserve(MAX_QUADS_PER_DRAW * 6);
+    for (size_t i = 0; i < MAX_QUADS_PER_DRAW * 4; i += 4)
+    {
+      for (size_t index : {i, i + 1, i + 2, i + 2, i + 3, i})
+        indices.push_back(static_cast<uint16_t>(index));
+    }
+    return indices;
+  }
+
+  /*!
+   \brief Queue quads for the next flush.
+   \param state the render state of the quads
+   \param vertices four vertices per quad
+   \param quads the number of quads
+   */
+  void Add(const State& state, const Vertex* vertices, size_t quads)
+  {
+    if (quads == 0)
+      return;
+
+    CRect bounds(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+    bool flat = true;
+    for (size_t i = 0; i < quads * 4; i++)
+    {
+      bounds.x1 = std::min(bounds.x1, vertices[i].x);
+      bounds.y1 = std::min(bounds.y1, vertices[i].y);
+      bounds.x2 = std::max(bounds.x2, vertices[i].x);
+      bounds.y2 = std::max(bounds.y2, vertices[i].y);
+      flat = flat && vertices[i].z == 0;
+    }
+
+    // where quads with a depth end up on screen depends on the projection
+    if (!flat)
+      Barrier();
+
+    Batch* target = nullptr;
+    for (size_t i = m_used; i > m_barrier && m_used - i < MAX_LOOKBEHIND; i--)
+    {
+      Batch& batch = m_batches[i - 1];
+      if (!batch.custom && batch.state == state)
+      {
+        target = &batch;
+        break;
+      }
+      if (batch.bounds.Intersects(bounds))
+        break;
+    }
+
+    if (!target)
+      target = &NewBatch(state, false);
+
+    target->vertices.insert(target->vertices.end(), vertices, vertices + quads * 4);
+    target->bounds.Union(bounds);
+
+    if (!flat)
+      Barrier();
+  }
+
+  /*!
+   \brief Queue a draw the renderer issues itself for the next flush.
+   \param state the render state of the draw
+   \param bounds the area drawn to, in the coordinates of the quads
+   */
+  void AddCustom(const State& state, const CRect& bounds)
+  {
+    NewBatch(state, true).bounds = bounds;
+  }
+
+  /*!
+   \brief Quads added after a barrier don't join the batches added before it.
+
+   Needed when the coordinates of the following quads can't be compared with the previous ones,
+   e.g. because the transformation to the screen changed.
+   */
+  void Barrier() { m_barrier = m_used; }
+
+  bool IsEmpty() const { return m_used == 0; }
+
+  /*!
+   \brief Hand the queued quads to the renderer and start over.
+   \param draw called once with the vertex stream and the draws, in the order they have to be
+          issued, as draw(const std::vector<Vertex>&, const std::vector<Draw>&). Draws without
+          quads are the ones queued with AddCustom().
+   */
+  template<typename Function>
+  void Flush(Function&& draw)
+  {
+    if (m_used == 0)
+      return;
+
+    m_vertices.clear();
+    m_draws.clear();
+    for (size_t i = 0; i < m_used; i++)
+    {
+      const Batch& batch = m_batches[i];
+      if (batch.custom)
+      {
+        m_draws.push_back({&batch.state, m_vertices.size(), 0});
+        continue;
+      }
+
+      const size_t quads = batch.vertices.size() / 4;
+      for (size_t quad = 0; quad < quads; quad += MAX_QUADS_PER_DRAW)
+      {
+        m_draws.push_back({&batch.state, m_vertices.size() + quad * 4,
+                           std::min(quads - quad, MAX_QUADS_PER_DRAW)});
+      }
+      m_vertices.insert(m_vertices.end(), batch.vertices.begin(), batch.vertices.end());
+    }
+
+    // clear before drawing, a flush may be requested again while drawing
+    m_used = 0;
+    m_barrier = 0;
+    draw(m_vertices, m_draws);
+  }
+
+private:
+  struct Batch
+  {
+    State state;
+    bool custom;
+    CRect bounds;
+    std::vector<Vertex> vertices;
+  };
+
+  Batch& NewBatch(const State& state, bool custom)
+  {
+    if (m_used == m_batches.size())
+      m_batches.emplace_back();
+    Batch& batch = m_batches[m_used++];
+    batch.state = state;
+    batch.custom = custom;
+    batch.bounds = CRect();
+    batch.vertices.clear();
+    return batch;
+  }
+
+  // the batches are reused from frame to frame to keep the allocations of their vertices
+  std::vector<Batch> m_batches;
+  size_t m_used = 0;
+  size_t m_barrier = 0;
+
+  std::vector<Vertex> m_vertices;
+  std::vector<Draw> m_draws;
+};
@@ -9,14 +9,14 @@
 #pragma once
 
 #include "GUITexture.h"
+#include "rendering/gl/RenderSystemGL.h"
 #include "utils/ColorUtils.h"
 
 #include <array>
+#include <vector>
 
 #include "system_gl.h"
 
-class CRenderSystemGL;
-
 class CGUITextureGL : public CGUITexture
 {
 public:
@@ -46,15 +46,10 @@ private:
 
   std::array<GLubyte, 4> m_col;
 
-  struct PackedVertex
-  {
-    float x, y, z;
-    float u1, v1;
-    float u2, v2;
-  };
+  using PackedVertex = CRenderSystemGL::GUIVertex;
 
+  CRenderSystemGL::GUIDrawState m_state;
   std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
   CRenderSystemGL *m_renderSystem;
 };
 
@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "Texture.h"
+#include "TextureGLES.h"
 #include "guilib/TextureFormats.h"
 #include "rendering/gles/RenderSystemGLES.h"
 #include "utils/GLUtils.h"
@@ -53,6 +54,8 @@ void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
+  m_state = CRenderSystemGLES::GUIDrawState();
+
   // Setup Colors
   m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
   m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
@@ -77,19 +80,19 @@ void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
     {
       if (texture->GetSwizzle() == KD_TEX_SWIZ_111R &&
           m_diffuse.m_textures[0]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR);
+        m_state.shader = ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR;
       else if (hasBlendColor)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR);
+        m_state.shader = ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR;
       else
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R);
+        m_state.shader = ShaderMethodGLES::SM_MULTI_RGBA_111R;
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
+      m_state.shader = ShaderMethodGLES::SM_MULTI_BLENDCOLOR;
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI);
+      m_state.shader = ShaderMethodGLES::SM_MULTI;
     }
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
@@ -97,89 +100,47 @@ void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
     // We don't need a 111R_RGBA version of the GLES 2.0 shaders, so in the
     // unlikely event of having an alpha-only texture, switch with the
     // diffuse.
+    const GLuint textureObject = static_cast<CGLESTexture*>(texture)->GetTextureObject();
+    const GLuint diffuseObject =
+        static_cast<CGLESTexture*>(m_diffuse.m_textures[0].get())->GetTextureObject();
     if (texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
-      texture->BindToUnit(1);
-      m_diffuse.m_textures[0]->BindToUnit(0);
+      m_state.textures = {diffuseObject, textureObject};
+      m_state.swapCoords = true;
     }
     else
     {
-      texture->BindToUnit(0);
-      m_diffuse.m_textures[0]->BindToUnit(1);
+      m_state.textures = {textureObject, diffuseObject};
     }
   }
   else
   {
     if (m_isGLES20 && texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_111R);
+      m_state.shader = ShaderMethodGLES::SM_TEXTURE_111R;
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
+      m_state.shader = ShaderMethodGLES::SM_TEXTURE;
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
+      m_state.shader = ShaderMethodGLES::SM_TEXTURE_NOBLEND;
     }
 
-    texture->BindToUnit(0);
+    m_state.textures[0] = static_cast<CGLESTexture*>(texture)->GetTextureObject();
   }
 
-  if ( hasAlpha )
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
+  m_state.color = m_col;
+  m_state.blending = hasAlpha;
+  m_state.depth = m_depth;
   m_packedVertices.clear();
 }
 
 void CGUITextureGLES::End()
 {
-  if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->GUIShaderGetPos();
-    GLint tex0Loc = m_renderSystem->GUIShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->GUIShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->GUIShaderGetUniCol();
-    GLint depthLoc = m_renderSystem->GUIShaderGetDepth();
-
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    glUniform1f(depthLoc, m_depth);
-
-    if(m_diffuse.size())
-    {
-      if (m_texture.m_textures[m_currentFrame]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        std::swap(tex0Loc, tex1Loc);
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-  m_renderSystem->DisableGUIShader();
+  // the quads are drawn together with those of other textures once the render state changes
+  m_renderSystem->DrawGUIQuads(m_state, m_packedVertices.data(), m_packedVertices.size() / 4);
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -255,17 +216,6 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGLES::DrawQuad(const CRect& rect,
@@ -342,6 +292,7 @@ void CGUITextureGLES::DrawQuad(const CRect& rect,
     tex[2][1] = tex[3][1] = coords.y2;
   }
   glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, idx);
+  renderSystem->AddDrawCalls(1, 1);
 
   glDisableVertexAttribArray(posLoc);
   if (texture)
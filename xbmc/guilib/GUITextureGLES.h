@@ -9,6 +9,7 @@
 #pragma once
 
 #include "GUITexture.h"
+#include "rendering/gles/RenderSystemGLES.h"
 #include "utils/ColorUtils.h"
 
 #include <array>
@@ -16,16 +17,9 @@
 
 #include "system_gl.h"
 
-struct PackedVertex
-{
-  float x, y, z;
-  float u1, v1;
-  float u2, v2;
-};
+using PackedVertex = CRenderSystemGLES::GUIVertex;
 typedef std::vector<PackedVertex> PackedVertices;
 
-class CRenderSystemGLES;
-
 class CGUITextureGLES : public CGUITexture
 {
 public:
@@ -55,8 +49,8 @@ private:
 
   std::array<GLubyte, 4> m_col;
 
+  CRenderSystemGLES::GUIDrawState m_state;
   PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
   CRenderSystemGLES *m_renderSystem;
   bool m_isGLES20{true};
 };
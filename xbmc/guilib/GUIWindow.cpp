@@ -14,6 +14,7 @@
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "GUIWindowCache.h"
 #include "GUIWindowManager.h"
 #include "ServiceBroker.h"
 #include "addons/Skin.h"
@@ -32,6 +33,7 @@
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
 #include <mutex>
 
 using namespace KODI;
@@ -124,9 +126,22 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  const auto start = std::chrono::steady_clock::now();
+  CGUIWindowCache& windowCache = g_SkinInfo->GetWindowCache();
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
+    // a cached window neither needs to be parsed nor to have its includes resolved
+    const std::unique_ptr<TiXmlElement> cachedRoot =
+        windowCache.Get(strPath, m_xmlIncludeConditions);
+    if (cachedRoot)
+    {
+      const bool ret = Load(cachedRoot.get());
+      windowCache.AddLoadTime(true, std::chrono::steady_clock::now() - start);
+      return ret;
+    }
+
     CXBMCTinyXML xmlDoc;
     std::string strPathLower = strPath;
     StringUtils::ToLower(strPathLower);
@@ -152,7 +167,15 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for {}", strPath);
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  const std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  const auto prepared = std::chrono::steady_clock::now();
+  if (preparedRoot)
+    windowCache.Put(strPath, *preparedRoot, m_xmlIncludeConditions);
+
+  const auto stored = std::chrono::steady_clock::now();
+  const bool ret = Load(preparedRoot.get());
+  windowCache.AddLoadTime(false, (prepared - start) + (std::chrono::steady_clock::now() - stored));
+  return ret;
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(const std::unique_ptr<TiXmlElement>& rootElement)
@@ -0,0 +1,335 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowCache.h"
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "GUIComponent.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <mutex>
+#include <stdexcept>
+
+using namespace XFILE;
+
+namespace
+{
+const std::string CACHE_PATH = "special://temp/skincache/";
+
+constexpr unsigned int FORMAT_VERSION = 1;
+constexpr unsigned int END_MARKER = 0x4B575343;
+constexpr int MAX_NODES = 100000;
+
+constexpr char NODE_ELEMENT = 'e';
+constexpr char NODE_TEXT = 't';
+constexpr char NODE_CDATA = 'c';
+
+void StoreElement(CArchive& ar, const TiXmlElement& element)
+{
+  ar << element.ValueStr();
+
+  int attributes = 0;
+  for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute;
+       attribute = attribute->Next())
+    attributes++;
+
+  ar << attributes;
+  for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute;
+       attribute = attribute->Next())
+    ar << std::string(attribute->Name()) << std::string(attribute->Value());
+
+  // comments and declarations don't matter for loading controls
+  int children = 0;
+  for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->ToElement() || child->ToText())
+      children++;
+  }
+
+  ar << children;
+  for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (const TiXmlElement* childElement = child->ToElement())
+    {
+      ar << NODE_ELEMENT;
+      StoreElement(ar, *childElement);
+    }
+    else if (const TiXmlText* text = child->ToText())
+    {
+      ar << (text->CDATA() ? NODE_CDATA : NODE_TEXT);
+      ar << text->ValueStr();
+    }
+  }
+}
+
+int LoadCount(CArchive& ar)
+{
+  int count;
+  ar >> count;
+  if (count < 0 || count > MAX_NODES)
+    throw std::out_of_range("Invalid number of nodes");
+  return count;
+}
+
+std::unique_ptr<TiXmlElement> LoadElement(CArchive& ar)
+{
+  std::string name;
+  ar >> name;
+  auto element = std::make_unique<TiXmlElement>(name);
+
+  for (int attributes = LoadCount(ar); attributes > 0; attributes--)
+  {
+    std::string attribute;
+    std::string value;
+    ar >> attribute >> value;
+    element->SetAttribute(attribute, value);
+  }
+
+  for (int children = LoadCount(ar); children > 0; children--)
+  {
+    char type;
+    ar >> type;
+    if (type == NODE_ELEMENT)
+    {
+      element->LinkEndChild(LoadElement(ar).release());
+    }
+    else if (type == NODE_TEXT || type == NODE_CDATA)
+    {
+      std::string value;
+      ar >> value;
+      auto text = std::make_unique<TiXmlText>(value);
+      text->SetCDATA(type == NODE_CDATA);
+      element->LinkEndChild(text.release());
+    }
+    else
+      throw std::out_of_range("Invalid node type");
+  }
+
+  return element;
+}
+} // unnamed namespace
+
+CGUIWindowCache::~CGUIWindowCache()
+{
+  Close();
+}
+
+void CGUIWindowCache::Open(const std::string& skinId, uint32_t state)
+{
+  Close();
+
+  const std::string name = StringUtils::Format("{}-{:08x}", skinId, state);
+
+  // drop the caches of previous states of the skin
+  CFileItemList items;
+  CDirectory::GetDirectory(CACHE_PATH, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE);
+  for (const auto& item : items)
+  {
+    const std::string& folder = item->GetLabel();
+    if (item->m_bIsFolder && StringUtils::StartsWith(folder, skinId + "-") && folder != name)
+    {
+      CLog::LogF(LOGDEBUG, "Removing outdated window cache {}", item->GetPath());
+      CDirectory::RemoveRecursive(item->GetPath());
+    }
+  }
+
+  const std::string path = URIUtils::AddFileToFolder(CACHE_PATH, name + "/");
+  if (!CDirectory::Exists(path))
+  {
+    CDirectory::Create(CACHE_PATH);
+    if (!CDirectory::Create(path))
+    {
+      CLog::LogF(LOGERROR, "Unable to create window cache {}", path);
+      return;
+    }
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_path = path;
+  CLog::LogF(LOGINFO, "Using window cache {}", m_path);
+}
+
+void CGUIWindowCache::Close()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_path.empty())
+    return;
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  const auto average = [](const Statistics& statistics)
+  {
+    return statistics.windows
+               ? Milliseconds(statistics.duration).count() / statistics.windows
+               : 0.0;
+  };
+
+  CLog::LogF(LOGINFO,
+             "Loaded {} windows from the window cache (average {:.2f} ms), {} from XML (average "
+             "{:.2f} ms)",
+             m_cached.windows, average(m_cached), m_parsed.windows, average(m_parsed));
+
+  m_path.clear();
+  m_cached = {};
+  m_parsed = {};
+}
+
+std::string CGUIWindowCache::GetCacheFile(const std::string& file) const
+{
+  return StringUtils::Format("{}{:08x}.bin", m_path, Crc32::Compute(file));
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::Get(
+    const std::string& file, std::map<INFO::InfoPtr, bool>& includeConditions) const
+{
+  std::string cacheFile;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (m_path.empty())
+      return {};
+
+    cacheFile = GetCacheFile(file);
+  }
+
+  struct __stat64 source;
+  if (CFile::Stat(file, &source) != 0)
+    return {};
+
+  CFile cache;
+  if (!cache.Open(cacheFile))
+    return {};
+
+  Conditions conditions;
+  std::unique_ptr<TiXmlElement> window;
+  try
+  {
+    CArchive ar(&cache, CArchive::load);
+    window = Load(ar, source.st_mtime, source.st_size, conditions);
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::LogF(LOGERROR, "Corrupt window cache file {} for {}", cacheFile, file);
+  }
+  cache.Close();
+
+  if (!window)
+    return {};
+
+  // the includes must resolve the same way as when the window was cached
+  std::map<INFO::InfoPtr, bool> registered;
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  for (const auto& [expression, value] : conditions)
+  {
+    const INFO::InfoPtr condition = infoMgr.Register(expression);
+    if (!condition || condition->Get(INFO::DEFAULT_CONTEXT) != value)
+      return {};
+
+    registered.insert(std::make_pair(condition, value));
+  }
+
+  includeConditions = std::move(registered);
+  return window;
+}
+
+void CGUIWindowCache::Put(const std::string& file,
+                          const TiXmlElement& window,
+                          const std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_path.empty())
+    return;
+
+  struct __stat64 source;
+  if (CFile::Stat(file, &source) != 0)
+    return;
+
+  Conditions conditions;
+  conditions.reserve(includeConditions.size());
+  for (const auto& [condition, value] : includeConditions)
+    conditions.emplace_back(condition->GetExpression(), value);
+
+  const std::string cacheFile = GetCacheFile(file);
+  CFile cache;
+  if (!cache.OpenForWrite(cacheFile, true))
+  {
+    CLog::LogF(LOGERROR, "Unable to write window cache file {} for {}", cacheFile, file);
+    return;
+  }
+
+  CArchive ar(&cache, CArchive::store);
+  Store(ar, source.st_mtime, source.st_size, window, conditions);
+  ar.Close();
+  cache.Close();
+}
+
+void CGUIWindowCache::AddLoadTime(bool cached, std::chrono::steady_clock::duration duration)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  Statistics& statistics = cached ? m_cached : m_parsed;
+  statistics.windows++;
+  statistics.duration += duration;
+}
+
+void CGUIWindowCache::Store(CArchive& ar,
+                            int64_t modified,
+                            int64_t size,
+                            const TiXmlElement& window,
+                            const Conditions& conditions)
+{
+  ar << FORMAT_VERSION;
+  ar << static_cast<long long>(modified) << static_cast<long long>(size);
+
+  ar << static_cast<int>(conditions.size());
+  for (const auto& [expression, value] : conditions)
+    ar << expression << value;
+
+  StoreElement(ar, window);
+  ar << END_MARKER;
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::Load(CArchive& ar,
+                                                    int64_t modified,
+                                                    int64_t size,
+                                                    Conditions& conditions)
+{
+  unsigned int version;
+  long long storedModified;
+  long long storedSize;
+  ar >> version >> storedModified >> storedSize;
+  if (version != FORMAT_VERSION || storedModified != modified || storedSize != size)
+    return {};
+
+  conditions.clear();
+  for (int count = LoadCount(ar); count > 0; count--)
+  {
+    std::string expression;
+    bool value;
+    ar >> expression >> value;
+    conditions.emplace_back(std::move(expression), value);
+  }
+
+  std::unique_ptr<TiXmlElement> window = LoadElement(ar);
+
+  // a truncated file reads as zeros
+  unsigned int endMarker;
+  ar >> endMarker;
+  if (endMarker != END_MARKER)
+    return {};
+
+  return window;
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CArchive;
+class TiXmlElement;
+
+/*!
+ \brief Cache of precompiled skin windows.
+
+ Window definitions with all includes, constants, expressions and defaults resolved are stored in
+ a compact binary form, so that loading a window needs neither parsing its XML nor resolving its
+ includes again. A cached window is only used as long as its XML file is unchanged and the
+ conditions of its includes have the values they had when it was resolved.
+
+ The cache of a skin is identified by a state covering everything else the resolved windows
+ depend on (skin version, resolution, XML files and loaded include files), a new state starts
+ with an empty cache.
+ */
+class CGUIWindowCache
+{
+public:
+  //! expressions of include conditions and their values when the window was resolved
+  using Conditions = std::vector<std::pair<std::string, bool>>;
+
+  CGUIWindowCache() = default;
+  ~CGUIWindowCache();
+
+  /*!
+   \brief Open the cache of a skin, dropping caches of other states of the skin.
+   \param skinId the id of the skin
+   \param state the state of the skin the windows are resolved for
+   */
+  void Open(const std::string& skinId, uint32_t state);
+
+  /*!
+   \brief Close the cache and log how long loading cached and parsed windows took.
+   */
+  void Close();
+
+  /*!
+   \brief Get the precompiled definition of a window.
+   \param file the XML file of the window
+   \param includeConditions [out] the conditions of the resolved includes
+   \return the window definition or nullptr if it's not cached or outdated
+   */
+  std::unique_ptr<TiXmlElement> Get(const std::string& file,
+                                    std::map<INFO::InfoPtr, bool>& includeConditions) const;
+
+  /*!
+   \brief Store the definition of a window with its includes resolved.
+   \param file the XML file of the window
+   \param window the resolved window definition
+   \param includeConditions the conditions of the resolved includes
+   */
+  void Put(const std::string& file,
+           const TiXmlElement& window,
+           const std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Account the time needed to load a window.
+   \param cached whether the window was loaded from the cache or parsed and resolved
+   \param duration the time needed to load the window
+   */
+  void AddLoadTime(bool cached, std::chrono::steady_clock::duration duration);
+
+  /*!
+   \brief Write a window definition to an archive.
+   \param ar the archive
+   \param modified the modification time of the window's XML file
+   \param size the size of the window's XML file
+   \param window the resolved window definition
+   \param conditions the conditions of the resolved includes
+   */
+  static void Store(CArchive& ar,
+                    int64_t modified,
+                    int64_t size,
+                    const TiXmlElement& window,
+                    const Conditions& conditions);
+
+  /*!
+   \brief Read a window definition from an archive.
+   \param ar the archive
+   \param modified the modification time of the window's XML file
+   \param size the size of the window's XML file
+   \param conditions [out] the conditions of the resolved includes
+   \return the window definition or nullptr if it was stored by another version or for another
+   state of the XML file
+   \throws std::out_of_range if the archive is corrupt
+   */
+  static std::unique_ptr<TiXmlElement> Load(CArchive& ar,
+                                            int64_t modified,
+                                            int64_t size,
+                                            Conditions& conditions);
+
+private:
+  CGUIWindowCache(const CGUIWindowCache&) = delete;
+  CGUIWindowCache& operator=(const CGUIWindowCache&) = delete;
+
+  struct Statistics
+  {
+    unsigned int windows{0};
+    std::chrono::steady_clock::duration duration{};
+  };
+
+  std::string GetCacheFile(const std::string& file) const;
+
+  mutable CCriticalSection m_critSection;
+  std::string m_path;
+  Statistics m_cached;
+  Statistics m_parsed;
+};
@@ -37,6 +37,7 @@
 #include "pictures/GUIWindowSlideShow.h"
 #include "profiles/windows/GUIWindowSettingsProfile.h"
 #include "programs/GUIWindowPrograms.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/windows/GUIWindowSettings.h"
@@ -44,6 +45,7 @@
 #include "settings/windows/GUIWindowSettingsScreenCalibration.h"
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -1218,6 +1220,9 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
 void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
+  KODI_TRACE_SCOPE("gui", "CGUIWindowManager::Process");
+  CGUIFrameStatistics::CStageTimer stageTimer(m_frameStatistics,
+                                               CGUIFrameStatistics::Stage::PROCESS);
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   m_dirtyregions.clear();
@@ -1354,6 +1359,9 @@ void CGUIWindowManager::RenderEx() const
 bool CGUIWindowManager::Render()
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
+  KODI_TRACE_SCOPE("gui", "CGUIWindowManager::Render");
+  CGUIFrameStatistics::CStageTimer stageTimer(m_frameStatistics,
+                                               CGUIFrameStatistics::Stage::RENDER);
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   int bufferAge = CServiceBroker::GetWinSystem()->GetBufferAge();
@@ -1411,6 +1419,8 @@ bool CGUIWindowManager::Render()
       CGUITexture::DrawQuad(i, 0x4c00ff00);
   }
 
+  CServiceBroker::GetRenderSystem()->FlushBatch();
+
   return hasRendered;
 }
 
@@ -1438,6 +1448,8 @@ void CGUIWindowManager::AfterRender()
 void CGUIWindowManager::FrameMove()
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
+  m_navigationReplay.FrameMove(m_frameStatistics);
+
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   if(m_iNested == 0)
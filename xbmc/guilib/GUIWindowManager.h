@@ -9,6 +9,8 @@
 #pragma once
 
 #include "DirtyRegionTracker.h"
+#include "GUIFrameStatistics.h"
+#include "GUINavigationReplay.h"
 #include "GUIWindow.h"
 #include "IMsgTargetCallback.h"
 #include "IWindowManagerCallback.h"
@@ -117,6 +119,15 @@ public:
    */
   void FrameMove();
 
+  /*! \brief Frame time distributions of the render loop, per window.
+   */
+  CGUIFrameStatistics& GetFrameStatistics() { return m_frameStatistics; }
+  const CGUIFrameStatistics& GetFrameStatistics() const { return m_frameStatistics; }
+
+  /*! \brief Scripted navigation to measure the frame cost of a window.
+   */
+  CGUINavigationReplay& GetNavigationReplay() { return m_navigationReplay; }
+
   /*! \brief Return whether the window manager is initialized.
    The window manager is initialized on skin load - if the skin isn't yet loaded,
    no windows should be able to be initialized.
@@ -288,4 +299,7 @@ private:
 
   CDirtyRegionList m_dirtyregions;
   CDirtyRegionTracker m_tracker;
+
+  CGUIFrameStatistics m_frameStatistics;
+  CGUINavigationReplay m_navigationReplay;
 };
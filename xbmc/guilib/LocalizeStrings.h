@@ -59,7 +59,7 @@ protected:
   typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
   typedef std::map<uint32_t, LocStr>::iterator       iStrings;
 
-  mutable CSharedSection m_stringsMutex;
+  mutable CSharedSection m_stringsMutex{CSharedSection::ReaderCounting::STRIPED};
   CSharedSection m_addonStringsMutex;
 };
 
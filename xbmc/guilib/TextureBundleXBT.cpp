@@ -26,8 +26,11 @@
 #include "windowing/WinSystem.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <exception>
+#include <future>
+#include <thread>
 
 #include <lzo/lzo1x.h>
 #include <lzo/lzoconf.h>
@@ -190,11 +193,12 @@ std::optional<CTextureBundleXBT::Animation> CTextureBundleXBT::LoadAnim(const st
   Animation animation;
   animation.textures.reserve(nTextures);
 
+  std::vector<std::vector<uint8_t>> buffers = UnpackFrames(*m_XBTFReader, file.GetFrames());
   for (size_t i = 0; i < nTextures; i++)
   {
     CXBTFFrame& frame = file.GetFrames().at(i);
 
-    std::unique_ptr<CTexture> texture = ConvertFrameToTexture(filename, frame);
+    std::unique_ptr<CTexture> texture = ConvertFrameToTexture(filename, frame, buffers[i]);
     if (!texture)
       return {};
 
@@ -211,31 +215,20 @@ std::optional<CTextureBundleXBT::Animation> CTextureBundleXBT::LoadAnim(const st
 std::unique_ptr<CTexture> CTextureBundleXBT::ConvertFrameToTexture(const std::string& name,
                                                                    const CXBTFFrame& frame)
 {
-  // found texture - allocate the necessary buffers
-  std::vector<unsigned char> buffer(static_cast<size_t>(frame.GetPackedSize()));
+  std::vector<uint8_t> buffer = UnpackFrame(*m_XBTFReader, frame);
+  return ConvertFrameToTexture(name, frame, buffer);
+}
 
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer.data()))
+std::unique_ptr<CTexture> CTextureBundleXBT::ConvertFrameToTexture(const std::string& name,
+                                                                   const CXBTFFrame& frame,
+                                                                   std::vector<uint8_t>& buffer)
+{
+  if (buffer.empty())
   {
     CLog::Log(LOGERROR, "Error loading texture: {}", name);
     return {};
   }
 
-  // check if it's packed with lzo
-  if (frame.IsPacked())
-  { // unpack
-    std::vector<unsigned char> unpacked(static_cast<size_t>(frame.GetUnpackedSize()));
-    lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer.data(), static_cast<lzo_uint>(buffer.size()), unpacked.data(),
-                              &s, NULL) != LZO_E_OK ||
-        s != frame.GetUnpackedSize())
-    {
-      CLog::Log(LOGERROR, "Error loading texture: {}: Decompression error", name);
-      return {};
-    }
-    buffer = std::move(unpacked);
-  }
-
   // create an xbmc texture
   std::unique_ptr<CTexture> texture = CTexture::CreateTexture();
 
@@ -272,17 +265,25 @@ std::string CTextureBundleXBT::Normalize(std::string name)
 std::vector<uint8_t> CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader,
                                                     const CXBTFFrame& frame)
 {
-  // load the compressed texture
-  std::vector<uint8_t> packedBuffer(static_cast<size_t>(frame.GetPackedSize()));
-  if (!reader.Load(frame, packedBuffer.data()))
+  // packed frames are decompressed straight from the mapped bundle, unpacked ones are copied as
+  // uploading may modify the pixels in place
+  const uint8_t* packedData = frame.IsPacked() ? reader.GetFrameData(frame) : nullptr;
+  std::vector<uint8_t> packedBuffer;
+  if (packedData == nullptr)
   {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
-    return {};
-  }
+    packedBuffer.resize(static_cast<size_t>(frame.GetPackedSize()));
+    if (!reader.Load(frame, packedBuffer.data()))
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
+      return {};
+    }
 
-  // if the frame isn't packed there's nothing else to be done
-  if (!frame.IsPacked())
-    return packedBuffer;
+    // if the frame isn't packed there's nothing else to be done
+    if (!frame.IsPacked())
+      return packedBuffer;
+
+    packedData = packedBuffer.data();
+  }
 
   // make sure lzo is initialized
   if (lzo_init() != LZO_E_OK)
@@ -293,7 +294,7 @@ std::vector<uint8_t> CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader,
 
   lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
   std::vector<uint8_t> unpackedBuffer(static_cast<size_t>(frame.GetUnpackedSize()));
-  if (lzo1x_decompress_safe(packedBuffer.data(), static_cast<lzo_uint>(packedBuffer.size()),
+  if (lzo1x_decompress_safe(packedData, static_cast<lzo_uint>(frame.GetPackedSize()),
                             unpackedBuffer.data(), &size, nullptr) != LZO_E_OK ||
       size != frame.GetUnpackedSize())
   {
@@ -305,3 +306,35 @@ std::vector<uint8_t> CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader,
 
   return unpackedBuffer;
 }
+
+std::vector<std::vector<uint8_t>> CTextureBundleXBT::UnpackFrames(
+    const CXBTFReader& reader, const std::vector<CXBTFFrame>& frames)
+{
+  std::vector<std::vector<uint8_t>> buffers(frames.size());
+  if (frames.empty())
+    return buffers;
+
+  // without a mapped bundle the frames are read through the file position of the reader, so they
+  // can't be unpacked at the same time
+  unsigned int threads = 1;
+  if (std::all_of(frames.begin(), frames.end(),
+                  [&reader](const CXBTFFrame& frame) { return reader.GetFrameData(frame); }))
+    threads = std::clamp<unsigned int>(std::thread::hardware_concurrency(), 1,
+                                       static_cast<unsigned int>(frames.size()));
+
+  std::atomic<size_t> next{0};
+  const auto unpack = [&reader, &frames, &buffers, &next]()
+  {
+    for (size_t i = next++; i < frames.size(); i = next++)
+      buffers[i] = UnpackFrame(reader, frames[i]);
+  };
+
+  std::vector<std::future<void>> workers;
+  for (unsigned int i = 1; i < threads; i++)
+    workers.emplace_back(std::async(std::launch::async, unpack));
+  unpack();
+  for (auto& worker : workers)
+    worker.wait();
+
+  return buffers;
+}
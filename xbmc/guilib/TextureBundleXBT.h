@@ -61,11 +61,22 @@ public:
   //! @todo Change return to std::optional<std::vector<uint8_t>>> when c++17 is allowed
   static std::vector<uint8_t> UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
 
+  /*!
+   * \brief Unpack several frames, e.g. the ones of an animation, in parallel if the bundle is
+   * mapped.
+   * \return the unpacked data of each frame, empty for the ones that failed
+   */
+  static std::vector<std::vector<uint8_t>> UnpackFrames(const CXBTFReader& reader,
+                                                        const std::vector<CXBTFFrame>& frames);
+
   void CloseBundle();
 
 private:
   bool OpenBundle();
   std::unique_ptr<CTexture> ConvertFrameToTexture(const std::string& name, const CXBTFFrame& frame);
+  std::unique_ptr<CTexture> ConvertFrameToTexture(const std::string& name,
+                                                  const CXBTFFrame& frame,
+                                                  std::vector<uint8_t>& buffer);
 
   time_t m_TimeStamp;
 
@@ -43,6 +43,8 @@ public:
   void SyncGPU() override;
   void BindToUnit(unsigned int unit) override;
 
+  GLuint GetTextureObject() const { return m_texture; }
+
   bool SupportsFormat(KD_TEX_FMT textureFormat, KD_TEX_SWIZ textureSwizzle) override
   {
     return true;
@@ -14,6 +14,13 @@
 #include "XBTFReader.h"
 #include "guilib/XBTF.h"
 #include "utils/EndianSwap.h"
+#include "utils/log.h"
+
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <system_error>
+#endif
 
 #ifdef TARGET_WINDOWS
 #include "filesystem/SpecialProtocol.h"
@@ -21,48 +28,74 @@
 #include "platform/win32/PlatformDefs.h"
 #endif
 
-static bool ReadString(FILE* file, char* str, size_t max_length)
+namespace
 {
-  if (file == nullptr || str == nullptr || max_length <= 0)
-    return false;
+// reads the header either from the mapped bundle or from the file
+class CHeaderReader
+{
+public:
+  CHeaderReader(const uint8_t* data, uint64_t size) : m_data(data), m_size(size) {}
+  explicit CHeaderReader(FILE* file) : m_file(file) {}
 
-  return (fread(str, max_length, 1, file) == 1);
-}
+  bool Read(void* buffer, size_t size)
+  {
+    if (m_data != nullptr)
+    {
+      if (size > m_size - m_position)
+        return false;
 
-static bool ReadChar(FILE* file, char& value)
-{
-  if (file == nullptr)
-    return false;
+      memcpy(buffer, m_data + m_position, size);
+      m_position += size;
+      return true;
+    }
 
-  if (fread(&value, sizeof(char), 1, file) != 1)
+    if (m_file == nullptr || fread(buffer, size, 1, m_file) != 1)
+      return false;
+
+    m_position += size;
+    return true;
+  }
+
+  uint64_t GetPosition() const { return m_position; }
+
+private:
+  const uint8_t* m_data = nullptr;
+  uint64_t m_size = 0;
+  FILE* m_file = nullptr;
+  uint64_t m_position = 0;
+};
+
+bool ReadString(CHeaderReader& reader, char* str, size_t max_length)
+{
+  if (str == nullptr || max_length <= 0)
     return false;
 
-  return true;
+  return reader.Read(str, max_length);
 }
 
-static bool ReadUInt32(FILE* file, uint32_t& value)
+bool ReadChar(CHeaderReader& reader, char& value)
 {
-  if (file == nullptr)
-    return false;
+  return reader.Read(&value, sizeof(char));
+}
 
-  if (fread(&value, sizeof(uint32_t), 1, file) != 1)
+bool ReadUInt32(CHeaderReader& reader, uint32_t& value)
+{
+  if (!reader.Read(&value, sizeof(uint32_t)))
     return false;
 
   value = Endian_SwapLE32(value);
   return true;
 }
 
-static bool ReadUInt64(FILE* file, uint64_t& value)
+bool ReadUInt64(CHeaderReader& reader, uint64_t& value)
 {
-  if (file == nullptr)
-    return false;
-
-  if (fread(&value, sizeof(uint64_t), 1, file) != 1)
+  if (!reader.Read(&value, sizeof(uint64_t)))
     return false;
 
   value = Endian_SwapLE64(value);
   return true;
 }
+} // unnamed namespace
 
 CXBTFReader::CXBTFReader()
   : CXBTFBase(),
@@ -91,9 +124,33 @@ bool CXBTFReader::Open(const std::string& path)
   if (m_file == nullptr)
     return false;
 
+#if defined(TARGET_POSIX)
+  // map the bundle so that frames can be read without seeking and copying them
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == 0 && fileStat.st_size > 0)
+  {
+    try
+    {
+      m_mapping = std::make_unique<KODI::UTILS::POSIX::CMmap>(
+          nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileno(m_file),
+          0);
+    }
+    catch (const std::system_error& e)
+    {
+      CLog::LogF(LOGDEBUG, "Unable to map {}, reading it instead: {}", m_path, e.what());
+    }
+  }
+
+  CHeaderReader reader =
+      m_mapping ? CHeaderReader(static_cast<const uint8_t*>(m_mapping->Data()), m_mapping->Size())
+                : CHeaderReader(m_file);
+#else
+  CHeaderReader reader(m_file);
+#endif
+
   // read the magic word
   char magic[4];
-  if (!ReadString(m_file, magic, sizeof(magic)))
+  if (!ReadString(reader, magic, sizeof(magic)))
     return false;
 
   if (strncmp(XBTF_MAGIC.c_str(), magic, sizeof(magic)) != 0)
@@ -101,14 +158,15 @@ bool CXBTFReader::Open(const std::string& path)
 
   // read the version
   char version;
-  if (!ReadChar(m_file, version))
+  if (!ReadChar(reader, version))
     return false;
 
-  if (version < XBTF_VERSION_MIN)
+  // newer bundles may pack their frames in ways we don't know about
+  if (version < XBTF_VERSION_MIN || version > XBTF_VERSION[0])
     return false;
 
   unsigned int nofFiles;
-  if (!ReadUInt32(m_file, nofFiles))
+  if (!ReadUInt32(reader, nofFiles))
     return false;
 
   for (uint32_t i = 0; i < nofFiles; i++)
@@ -119,47 +177,47 @@ bool CXBTFReader::Open(const std::string& path)
 
     // one extra char to null terminate the string
     char path[CXBTFFile::MaximumPathLength + 1] = {};
-    if (!ReadString(m_file, path, sizeof(path) - 1))
+    if (!ReadString(reader, path, sizeof(path) - 1))
       return false;
     xbtfFile.SetPath(path);
 
-    if (!ReadUInt32(m_file, u32))
+    if (!ReadUInt32(reader, u32))
       return false;
     xbtfFile.SetLoop(u32);
 
     unsigned int nofFrames;
-    if (!ReadUInt32(m_file, nofFrames))
+    if (!ReadUInt32(reader, nofFrames))
       return false;
 
     for (uint32_t j = 0; j < nofFrames; j++)
     {
       CXBTFFrame frame;
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(reader, u32))
         return false;
       frame.SetWidth(u32);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(reader, u32))
         return false;
       frame.SetHeight(u32);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(reader, u32))
         return false;
       frame.SetFormat(static_cast<XB_FMT>(u32));
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(reader, u64))
         return false;
       frame.SetPackedSize(u64);
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(reader, u64))
         return false;
       frame.SetUnpackedSize(u64);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(reader, u32))
         return false;
       frame.SetDuration(u32);
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(reader, u64))
         return false;
       frame.SetOffset(u64);
 
@@ -170,8 +228,7 @@ bool CXBTFReader::Open(const std::string& path)
   }
 
   // Sanity check
-  uint64_t pos = static_cast<uint64_t>(ftell(m_file));
-  if (pos != GetHeaderSize())
+  if (reader.GetPosition() != GetHeaderSize())
     return false;
 
   return true;
@@ -184,6 +241,10 @@ bool CXBTFReader::IsOpen() const
 
 void CXBTFReader::Close()
 {
+#if defined(TARGET_POSIX)
+  m_mapping.reset();
+#endif
+
   if (m_file != nullptr)
   {
     fclose(m_file);
@@ -206,11 +267,29 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
   return fileStat.st_mtime;
 }
 
+const uint8_t* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+#if defined(TARGET_POSIX)
+  if (m_mapping && frame.GetOffset() <= m_mapping->Size() &&
+      frame.GetPackedSize() <= m_mapping->Size() - frame.GetOffset())
+    return static_cast<const uint8_t*>(m_mapping->Data()) + frame.GetOffset();
+#endif
+
+  return nullptr;
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
   if (m_file == nullptr)
     return false;
 
+  const uint8_t* data = GetFrameData(frame);
+  if (data != nullptr)
+  {
+    memcpy(buffer, data, static_cast<size_t>(frame.GetPackedSize()));
+    return true;
+  }
+
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
   if (fseeko(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
 #elif defined(TARGET_ANDROID)
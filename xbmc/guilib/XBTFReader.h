@@ -15,6 +15,13 @@
 #include <string>
 #include <vector>
 
+#if defined(TARGET_POSIX)
+namespace KODI::UTILS::POSIX
+{
+class CMmap;
+}
+#endif
+
 class CXBTFReader : public CXBTFBase
 {
 public:
@@ -27,11 +34,22 @@ public:
 
   time_t GetLastModificationTimestamp() const;
 
+  /*!
+   \brief Get the (packed) data of a frame without copying it.
+   \param frame the frame
+   \return the data within the mapped bundle, or nullptr if the bundle is not mapped. Valid as
+   long as the bundle is open.
+   */
+  const uint8_t* GetFrameData(const CXBTFFrame& frame) const;
+
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
 private:
   std::string m_path;
   FILE* m_file = nullptr;
+#if defined(TARGET_POSIX)
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_mapping;
+#endif
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
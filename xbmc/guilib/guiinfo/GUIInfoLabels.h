@@ -502,6 +502,13 @@
 #define SYSTEM_PLATFORM_DARWIN_TVOS 755
 #define SYSTEM_SUPPORTED_HDR_TYPES  756
 #define SYSTEM_PLATFORM_WEBOS       757
+#define SYSTEM_FRAME_TIME_P50       758
+#define SYSTEM_FRAME_TIME_P95       759
+#define SYSTEM_FRAME_TIME_P99       760
+#define SYSTEM_FRAME_TIME_PROCESS   761
+#define SYSTEM_FRAME_TIME_RENDER    762
+#define SYSTEM_FRAME_TIME_PRESENT   763
+#define SYSTEM_FRAMES_OVER_BUDGET   764
 
 #define SLIDESHOW_ISPAUSED          800
 #define SLIDESHOW_ISRANDOM          801
@@ -230,6 +230,36 @@ bool CSystemGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case SYSTEM_FPS:
       value = StringUtils::Format("{:02.2f}", m_fps);
       return true;
+    case SYSTEM_FRAME_TIME_P50:
+    case SYSTEM_FRAME_TIME_P95:
+    case SYSTEM_FRAME_TIME_P99:
+    case SYSTEM_FRAME_TIME_PROCESS:
+    case SYSTEM_FRAME_TIME_RENDER:
+    case SYSTEM_FRAME_TIME_PRESENT:
+    case SYSTEM_FRAMES_OVER_BUDGET:
+    {
+      const CGUIWindowManager& windowManager = CServiceBroker::GetGUI()->GetWindowManager();
+      CGUIFrameStatistics::Summary summary;
+      if (!windowManager.GetFrameStatistics().GetSummary(windowManager.GetActiveWindowOrDialog(),
+                                                         summary))
+        return false;
+
+      if (info.m_info == SYSTEM_FRAME_TIME_P50)
+        value = StringUtils::Format("{:.2f}", summary.frameCost.p50);
+      else if (info.m_info == SYSTEM_FRAME_TIME_P95)
+        value = StringUtils::Format("{:.2f}", summary.frameCost.p95);
+      else if (info.m_info == SYSTEM_FRAME_TIME_P99)
+        value = StringUtils::Format("{:.2f}", summary.frameCost.p99);
+      else if (info.m_info == SYSTEM_FRAME_TIME_PROCESS)
+        value = StringUtils::Format("{:.2f}", summary.process.p95);
+      else if (info.m_info == SYSTEM_FRAME_TIME_RENDER)
+        value = StringUtils::Format("{:.2f}", summary.render.p95);
+      else if (info.m_info == SYSTEM_FRAME_TIME_PRESENT)
+        value = StringUtils::Format("{:.2f}", summary.present.p95);
+      else if (info.m_info == SYSTEM_FRAMES_OVER_BUDGET)
+        value = StringUtils::Format("{}%", summary.framesOverBudget * 100 / summary.frames);
+      return true;
+    }
 #ifdef HAS_OPTICAL_DRIVE
     case SYSTEM_DVD_LABEL:
       value = CServiceBroker::GetMediaManager().GetDiskLabel();
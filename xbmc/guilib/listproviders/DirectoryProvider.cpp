@@ -9,6 +9,7 @@
 #include "DirectoryProvider.h"
 
 #include "ContextMenuManager.h"
+#include "DirectoryProviderCache.h"
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "addons/AddonManager.h"
@@ -59,13 +60,15 @@ public:
                 SortDescription sort,
                 int limit,
                 CDirectoryProvider::BrowseMode browse,
-                int parentID)
+                int parentID,
+                CDirectoryProviderCache::Clock::time_point notBefore)
     : m_url(url),
       m_target(target),
       m_sort(sort),
       m_limit(limit),
       m_browse(browse),
-      m_parentID(parentID)
+      m_parentID(parentID),
+      m_notBefore(notBefore)
   { }
   ~CDirectoryJob() override = default;
 
@@ -83,22 +86,49 @@ public:
 
   bool DoWork() override
   {
-    CFileItemList items;
-    if (CDirectory::GetDirectory(m_url, items, "", DIR_FLAG_DEFAULTS))
+    CDirectoryProviderCache& cache = CServiceBroker::GetDirectoryProviderCache();
+    std::shared_ptr<const CFileItemList> listing;
+    bool paged = false;
+
+    // sorted and limited library nodes only need their first items, let the database get them
+    if (m_limit > 0 && m_sort.sortBy != SortByNone && CDirectoryProviderCache::IsPageable(m_url))
+    {
+      SortDescription sorting = m_sort;
+      sorting.limitEnd = static_cast<int>(m_limit);
+      listing = cache.GetDirectoryPage(m_url, sorting, m_notBefore);
+      paged = listing != nullptr;
+    }
+    if (!listing)
+      listing = cache.GetDirectory(m_url, m_notBefore);
+
+    // the listing is shared with other providers, so work on a copy
+    if (listing)
     {
+      CFileItemList items;
+      items.Copy(*listing);
+
       // sort the items if necessary
       if (m_sort.sortBy != SortByNone)
         items.Sort(m_sort);
 
+      // the number of items of the whole directory, even if only a page of it was retrieved
+      const int total =
+          paged ? std::max(static_cast<int>(items.GetProperty("total").asInteger()), items.Size())
+                : items.Size();
+
       // limit must not exceed the number of items
       int limit = (m_limit == 0) ? items.Size() : std::min(static_cast<int>(m_limit), items.Size());
-      if (limit < items.Size())
+      if (limit < total)
         m_items.reserve(limit + 1);
       else
         m_items.reserve(limit);
       // convert to CGUIStaticItem's and set visibility and targets
       for (int i = 0; i < limit; i++)
       {
+        // the provider moved on to another listing meanwhile
+        if (ShouldCancel(i, limit))
+          return false;
+
         CGUIStaticItemPtr item(new CGUIStaticItem(*items[i]));
         if (item->HasProperty("node.visible"))
           item->SetVisibleCondition(item->GetProperty("node.visible").asString(), m_parentID);
@@ -112,7 +142,7 @@ public:
         m_target = items.GetProperty("node.target").asString();
 
       if ((m_browse == CDirectoryProvider::BrowseMode::ALWAYS && !items.IsEmpty()) ||
-          (m_browse == CDirectoryProvider::BrowseMode::AUTO && limit < items.Size()))
+          (m_browse == CDirectoryProvider::BrowseMode::AUTO && limit < total))
       {
         // Add a special item to the end of the list, which can be used to open the
         // full listing containg all items in the given target window.
@@ -186,6 +216,7 @@ private:
   unsigned int m_limit;
   CDirectoryProvider::BrowseMode m_browse{CDirectoryProvider::BrowseMode::AUTO};
   int m_parentID;
+  CDirectoryProviderCache::Clock::time_point m_notBefore;
   std::vector<CGUIStaticItemPtr> m_items;
   std::map<InfoTagType, std::shared_ptr<CThumbLoader> > m_thumbloaders;
 };
@@ -261,8 +292,13 @@ bool CDirectoryProvider::Update(bool forceRefresh)
   fireJob &= !m_currentUrl.empty();
 
   std::unique_lock<CCriticalSection> lock(m_section);
+  // after an invalidation, listings retrieved before it must not be used
+  CDirectoryProviderCache::Clock::time_point notBefore;
   if (m_updateState == INVALIDATED)
+  {
     fireJob = true;
+    notBefore = m_invalidatedTime;
+  }
   else if (m_updateState == DONE)
     changed = true;
 
@@ -275,7 +311,7 @@ bool CDirectoryProvider::Update(bool forceRefresh)
       CServiceBroker::GetJobManager()->CancelJob(m_jobID);
     m_jobID = CServiceBroker::GetJobManager()->AddJob(
         new CDirectoryJob(m_currentUrl, m_target.GetLabel(m_parentID, false), m_currentSort,
-                          m_currentLimit, m_currentBrowse, m_parentID),
+                          m_currentLimit, m_currentBrowse, m_parentID, notBefore),
         this);
   }
 
@@ -311,7 +347,7 @@ void CDirectoryProvider::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
             m_currentSort.sortBy == SortByLastPlayed ||
             m_currentSort.sortBy == SortByDateAdded || m_currentSort.sortBy == SortByPlaycount ||
             m_currentSort.sortBy == SortByLastUsed)
-          m_updateState = INVALIDATED;
+          Invalidate();
       }
     }
     else
@@ -324,7 +360,7 @@ void CDirectoryProvider::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
       // to PENDING to fire off a new job in the next update
       if (message == "OnScanFinished" || message == "OnCleanFinished" || message == "OnUpdate" ||
           message == "OnRemove" || message == "OnRefresh")
-        m_updateState = INVALIDATED;
+        Invalidate();
     }
   }
 }
@@ -345,13 +381,8 @@ void CDirectoryProvider::OnAddonEvent(const ADDON::AddonEvent& event)
   std::unique_lock<CCriticalSection> lock(m_section);
   if (URIUtils::IsProtocol(m_currentUrl, "addons"))
   {
-    if (typeid(event) == typeid(ADDON::AddonEvents::Enabled) ||
-        typeid(event) == typeid(ADDON::AddonEvents::Disabled) ||
-        typeid(event) == typeid(ADDON::AddonEvents::ReInstalled) ||
-        typeid(event) == typeid(ADDON::AddonEvents::UnInstalled) ||
-        typeid(event) == typeid(ADDON::AddonEvents::MetadataChanged) ||
-        typeid(event) == typeid(ADDON::AddonEvents::AutoUpdateStateChanged))
-      m_updateState = INVALIDATED;
+    if (CDirectoryProviderCache::IsAddonsChange(event))
+      Invalidate();
   }
 }
 
@@ -360,7 +391,7 @@ void CDirectoryProvider::OnAddonRepositoryEvent(const ADDON::CRepositoryUpdater:
   std::unique_lock<CCriticalSection> lock(m_section);
   if (URIUtils::IsProtocol(m_currentUrl, "addons"))
   {
-    m_updateState = INVALIDATED;
+    Invalidate();
   }
 }
 
@@ -369,15 +400,8 @@ void CDirectoryProvider::OnPVRManagerEvent(const PVR::PVREvent& event)
   std::unique_lock<CCriticalSection> lock(m_section);
   if (URIUtils::IsProtocol(m_currentUrl, "pvr"))
   {
-    if (event == PVR::PVREvent::ManagerStarted || event == PVR::PVREvent::ManagerStopped ||
-        event == PVR::PVREvent::ManagerError || event == PVR::PVREvent::ManagerInterrupted ||
-        event == PVR::PVREvent::RecordingsInvalidated ||
-        event == PVR::PVREvent::TimersInvalidated ||
-        event == PVR::PVREvent::ChannelGroupsInvalidated ||
-        event == PVR::PVREvent::SavedSearchesInvalidated ||
-        event == PVR::PVREvent::ClientsInvalidated ||
-        event == PVR::PVREvent::ClientsPrioritiesInvalidated)
-      m_updateState = INVALIDATED;
+    if (CDirectoryProviderCache::IsPVRChange(event))
+      Invalidate();
   }
 }
 
@@ -385,7 +409,13 @@ void CDirectoryProvider::OnFavouritesEvent(const CFavouritesService::FavouritesU
 {
   std::unique_lock<CCriticalSection> lock(m_section);
   if (URIUtils::IsProtocol(m_currentUrl, "favourites"))
-    m_updateState = INVALIDATED;
+    Invalidate();
+}
+
+void CDirectoryProvider::Invalidate()
+{
+  m_updateState = INVALIDATED;
+  m_invalidatedTime = CDirectoryProviderCache::Clock::now();
 }
 
 void CDirectoryProvider::Reset()
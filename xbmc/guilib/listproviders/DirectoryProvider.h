@@ -17,6 +17,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,7 @@ public:
   void OnJobComplete(unsigned int jobID, bool success, CJob *job) override;
 private:
   UpdateState m_updateState = OK;
+  std::chrono::steady_clock::time_point m_invalidatedTime; ///< \brief when m_updateState was set to INVALIDATED
   unsigned int m_jobID = 0;
   KODI::GUILIB::GUIINFO::CGUIInfoLabel m_url;
   KODI::GUILIB::GUIINFO::CGUIInfoLabel m_target;
@@ -106,6 +108,7 @@ private:
   void OnAddonRepositoryEvent(const ADDON::CRepositoryUpdater::RepositoryUpdated& event);
   void OnPVRManagerEvent(const PVR::PVREvent& event);
   void OnFavouritesEvent(const CFavouritesService::FavouritesUpdated& event);
+  void Invalidate();
   std::string GetTarget(const CFileItem& item) const;
 
   CCriticalSection m_subscriptionSection;
@@ -0,0 +1,279 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DirectoryProviderCache.h"
+
+#include "FileItemList.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "addons/AddonManager.h"
+#include "filesystem/Directory.h"
+#include "filesystem/MusicDatabaseDirectory.h"
+#include "filesystem/VideoDatabaseDirectory.h"
+#include "interfaces/AnnouncementManager.h"
+#include "pvr/PVRManager.h"
+#include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <typeinfo>
+#include <utility>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr size_t MAX_ENTRIES = 50;
+constexpr auto MAX_AGE = std::chrono::minutes(5);
+} // unnamed namespace
+
+CDirectoryProviderCache::CDirectoryProviderCache(Fetcher fetcher, PageFetcher pageFetcher)
+  : m_fetcher(fetcher ? std::move(fetcher)
+                      : [](const std::string& url, CFileItemList& items)
+                    { return CDirectory::GetDirectory(url, items, "", DIR_FLAG_DEFAULTS); }),
+    m_pageFetcher(pageFetcher ? std::move(pageFetcher)
+                              : [](const std::string& url, const SortDescription& sorting,
+                                   CFileItemList& items)
+                  {
+                    if (URIUtils::IsProtocol(url, "musicdb"))
+                      return CMusicDatabaseDirectory::GetDirectoryPage(CURL(url), sorting, items);
+                    return CVideoDatabaseDirectory::GetDirectoryPage(CURL(url), sorting, items);
+                  })
+{
+}
+
+CDirectoryProviderCache::~CDirectoryProviderCache()
+{
+  Deinitialize();
+}
+
+void CDirectoryProviderCache::Initialize()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_initialized)
+    return;
+
+  m_initialized = true;
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(
+      this, ANNOUNCEMENT::VideoLibrary | ANNOUNCEMENT::AudioLibrary | ANNOUNCEMENT::Player);
+  CServiceBroker::GetAddonMgr().Events().Subscribe(this, &CDirectoryProviderCache::OnAddonEvent);
+  CServiceBroker::GetRepositoryUpdater().Events().Subscribe(
+      this, &CDirectoryProviderCache::OnAddonRepositoryEvent);
+  CServiceBroker::GetPVRManager().Events().Subscribe(this,
+                                                     &CDirectoryProviderCache::OnPVRManagerEvent);
+  CServiceBroker::GetFavouritesService().Events().Subscribe(
+      this, &CDirectoryProviderCache::OnFavouritesEvent);
+}
+
+void CDirectoryProviderCache::Deinitialize()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (!m_initialized)
+      return;
+
+    m_initialized = false;
+  }
+
+  CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
+  CServiceBroker::GetFavouritesService().Events().Unsubscribe(this);
+  CServiceBroker::GetRepositoryUpdater().Events().Unsubscribe(this);
+  CServiceBroker::GetAddonMgr().Events().Unsubscribe(this);
+  CServiceBroker::GetPVRManager().Events().Unsubscribe(this);
+
+  Clear();
+}
+
+CDirectoryProviderCache::Source CDirectoryProviderCache::GetSource(const std::string& url)
+{
+  if (URIUtils::IsProtocol(url, "addons"))
+    return Source::ADDONS;
+  if (URIUtils::IsProtocol(url, "pvr"))
+    return Source::PVR;
+  if (URIUtils::IsProtocol(url, "favourites"))
+    return Source::FAVOURITES;
+  return Source::LIBRARY;
+}
+
+bool CDirectoryProviderCache::IsPageable(const std::string& url)
+{
+  return URIUtils::IsProtocol(url, "musicdb") || URIUtils::IsProtocol(url, "videodb");
+}
+
+std::shared_ptr<const CFileItemList> CDirectoryProviderCache::GetDirectory(
+    const std::string& url, Clock::time_point notBefore)
+{
+  return Get(url, url, [this, &url](CFileItemList& items) { return m_fetcher(url, items); },
+             notBefore);
+}
+
+std::shared_ptr<const CFileItemList> CDirectoryProviderCache::GetDirectoryPage(
+    const std::string& url, const SortDescription& sorting, Clock::time_point notBefore)
+{
+  if (!IsPageable(url))
+    return {};
+
+  const auto fetch = [this, &url, &sorting](CFileItemList& items)
+  { return m_pageFetcher(url, sorting, items); };
+
+  // every request for a random page gets a different one
+  if (sorting.sortBy == SortByRandom)
+  {
+    auto items = std::make_shared<CFileItemList>();
+    if (!fetch(*items))
+      return {};
+    return items;
+  }
+
+  const std::string key = StringUtils::Format(
+      "{}|sortby={}|sortorder={}|sortattributes={}|start={}|end={}", url,
+      static_cast<int>(sorting.sortBy), static_cast<int>(sorting.sortOrder),
+      static_cast<int>(sorting.sortAttributes), sorting.limitStart, sorting.limitEnd);
+  return Get(key, url, fetch, notBefore);
+}
+
+std::shared_ptr<const CFileItemList> CDirectoryProviderCache::Get(
+    const std::string& key,
+    const std::string& url,
+    const std::function<bool(CFileItemList&)>& fetch,
+    Clock::time_point notBefore)
+{
+  std::shared_future<std::shared_ptr<const CFileItemList>> items;
+  std::promise<std::shared_ptr<const CFileItemList>> promise;
+  bool retrieve = false;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    const Clock::time_point now = Clock::now();
+    notBefore = std::max({notBefore, m_changed[static_cast<size_t>(GetSource(url))], now - MAX_AGE});
+
+    Entry& entry = m_entries[key];
+    entry.lastAccess = ++m_accessCount;
+
+    // a failed retrieval is not reused, but waiters for a retrieval in progress share its result
+    const bool failed = entry.items.valid() &&
+                        entry.items.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                        !entry.items.get();
+    if (!entry.items.valid() || failed || entry.fetched <= notBefore)
+    {
+      retrieve = true;
+      entry.items = promise.get_future().share();
+      entry.fetched = now;
+
+      while (m_entries.size() > MAX_ENTRIES)
+      {
+        const auto oldest = std::min_element(m_entries.begin(), m_entries.end(),
+                                             [](const auto& entry1, const auto& entry2) {
+                                               return entry1.second.lastAccess <
+                                                      entry2.second.lastAccess;
+                                             });
+        m_entries.erase(oldest);
+      }
+    }
+    items = entry.items;
+  }
+
+  if (retrieve)
+  {
+    auto result = std::make_shared<CFileItemList>();
+    if (fetch(*result))
+    {
+      promise.set_value(std::move(result));
+    }
+    else
+    {
+      CLog::LogF(LOGDEBUG, "Unable to retrieve directory {}", CURL::GetRedacted(url));
+      promise.set_value({});
+    }
+  }
+
+  return items.get();
+}
+
+void CDirectoryProviderCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  // retrievals in progress finish for their waiters, but are not reused
+  m_entries.clear();
+}
+
+void CDirectoryProviderCache::SetChanged(Source source)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_changed[static_cast<size_t>(source)] = Clock::now();
+}
+
+void CDirectoryProviderCache::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                                       const std::string& sender,
+                                       const std::string& message,
+                                       const CVariant& data)
+{
+  if (flag & ANNOUNCEMENT::Player)
+  {
+    // listings like in progress or recently played items change with playback
+    if (message == "OnPlay" || message == "OnResume" || message == "OnStop")
+      SetChanged(Source::LIBRARY);
+  }
+  else
+  {
+    if (data.isMember("transaction") && data["transaction"].asBoolean())
+      return;
+
+    if (message == "OnScanFinished" || message == "OnCleanFinished" || message == "OnUpdate" ||
+        message == "OnRemove" || message == "OnRefresh")
+      SetChanged(Source::LIBRARY);
+  }
+}
+
+bool CDirectoryProviderCache::IsAddonsChange(const ADDON::AddonEvent& event)
+{
+  return typeid(event) == typeid(ADDON::AddonEvents::Enabled) ||
+         typeid(event) == typeid(ADDON::AddonEvents::Disabled) ||
+         typeid(event) == typeid(ADDON::AddonEvents::ReInstalled) ||
+         typeid(event) == typeid(ADDON::AddonEvents::UnInstalled) ||
+         typeid(event) == typeid(ADDON::AddonEvents::MetadataChanged) ||
+         typeid(event) == typeid(ADDON::AddonEvents::AutoUpdateStateChanged);
+}
+
+bool CDirectoryProviderCache::IsPVRChange(const PVR::PVREvent& event)
+{
+  return event == PVR::PVREvent::ManagerStarted || event == PVR::PVREvent::ManagerStopped ||
+         event == PVR::PVREvent::ManagerError || event == PVR::PVREvent::ManagerInterrupted ||
+         event == PVR::PVREvent::RecordingsInvalidated ||
+         event == PVR::PVREvent::TimersInvalidated ||
+         event == PVR::PVREvent::ChannelGroupsInvalidated ||
+         event == PVR::PVREvent::SavedSearchesInvalidated ||
+         event == PVR::PVREvent::ClientsInvalidated ||
+         event == PVR::PVREvent::ClientsPrioritiesInvalidated;
+}
+
+void CDirectoryProviderCache::OnAddonEvent(const ADDON::AddonEvent& event)
+{
+  if (IsAddonsChange(event))
+    SetChanged(Source::ADDONS);
+}
+
+void CDirectoryProviderCache::OnAddonRepositoryEvent(
+    const ADDON::CRepositoryUpdater::RepositoryUpdated& event)
+{
+  SetChanged(Source::ADDONS);
+}
+
+void CDirectoryProviderCache::OnPVRManagerEvent(const PVR::PVREvent& event)
+{
+  if (IsPVRChange(event))
+    SetChanged(Source::PVR);
+}
+
+void CDirectoryProviderCache::OnFavouritesEvent(const CFavouritesService::FavouritesUpdated& event)
+{
+  SetChanged(Source::FAVOURITES);
+}
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "addons/AddonEvents.h"
+#include "addons/RepositoryUpdater.h"
+#include "favourites/FavouritesService.h"
+#include "interfaces/IAnnouncer.h"
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+
+class CFileItemList;
+class CVariant;
+struct SortDescription;
+
+namespace PVR
+{
+enum class PVREvent;
+}
+
+/*!
+ * @brief Directory listings shared by all directory list providers (e.g. home screen widgets).
+ *
+ * Widgets showing the same path, in the same or in different windows, use the same listing
+ * instead of each retrieving and parsing it on its own. Concurrent requests for the same path are
+ * served by a single retrieval.
+ *
+ * A listing is reused as long as it was retrieved after the last change to its source (library,
+ * add-ons, PVR or favourites) and is not older than a few minutes. Providers being invalidated
+ * themselves pass the time of their invalidation, so that they never get an older listing.
+ *
+ * Providers showing only the first items of a library node can get just these items, sorted and
+ * limited by the database, instead of the whole listing.
+ */
+class CDirectoryProviderCache : public ANNOUNCEMENT::IAnnouncer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Fetcher = std::function<bool(const std::string& url, CFileItemList& items)>;
+  using PageFetcher = std::function<bool(
+      const std::string& url, const SortDescription& sorting, CFileItemList& items)>;
+
+  /*!
+   * @brief Create the cache.
+   * @param fetcher Retrieves a directory listing. Defaults to CDirectory::GetDirectory.
+   * @param pageFetcher Retrieves a page of a library node. Defaults to
+   * CMusicDatabaseDirectory::GetDirectoryPage and CVideoDatabaseDirectory::GetDirectoryPage.
+   */
+  explicit CDirectoryProviderCache(Fetcher fetcher = {}, PageFetcher pageFetcher = {});
+  ~CDirectoryProviderCache() override;
+
+  /*!
+   * @brief Start tracking changes to the sources of the listings.
+   */
+  void Initialize();
+
+  /*!
+   * @brief Stop tracking changes and drop all listings.
+   */
+  void Deinitialize();
+
+  // IAnnouncer implementation
+  void Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override;
+
+  /*!
+   * @brief Get the listing of a directory, from the cache if possible. Waits for a retrieval of the
+   * same directory already in progress instead of starting another one.
+   * @param url The directory.
+   * @param notBefore Only listings retrieved after this time are acceptable.
+   * @return The listing (must not be modified) or nullptr if the directory could not be retrieved.
+   */
+  std::shared_ptr<const CFileItemList> GetDirectory(const std::string& url,
+                                                    Clock::time_point notBefore);
+
+  /*!
+   * @brief Get a page of the items of a library node, from the cache if possible. Pages are
+   * shared and refreshed like complete listings, except randomly sorted ones.
+   * @param url The library node.
+   * @param sorting The sort method, order and attributes and the range of items to get.
+   * @param notBefore Only pages retrieved after this time are acceptable.
+   * @return The page (must not be modified), its "total" property holding the number of items of
+   * the whole node, or nullptr if the node can not be paged.
+   */
+  std::shared_ptr<const CFileItemList> GetDirectoryPage(const std::string& url,
+                                                        const SortDescription& sorting,
+                                                        Clock::time_point notBefore);
+
+  /*!
+   * @brief Check whether pages of the given directory can be requested.
+   */
+  static bool IsPageable(const std::string& url);
+
+  /*!
+   * @brief Drop all listings, e.g. because another profile was loaded.
+   */
+  void Clear();
+
+  /*!
+   * @brief Check whether the given add-on event changes addons:// listings.
+   */
+  static bool IsAddonsChange(const ADDON::AddonEvent& event);
+
+  /*!
+   * @brief Check whether the given PVR event changes pvr:// listings.
+   */
+  static bool IsPVRChange(const PVR::PVREvent& event);
+
+private:
+  CDirectoryProviderCache(const CDirectoryProviderCache&) = delete;
+  CDirectoryProviderCache& operator=(const CDirectoryProviderCache&) = delete;
+
+  enum class Source
+  {
+    LIBRARY, //!< media library and everything else refreshed on library changes and playback
+    ADDONS,
+    PVR,
+    FAVOURITES,
+    COUNT
+  };
+
+  struct Entry
+  {
+    std::shared_future<std::shared_ptr<const CFileItemList>> items;
+    Clock::time_point fetched; //!< when the retrieval was started
+    unsigned int lastAccess{0};
+  };
+
+  static Source GetSource(const std::string& url);
+  std::shared_ptr<const CFileItemList> Get(const std::string& key,
+                                           const std::string& url,
+                                           const std::function<bool(CFileItemList&)>& fetch,
+                                           Clock::time_point notBefore);
+  void SetChanged(Source source);
+  void OnAddonEvent(const ADDON::AddonEvent& event);
+  void OnAddonRepositoryEvent(const ADDON::CRepositoryUpdater::RepositoryUpdated& event);
+  void OnPVRManagerEvent(const PVR::PVREvent& event);
+  void OnFavouritesEvent(const CFavouritesService::FavouritesUpdated& event);
+
+  const Fetcher m_fetcher;
+  const PageFetcher m_pageFetcher;
+  mutable CCriticalSection m_critSection;
+  std::map<std::string, Entry> m_entries;
+  std::array<Clock::time_point, static_cast<size_t>(Source::COUNT)> m_changed{};
+  unsigned int m_accessCount{0};
+  bool m_initialized{false};
+};
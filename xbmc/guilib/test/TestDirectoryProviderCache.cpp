@@ -0,0 +1,187 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "guilib/listproviders/DirectoryProviderCache.h"
+#include "utils/SortUtils.h"
+#include "utils/Variant.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::string LIBRARY_URL = "videodb://recentlyaddedmovies/";
+const std::string PVR_URL = "pvr://channels/tv/";
+
+class TestDirectoryProviderCache : public testing::Test
+{
+protected:
+  TestDirectoryProviderCache()
+    : m_cache(
+          [this](const std::string& url, CFileItemList& items)
+          {
+            ++m_fetches;
+            if (m_fail)
+              return false;
+            items.Add(std::make_shared<CFileItem>(url));
+            return true;
+          },
+          [this](const std::string& url, const SortDescription& sorting, CFileItemList& items)
+          {
+            ++m_pageFetches;
+            for (int i = sorting.limitStart; i < sorting.limitEnd; ++i)
+              items.Add(std::make_shared<CFileItem>(url + std::to_string(i)));
+            items.SetProperty("total", 100);
+            return true;
+          })
+  {
+  }
+
+  void Announce(const std::string& message)
+  {
+    m_cache.Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", message, CVariant());
+  }
+
+  CDirectoryProviderCache m_cache;
+  std::atomic<int> m_fetches{0};
+  std::atomic<int> m_pageFetches{0};
+  bool m_fail{false};
+};
+} // unnamed namespace
+
+TEST_F(TestDirectoryProviderCache, Shared)
+{
+  const auto items = m_cache.GetDirectory(LIBRARY_URL, {});
+  ASSERT_NE(nullptr, items);
+  EXPECT_EQ(1, items->Size());
+  EXPECT_EQ(items, m_cache.GetDirectory(LIBRARY_URL, {}));
+  EXPECT_EQ(1, m_fetches);
+
+  m_cache.GetDirectory(PVR_URL, {});
+  EXPECT_EQ(2, m_fetches);
+
+  m_cache.Clear();
+  EXPECT_NE(items, m_cache.GetDirectory(LIBRARY_URL, {}));
+  EXPECT_EQ(3, m_fetches);
+}
+
+TEST_F(TestDirectoryProviderCache, Invalidation)
+{
+  const auto items = m_cache.GetDirectory(LIBRARY_URL, {});
+  m_cache.GetDirectory(PVR_URL, {});
+
+  // an invalidated provider doesn't get a listing retrieved before its invalidation
+  const auto invalidated = CDirectoryProviderCache::Clock::now();
+  const auto refreshed = m_cache.GetDirectory(LIBRARY_URL, invalidated);
+  EXPECT_NE(items, refreshed);
+  EXPECT_EQ(3, m_fetches);
+
+  // ...but other providers invalidated at the same time share the refreshed listing
+  EXPECT_EQ(refreshed, m_cache.GetDirectory(LIBRARY_URL, invalidated));
+  EXPECT_EQ(3, m_fetches);
+
+  // library changes made during a scan don't count, the end of the scan does
+  CVariant data;
+  data["transaction"] = true;
+  m_cache.Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnUpdate", data);
+  EXPECT_EQ(refreshed, m_cache.GetDirectory(LIBRARY_URL, {}));
+
+  Announce("OnScanFinished");
+  EXPECT_NE(refreshed, m_cache.GetDirectory(LIBRARY_URL, {}));
+  EXPECT_EQ(4, m_fetches);
+
+  // other sources are not affected by library changes
+  m_cache.GetDirectory(PVR_URL, {});
+  EXPECT_EQ(4, m_fetches);
+}
+
+TEST_F(TestDirectoryProviderCache, FailureNotCached)
+{
+  m_fail = true;
+  EXPECT_EQ(nullptr, m_cache.GetDirectory(LIBRARY_URL, {}));
+
+  m_fail = false;
+  EXPECT_NE(nullptr, m_cache.GetDirectory(LIBRARY_URL, {}));
+  EXPECT_EQ(2, m_fetches);
+}
+
+TEST_F(TestDirectoryProviderCache, Pages)
+{
+  SortDescription sorting;
+  sorting.sortBy = SortByDateAdded;
+  sorting.sortOrder = SortOrderDescending;
+  sorting.limitEnd = 10;
+
+  const auto page = m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {});
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(10, page->Size());
+  EXPECT_EQ(100, page->GetProperty("total").asInteger());
+  EXPECT_EQ(page, m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {}));
+  EXPECT_EQ(1, m_pageFetches);
+
+  // pages are neither shared with other pages nor with the complete listing
+  sorting.limitEnd = 20;
+  EXPECT_NE(page, m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {}));
+  EXPECT_EQ(2, m_pageFetches);
+  m_cache.GetDirectory(LIBRARY_URL, {});
+  EXPECT_EQ(1, m_fetches);
+
+  // pages are refreshed with the library
+  sorting.limitEnd = 10;
+  Announce("OnUpdate");
+  EXPECT_NE(page, m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {}));
+  EXPECT_EQ(3, m_pageFetches);
+
+  // random pages are never reused
+  sorting.sortBy = SortByRandom;
+  EXPECT_NE(m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {}),
+            m_cache.GetDirectoryPage(LIBRARY_URL, sorting, {}));
+  EXPECT_EQ(5, m_pageFetches);
+
+  // only library nodes can be paged
+  EXPECT_EQ(nullptr, m_cache.GetDirectoryPage(PVR_URL, sorting, {}));
+  EXPECT_EQ(5, m_pageFetches);
+}
+
+TEST_F(TestDirectoryProviderCache, ConcurrentRequests)
+{
+  std::promise<void> entered;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+
+  CDirectoryProviderCache cache(
+      [&](const std::string& url, CFileItemList& items)
+      {
+        ++m_fetches;
+        entered.set_value();
+        released.wait();
+        items.Add(std::make_shared<CFileItem>(url));
+        return true;
+      });
+
+  auto first = std::async(std::launch::async,
+                          [&cache]() { return cache.GetDirectory(LIBRARY_URL, {}); });
+  entered.get_future().wait();
+
+  // requests for a listing being retrieved wait for that retrieval
+  auto second = std::async(std::launch::async,
+                           [&cache]() { return cache.GetDirectory(LIBRARY_URL, {}); });
+  release.set_value();
+
+  const auto items = first.get();
+  ASSERT_NE(nullptr, items);
+  EXPECT_EQ(items, second.get());
+  EXPECT_EQ(1, m_fetches);
+}
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIFrameStatistics.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int WINDOW_A = 10000;
+constexpr int WINDOW_B = 10001;
+constexpr auto NO_BUDGET = std::chrono::hours(1);
+
+void AddFrame(CGUIFrameStatistics& statistics,
+              int window,
+              std::chrono::steady_clock::duration process,
+              std::chrono::steady_clock::duration render,
+              std::chrono::steady_clock::duration budget = NO_BUDGET)
+{
+  statistics.AddStageTime(CGUIFrameStatistics::Stage::PROCESS, process);
+  statistics.AddStageTime(CGUIFrameStatistics::Stage::RENDER, render);
+  statistics.AddStageTime(CGUIFrameStatistics::Stage::PRESENT, 100us);
+  statistics.EndFrame(window, true, budget);
+}
+
+// percentiles are estimated to about 9%
+void ExpectTime(double expected, double milliseconds)
+{
+  EXPECT_GE(milliseconds, expected);
+  EXPECT_LE(milliseconds, expected * 1.1);
+}
+} // unnamed namespace
+
+TEST(TestGUIFrameStatistics, Percentiles)
+{
+  CGUIFrameStatistics statistics;
+  for (int i = 0; i < 90; i++)
+    AddFrame(statistics, WINDOW_A, 1ms, 2ms);
+  for (int i = 0; i < 10; i++)
+    AddFrame(statistics, WINDOW_A, 10ms, 20ms);
+
+  const CGUIFrameStatistics::Summary summary = statistics.GetSummary();
+  EXPECT_EQ(100u, summary.frames);
+  EXPECT_EQ(0u, summary.framesOverBudget);
+  ExpectTime(1.0, summary.process.p50);
+  ExpectTime(10.0, summary.process.p95);
+  ExpectTime(2.0, summary.render.p50);
+  ExpectTime(20.0, summary.render.p99);
+  ExpectTime(0.1, summary.present.p99);
+  ExpectTime(3.0, summary.frameCost.p50);
+  ExpectTime(30.0, summary.frameCost.p95);
+}
+
+TEST(TestGUIFrameStatistics, Windows)
+{
+  CGUIFrameStatistics statistics;
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms);
+  AddFrame(statistics, WINDOW_B, 5ms, 5ms);
+  AddFrame(statistics, WINDOW_B, 5ms, 5ms);
+
+  // frames which didn't render anything aren't recorded
+  statistics.AddStageTime(CGUIFrameStatistics::Stage::PROCESS, 1s);
+  statistics.EndFrame(WINDOW_A, false, NO_BUDGET);
+
+  const std::vector<int> windows = statistics.GetWindows();
+  ASSERT_EQ(2u, windows.size());
+  EXPECT_EQ(WINDOW_A, windows[0]);
+  EXPECT_EQ(WINDOW_B, windows[1]);
+
+  CGUIFrameStatistics::Summary summary;
+  ASSERT_TRUE(statistics.GetSummary(WINDOW_A, summary));
+  EXPECT_EQ(1u, summary.frames);
+  ExpectTime(1.0, summary.process.p99);
+  ASSERT_TRUE(statistics.GetSummary(WINDOW_B, summary));
+  EXPECT_EQ(2u, summary.frames);
+  ExpectTime(10.0, summary.frameCost.p50);
+  EXPECT_EQ(3u, statistics.GetSummary().frames);
+
+  statistics.Reset();
+  EXPECT_FALSE(statistics.GetSummary(WINDOW_A, summary));
+  EXPECT_EQ(0u, statistics.GetSummary().frames);
+}
+
+TEST(TestGUIFrameStatistics, RollingHistory)
+{
+  CGUIFrameStatistics statistics;
+  for (size_t i = 0; i < CGUIFrameStatistics::HISTORY_SIZE; i++)
+    AddFrame(statistics, WINDOW_A, 50ms, 0ms);
+  for (size_t i = 0; i < CGUIFrameStatistics::HISTORY_SIZE; i++)
+    AddFrame(statistics, WINDOW_A, 1ms, 0ms);
+
+  // the slow frames dropped out of the history
+  const CGUIFrameStatistics::Summary summary = statistics.GetSummary();
+  EXPECT_EQ(CGUIFrameStatistics::HISTORY_SIZE, summary.frames);
+  ExpectTime(1.0, summary.process.p99);
+}
+
+TEST(TestGUIFrameStatistics, OverBudget)
+{
+  CGUIFrameStatistics statistics;
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms, 1ms);
+  std::this_thread::sleep_for(5ms);
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms, 1ms);
+  EXPECT_EQ(1u, statistics.GetSummary().framesOverBudget);
+
+  // a frame following a frame which didn't render anything isn't late
+  statistics.EndFrame(WINDOW_A, false, 1ms);
+  std::this_thread::sleep_for(5ms);
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms, 1ms);
+  EXPECT_EQ(1u, statistics.GetSummary().framesOverBudget);
+
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms);
+  EXPECT_EQ(1u, statistics.GetSummary().framesOverBudget);
+}
+
+TEST(TestGUIFrameStatistics, DrawCalls)
+{
+  CGUIFrameStatistics statistics;
+  statistics.AddDrawCalls(10, 100);
+  AddFrame(statistics, WINDOW_A, 1ms, 1ms);
+  statistics.AddDrawCalls(20, 200);
+  statistics.AddDrawCalls(10, 100);
+  AddFrame(statistics, WINDOW_B, 1ms, 1ms);
+
+  // the draw calls of a frame which didn't render anything are dropped
+  statistics.AddDrawCalls(1000, 1000);
+  statistics.EndFrame(WINDOW_A, false, NO_BUDGET);
+
+  CGUIFrameStatistics::Summary summary = statistics.GetSummary();
+  EXPECT_DOUBLE_EQ(20.0, summary.drawCalls);
+  EXPECT_DOUBLE_EQ(200.0, summary.quads);
+  ASSERT_TRUE(statistics.GetSummary(WINDOW_B, summary));
+  EXPECT_DOUBLE_EQ(30.0, summary.drawCalls);
+  EXPECT_DOUBLE_EQ(300.0, summary.quads);
+}
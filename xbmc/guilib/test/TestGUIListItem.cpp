@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "guilib/GUIListItem.h"
+#include "music/tags/MusicInfoTag.h"
+#include "test/Benchmark.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
+
+#include <memory>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <gtest/gtest.h>
+
+TEST(TestGUIListItem, Properties)
+{
+  CGUIListItem item;
+  EXPECT_FALSE(item.HasProperties());
+
+  item.SetProperty("b", 2);
+  item.SetProperty("a", "1");
+  item.SetProperty("C", 3.0);
+  EXPECT_TRUE(item.HasProperties());
+  EXPECT_EQ("1", item.GetProperty("a").asString());
+  EXPECT_EQ(2, item.GetProperty("b").asInteger());
+
+  // keys are not case sensitive
+  EXPECT_TRUE(item.HasProperty("c"));
+  item.SetProperty("B", 4);
+  EXPECT_EQ(4, item.GetProperty("b").asInteger());
+  item.IncrementProperty("b", 1);
+  EXPECT_EQ(5, item.GetProperty("B").asInteger());
+
+  item.ClearProperty("A");
+  EXPECT_FALSE(item.HasProperty("a"));
+  EXPECT_TRUE(item.GetProperty("a").isNull());
+
+  CGUIListItem other;
+  other.SetProperty("c", 6);
+  other.SetProperty("d", 7);
+  other.AppendProperties(item);
+  EXPECT_EQ(3.0, other.GetProperty("c").asDouble());
+  EXPECT_EQ(7, other.GetProperty("d").asInteger());
+
+  CVariant serialized;
+  other.Serialize(serialized);
+  EXPECT_EQ(3u, serialized["properties"].size());
+  EXPECT_TRUE(serialized["properties"].isMember("b"));
+
+  other.ClearProperties();
+  EXPECT_FALSE(other.HasProperties());
+}
+
+TEST(TestGUIListItem, Art)
+{
+  CGUIListItem item;
+  item.SetArt("thumb", "thumb.jpg");
+  item.SetArt({{"poster", "poster.jpg"}, {"fanart", "fanart.jpg"}});
+  EXPECT_FALSE(item.HasArt("thumb"));
+  EXPECT_EQ("poster.jpg", item.GetArt("poster"));
+
+  item.AppendArt({{"poster", "show.jpg"}}, "tvshow");
+  item.SetArt("fanart", "");
+  const CGUIListItem::ArtMap expected{
+      {"fanart", ""}, {"poster", "poster.jpg"}, {"tvshow.poster", "show.jpg"}};
+  EXPECT_EQ(expected, item.GetArt());
+  EXPECT_FALSE(item.HasArt("fanart"));
+
+  item.SetArtFallback("thumb", "poster");
+  EXPECT_EQ("poster.jpg", item.GetArt("thumb"));
+  item.SetArt("thumb", "thumb.jpg");
+  EXPECT_EQ("thumb.jpg", item.GetArt("thumb"));
+
+  CGUIListItem copy(item);
+  item.ClearArt();
+  EXPECT_FALSE(item.HasArt());
+  EXPECT_TRUE(copy.HasArt());
+  EXPECT_EQ("thumb.jpg", copy.GetArt("thumb"));
+}
+
+TEST(TestGUIListItem, SharedAndOwnKeys)
+{
+  // "thumb" and "IsPlayable" are shared, the add-on keys are stored with the item
+  CGUIListItem item;
+  item.SetArt("thumb", "thumb.jpg");
+  item.SetArt("addon.art", "addon.jpg");
+  item.SetProperty("IsPlayable", "true");
+  item.SetProperty("addon.property", 1);
+
+  CGUIListItem copy(item);
+  item.SetArt("addon.art", "other.jpg");
+  item.ClearProperty("addon.property");
+
+  const CGUIListItem::ArtMap expected{{"addon.art", "addon.jpg"}, {"thumb", "thumb.jpg"}};
+  EXPECT_EQ(expected, copy.GetArt());
+  EXPECT_EQ("other.jpg", item.GetArt("addon.art"));
+  EXPECT_EQ(1, copy.GetProperty("ADDON.property").asInteger());
+  EXPECT_FALSE(item.HasProperty("addon.property"));
+  EXPECT_EQ("true", copy.GetProperty("isplayable").asString());
+}
+
+// Memory needed by large lists, e.g. a library of 100k songs or movies
+TEST(TestGUIListItem, DISABLED_MemoryBenchmark)
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  constexpr int ITEMS = 100000;
+
+  const auto populate = [](CFileItemList& items, bool songs)
+  {
+    for (int i = 0; i < ITEMS; ++i)
+    {
+      const std::string id = std::to_string(i);
+      auto item = std::make_shared<CFileItem>(id);
+      if (songs)
+      {
+        item->SetPath("musicdb://songs/" + id + ".flac");
+        item->GetMusicInfoTag()->SetTitle("Song " + id);
+        item->GetMusicInfoTag()->SetDatabaseId(i, MediaTypeSong);
+        item->SetArt({{"thumb", "image://music/" + id + ".jpg/"},
+                      {"album.thumb", "image://music/" + id + ".jpg/"}});
+      }
+      else
+      {
+        item->SetPath("videodb://movies/titles/" + id);
+        item->GetVideoInfoTag()->m_strTitle = "Movie " + id;
+        item->GetVideoInfoTag()->m_iDbId = i;
+        item->GetVideoInfoTag()->m_type = MediaTypeMovie;
+        item->SetArt({{"fanart", "image://video/" + id + "-fanart.jpg/"},
+                      {"poster", "image://video/" + id + "-poster.jpg/"},
+                      {"thumb", "image://video/" + id + "-thumb.jpg/"}});
+        item->SetProperty("hasvideoversions", false);
+        item->SetProperty("hasvideoextras", false);
+      }
+      item->SetProperty("dbid", i);
+      items.Add(std::move(item));
+    }
+  };
+
+  for (bool songs : {true, false})
+  {
+    const size_t before = mallinfo2().uordblks;
+    {
+      CFileItemList items;
+      populate(items, songs);
+      const size_t used = mallinfo2().uordblks - before;
+      Benchmark::Report(songs ? "CFileItemList of songs" : "CFileItemList of movies",
+                        static_cast<double>(used) / ITEMS, "bytes/item");
+    }
+  }
+#else
+  GTEST_SKIP() << "Memory usage is only available with glibc";
+#endif
+}
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIQuadBatch.h"
+#include "test/Benchmark.h"
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct TestState
+{
+  int texture;
+
+  bool operator==(const TestState& other) const { return texture == other.texture; }
+};
+
+struct TestVertex
+{
+  float x, y, z;
+  int quad;
+};
+
+using Batch = CGUIQuadBatch<TestState, TestVertex>;
+
+struct Result
+{
+  int texture;
+  std::vector<int> quads;
+};
+
+// a quad, or a label if there is no texture
+struct Element
+{
+  int texture;
+  CRect rect;
+};
+
+// a window with a side menu and a list of 15 items with an icon and two labels, as drawn by a skin
+std::vector<Element> MakeListWindow()
+{
+  constexpr int BACKGROUND = 1;
+  constexpr int BUTTON = 2;
+  constexpr int ICON = 3;
+  constexpr int LABEL = 0;
+
+  std::vector<Element> elements{{BACKGROUND, {0, 0, 1920, 1080}}, {BACKGROUND, {0, 0, 400, 1080}}};
+  for (int i = 0; i < 8; i++)
+  {
+    const float y = 100.0f + i * 70.0f;
+    elements.push_back({BUTTON, {0, y, 400, y + 60}});
+    elements.push_back({LABEL, {20, y + 10, 380, y + 50}});
+  }
+  elements.push_back({LABEL, {450, 10, 1850, 50}});
+  for (int i = 0; i < 15; i++)
+  {
+    const float y = 60.0f + i * 64.0f;
+    elements.push_back({BUTTON, {450, y, 1850, y + 60}});
+    elements.push_back({ICON, {460, y + 6, 508, y + 54}});
+    elements.push_back({LABEL, {520, y + 10, 1500, y + 50}});
+    elements.push_back({LABEL, {1550, y + 10, 1840, y + 50}});
+  }
+  return elements;
+}
+
+class TestGUIQuadBatch : public ::testing::Test
+{
+protected:
+  void Add(int texture, float x, float y, float size = 10.0f, float z = 0.0f)
+  {
+    const std::array<TestVertex, 4> vertices{{{x, y, z, m_quads},
+                                              {x + size, y, z, m_quads},
+                                              {x + size, y + size, z, m_quads},
+                                              {x, y + size, z, m_quads}}};
+    m_quads++;
+    m_batch.Add({texture}, vertices.data(), 1);
+  }
+
+  void Add(int texture, const CRect& rect)
+  {
+    const std::array<TestVertex, 4> vertices{{{rect.x1, rect.y1, 0.0f, m_quads},
+                                              {rect.x2, rect.y1, 0.0f, m_quads},
+                                              {rect.x2, rect.y2, 0.0f, m_quads},
+                                              {rect.x1, rect.y2, 0.0f, m_quads}}};
+    m_quads++;
+    m_batch.Add({texture}, vertices.data(), 1);
+  }
+
+  std::vector<Result> Flush()
+  {
+    std::vector<Result> results;
+    m_batch.Flush(
+        [&results](const std::vector<TestVertex>& vertices, const std::vector<Batch::Draw>& draws)
+        {
+          for (const auto& draw : draws)
+          {
+            Result result{draw.state->texture, {}};
+            for (size_t i = 0; i < draw.quads; i++)
+              result.quads.push_back(vertices[draw.firstVertex + i * 4].quad);
+            results.push_back(result);
+          }
+        });
+    return results;
+  }
+
+  Batch m_batch;
+  int m_quads = 0;
+};
+} // unnamed namespace
+
+TEST_F(TestGUIQuadBatch, MergesConsecutiveQuads)
+{
+  Add(1, 0, 0);
+  Add(1, 20, 0);
+  Add(2, 0, 0);
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(1, results[0].texture);
+  EXPECT_EQ((std::vector<int>{0, 1}), results[0].quads);
+  EXPECT_EQ(2, results[1].texture);
+  EXPECT_EQ((std::vector<int>{2}), results[1].quads);
+
+  EXPECT_TRUE(m_batch.IsEmpty());
+  EXPECT_TRUE(Flush().empty());
+}
+
+TEST_F(TestGUIQuadBatch, ReordersDisjointQuads)
+{
+  // a list of icons and their overlays, each overlay covering its icon
+  for (int i = 0; i < 4; i++)
+  {
+    Add(1, 0, i * 20.0f);
+    Add(2, 0, i * 20.0f);
+  }
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ((std::vector<int>{0, 2, 4, 6}), results[0].quads);
+  EXPECT_EQ((std::vector<int>{1, 3, 5, 7}), results[1].quads);
+}
+
+TEST_F(TestGUIQuadBatch, KeepsOrderOfOverlappingQuads)
+{
+  Add(1, 0, 0);
+  Add(2, 5, 5);
+  // overlaps the quad of texture 2, so it mustn't be drawn before it
+  Add(1, 10, 10);
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(1, results[0].texture);
+  EXPECT_EQ(2, results[1].texture);
+  EXPECT_EQ(1, results[2].texture);
+
+  // touching edges don't overlap
+  Add(1, 0, 0);
+  Add(2, 10, 0);
+  Add(1, 20, 0);
+  EXPECT_EQ(2u, Flush().size());
+}
+
+TEST_F(TestGUIQuadBatch, Barrier)
+{
+  Add(1, 0, 0);
+  Add(2, 20, 0);
+  m_batch.Barrier();
+  Add(1, 40, 0);
+
+  EXPECT_EQ(3u, Flush().size());
+
+  // a flush removes the barrier
+  Add(1, 0, 0);
+  Add(2, 20, 0);
+  Add(1, 40, 0);
+  EXPECT_EQ(2u, Flush().size());
+}
+
+TEST_F(TestGUIQuadBatch, KeepsOrderOfQuadsWithDepth)
+{
+  // disjoint in x and y, but a perspective projection may move them on top of each other
+  Add(1, 0, 0);
+  Add(2, 20, 0, 10.0f, 5.0f);
+  Add(1, 40, 0);
+  Add(2, 60, 0);
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(4u, results.size());
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ((std::vector<int>{i}), results[i].quads);
+}
+
+TEST_F(TestGUIQuadBatch, CustomDraws)
+{
+  // a row with an icon and a label, the icon of the next row can be drawn with the first
+  Add(1, 0, 0);
+  m_batch.AddCustom({3}, CRect(0, 0, 100, 10));
+  Add(1, 0, 20);
+  // custom draws are never joined
+  Add(3, 200, 0);
+  // overlaps the label, so it mustn't be drawn before it
+  Add(1, 5, 5);
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(4u, results.size());
+  EXPECT_EQ(1, results[0].texture);
+  EXPECT_EQ((std::vector<int>{0, 1}), results[0].quads);
+  EXPECT_EQ(3, results[1].texture);
+  EXPECT_TRUE(results[1].quads.empty());
+  EXPECT_EQ(3, results[2].texture);
+  EXPECT_EQ((std::vector<int>{2}), results[2].quads);
+  EXPECT_EQ((std::vector<int>{3}), results[3].quads);
+}
+
+TEST_F(TestGUIQuadBatch, SplitsLargeBatches)
+{
+  for (size_t i = 0; i < Batch::MAX_QUADS_PER_DRAW + 1; i++)
+    Add(1, 0, 0, 1.0f);
+
+  const std::vector<Result> results = Flush();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(Batch::MAX_QUADS_PER_DRAW, results[0].quads.size());
+  EXPECT_EQ(1u, results[1].quads.size());
+  EXPECT_EQ(static_cast<int>(Batch::MAX_QUADS_PER_DRAW), results[1].quads[0]);
+}
+
+TEST_F(TestGUIQuadBatch, DISABLED_Benchmark)
+{
+  const std::vector<Element> window = MakeListWindow();
+
+  // text used to be drawn right away, flushing the quads queued before it
+  for (const bool queueText : {false, true})
+  {
+    size_t draws = 0;
+    const auto flush = [this, &draws]
+    {
+      m_batch.Flush([&draws](const std::vector<TestVertex>&, const std::vector<Batch::Draw>& batch)
+                    { draws += batch.size(); });
+    };
+
+    const auto drawFrame = [&]
+    {
+      draws = 0;
+      for (const auto& element : window)
+      {
+        if (element.texture != 0)
+          Add(element.texture, element.rect);
+        else if (queueText)
+          m_batch.AddCustom({0}, element.rect);
+        else
+        {
+          flush();
+          draws++;
+        }
+      }
+      flush();
+    };
+
+    const auto time = Benchmark::TimePerCall(1000, drawFrame);
+
+    const std::string name = queueText ? "list window, text queued" : "list window, text flushing";
+    Benchmark::Report(name + ": draws", static_cast<double>(draws), "per frame");
+    Benchmark::Report(name + ": batching", Benchmark::Microseconds(time), "us per frame");
+  }
+}
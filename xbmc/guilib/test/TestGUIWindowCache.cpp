@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/GUIWindowCache.h"
+#include "test/TestUtils.h"
+#include "utils/Archive.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::string WINDOW = R"(<window type="dialog" id="1100">
+  <!-- comments are dropped -->
+  <defaultcontrol always="true">9000</defaultcontrol>
+  <controls>
+    <control type="label" id="1">
+      <label><![CDATA[[B]$INFO[ListItem.Label][/B]]]></label>
+      <visible>Skin.HasSetting(ShowLabel)</visible>
+    </control>
+  </controls>
+</window>)";
+
+std::string ToString(const TiXmlElement& element)
+{
+  TiXmlPrinter printer;
+  element.Accept(&printer);
+  return printer.Str();
+}
+
+class TestGUIWindowCache : public testing::Test
+{
+protected:
+  TestGUIWindowCache() { m_file = XBMC_CREATETEMPFILE(".bin"); }
+  ~TestGUIWindowCache() override { EXPECT_TRUE(XBMC_DELETETEMPFILE(m_file)); }
+
+  void Store(const CGUIWindowCache::Conditions& conditions)
+  {
+    CXBMCTinyXML doc;
+    ASSERT_TRUE(doc.Parse(WINDOW));
+
+    // the cached window is expected without the comment
+    TiXmlElement expected(*doc.RootElement());
+    expected.RemoveChild(expected.FirstChild());
+    m_window = ToString(expected);
+
+    CArchive ar(m_file, CArchive::store);
+    CGUIWindowCache::Store(ar, MODIFIED, SIZE, *doc.RootElement(), conditions);
+    ar.Close();
+    m_file->Seek(0, SEEK_SET);
+  }
+
+  std::unique_ptr<TiXmlElement> Load(int64_t modified,
+                                     int64_t size,
+                                     CGUIWindowCache::Conditions& conditions)
+  {
+    CArchive ar(m_file, CArchive::load);
+    auto window = CGUIWindowCache::Load(ar, modified, size, conditions);
+    ar.Close();
+    return window;
+  }
+
+  static constexpr int64_t MODIFIED = 1700000000;
+  static constexpr int64_t SIZE = 4096;
+
+  XFILE::CFile* m_file;
+  std::string m_window;
+};
+} // unnamed namespace
+
+TEST_F(TestGUIWindowCache, RoundTrip)
+{
+  ASSERT_NE(nullptr, m_file);
+  Store({{"skin.hassetting(compact)", true}, {"system.platform.android", false}});
+
+  CGUIWindowCache::Conditions conditions;
+  const auto window = Load(MODIFIED, SIZE, conditions);
+  ASSERT_NE(nullptr, window);
+  EXPECT_EQ(m_window, ToString(*window));
+
+  const TiXmlElement* label = window->FirstChildElement("controls")
+                                  ->FirstChildElement("control")
+                                  ->FirstChildElement("label");
+  ASSERT_NE(nullptr, label);
+  EXPECT_TRUE(label->FirstChild()->ToText()->CDATA());
+
+  const CGUIWindowCache::Conditions expected{{"skin.hassetting(compact)", true},
+                                             {"system.platform.android", false}};
+  EXPECT_EQ(expected, conditions);
+}
+
+TEST_F(TestGUIWindowCache, ChangedSource)
+{
+  ASSERT_NE(nullptr, m_file);
+  Store({});
+
+  CGUIWindowCache::Conditions conditions;
+  EXPECT_EQ(nullptr, Load(MODIFIED + 1, SIZE, conditions));
+  m_file->Seek(0, SEEK_SET);
+  EXPECT_EQ(nullptr, Load(MODIFIED, SIZE + 1, conditions));
+}
+
+TEST_F(TestGUIWindowCache, Truncated)
+{
+  ASSERT_NE(nullptr, m_file);
+  Store({});
+  m_file->Truncate(m_file->GetLength() / 2);
+  m_file->Seek(0, SEEK_SET);
+
+  // depending on where the file ends, reading fails or the end marker is missing
+  CGUIWindowCache::Conditions conditions;
+  std::unique_ptr<TiXmlElement> window;
+  try
+  {
+    window = Load(MODIFIED, SIZE, conditions);
+  }
+  catch (const std::out_of_range&)
+  {
+  }
+  EXPECT_EQ(nullptr, window);
+}
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/TextureBundleXBT.h"
+#include "guilib/XBTF.h"
+#include "guilib/XBTFReader.h"
+#include "test/TestUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <lzo/lzo1x.h>
+
+namespace
+{
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 64;
+constexpr uint32_t FRAMES = 4;
+
+void Append(std::vector<uint8_t>& data, const void* value, size_t size)
+{
+  const auto* bytes = static_cast<const uint8_t*>(value);
+  data.insert(data.end(), bytes, bytes + size);
+}
+
+template<typename T>
+void Append(std::vector<uint8_t>& data, T value)
+{
+  // bundles are little endian, as are the platforms the tests run on
+  Append(data, &value, sizeof(value));
+}
+
+std::vector<uint8_t> MakePixels(uint32_t frame)
+{
+  std::vector<uint8_t> pixels(WIDTH * HEIGHT * 4);
+  for (size_t i = 0; i < pixels.size(); i++)
+    pixels[i] = static_cast<uint8_t>((i / 64 + frame) % 7);
+  return pixels;
+}
+
+// a bundle with one animation of lzo compressed frames
+std::vector<uint8_t> MakeBundle()
+{
+  lzo_init();
+  std::vector<uint8_t> working(LZO1X_1_MEM_COMPRESS);
+
+  std::vector<std::vector<uint8_t>> packed;
+  for (uint32_t i = 0; i < FRAMES; i++)
+  {
+    const std::vector<uint8_t> pixels = MakePixels(i);
+    lzo_uint size = pixels.size() + pixels.size() / 16 + 64 + 3; // see simple.c in lzo
+    std::vector<uint8_t> frame(size);
+    lzo1x_1_compress(pixels.data(), pixels.size(), frame.data(), &size, working.data());
+    frame.resize(size);
+    packed.push_back(frame);
+  }
+
+  std::vector<uint8_t> data;
+  Append(data, XBTF_MAGIC.data(), XBTF_MAGIC.size());
+  Append(data, XBTF_VERSION[0]);
+  Append<uint32_t>(data, 1);
+
+  char path[CXBTFFile::MaximumPathLength] = "anim.png";
+  Append(data, path, sizeof(path));
+  Append<uint32_t>(data, 0);
+  Append<uint32_t>(data, FRAMES);
+
+  const uint64_t headerSize = data.size() + FRAMES * CXBTFFrame().GetHeaderSize();
+  uint64_t offset = headerSize;
+  for (const auto& frame : packed)
+  {
+    Append<uint32_t>(data, WIDTH);
+    Append<uint32_t>(data, HEIGHT);
+    Append<uint32_t>(data, XB_FMT_A8R8G8B8);
+    Append<uint64_t>(data, frame.size());
+    Append<uint64_t>(data, WIDTH * HEIGHT * 4);
+    Append<uint32_t>(data, 100);
+    Append<uint64_t>(data, offset);
+    offset += frame.size();
+  }
+
+  for (const auto& frame : packed)
+    Append(data, frame.data(), frame.size());
+
+  return data;
+}
+
+class TestTextureBundleXBT : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".xbt");
+    ASSERT_NE(nullptr, m_file);
+    m_file->Close();
+
+    const std::vector<uint8_t> bundle = MakeBundle();
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(XBMC_TEMPFILEPATH(m_file), true));
+    ASSERT_EQ(static_cast<ssize_t>(bundle.size()), file.Write(bundle.data(), bundle.size()));
+    file.Close();
+  }
+
+  void TearDown() override { XBMC_DELETETEMPFILE(m_file); }
+
+  XFILE::CFile* m_file = nullptr;
+};
+} // namespace
+
+TEST_F(TestTextureBundleXBT, UnpackFrame)
+{
+  CXBTFReader reader;
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(m_file)));
+
+  CXBTFFile file;
+  ASSERT_TRUE(reader.Get("anim.png", file));
+  ASSERT_EQ(FRAMES, file.GetFrames().size());
+
+  const CXBTFFrame& frame = file.GetFrames()[1];
+  EXPECT_TRUE(frame.IsPacked());
+  EXPECT_EQ(MakePixels(1), CTextureBundleXBT::UnpackFrame(reader, frame));
+}
+
+TEST_F(TestTextureBundleXBT, UnpackFrames)
+{
+  CXBTFReader reader;
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(m_file)));
+
+  CXBTFFile file;
+  ASSERT_TRUE(reader.Get("anim.png", file));
+
+  const std::vector<std::vector<uint8_t>> frames =
+      CTextureBundleXBT::UnpackFrames(reader, file.GetFrames());
+  ASSERT_EQ(FRAMES, frames.size());
+  for (uint32_t i = 0; i < FRAMES; i++)
+    EXPECT_EQ(MakePixels(i), frames[i]);
+}
+
+TEST_F(TestTextureBundleXBT, RejectsNewerVersion)
+{
+  std::vector<uint8_t> bundle = MakeBundle();
+  bundle[XBTF_MAGIC.size()] = XBTF_VERSION[0] + 1;
+
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(XBMC_TEMPFILEPATH(m_file), true));
+  ASSERT_EQ(static_cast<ssize_t>(bundle.size()), file.Write(bundle.data(), bundle.size()));
+  file.Close();
+
+  CXBTFReader reader;
+  EXPECT_FALSE(reader.Open(XBMC_TEMPFILEPATH(m_file)));
+}
@@ -22,6 +22,7 @@
 #include "settings/SettingsComponent.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -113,6 +114,38 @@ static int SetVolume(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Start recording trace events.
+ *  \param params (ignored)
+ */
+static int StartTracing(const std::vector<std::string>& params)
+{
+  CTrace::Start();
+
+  return 0;
+}
+
+/*! \brief Stop recording trace events.
+ *  \param params (ignored)
+ */
+static int StopTracing(const std::vector<std::string>& params)
+{
+  CTrace::Stop();
+
+  return 0;
+}
+
+/*! \brief Write the recorded trace events to a file.
+ *  \param params The parameters.
+ *  \details params[0] = The file to write (optional).
+ */
+static int DumpTrace(const std::vector<std::string>& params)
+{
+  if (CTrace::Dump(params.empty() ? "" : params[0]).empty())
+    return -1;
+
+  return 0;
+}
+
 /*! \brief Toggle debug info.
  *  \param params (ignored)
  */
@@ -168,6 +201,14 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///             @note If not given\, extracts to folder with archive.
 ///   }
 ///   \table_row2_l{
+///     <b>`DumpTrace([path])`</b>
+///     ,
+///     Writes the recorded trace events in the Chrome trace event format\, which
+///     can be loaded into https://ui.perfetto.dev.
+///     @param[in] path                  The file to write (optional).
+///             @note If not given\, writes kodi-trace.json to the log folder.
+///   }
+///   \table_row2_l{
 ///     <b>`Mute`</b>
 ///     ,
 ///     Mutes (or unmutes) the volume.
@@ -189,6 +230,17 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     @param[in] showvolumebar         Add "showVolumeBar" to show volume bar (optional).
 ///   }
 ///   \table_row2_l{
+///     <b>`StartTracing`</b>
+///     ,
+///     Starts recording trace events of the instrumented subsystems\, discarding
+///     the events recorded before.
+///   }
+///   \table_row2_l{
+///     <b>`StopTracing`</b>
+///     ,
+///     Stops recording trace events. The recorded events are kept for DumpTrace.
+///   }
+///   \table_row2_l{
 ///     <b>`ToggleDebug`</b>
 ///     ,
 ///     Toggles debug mode on/off
@@ -211,10 +263,13 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 CBuiltins::CommandMap CApplicationBuiltins::GetOperations() const
 {
   return {
+           {"dumptrace", {"Writes the recorded trace events to a file", 0, DumpTrace}},
            {"extract", {"Extracts the specified archive", 1, Extract}},
            {"mute", {"Mute the player", 0, Mute}},
            {"notifyall", {"Notify all connected clients", 2, NotifyAll}},
            {"setvolume", {"Set the current volume", 1, SetVolume}},
+           {"starttracing", {"Starts recording trace events", 0, StartTracing}},
+           {"stoptracing", {"Stops recording trace events", 0, StopTracing}},
            {"toggledebug", {"Enables/disables debug mode", 0, ToggleDebug}},
            {"toggledpms", {"Toggle DPMS mode manually", 0, ToggleDPMS}},
            {"wakeonlan", {"Sends the wake-up packet to the broadcast address for the specified MAC address", 1, WakeOnLAN}}
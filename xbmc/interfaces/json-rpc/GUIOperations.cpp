@@ -139,6 +139,56 @@ JSONRPC_STATUS CGUIOperations::ActivateScreenSaver(const std::string& method,
   return ACK;
 }
 
+JSONRPC_STATUS CGUIOperations::GetFrameStatistics(const std::string& method,
+                                                  ITransportLayer* transport,
+                                                  IClient* client,
+                                                  const CVariant& parameterObject,
+                                                  CVariant& result)
+{
+  CGUIWindowManager& windowManager = CServiceBroker::GetGUI()->GetWindowManager();
+  CGUIFrameStatistics& statistics = windowManager.GetFrameStatistics();
+
+  result["replayrunning"] = windowManager.GetNavigationReplay().IsRunning();
+  result["total"] = SerializeFrameStatistics(statistics.GetSummary());
+  result["windows"] = CVariant(CVariant::VariantTypeArray);
+  for (int windowId : statistics.GetWindows())
+  {
+    CGUIFrameStatistics::Summary summary;
+    if (!statistics.GetSummary(windowId, summary))
+      continue;
+
+    CVariant window = SerializeFrameStatistics(summary);
+    window["window"] = CWindowTranslator::TranslateWindow(windowId);
+    result["windows"].push_back(window);
+  }
+
+  if (parameterObject["reset"].asBoolean())
+    statistics.Reset();
+
+  return OK;
+}
+
+JSONRPC_STATUS CGUIOperations::ReplayNavigation(const std::string& method,
+                                                ITransportLayer* transport,
+                                                IClient* client,
+                                                const CVariant& parameterObject,
+                                                CVariant& result)
+{
+  std::vector<std::string> actions;
+  for (CVariant::const_iterator_array action = parameterObject["actions"].begin_array();
+       action != parameterObject["actions"].end_array(); ++action)
+    actions.push_back(action->asString());
+
+  CGUINavigationReplay& replay = CServiceBroker::GetGUI()->GetWindowManager().GetNavigationReplay();
+  if (!replay.Start(parameterObject["window"].asString(), actions,
+                    static_cast<unsigned int>(parameterObject["repeat"].asUnsignedInteger()),
+                    static_cast<unsigned int>(
+                        parameterObject["framesperaction"].asUnsignedInteger())))
+    return InvalidParams;
+
+  return ACK;
+}
+
 JSONRPC_STATUS CGUIOperations::GetPropertyValue(const std::string &property, CVariant &result)
 {
   if (property == "currentwindow")
@@ -178,6 +228,29 @@ JSONRPC_STATUS CGUIOperations::GetPropertyValue(const std::string &property, CVa
   return OK;
 }
 
+CVariant CGUIOperations::SerializeFrameStatistics(const CGUIFrameStatistics::Summary& summary)
+{
+  const auto serializePercentiles = [](const CGUIFrameStatistics::Percentiles& percentiles)
+  {
+    CVariant frameTime(CVariant::VariantTypeObject);
+    frameTime["p50"] = percentiles.p50;
+    frameTime["p95"] = percentiles.p95;
+    frameTime["p99"] = percentiles.p99;
+    return frameTime;
+  };
+
+  CVariant statistics(CVariant::VariantTypeObject);
+  statistics["frames"] = static_cast<uint64_t>(summary.frames);
+  statistics["framesoverbudget"] = static_cast<uint64_t>(summary.framesOverBudget);
+  statistics["process"] = serializePercentiles(summary.process);
+  statistics["render"] = serializePercentiles(summary.render);
+  statistics["present"] = serializePercentiles(summary.present);
+  statistics["framecost"] = serializePercentiles(summary.frameCost);
+  statistics["drawcalls"] = summary.drawCalls;
+  statistics["quads"] = summary.quads;
+  return statistics;
+}
+
 CVariant CGUIOperations::GetStereoModeObjectFromGuiMode(const RENDER_STEREO_MODE &mode)
 {
   const CStereoscopicsManager &stereoscopicsManager = CServiceBroker::GetGUI()->GetStereoscopicsManager();
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "JSONRPC.h"
+#include "guilib/GUIFrameStatistics.h"
 #include "rendering/RenderSystemTypes.h"
 
 class CVariant;
@@ -31,8 +32,19 @@ namespace JSONRPC
                                                   IClient* client,
                                                   const CVariant& parameterObject,
                                                   CVariant& result);
+    static JSONRPC_STATUS GetFrameStatistics(const std::string& method,
+                                             ITransportLayer* transport,
+                                             IClient* client,
+                                             const CVariant& parameterObject,
+                                             CVariant& result);
+    static JSONRPC_STATUS ReplayNavigation(const std::string& method,
+                                           ITransportLayer* transport,
+                                           IClient* client,
+                                           const CVariant& parameterObject,
+                                           CVariant& result);
   private:
     static JSONRPC_STATUS GetPropertyValue(const std::string &property, CVariant &result);
     static CVariant GetStereoModeObjectFromGuiMode(const RENDER_STEREO_MODE &mode);
+    static CVariant SerializeFrameStatistics(const CGUIFrameStatistics::Summary& summary);
   };
 }
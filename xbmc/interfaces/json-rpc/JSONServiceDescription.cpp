@@ -178,6 +178,8 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "GUI.SetStereoscopicMode",                      CGUIOperations::SetStereoscopicMode },
   { "GUI.GetStereoscopicModes",                     CGUIOperations::GetStereoscopicModes },
   { "GUI.ActivateScreenSaver",                      CGUIOperations::ActivateScreenSaver},
+  { "GUI.GetFrameStatistics",                       CGUIOperations::GetFrameStatistics },
+  { "GUI.ReplayNavigation",                         CGUIOperations::ReplayNavigation },
 
 // PVR operations
   { "PVR.GetProperties",                            CPVROperations::GetProperties },
@@ -256,7 +258,10 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.GetLockStatistics",                       CXBMCOperations::GetLockStatistics },
+  { "XBMC.SetTracing",                              CXBMCOperations::SetTracing },
+  { "XBMC.DumpTrace",                               CXBMCOperations::DumpTrace }
 };
 
 // clang-format on
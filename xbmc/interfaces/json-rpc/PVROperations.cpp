@@ -144,10 +144,11 @@ JSONRPC_STATUS CPVROperations::GetChannels(const std::string& method,
     return InvalidParams;
 
   CFileItemList channels;
-  const auto groupMembers = channelGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
-  for (const auto& groupMember : groupMembers)
+  const auto groupMembers = channelGroup->GetMembers();
+  for (const auto& groupMember : *groupMembers)
   {
-    channels.Add(std::make_shared<CFileItem>(groupMember));
+    if (!groupMember->Channel()->IsHidden())
+      channels.Add(std::make_shared<CFileItem>(groupMember));
   }
 
   HandleFileItemList("channelid", false, "channels", channels, parameterObject, result, true);
@@ -406,10 +407,11 @@ void CPVROperations::FillChannelGroupDetails(
   else
   {
     CFileItemList channels;
-    const auto groupMembers{channelGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE)};
-    for (const auto& groupMember : groupMembers)
+    const auto groupMembers{channelGroup->GetMembers()};
+    for (const auto& groupMember : *groupMembers)
     {
-      channels.Add(std::make_shared<CFileItem>(groupMember));
+      if (!groupMember->Channel()->IsHidden())
+        channels.Add(std::make_shared<CFileItem>(groupMember));
     }
 
     object["channels"] = CVariant(CVariant::VariantTypeArray);
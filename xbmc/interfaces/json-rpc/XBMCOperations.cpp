@@ -11,8 +11,12 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "threads/LockProfiler.h"
+#include "utils/Trace.h"
 #include "utils/Variant.h"
 
+#include <chrono>
+
 using namespace JSONRPC;
 
 JSONRPC_STATUS CXBMCOperations::GetInfoLabels(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
@@ -86,3 +90,65 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetLockStatistics(const std::string& method,
+                                                  ITransportLayer* transport,
+                                                  IClient* client,
+                                                  const CVariant& parameterObject,
+                                                  CVariant& result)
+{
+  using XbmcThreads::CLockProfiler;
+  const auto milliseconds = [](std::chrono::nanoseconds duration)
+  { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+  const size_t limit = static_cast<size_t>(parameterObject["limit"].asUnsignedInteger());
+
+  result["enabled"] = CLockProfiler::IsEnabled();
+  result["locks"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& lock : CLockProfiler::GetStatistics(limit))
+  {
+    CVariant statistics(CVariant::VariantTypeObject);
+    statistics["name"] = lock.name;
+    statistics["acquisitions"] = lock.acquisitions;
+    statistics["contentions"] = lock.contentions;
+    statistics["waittime"] = milliseconds(lock.waitTime);
+    statistics["maxwait"] = milliseconds(lock.maxWait);
+    statistics["holdtime"] = milliseconds(lock.holdTime);
+    statistics["maxhold"] = milliseconds(lock.maxHold);
+    statistics["longestholder"] = lock.longestHolder;
+    result["locks"].push_back(statistics);
+  }
+
+  if (parameterObject["reset"].asBoolean())
+    CLockProfiler::Reset();
+
+  return OK;
+}
+
+JSONRPC_STATUS CXBMCOperations::SetTracing(const std::string& method,
+                                           ITransportLayer* transport,
+                                           IClient* client,
+                                           const CVariant& parameterObject,
+                                           CVariant& result)
+{
+  if (parameterObject["enabled"].asBoolean())
+    CTrace::Start();
+  else
+    CTrace::Stop();
+
+  return ACK;
+}
+
+JSONRPC_STATUS CXBMCOperations::DumpTrace(const std::string& method,
+                                          ITransportLayer* transport,
+                                          IClient* client,
+                                          const CVariant& parameterObject,
+                                          CVariant& result)
+{
+  const std::string path = CTrace::Dump();
+  if (path.empty())
+    return InternalError;
+
+  result = path;
+  return OK;
+}
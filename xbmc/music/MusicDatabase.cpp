@@ -6053,7 +6053,7 @@ bool CMusicDatabase::GetDiscsByWhere(CMusicDbUrl& musicUrl,
       return false;
 
     // Get data from returned rows, note possibly multiple albums although usually only one
-    items.Reserve(total);
+    items.Reserve(std::min(total, iRowsFound));
     int albumOffset = 2;
     CAlbum album;
     bool useTitle = true; // Assume we want to match by disc title later unless we have no titles
@@ -6308,7 +6308,7 @@ bool CMusicDatabase::GetSongsFullByWhere(
     items.SetSortOrder(sorting.sortOrder);
 
     // Get songs from returned rows. If join songartistview then there is a row for every artist
-    items.Reserve(total);
+    items.Reserve(std::min(total, iRowsFound));
     int songArtistOffset = song_enumCount;
     int songId = -1;
     VECARTISTCREDITS artistCredits;
@@ -6425,6 +6425,25 @@ bool CMusicDatabase::GetSongsByWhere(
     if (!BuildSQL(strSQLExtra, extFilter, strSQLExtra))
       return false;
 
+    // Fetch further pages of a sorted listing by the ids sorted for its first page
+    static CSortedIdsCache sortedIds;
+    const std::string sortedIdsKey = CSortedIdsCache::GetKey(strSQLExtra, sorting);
+    std::vector<int> pageIds;
+    if (extFilter.limit.empty() && sortedIds.GetPage(sortedIdsKey, sorting, pageIds, total))
+    {
+      if (pageIds.empty())
+      {
+        items.SetProperty("total", total);
+        return true;
+      }
+
+      Filter pageFilter = extFilter;
+      pageFilter.AppendWhere(CSortedIdsCache::GetWhereClause("songview.idSong", pageIds));
+      strSQLExtra.clear();
+      if (!BuildSQL(strSQLExtra, pageFilter, strSQLExtra))
+        return false;
+    }
+
     // Apply the limiting directly here if there's no special sorting but limiting
     if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
         (sorting.limitStart > 0 || sorting.limitEnd > 0))
@@ -6457,7 +6476,10 @@ bool CMusicDatabase::GetSongsByWhere(
 
     DatabaseResults results;
     results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
+    if (!pageIds.empty())
+      CSortedIdsCache::OrderFromDataset(pageIds, m_pDS, song_idSong, results);
+    else if (!sortedIds.SortFromDataset(sortedIdsKey, sorting, MediaTypeSong, m_pDS, song_idSong,
+                                        results))
       return false;
 
     // get data from returned rows
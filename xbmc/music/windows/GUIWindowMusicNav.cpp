@@ -382,6 +382,21 @@ bool CGUIWindowMusicNav::Update(const std::string &strDirectory, bool updateFilt
   return false;
 }
 
+bool CGUIWindowMusicNav::CanPageDirectory(const CURL& url) const
+{
+  return url.IsProtocol("musicdb");
+}
+
+void CGUIWindowMusicNav::OnMoreItems(CFileItemList& items)
+{
+  CGUIWindowMusicBase::OnMoreItems(items);
+
+  // the thumb loader only got the items of the last Update()
+  if (m_thumbLoader.IsLoading())
+    m_thumbLoader.StopThread();
+  m_thumbLoader.Load(*m_unfilteredItems);
+}
+
 bool CGUIWindowMusicNav::GetDirectory(const std::string &strDirectory, CFileItemList &items)
 {
   if (strDirectory.empty())
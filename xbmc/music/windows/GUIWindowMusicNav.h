@@ -29,6 +29,8 @@ protected:
   // override base class methods
   bool Update(const std::string &strDirectory, bool updateFilterPath = true) override;
   bool GetDirectory(const std::string &strDirectory, CFileItemList &items) override;
+  bool CanPageDirectory(const CURL& url) const override;
+  void OnMoreItems(CFileItemList& items) override;
   void UpdateButtons() override;
   void PlayItem(int iItem) override;
   void OnWindowLoaded() override;
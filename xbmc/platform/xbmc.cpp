@@ -6,8 +6,12 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "ServiceBroker.h"
 #include "application/Application.h"
 #include "platform/MessagePrinter.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StartupTrace.h"
 
 #ifdef TARGET_WINDOWS_DESKTOP
 #include "platform/win32/IMMNotificationClient.h"
@@ -46,6 +50,9 @@ extern "C" int XBMC_Run(bool renderGUI)
     return status;
   }
 
+  CStartupTrace::Finish(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_startupTrace);
+
 #ifdef TARGET_WINDOWS_DESKTOP
   Microsoft::WRL::ComPtr<IMMDeviceEnumerator> pEnumerator = nullptr;
   CMMNotificationClient cMMNC;
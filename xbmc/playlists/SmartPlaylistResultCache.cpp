@@ -0,0 +1,343 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SmartPlaylistResultCache.h"
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "music/tags/MusicInfoTag.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+#include "video/VideoInfoTag.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using namespace KODI::PLAYLIST;
+
+namespace
+{
+constexpr size_t MAX_ENTRIES = 50;
+constexpr size_t MAX_CHANGED_IDS = 50;
+constexpr auto MAX_AGE = std::chrono::hours(1);
+
+constexpr const char* LIBRARY_VIDEO = "videodb";
+constexpr const char* LIBRARY_MUSIC = "musicdb";
+
+std::string GetLibrary(const std::string& baseDir)
+{
+  if (StringUtils::StartsWith(baseDir, "videodb://"))
+    return LIBRARY_VIDEO;
+  if (StringUtils::StartsWith(baseDir, "musicdb://"))
+    return LIBRARY_MUSIC;
+  return {};
+}
+
+/*!
+ * @brief Get the id column of the view the items of the given type are queried from. Only item
+ * types whose items do not depend on other items of the library can be updated one by one.
+ */
+std::string GetIdColumn(const MediaType& itemType)
+{
+  if (itemType == MediaTypeMovie)
+    return "movie_view.idMovie";
+  if (itemType == MediaTypeEpisode)
+    return "episode_view.idEpisode";
+  if (itemType == MediaTypeMusicVideo)
+    return "musicvideo_view.idMVideo";
+  if (itemType == MediaTypeSong)
+    return "songview.idSong";
+  return {};
+}
+
+/*!
+ * @brief Get the group of video media types whose changes can affect each other's listings.
+ */
+std::string GetVideoFamily(const MediaType& type)
+{
+  if (type == MediaTypeMovie || type == MediaTypeVideoCollection)
+    return MediaTypeMovie;
+  if (type == MediaTypeTvShow || type == MediaTypeSeason || type == MediaTypeEpisode)
+    return MediaTypeTvShow;
+  if (type == MediaTypeMusicVideo)
+    return MediaTypeMusicVideo;
+  return {};
+}
+
+bool IsUnrelated(const std::string& library, const MediaType& itemType, const MediaType& type)
+{
+  // albums and artists are derived from songs and vice versa
+  if (library != LIBRARY_VIDEO)
+    return false;
+
+  const std::string itemFamily = GetVideoFamily(itemType);
+  const std::string family = GetVideoFamily(type);
+  return !itemFamily.empty() && !family.empty() && itemFamily != family;
+}
+
+int GetDatabaseId(const CFileItem& item)
+{
+  if (item.HasVideoInfoTag())
+    return item.GetVideoInfoTag()->m_iDbId;
+  if (item.HasMusicInfoTag())
+    return item.GetMusicInfoTag()->GetDatabaseId();
+  return -1;
+}
+} // unnamed namespace
+
+CSmartPlaylistResultCache::CSmartPlaylistResultCache()
+{
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(
+      this, ANNOUNCEMENT::VideoLibrary | ANNOUNCEMENT::AudioLibrary);
+}
+
+CSmartPlaylistResultCache::~CSmartPlaylistResultCache()
+{
+  CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
+}
+
+bool CSmartPlaylistResultCache::IsCacheable(const SortDescription& sorting)
+{
+  // every evaluation of a random playlist is supposed to be different
+  return sorting.sortBy != SortByRandom;
+}
+
+std::string CSmartPlaylistResultCache::GetKey(const std::string& baseDir,
+                                              const SortDescription& sorting)
+{
+  return StringUtils::Format("{}|{}|{}|{}|{}|{}", static_cast<int>(sorting.sortBy),
+                             static_cast<int>(sorting.sortOrder),
+                             static_cast<int>(sorting.sortAttributes), sorting.limitStart,
+                             sorting.limitEnd, baseDir);
+}
+
+bool CSmartPlaylistResultCache::IsIncremental(const Entry& entry) const
+{
+  // a changed item may move other items in or out of a limited result
+  return !GetIdColumn(entry.itemType).empty() && entry.sorting.limitStart == 0 &&
+         entry.sorting.limitEnd <= 0;
+}
+
+bool CSmartPlaylistResultCache::GetItems(const std::string& baseDir,
+                                         const MediaType& itemType,
+                                         const SortDescription& sorting,
+                                         CFileItemList& items,
+                                         const Fetcher& fetcher)
+{
+  const std::string library = GetLibrary(baseDir);
+  if (library.empty() || !IsCacheable(sorting))
+    return fetcher(baseDir, items, CDatabase::Filter(), sorting);
+
+  const std::string key = GetKey(baseDir, sorting);
+
+  std::shared_ptr<const CFileItemList> cached;
+  std::set<int> changedIds;
+  auto created = std::chrono::steady_clock::now();
+  unsigned int generation = 0;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    generation = m_generation;
+
+    const auto it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+      if (std::chrono::steady_clock::now() - it->second.created > MAX_AGE)
+      {
+        m_entries.erase(it);
+      }
+      else
+      {
+        it->second.lastAccess = ++m_accessCount;
+        cached = it->second.items;
+        changedIds = it->second.changedIds;
+        created = it->second.created;
+      }
+    }
+  }
+
+  if (cached && changedIds.empty())
+  {
+    CopyTo(*cached, items);
+    return true;
+  }
+
+  Entry entry{library, itemType, sorting, nullptr, {}, created, 0};
+
+  if (cached)
+  {
+    // re-query only the changed items and merge them into the cached result
+    std::vector<std::string> ids;
+    ids.reserve(changedIds.size());
+    for (int id : changedIds)
+      ids.emplace_back(std::to_string(id));
+
+    CDatabase::Filter filter;
+    filter.AppendWhere(GetIdColumn(itemType) + " IN (" + StringUtils::Join(ids, ",") + ")");
+
+    CFileItemList changedItems;
+    if (fetcher(baseDir, changedItems, filter, sorting))
+    {
+      entry.items = Merge(*cached, changedIds, changedItems, sorting);
+      CLog::LogFC(LOGDEBUG, LOGDATABASE, "Updated {} items of cached smart playlist result",
+                  changedIds.size());
+    }
+  }
+
+  if (!entry.items)
+  {
+    auto result = std::make_shared<CFileItemList>();
+    if (!fetcher(baseDir, *result, CDatabase::Filter(), sorting))
+      return false;
+
+    entry.items = std::move(result);
+    entry.created = std::chrono::steady_clock::now();
+  }
+
+  CopyTo(*entry.items, items);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  // don't store results that could have missed changes announced while they were fetched
+  if (m_generation == generation)
+    Store(key, std::move(entry));
+
+  return true;
+}
+
+void CSmartPlaylistResultCache::Store(const std::string& key, Entry entry)
+{
+  entry.lastAccess = ++m_accessCount;
+  m_entries[key] = std::move(entry);
+
+  while (m_entries.size() > MAX_ENTRIES)
+  {
+    const auto oldest = std::min_element(m_entries.begin(), m_entries.end(),
+                                         [](const auto& entry1, const auto& entry2) {
+                                           return entry1.second.lastAccess <
+                                                  entry2.second.lastAccess;
+                                         });
+    m_entries.erase(oldest);
+  }
+}
+
+std::shared_ptr<CFileItemList> CSmartPlaylistResultCache::Merge(const CFileItemList& items,
+                                                                const std::set<int>& changedIds,
+                                                                const CFileItemList& changedItems,
+                                                                const SortDescription& sorting)
+{
+  auto result = std::make_shared<CFileItemList>();
+  result->AppendProperties(items);
+  result->SetContent(items.GetContent());
+
+  // items are never modified once cached, so they can be shared between the results
+  for (const auto& item : items)
+  {
+    if (changedIds.find(GetDatabaseId(*item)) == changedIds.end())
+      result->Add(item);
+  }
+
+  // items which don't match the playlist anymore (or were removed) are not part of changedItems
+  result->Append(changedItems);
+  result->Sort(sorting);
+
+  if (result->HasProperty("total"))
+    result->SetProperty("total", result->Size());
+
+  return result;
+}
+
+void CSmartPlaylistResultCache::CopyTo(const CFileItemList& source, CFileItemList& items)
+{
+  // same effect on the list as fetching the items from the database
+  for (const auto& item : source)
+    items.Add(std::make_shared<CFileItem>(*item));
+
+  items.AppendProperties(source);
+  if (!source.GetContent().empty())
+    items.SetContent(source.GetContent());
+  items.SetSortMethod(source.GetSortMethod());
+  items.SetSortOrder(source.GetSortOrder());
+}
+
+void CSmartPlaylistResultCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_entries.clear();
+  ++m_generation;
+}
+
+void CSmartPlaylistResultCache::Invalidate(const std::string& library)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.library == library)
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+  ++m_generation;
+}
+
+void CSmartPlaylistResultCache::OnItemChanged(const std::string& library,
+                                              const std::string& type,
+                                              int id)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    Entry& entry = it->second;
+    if (entry.library != library || IsUnrelated(library, entry.itemType, type))
+    {
+      ++it;
+      continue;
+    }
+
+    if (id > 0 && type == entry.itemType && IsIncremental(entry) &&
+        entry.changedIds.size() < MAX_CHANGED_IDS)
+    {
+      entry.changedIds.insert(id);
+      ++it;
+    }
+    else
+    {
+      it = m_entries.erase(it);
+    }
+  }
+  ++m_generation;
+}
+
+void CSmartPlaylistResultCache::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                                         const std::string& sender,
+                                         const std::string& message,
+                                         const CVariant& data)
+{
+  const std::string library = (flag & ANNOUNCEMENT::VideoLibrary) ? LIBRARY_VIDEO : LIBRARY_MUSIC;
+
+  // changes made during a scan or clean are covered by its final announcement
+  if (data.isMember("transaction") && data["transaction"].asBoolean())
+    return;
+
+  if (message == "OnScanFinished" || message == "OnCleanFinished" || message == "OnRefresh")
+  {
+    Invalidate(library);
+  }
+  else if (message == "OnUpdate" || message == "OnRemove")
+  {
+    // the item is either described directly or as announced item
+    const CVariant& item = data.isMember("type") ? data : data["item"];
+    if (item.isMember("type") && item.isMember("id"))
+      OnItemChanged(library, item["type"].asString(), static_cast<int>(item["id"].asInteger()));
+    else
+      Invalidate(library);
+  }
+}
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "dbwrappers/Database.h"
+#include "interfaces/IAnnouncer.h"
+#include "media/MediaType.h"
+#include "threads/CriticalSection.h"
+#include "utils/SortUtils.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+class CFileItemList;
+class CVariant;
+
+namespace KODI::PLAYLIST
+{
+
+/*!
+ * @brief Cache for the library items of smart playlists.
+ *
+ * Smart playlists are evaluated by running their (often expensive) SQL query against the video or
+ * music database. Widgets and nodes showing the same playlist over and over again would re-run the
+ * same query each time, although the library rarely changes in between. This cache keeps the
+ * results keyed by the database URL of the playlist (which contains the playlist rules) and the
+ * sort description, and keeps them current using the library announcements:
+ *
+ * - If a single movie, episode, music video or song is updated or removed, only that item is
+ *   re-queried (using the playlist's rules plus a filter for its id) on the next access and merged
+ *   into the cached result.
+ * - Any other change to the library (scans, cleans, changes to items the cached result depends on
+ *   indirectly, limited or grouped results) drops the affected results.
+ *
+ * Results are also dropped after some time, to cover rules relative to the current date.
+ */
+class CSmartPlaylistResultCache : public ANNOUNCEMENT::IAnnouncer
+{
+public:
+  /*!
+   * @brief Fetches items from the database, e.g. by calling CVideoDatabase::GetItems.
+   */
+  using Fetcher = std::function<bool(const std::string& baseDir,
+                                     CFileItemList& items,
+                                     const CDatabase::Filter& filter,
+                                     const SortDescription& sorting)>;
+
+  CSmartPlaylistResultCache();
+  ~CSmartPlaylistResultCache() override;
+
+  // IAnnouncer implementation
+  void Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override;
+
+  /*!
+   * @brief Get the items of a smart playlist query, from the cache if possible.
+   * @param baseDir The videodb:// or musicdb:// URL of the query, including the playlist.
+   * @param itemType The media type of the resulting items.
+   * @param sorting The sort description of the query.
+   * @param items The list to append the items to. List properties are set as by the fetcher.
+   * @param fetcher Fetches the items from the database if they are not cached (completely).
+   * @return True on success, false otherwise.
+   */
+  bool GetItems(const std::string& baseDir,
+                const MediaType& itemType,
+                const SortDescription& sorting,
+                CFileItemList& items,
+                const Fetcher& fetcher);
+
+  /*!
+   * @brief Drop all cached results, e.g. because another database is used now.
+   */
+  void Clear();
+
+  /*!
+   * @brief Check whether the results of a query can be cached at all.
+   * @param sorting The sort description of the query.
+   * @return True if the results can be cached, false otherwise.
+   */
+  static bool IsCacheable(const SortDescription& sorting);
+
+private:
+  CSmartPlaylistResultCache(const CSmartPlaylistResultCache&) = delete;
+  CSmartPlaylistResultCache& operator=(const CSmartPlaylistResultCache&) = delete;
+
+  struct Entry
+  {
+    std::string library; //!< "videodb" or "musicdb"
+    MediaType itemType;
+    SortDescription sorting;
+    std::shared_ptr<const CFileItemList> items; //!< never modified once cached
+    std::set<int> changedIds; //!< ids of items to re-query on next access
+    std::chrono::steady_clock::time_point created;
+    unsigned int lastAccess{0};
+  };
+
+  bool IsIncremental(const Entry& entry) const;
+  void OnItemChanged(const std::string& library, const std::string& type, int id);
+  void Invalidate(const std::string& library);
+  void Store(const std::string& key, Entry entry);
+
+  static std::string GetKey(const std::string& baseDir, const SortDescription& sorting);
+  static std::shared_ptr<CFileItemList> Merge(const CFileItemList& items,
+                                              const std::set<int>& changedIds,
+                                              const CFileItemList& changedItems,
+                                              const SortDescription& sorting);
+  static void CopyTo(const CFileItemList& source, CFileItemList& items);
+
+  mutable CCriticalSection m_critSection;
+  std::map<std::string, Entry> m_entries;
+  unsigned int m_generation{0}; //!< changed on every modification triggered by an announcement
+  unsigned int m_accessCount{0};
+};
+
+} // namespace KODI::PLAYLIST
@@ -0,0 +1,180 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "playlists/SmartPlaylistResultCache.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+
+namespace
+{
+const std::string PLAYLIST_URL = "videodb://movies/titles/?xsp=%7B%7D";
+
+class TestSmartPlaylistResultCache : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    CServiceBroker::RegisterAnnouncementManager(
+        std::make_shared<ANNOUNCEMENT::CAnnouncementManager>());
+    m_cache = std::make_unique<PLAYLIST::CSmartPlaylistResultCache>();
+
+    m_sorting.sortBy = SortByLabel;
+    m_fetcher = [this](const std::string& baseDir, CFileItemList& items,
+                       const CDatabase::Filter& filter, const SortDescription& sorting)
+    {
+      m_fetches.emplace_back(filter.where);
+      for (const auto& [id, title] : m_library)
+      {
+        // the fake query only understands the filter used for re-querying changed items
+        if (!filter.where.empty() && filter.where.find(std::to_string(id)) == std::string::npos)
+          continue;
+
+        const auto item = std::make_shared<CFileItem>(title);
+        item->GetVideoInfoTag()->m_iDbId = id;
+        item->GetVideoInfoTag()->m_type = MediaTypeMovie;
+        items.Add(item);
+      }
+      items.Sort(sorting);
+      return true;
+    };
+  }
+
+  void TearDown() override
+  {
+    m_cache.reset();
+    CServiceBroker::UnregisterAnnouncementManager();
+  }
+
+  std::vector<std::string> GetLabels(const SortDescription& sorting)
+  {
+    CFileItemList items;
+    EXPECT_TRUE(m_cache->GetItems(PLAYLIST_URL, MediaTypeMovie, sorting, items, m_fetcher));
+
+    std::vector<std::string> labels;
+    for (const auto& item : items)
+      labels.emplace_back(item->GetLabel());
+    return labels;
+  }
+
+  std::vector<std::string> GetLabels() { return GetLabels(m_sorting); }
+
+  void Announce(const std::string& message, const std::string& type, int id)
+  {
+    CVariant data;
+    data["type"] = type;
+    data["id"] = id;
+    m_cache->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", message, data);
+  }
+
+  std::unique_ptr<PLAYLIST::CSmartPlaylistResultCache> m_cache;
+  std::map<int, std::string> m_library{{1, "b"}, {2, "c"}, {3, "a"}};
+  std::vector<std::string> m_fetches;
+  SortDescription m_sorting;
+  PLAYLIST::CSmartPlaylistResultCache::Fetcher m_fetcher;
+};
+} // unnamed namespace
+
+TEST_F(TestSmartPlaylistResultCache, CachedUntilChanged)
+{
+  const std::vector<std::string> expected{"a", "b", "c"};
+  EXPECT_EQ(expected, GetLabels());
+  EXPECT_EQ(expected, GetLabels());
+  EXPECT_EQ(1u, m_fetches.size());
+
+  // a different sort order is a different result
+  SortDescription descending = m_sorting;
+  descending.sortOrder = SortOrderDescending;
+  EXPECT_EQ(std::vector<std::string>({"c", "b", "a"}), GetLabels(descending));
+  EXPECT_EQ(2u, m_fetches.size());
+
+  m_cache->Clear();
+  EXPECT_EQ(expected, GetLabels());
+  EXPECT_EQ(3u, m_fetches.size());
+}
+
+TEST_F(TestSmartPlaylistResultCache, UpdateChangedItems)
+{
+  GetLabels();
+
+  m_library[2] = "0";
+  m_library[4] = "d";
+  Announce("OnUpdate", MediaTypeMovie, 2);
+  Announce("OnUpdate", MediaTypeMovie, 4);
+
+  // only the changed items are re-queried and merged in sort order
+  EXPECT_EQ(std::vector<std::string>({"0", "a", "b", "d"}), GetLabels());
+  ASSERT_EQ(2u, m_fetches.size());
+  EXPECT_TRUE(StringUtils::EndsWith(m_fetches[1], "IN (2,4)"));
+
+  m_library.erase(1);
+  Announce("OnRemove", MediaTypeMovie, 1);
+  EXPECT_EQ(std::vector<std::string>({"0", "a", "d"}), GetLabels());
+  EXPECT_EQ(std::vector<std::string>({"0", "a", "d"}), GetLabels());
+  EXPECT_EQ(3u, m_fetches.size());
+}
+
+TEST_F(TestSmartPlaylistResultCache, Invalidate)
+{
+  GetLabels();
+
+  // changes of unrelated items and changes made during a scan don't matter
+  Announce("OnUpdate", MediaTypeEpisode, 1);
+  CVariant data;
+  data["type"] = MediaTypeMovie;
+  data["id"] = 1;
+  data["transaction"] = true;
+  m_cache->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnUpdate", data);
+  m_cache->Announce(ANNOUNCEMENT::AudioLibrary, "xbmc", "OnScanFinished", CVariant());
+  GetLabels();
+  EXPECT_EQ(1u, m_fetches.size());
+
+  m_cache->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnScanFinished", CVariant());
+  GetLabels();
+  ASSERT_EQ(2u, m_fetches.size());
+  EXPECT_TRUE(m_fetches[1].empty());
+
+  // the movie set of a movie is displayed as part of the movie
+  Announce("OnUpdate", MediaTypeVideoCollection, 1);
+  GetLabels();
+  ASSERT_EQ(3u, m_fetches.size());
+  EXPECT_TRUE(m_fetches[2].empty());
+}
+
+TEST_F(TestSmartPlaylistResultCache, NotIncremental)
+{
+  // a limited result may need items which were not part of it before
+  SortDescription limited = m_sorting;
+  limited.limitEnd = 2;
+  EXPECT_EQ(std::vector<std::string>({"a", "b"}), GetLabels(limited));
+
+  Announce("OnUpdate", MediaTypeMovie, 3);
+  GetLabels(limited);
+  ASSERT_EQ(2u, m_fetches.size());
+  EXPECT_TRUE(m_fetches[1].empty());
+
+  // random results are never cached
+  SortDescription random = m_sorting;
+  random.sortBy = SortByRandom;
+  GetLabels(random);
+  GetLabels(random);
+  EXPECT_EQ(4u, m_fetches.size());
+}
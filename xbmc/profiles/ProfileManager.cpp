@@ -36,11 +36,13 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "guilib/StereoscopicsManager.h" //! @todo Remove me
+#include "guilib/listproviders/DirectoryProviderCache.h"
 #include "input/InputManager.h"
 #include "interfaces/json-rpc/JSONRPC.h" //! @todo Remove me
 #include "music/MusicLibraryQueue.h"
 #include "network/Network.h" //! @todo Remove me
 #include "network/NetworkServices.h" //! @todo Remove me
+#include "playlists/SmartPlaylistResultCache.h"
 #include "pvr/PVRManager.h" //! @todo Remove me
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -328,6 +330,8 @@ bool CProfileManager::LoadProfile(unsigned int index)
   CreateProfileFolders();
 
   CServiceBroker::GetDatabaseManager().Initialize();
+  CServiceBroker::GetSmartPlaylistResultCache().Clear();
+  CServiceBroker::GetDirectoryProviderCache().Clear();
   CServiceBroker::GetInputManager().LoadKeymaps();
 
   CServiceBroker::GetInputManager().SetMouseEnabled(settings->GetBool(CSettings::SETTING_INPUT_ENABLEMOUSE));
@@ -1012,6 +1012,9 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
 
   bool bReturn(true);
 
+  // only channels written now can lack their database id. all others keep theirs.
+  std::vector<std::shared_ptr<CPVRChannelGroupMember>> persistedMembers;
+
   std::shared_ptr<CPVRChannel> channel;
   for (const auto& groupMember : group.m_members)
   {
@@ -1021,6 +1024,7 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
       if (Persist(*channel, false))
       {
         channel->Persisted();
+        persistedMembers.emplace_back(groupMember.second);
         bReturn = true;
       }
     }
@@ -1032,18 +1036,24 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
   {
     std::string strQuery;
     std::string strValue;
-    for (const auto& groupMember : group.m_members)
+    for (const auto& groupMember : persistedMembers)
     {
-      channel = groupMember.second->Channel();
+      channel = groupMember->Channel();
+      if (channel->ChannelID() > 0)
+        continue;
+
       strQuery =
           PrepareSQL("iUniqueId = %i AND iClientId = %i", channel->UniqueID(), channel->ClientID());
       strValue = GetSingleValue("channels", "idChannel", strQuery);
       if (!strValue.empty() && StringUtils::IsInteger(strValue))
-      {
-        const int iChannelID = std::atoi(strValue.c_str());
-        channel->SetChannelID(iChannelID);
-        groupMember.second->m_iChannelDatabaseID = iChannelID;
-      }
+        channel->SetChannelID(std::atoi(strValue.c_str()));
+    }
+
+    for (const auto& groupMember : group.m_members)
+    {
+      channel = groupMember.second->Channel();
+      if (channel->ChannelID() > 0)
+        groupMember.second->m_iChannelDatabaseID = channel->ChannelID();
     }
   }
 
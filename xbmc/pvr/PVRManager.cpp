@@ -358,6 +358,7 @@ void CPVRManager::ResetProperties()
   m_guiInfo = std::make_unique<CPVRGUIInfo>();
   m_parentalTimer = std::make_unique<CStopWatch>();
   m_knownClients.clear();
+  m_cachedClients.clear();
 }
 
 void CPVRManager::Init()
@@ -500,8 +501,24 @@ void CPVRManager::Process()
     return;
   }
 
-  // Wait for at least one client to come up and load/update data
-  UpdateComponents(ManagerState::STATE_STARTING);
+  // Make the channels and groups of the last session usable right away. The clients are synced in
+  // the background, as soon as they are connected.
+  std::vector<std::shared_ptr<CPVRClient>> createdClients;
+  for (const auto& entry : m_addons->GetCreatedClients())
+    createdClients.emplace_back(entry.second);
+
+  if (LoadComponentsFromDatabase(createdClients))
+  {
+    PublishEvent(PVREvent::ChannelGroupsInvalidated);
+  }
+  else
+  {
+    // drop what was loaded partially, data gets loaded again once the clients are connected
+    CLog::LogF(LOGERROR, "Failed to load PVR providers / channels / groups from the database.");
+    UnloadComponents();
+    m_knownClients.clear(); // start over
+    PublishEvent(PVREvent::ClientsInvalidated);
+  }
 
   if (!IsInitialising())
   {
@@ -685,6 +702,7 @@ bool CPVRManager::UpdateComponents(ManagerState stateToCheck,
   {
     CLog::LogFC(LOGDEBUG, LOGPVR, "All created PVR clients gone!");
     m_knownClients.clear(); // start over
+    m_cachedClients.clear();
     PublishEvent(PVREvent::ClientsInvalidated);
     return false;
   }
@@ -717,7 +735,15 @@ bool CPVRManager::UpdateComponents(ManagerState stateToCheck,
   if (progressHandler)
     progressHandler->UpdateProgress(g_localizeStrings.Get(19236), 0); // Loading channels and groups
 
-  if (!m_providers->Update(newClients))
+  if (!LoadComponentsFromDatabase(newClients))
+  {
+    CLog::LogF(LOGERROR, "Failed to load PVR providers / channels / groups from the database.");
+    m_knownClients.clear(); // start over
+    PublishEvent(PVREvent::ClientsInvalidated);
+    return false;
+  }
+
+  if (!m_providers->UpdateFromClients(newClients))
   {
     CLog::LogF(LOGERROR, "Failed to load PVR providers.");
     m_knownClients.clear(); // start over
@@ -728,7 +754,7 @@ bool CPVRManager::UpdateComponents(ManagerState stateToCheck,
   if (stateToCheck != GetState())
     return false;
 
-  if (!m_channelGroups->Update(newClients))
+  if (!m_channelGroups->UpdateFromClients(newClients))
   {
     CLog::LogF(LOGERROR, "Failed to load PVR channels / groups.");
     m_knownClients.clear(); // start over
@@ -767,8 +793,36 @@ bool CPVRManager::UpdateComponents(ManagerState stateToCheck,
   return true;
 }
 
+bool CPVRManager::LoadComponentsFromDatabase(
+    const std::vector<std::shared_ptr<CPVRClient>>& clients)
+{
+  std::vector<std::shared_ptr<CPVRClient>> clientsToLoad;
+  for (const auto& client : clients)
+  {
+    if (std::find(m_cachedClients.cbegin(), m_cachedClients.cend(), client->GetID()) ==
+        m_cachedClients.cend())
+      clientsToLoad.emplace_back(client);
+  }
+
+  if (clientsToLoad.empty())
+    return true;
+
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Loading data of {} PVR client(s) from the database",
+              clientsToLoad.size());
+
+  if (!m_providers->LoadFromDatabase(clientsToLoad) ||
+      !m_channelGroups->LoadFromDatabase(clientsToLoad))
+    return false;
+
+  for (const auto& client : clientsToLoad)
+    m_cachedClients.emplace_back(client->GetID());
+
+  return true;
+}
+
 void CPVRManager::UnloadComponents()
 {
+  m_cachedClients.clear();
   m_recordings->Unload();
   m_timers->Unload();
   m_channelGroups->Unload();
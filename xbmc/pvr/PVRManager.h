@@ -401,6 +401,14 @@ private:
   bool UpdateComponents(ManagerState stateToCheck,
                         const std::unique_ptr<CPVRGUIProgressHandler>& progressHandler);
 
+  /*!
+   * @brief Load the providers, channels and channel groups of the given PVR clients stored in the
+   * database, without waiting for the clients to be connected. Clients already loaded are skipped.
+   * @param clients The clients.
+   * @return True on success, false otherwise.
+   */
+  bool LoadComponentsFromDatabase(const std::vector<std::shared_ptr<CPVRClient>>& clients);
+
   /*!
    * @brief Unload all PVR data (recordings, timers, channelgroups).
    */
@@ -446,6 +454,7 @@ private:
   //@}
 
   std::vector<std::shared_ptr<CPVRClient>> m_knownClients; /*!< vector with all known clients */
+  std::vector<int> m_cachedClients; /*!< ids of the clients loaded from the database */
   std::unique_ptr<CPVRManagerJobQueue> m_pendingUpdates; /*!< vector of pending pvr updates */
   std::shared_ptr<CPVRDatabase> m_database; /*!< the database for all PVR related data */
   mutable CCriticalSection
@@ -28,6 +28,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -619,7 +621,7 @@ bool CPVRClients::GetTimers(const std::vector<std::shared_ptr<CPVRClient>>& clie
              [timers](const std::shared_ptr<const CPVRClient>& client) {
                return client->GetTimers(timers);
              },
-             failedClients) == PVR_ERROR_NO_ERROR;
+             failedClients, true) == PVR_ERROR_NO_ERROR;
 }
 
 PVR_ERROR CPVRClients::UpdateTimerTypes(const std::vector<std::shared_ptr<CPVRClient>>& clients,
@@ -659,7 +661,7 @@ PVR_ERROR CPVRClients::GetRecordings(const std::vector<std::shared_ptr<CPVRClien
       [recordings, deleted](const std::shared_ptr<const CPVRClient>& client) {
         return client->GetRecordings(recordings, deleted);
       },
-      failedClients);
+      failedClients, true);
 }
 
 PVR_ERROR CPVRClients::DeleteAllRecordingsFromTrash()
@@ -688,12 +690,27 @@ PVR_ERROR CPVRClients::GetChannels(const std::vector<std::shared_ptr<CPVRClient>
                                    std::vector<std::shared_ptr<CPVRChannel>>& channels,
                                    std::vector<int>& failedClients) const
 {
-  return ForClients(
+  // collect the channels per client, so that clients can be called in parallel
+  CCriticalSection critSection;
+  std::map<int, std::vector<std::shared_ptr<CPVRChannel>>> channelsByClient;
+
+  const PVR_ERROR error = ForClients(
       __FUNCTION__, clients,
-      [bRadio, &channels](const std::shared_ptr<const CPVRClient>& client) {
-        return client->GetChannels(bRadio, channels);
+      [bRadio, &critSection, &channelsByClient](const std::shared_ptr<const CPVRClient>& client)
+      {
+        std::vector<std::shared_ptr<CPVRChannel>> clientChannels;
+        const PVR_ERROR clientError = client->GetChannels(bRadio, clientChannels);
+
+        std::unique_lock<CCriticalSection> lock(critSection);
+        channelsByClient[client->GetID()] = std::move(clientChannels);
+        return clientError;
       },
-      failedClients);
+      failedClients, true);
+
+  for (const auto& entry : channelsByClient)
+    channels.insert(channels.end(), entry.second.cbegin(), entry.second.cend());
+
+  return error;
 }
 
 PVR_ERROR CPVRClients::GetProviders(const std::vector<std::shared_ptr<CPVRClient>>& clients,
@@ -705,7 +722,7 @@ PVR_ERROR CPVRClients::GetProviders(const std::vector<std::shared_ptr<CPVRClient
       [providers](const std::shared_ptr<const CPVRClient>& client) {
         return client->GetProviders(*providers);
       },
-      failedClients);
+      failedClients, true);
 }
 
 PVR_ERROR CPVRClients::GetChannelGroups(const std::vector<std::shared_ptr<CPVRClient>>& clients,
@@ -717,7 +734,7 @@ PVR_ERROR CPVRClients::GetChannelGroups(const std::vector<std::shared_ptr<CPVRCl
       [groups](const std::shared_ptr<const CPVRClient>& client) {
         return client->GetChannelGroups(groups);
       },
-      failedClients);
+      failedClients, true);
 }
 
 PVR_ERROR CPVRClients::GetChannelGroupMembers(
@@ -938,12 +955,11 @@ PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
 
 PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
                                          const PVRClientFunction& function,
-                                         std::vector<int>& failedClients) const
+                                         std::vector<int>& failedClients,
+                                         bool bParallel /* = false */) const
 {
-  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
-
-  CPVRClientMap clients;
-  GetCallableClients(clients, failedClients);
+  CPVRClientMap clientMap;
+  GetCallableClients(clientMap, failedClients);
 
   if (!failedClients.empty())
   {
@@ -956,39 +972,22 @@ PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
     }
   }
 
-  for (const auto& clientEntry : clients)
-  {
-    //    CLog::LogFC(LOGDEBUG, LOGPVR, "Calling add-on function '{}' on client {}.", strFunctionName,
-    //                clientEntry.second->GetID());
-
-    PVR_ERROR currentError = function(clientEntry.second);
-
-    //    CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on client {}. return={}",
-    //                strFunctionName, clientEntry.second->GetID(), currentError);
-
-    if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
-    {
-      lastError = currentError;
-      failedClients.emplace_back(clientEntry.first);
+  std::vector<std::shared_ptr<CPVRClient>> clients;
+  clients.reserve(clientMap.size());
+  for (const auto& clientEntry : clientMap)
+    clients.emplace_back(clientEntry.second);
 
-      CLog::LogFC(LOGDEBUG, LOGPVR,
-                  "Added client {} to failed clients list after call to "
-                  "function '{}‘ returned error {}.",
-                  clientEntry.second->GetID(), strFunctionName, currentError);
-    }
-  }
-  return lastError;
+  return CallClients(strFunctionName, clients, function, failedClients, bParallel);
 }
 
 PVR_ERROR CPVRClients::ForClients(const char* strFunctionName,
                                   const std::vector<std::shared_ptr<CPVRClient>>& clients,
                                   const PVRClientFunction& function,
-                                  std::vector<int>& failedClients) const
+                                  std::vector<int>& failedClients,
+                                  bool bParallel /* = false */) const
 {
   if (clients.empty())
-    return ForCreatedClients(strFunctionName, function, failedClients);
-
-  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
+    return ForCreatedClients(strFunctionName, function, failedClients, bParallel);
 
   failedClients.clear();
 
@@ -1008,33 +1007,60 @@ PVR_ERROR CPVRClients::ForClients(const char* strFunctionName,
     }
   }
 
+  std::vector<std::shared_ptr<CPVRClient>> callableClients;
   for (const auto& client : clients)
   {
     if (std::none_of(failedClients.cbegin(), failedClients.cend(),
                      [&client](int failedClientId) { return failedClientId == client->GetID(); }))
-    {
-      //      CLog::LogFC(LOGDEBUG, LOGPVR, "Calling add-on function '{}' on client {}.", strFunctionName,
-      //                  client->GetID());
+      callableClients.emplace_back(client);
+    else
+      LogClientWarning(strFunctionName, client);
+  }
+
+  return CallClients(strFunctionName, callableClients, function, failedClients, bParallel);
+}
 
-      PVR_ERROR currentError = function(client);
+PVR_ERROR CPVRClients::CallClients(const char* strFunctionName,
+                                   const std::vector<std::shared_ptr<CPVRClient>>& clients,
+                                   const PVRClientFunction& function,
+                                   std::vector<int>& failedClients,
+                                   bool bParallel) const
+{
+  std::vector<PVR_ERROR> errors(clients.size(), PVR_ERROR_NO_ERROR);
 
-      //      CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on client {}. return={}",
-      //                  strFunctionName, client->GetID(), currentError);
+  if (bParallel && clients.size() > 1)
+  {
+    // the first client is called by this thread
+    std::vector<std::future<void>> calls;
+    for (size_t i = 1; i < clients.size(); ++i)
+      calls.emplace_back(std::async(std::launch::async, [&function, &clients, &errors, i]()
+                                    { errors[i] = function(clients[i]); }));
 
-      if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
-      {
-        lastError = currentError;
-        failedClients.emplace_back(client->GetID());
+    errors[0] = function(clients[0]);
 
-        CLog::LogFC(LOGDEBUG, LOGPVR,
-                    "Added client {} to failed clients list after call to "
-                    "function '{}‘ returned error {}.",
-                    client->GetID(), strFunctionName, currentError);
-      }
-    }
-    else
+    for (auto& call : calls)
+      call.get();
+  }
+  else
+  {
+    for (size_t i = 0; i < clients.size(); ++i)
+      errors[i] = function(clients[i]);
+  }
+
+  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
+
+  for (size_t i = 0; i < clients.size(); ++i)
+  {
+    const PVR_ERROR currentError = errors[i];
+    if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
     {
-      LogClientWarning(strFunctionName, client);
+      lastError = currentError;
+      failedClients.emplace_back(clients[i]->GetID());
+
+      CLog::LogFC(LOGDEBUG, LOGPVR,
+                  "Added client {} to failed clients list after call to "
+                  "function '{}‘ returned error {}.",
+                  clients[i]->GetID(), strFunctionName, currentError);
     }
   }
   return lastError;
@@ -461,12 +461,14 @@ struct SBackend
      * @param clients The clients to wrap.
      * @param function The function to wrap. It has to have return type PVR_ERROR and must take a const reference to a std::shared_ptr<CPVRClient> as parameter.
      * @param failedClients Contains a list of the ids of clients for that the call failed, if any.
+     * @param bParallel If true, call the clients concurrently. The function must be thread safe then.
      * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
      */
     PVR_ERROR ForClients(const char* strFunctionName,
                          const std::vector<std::shared_ptr<CPVRClient>>& clients,
                          const PVRClientFunction& function,
-                         std::vector<int>& failedClients) const;
+                         std::vector<int>& failedClients,
+                         bool bParallel = false) const;
 
     /*!
      * @brief Wraps calls to all created clients in order to do common pre and post function invocation actions.
@@ -482,11 +484,28 @@ struct SBackend
      * @param strFunctionName The function name, for logging purposes.
      * @param function The function to wrap. It has to have return type PVR_ERROR and must take a const reference to a std::shared_ptr<CPVRClient> as parameter.
      * @param failedClients Contains a list of the ids of clients for that the call failed, if any.
+     * @param bParallel If true, call the clients concurrently. The function must be thread safe then.
      * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
      */
     PVR_ERROR ForCreatedClients(const char* strFunctionName,
                                 const PVRClientFunction& function,
-                                std::vector<int>& failedClients) const;
+                                std::vector<int>& failedClients,
+                                bool bParallel = false) const;
+
+    /*!
+     * @brief Call the given function for the given clients, each client exactly once.
+     * @param strFunctionName The function name, for logging purposes.
+     * @param clients The clients to call.
+     * @param function The function to call.
+     * @param failedClients The ids of the clients for that the call failed get appended to this list.
+     * @param bParallel If true, call the clients concurrently. The function must be thread safe then.
+     * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
+     */
+    PVR_ERROR CallClients(const char* strFunctionName,
+                          const std::vector<std::shared_ptr<CPVRClient>>& clients,
+                          const PVRClientFunction& function,
+                          std::vector<int>& failedClients,
+                          bool bParallel) const;
 
     mutable CCriticalSection m_critSection;
     CPVRClientMap m_clientMap;
@@ -126,6 +126,7 @@ void CPVRChannelGroup::Unload()
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_sortedMembers.clear();
   m_members.clear();
+  ++m_iMembersVersion;
   m_failedClients.clear();
 }
 
@@ -216,12 +217,14 @@ void CPVRChannelGroup::SortByClientChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+  ++m_iMembersVersion;
 }
 
 void CPVRChannelGroup::SortByChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+  ++m_iMembersVersion;
 }
 
 void CPVRChannelGroup::UpdateClientPriorities()
@@ -281,12 +284,33 @@ bool CPVRChannelGroup::UpdateMembersClientPriority()
 
 /********** getters **********/
 
+std::shared_ptr<const CPVRChannelGroupMembersSnapshot> CPVRChannelGroup::GetMembersSnapshot() const
+{
+  std::shared_ptr<const CPVRChannelGroupMembersSnapshot> snapshot = m_membersSnapshot.Load();
+  if (snapshot && snapshot->version == m_iMembersVersion)
+    return snapshot;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  // another reader might have published an up to date snapshot meanwhile
+  snapshot = m_membersSnapshot.Load();
+  if (snapshot && snapshot->version == m_iMembersVersion)
+    return snapshot;
+
+  auto newSnapshot = std::make_shared<CPVRChannelGroupMembersSnapshot>();
+  newSnapshot->sortedMembers = m_sortedMembers;
+  newSnapshot->members = m_members;
+  newSnapshot->version = m_iMembersVersion;
+  m_membersSnapshot.Store(newSnapshot);
+  return newSnapshot;
+}
+
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetByUniqueID(
     const std::pair<int, int>& id) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  const auto it = m_members.find(id);
-  return it != m_members.end() ? it->second : std::shared_ptr<CPVRChannelGroupMember>();
+  const auto snapshot = GetMembersSnapshot();
+  const auto it = snapshot->members.find(id);
+  return it != snapshot->members.end() ? it->second : std::shared_ptr<CPVRChannelGroupMember>();
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByUniqueID(int iUniqueChannelId,
@@ -299,12 +323,13 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByUniqueID(int iUniqueChannelI
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelID(int iChannelID) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto snapshot = GetMembersSnapshot();
+  const auto& members = snapshot->members;
   const auto it =
-      std::find_if(m_members.cbegin(), m_members.cend(), [iChannelID](const auto& member) {
+      std::find_if(members.cbegin(), members.cend(), [iChannelID](const auto& member) {
         return member.second->Channel()->ChannelID() == iChannelID;
       });
-  return it != m_members.cend() ? (*it).second->Channel() : std::shared_ptr<CPVRChannel>();
+  return it != members.cend() ? (*it).second->Channel() : std::shared_ptr<CPVRChannel>();
 }
 
 namespace
@@ -318,17 +343,17 @@ bool MatchProvider(const std::shared_ptr<CPVRChannel>& channel, int clientId, in
 
 bool CPVRChannelGroup::HasChannelForProvider(int clientId, int providerId) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
+  const auto snapshot = GetMembersSnapshot();
+  return std::any_of(snapshot->members.cbegin(), snapshot->members.cend(),
                      [clientId, providerId](const auto& member)
                      { return MatchProvider(member.second->Channel(), clientId, providerId); });
 }
 
 unsigned int CPVRChannelGroup::GetChannelCountByProvider(int clientId, int providerId) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto snapshot = GetMembersSnapshot();
   auto channels =
-      std::count_if(m_members.cbegin(), m_members.cend(),
+      std::count_if(snapshot->members.cbegin(), snapshot->members.cend(),
                     [clientId, providerId](const auto& member)
                     { return MatchProvider(member.second->Channel(), clientId, providerId); });
   return static_cast<unsigned int>(channels);
@@ -337,10 +362,10 @@ unsigned int CPVRChannelGroup::GetChannelCountByProvider(int clientId, int provi
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetLastPlayedChannelGroupMember(
     int iCurrentChannel /* = -1 */) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto snapshot = GetMembersSnapshot();
 
   std::shared_ptr<CPVRChannelGroupMember> groupMember;
-  for (const auto& memberPair : m_members)
+  for (const auto& memberPair : snapshot->members)
   {
     const std::shared_ptr<const CPVRChannel> channel = memberPair.second->Channel();
     if (channel->ChannelID() != iCurrentChannel &&
@@ -357,12 +382,11 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetLastPlayedChannelGr
 
 GroupMemberPair CPVRChannelGroup::GetLastAndPreviousToLastPlayedChannelGroupMember() const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  if (m_sortedMembers.empty())
+  const auto snapshot = GetMembersSnapshot();
+  if (snapshot->sortedMembers.empty())
     return {};
 
-  auto members = m_sortedMembers;
-  lock.unlock();
+  auto members = snapshot->sortedMembers;
 
   std::sort(members.begin(), members.end(), [](const auto& a, const auto& b) {
     return a->Channel()->LastWatched() > b->Channel()->LastWatched();
@@ -383,7 +407,6 @@ GroupMemberPair CPVRChannelGroup::GetLastAndPreviousToLastPlayedChannelGroupMemb
 CPVRChannelNumber CPVRChannelGroup::GetChannelNumber(
     const std::shared_ptr<const CPVRChannel>& channel) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
   const std::shared_ptr<const CPVRChannelGroupMember> member = GetByUniqueID(channel->StorageId());
   return member ? member->ChannelNumber() : CPVRChannelNumber();
 }
@@ -391,7 +414,6 @@ CPVRChannelNumber CPVRChannelGroup::GetChannelNumber(
 CPVRChannelNumber CPVRChannelGroup::GetClientChannelNumber(
     const std::shared_ptr<const CPVRChannel>& channel) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
   const std::shared_ptr<const CPVRChannelGroupMember> member = GetByUniqueID(channel->StorageId());
   return member ? member->ClientChannelNumber() : CPVRChannelNumber();
 }
@@ -399,9 +421,9 @@ CPVRChannelNumber CPVRChannelGroup::GetClientChannelNumber(
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetByChannelNumber(
     const CPVRChannelNumber& channelNumber) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto snapshot = GetMembersSnapshot();
   const bool bUseBackendChannelNumbers = GetSettings()->UseBackendChannelNumbers();
-  for (const auto& member : m_sortedMembers)
+  for (const auto& member : snapshot->sortedMembers)
   {
     CPVRChannelNumber activeChannelNumber =
         bUseBackendChannelNumbers ? member->ClientChannelNumber() : member->ChannelNumber();
@@ -419,15 +441,16 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetNextChannelGroupMem
 
   if (groupMember)
   {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    for (auto it = m_sortedMembers.cbegin(); !nextMember && it != m_sortedMembers.cend(); ++it)
+    const auto snapshot = GetMembersSnapshot();
+    const auto& members = snapshot->sortedMembers;
+    for (auto it = members.cbegin(); !nextMember && it != members.cend(); ++it)
     {
       if (*it == groupMember)
       {
         do
         {
-          if ((++it) == m_sortedMembers.cend())
-            it = m_sortedMembers.cbegin();
+          if ((++it) == members.cend())
+            it = members.cbegin();
           if ((*it)->Channel() && !(*it)->Channel()->IsHidden())
             nextMember = *it;
         } while (!nextMember && *it != groupMember);
@@ -447,16 +470,16 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetPreviousChannelGrou
 
   if (groupMember)
   {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    for (auto it = m_sortedMembers.crbegin(); !previousMember && it != m_sortedMembers.crend();
-         ++it)
+    const auto snapshot = GetMembersSnapshot();
+    const auto& members = snapshot->sortedMembers;
+    for (auto it = members.crbegin(); !previousMember && it != members.crend(); ++it)
     {
       if (*it == groupMember)
       {
         do
         {
-          if ((++it) == m_sortedMembers.crend())
-            it = m_sortedMembers.crbegin();
+          if ((++it) == members.crend())
+            it = members.crbegin();
           if ((*it)->Channel() && !(*it)->Channel()->IsHidden())
             previousMember = *it;
         } while (!previousMember && *it != groupMember);
@@ -468,15 +491,15 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetPreviousChannelGrou
   return previousMember;
 }
 
-std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::GetMembers(
-    Include eFilter /* = Include::ALL */) const
+std::shared_ptr<const std::vector<std::shared_ptr<CPVRChannelGroupMember>>> CPVRChannelGroup::
+    GetMembers(Include eFilter /* = Include::ALL */) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  auto snapshot = GetMembersSnapshot();
   if (eFilter == Include::ALL)
-    return m_sortedMembers;
+    return {snapshot, &snapshot->sortedMembers}; // shares ownership with the snapshot
 
-  std::vector<std::shared_ptr<CPVRChannelGroupMember>> members;
-  for (const auto& member : m_sortedMembers)
+  auto members = std::make_shared<std::vector<std::shared_ptr<CPVRChannelGroupMember>>>();
+  for (const auto& member : snapshot->sortedMembers)
   {
     switch (eFilter)
     {
@@ -492,7 +515,7 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::GetMember
         break;
     }
 
-    members.emplace_back(member);
+    members->emplace_back(member);
   }
 
   return members;
@@ -500,9 +523,9 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::GetMember
 
 void CPVRChannelGroup::GetChannelNumbers(std::vector<std::string>& channelNumbers) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto snapshot = GetMembersSnapshot();
   const bool bUseBackendChannelNumbers = GetSettings()->UseBackendChannelNumbers();
-  for (const auto& member : m_sortedMembers)
+  for (const auto& member : snapshot->sortedMembers)
   {
     CPVRChannelNumber activeChannelNumber =
         bUseBackendChannelNumbers ? member->ClientChannelNumber() : member->ChannelNumber();
@@ -544,12 +567,14 @@ int CPVRChannelGroup::LoadFromDatabase(const std::vector<std::shared_ptr<CPVRCli
       if (member->ChannelClientID() > 0 && member->ChannelUID() > 0 &&
           member->IsRadio() == IsRadio())
       {
-        // Ignore data from unknown/disabled clients
-        if (allClients->IsEnabledClient(member->ChannelClientID()))
+        // Ignore data from unknown/disabled clients and members loaded before
+        if (allClients->IsEnabledClient(member->ChannelClientID()) &&
+            m_members
+                .emplace(std::make_pair(member->ChannelClientID(), member->ChannelUID()), member)
+                .second)
         {
           m_sortedMembers.emplace_back(member);
-          m_members.emplace(std::make_pair(member->ChannelClientID(), member->ChannelUID()),
-                            member);
+          ++m_iMembersVersion;
         }
       }
       else
@@ -610,10 +635,11 @@ bool CPVRChannelGroup::UpdateFromClient(const std::shared_ptr<CPVRChannelGroupMe
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
   const std::shared_ptr<CPVRChannel> channel = groupMember->Channel();
-  const std::shared_ptr<CPVRChannelGroupMember> existingMember =
-      GetByUniqueID(channel->StorageId());
-  if (existingMember)
+  const auto it = m_members.find(channel->StorageId());
+  if (it != m_members.end())
   {
+    const std::shared_ptr<CPVRChannelGroupMember>& existingMember = (*it).second;
+
     // update existing channel
     if (IsChannelsOwner() && existingMember->Channel()->UpdateFromClient(channel))
     {
@@ -643,6 +669,7 @@ bool CPVRChannelGroup::UpdateFromClient(const std::shared_ptr<CPVRChannelGroupMe
 
     m_sortedMembers.emplace_back(groupMember);
     m_members.emplace(channel->StorageId(), groupMember);
+    ++m_iMembersVersion;
 
     CLog::LogFC(LOGDEBUG, LOGPVR, "Added {} channel group member '{}' to group '{}'",
                 IsRadio() ? "radio" : "TV", channel->ChannelName(), GroupName());
@@ -730,6 +757,7 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::RemoveDel
 
       m_members.erase(channel->StorageId());
       it = m_sortedMembers.erase(it);
+      ++m_iMembersVersion;
       continue;
     }
 
@@ -745,6 +773,7 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::RemoveDel
 
         m_members.erase(channel->StorageId());
         it = m_sortedMembers.erase(it);
+        ++m_iMembersVersion;
         continue;
       }
     }
@@ -805,6 +834,7 @@ bool CPVRChannelGroup::RemoveFromGroup(
     {
       m_members.erase(storageId);
       m_sortedMembers.erase(it);
+      ++m_iMembersVersion;
       bReturn = true;
       break;
     }
@@ -827,7 +857,7 @@ bool CPVRChannelGroup::AppendToGroup(
 
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
-  if (!CPVRChannelGroup::IsGroupMember(groupMember))
+  if (m_members.find(groupMember->Channel()->StorageId()) == m_members.end())
   {
     unsigned int channelNumberMax =
         std::accumulate(m_sortedMembers.cbegin(), m_sortedMembers.cend(), 0,
@@ -845,6 +875,7 @@ bool CPVRChannelGroup::AppendToGroup(
 
     m_sortedMembers.emplace_back(newMember);
     m_members.emplace(channel->StorageId(), newMember);
+    ++m_iMembersVersion;
 
     SortAndRenumber();
     bReturn = true;
@@ -855,8 +886,8 @@ bool CPVRChannelGroup::AppendToGroup(
 bool CPVRChannelGroup::IsGroupMember(
     const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return m_members.find(groupMember->Channel()->StorageId()) != m_members.end();
+  const auto snapshot = GetMembersSnapshot();
+  return snapshot->members.find(groupMember->Channel()->StorageId()) != snapshot->members.end();
 }
 
 bool CPVRChannelGroup::Persist()
@@ -961,8 +992,8 @@ bool CPVRChannelGroup::Renumber(RenumberMode mode /* = NORMAL */)
 
 bool CPVRChannelGroup::HasNewChannels() const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
+  const auto snapshot = GetMembersSnapshot();
+  return std::any_of(snapshot->members.cbegin(), snapshot->members.cend(),
                      [](const auto& member) { return member.second->Channel()->ChannelID() <= 0; });
 }
 
@@ -1135,20 +1166,18 @@ void CPVRChannelGroup::SetLastOpened(uint64_t iLastOpened)
 
 size_t CPVRChannelGroup::Size() const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return m_members.size();
+  return GetMembersSnapshot()->members.size();
 }
 
 bool CPVRChannelGroup::HasChannels() const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return !m_members.empty();
+  return !GetMembersSnapshot()->members.empty();
 }
 
 bool CPVRChannelGroup::HasHiddenChannels() const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
+  const auto snapshot = GetMembersSnapshot();
+  return std::any_of(snapshot->members.cbegin(), snapshot->members.cend(),
                      [](const auto& member) { return member.second->Channel()->IsHidden(); });
 }
 
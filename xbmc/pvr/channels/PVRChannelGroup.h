@@ -11,8 +11,10 @@
 #include "pvr/channels/PVRChannelGroupSettings.h"
 #include "pvr/channels/PVRChannelNumber.h"
 #include "pvr/channels/PVRChannelsPath.h"
+#include "threads/AtomicSharedPtr.h"
 #include "utils/EventStream.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -49,6 +51,18 @@ enum RenumberMode
 using GroupMemberPair =
     std::pair<std::shared_ptr<CPVRChannelGroupMember>, std::shared_ptr<CPVRChannelGroupMember>>;
 
+/*!
+ * @brief An immutable snapshot of the members of a channel group.
+ */
+struct CPVRChannelGroupMembersSnapshot
+{
+  std::vector<std::shared_ptr<CPVRChannelGroupMember>>
+      sortedMembers; /*!< members sorted by channel number */
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>>
+      members; /*!< members with key clientid+uniqueid */
+  unsigned int version = 0; /*!< the version of the group members this snapshot was taken from */
+};
+
 class CPVRChannelGroup : public IChannelGroupSettingsCallback
 {
   friend class CPVRDatabase;
@@ -320,13 +334,21 @@ public:
   };
 
   /*!
-   * @brief Get the current members of this group
-   * @param eFilter A filter to apply.
-   * @return The group members
+   * @brief Get the current members of this group, sorted by channel number.
+   * @param eFilter A filter to apply. Without a filter, the members of the current snapshot are
+   * returned without copying them; filters create a new list.
+   * @return The group members. The list is never changed; it keeps its snapshot alive.
    */
-  std::vector<std::shared_ptr<CPVRChannelGroupMember>> GetMembers(
+  std::shared_ptr<const std::vector<std::shared_ptr<CPVRChannelGroupMember>>> GetMembers(
       Include eFilter = Include::ALL) const;
 
+  /*!
+   * @brief Get a snapshot of the current members of this group. Does not lock the group and does
+   * not copy the members, unless they were changed since the last snapshot was taken.
+   * @return The snapshot. It is never changed; changes of the group create a new snapshot.
+   */
+  std::shared_ptr<const CPVRChannelGroupMembersSnapshot> GetMembersSnapshot() const;
+
   /*!
    * @brief Get the list of active channel numbers in a group.
    * @param channelNumbers The list to store the numbers in.
@@ -588,7 +610,11 @@ protected:
       m_sortedMembers; /*!< members sorted by channel number */
   std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>>
       m_members; /*!< members with key clientid+uniqueid */
-  mutable CCriticalSection m_critSection;
+  std::atomic<unsigned int> m_iMembersVersion{
+      0}; /*!< incremented with every change of m_sortedMembers and m_members */
+  mutable XbmcThreads::CAtomicSharedPtr<const CPVRChannelGroupMembersSnapshot>
+      m_membersSnapshot; /*!< the last published snapshot of the members */
+  mutable CCriticalSection m_critSection{"PVRChannelGroup"};
   std::vector<int> m_failedClients;
   CEventSource<PVREvent> m_events;
   mutable std::shared_ptr<CPVRChannelGroupSettings> m_settings;
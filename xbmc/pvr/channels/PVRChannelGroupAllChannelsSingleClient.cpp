@@ -26,12 +26,11 @@ std::vector<std::shared_ptr<CPVRChannelGroup>> CPVRChannelGroupAllChannelsSingle
     CreateMissingGroups(const std::shared_ptr<CPVRChannelGroup>& allChannelsGroup,
                         const std::vector<std::shared_ptr<CPVRChannelGroup>>& allChannelGroups)
 {
-  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> allGroupMembers{
-      allChannelsGroup->GetMembers()};
+  const auto allGroupMembers{allChannelsGroup->GetMembersSnapshot()};
 
   // Create a unique list of active client ids from current members of the all channels list.
   std::unordered_set<int> clientIds;
-  for (const auto& member : allGroupMembers)
+  for (const auto& member : allGroupMembers->sortedMembers)
   {
     clientIds.insert(member->ChannelClientID());
   }
@@ -81,8 +80,8 @@ bool CPVRChannelGroupAllChannelsSingleClient::UpdateGroupMembers(
   std::vector<std::shared_ptr<CPVRChannelGroupMember>> groupMembers;
 
   // Collect and populate matching members.
-  const auto allChannelsGroupMembers{allChannelsGroup->GetMembers()};
-  for (const auto& member : allChannelsGroupMembers)
+  const auto allChannelsGroupMembers{allChannelsGroup->GetMembersSnapshot()};
+  for (const auto& member : allChannelsGroupMembers->sortedMembers)
   {
     if (member->ChannelClientID() != GetClientID())
       continue;
@@ -147,8 +147,8 @@ bool CPVRChannelGroupMergedByName::UpdateGroupMembers(
       case CPVRChannelGroup::Origin::USER:
       case CPVRChannelGroup::Origin::CLIENT:
       {
-        const auto members{group->GetMembers()};
-        for (const auto& member : members)
+        const auto members{group->GetMembersSnapshot()};
+        for (const auto& member : members->sortedMembers)
         {
           groupMembers.emplace_back(std::make_shared<CPVRChannelGroupMember>(
               GroupID(), GroupName(), GetClientID(), member->Channel()));
@@ -247,8 +247,8 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroups::GetMembe
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
 
-    const auto allGroupMembers = GetGroupAll()->GetMembers();
-    for (const auto& groupMember : allGroupMembers)
+    const auto allGroupMembers = GetGroupAll()->GetMembersSnapshot();
+    for (const auto& groupMember : allGroupMembers->sortedMembers)
     {
       if (!group->IsGroupMember(groupMember) &&
           (group->IsChannelsOwner() || !groupMember->Channel()->IsHidden()))
@@ -298,7 +298,7 @@ private:
 
   bool m_bRadio{false};
   std::vector<std::shared_ptr<CPVRChannelGroup>> m_groups;
-  mutable CCriticalSection m_critSection;
+  mutable CCriticalSection m_critSection{"PVRChannelGroups"};
   std::vector<int> m_failedClientsForChannelGroups;
   bool m_isSubscribed{false};
   CPVRSettings m_settings;
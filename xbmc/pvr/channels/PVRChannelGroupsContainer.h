@@ -42,6 +42,13 @@ public:
    */
   bool Update(const std::vector<std::shared_ptr<CPVRClient>>& clients);
 
+  /*!
+   * @brief Load all channel groups and all channels from PVR database.
+   * @param clients The PVR clients data should be loaded for. Leave empty for all clients.
+   * @return True on success, false otherwise.
+   */
+  bool LoadFromDatabase(const std::vector<std::shared_ptr<CPVRClient>>& clients);
+
   /*!
    * @brief Update data with groups and channels from the given clients, sync with local data.
    * @param clients The clients to fetch data from. Leave empty to fetch data from all created clients.
@@ -180,13 +187,6 @@ private:
   CPVRChannelGroupsContainer& operator=(const CPVRChannelGroupsContainer&) = delete;
   CPVRChannelGroupsContainer(const CPVRChannelGroupsContainer&) = delete;
 
-  /*!
-   * @brief Load all channel groups and all channels from PVR database.
-   * @param clients The PVR clients data should be loaded for. Leave empty for all clients.
-   * @return True on success, false otherwise.
-   */
-  bool LoadFromDatabase(const std::vector<std::shared_ptr<CPVRClient>>& clients);
-
   std::shared_ptr<CPVRChannelGroups> m_groupsRadio; /*!< all radio channel groups */
   std::shared_ptr<CPVRChannelGroups> m_groupsTV; /*!< all TV channel groups */
   CCriticalSection m_critSection;
@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_channels.h"
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroupAllChannels.h"
+#include "pvr/channels/PVRChannelGroupFromUser.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
+#include "pvr/channels/PVRChannelsPath.h"
+#include "test/Benchmark.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int CLIENT_ID = 1;
+
+std::shared_ptr<CPVRChannelGroupMember> MakeMember(int uniqueId, bool hidden = false)
+{
+  PVR_CHANNEL data{};
+  data.iUniqueId = uniqueId;
+  data.iChannelNumber = uniqueId;
+  data.bIsHidden = hidden;
+  const auto channel = std::make_shared<CPVRChannel>(data, CLIENT_ID);
+  return std::make_shared<CPVRChannelGroupMember>(-1, "", CLIENT_ID, channel);
+}
+
+std::set<int> UniqueIds(const std::vector<std::shared_ptr<CPVRChannelGroupMember>>& members)
+{
+  std::set<int> ids;
+  for (const auto& member : members)
+    ids.insert(member->Channel()->UniqueID());
+  return ids;
+}
+
+std::shared_ptr<CPVRChannelGroup> MakeGroup()
+{
+  const auto allChannels = std::make_shared<CPVRChannelGroupAllChannels>(false);
+  return std::make_shared<CPVRChannelGroupFromUser>(
+      CPVRChannelsPath(false, "Test", PVR_GROUP_CLIENT_ID_LOCAL), allChannels);
+}
+} // unnamed namespace
+
+TEST(TestPVRChannelGroup, SnapshotIsSharedUntilMembersChange)
+{
+  const auto group = MakeGroup();
+
+  const auto empty = group->GetMembersSnapshot();
+  ASSERT_NE(nullptr, empty);
+  EXPECT_TRUE(empty->sortedMembers.empty());
+  EXPECT_EQ(empty, group->GetMembersSnapshot());
+
+  // the list of all members is the one of the snapshot, not a copy
+  EXPECT_EQ(&empty->sortedMembers, group->GetMembers().get());
+
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(1)));
+  const auto one = group->GetMembersSnapshot();
+  EXPECT_NE(empty, one);
+  EXPECT_GT(one->version, empty->version);
+  EXPECT_EQ(1u, one->sortedMembers.size());
+  EXPECT_EQ(1u, one->members.size());
+  EXPECT_NE(nullptr, group->GetByUniqueID({CLIENT_ID, 1}));
+
+  // older snapshots are never changed
+  EXPECT_TRUE(empty->sortedMembers.empty());
+  EXPECT_TRUE(empty->members.empty());
+
+  // nothing changed, nothing rebuilt
+  EXPECT_FALSE(group->AppendToGroup(MakeMember(1)));
+  EXPECT_EQ(one, group->GetMembersSnapshot());
+}
+
+TEST(TestPVRChannelGroup, MembersKeepTheirSnapshotAlive)
+{
+  const auto group = MakeGroup();
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(1)));
+
+  const auto members = group->GetMembers();
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(2)));
+  group->Unload();
+
+  ASSERT_EQ(1u, members->size());
+  EXPECT_EQ(1, members->front()->Channel()->UniqueID());
+  EXPECT_TRUE(group->GetMembers()->empty());
+}
+
+TEST(TestPVRChannelGroup, GetMembersFiltered)
+{
+  const auto group = MakeGroup();
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(1)));
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(2, true)));
+  ASSERT_TRUE(group->AppendToGroup(MakeMember(3)));
+
+  EXPECT_EQ(3u, group->GetMembers()->size());
+
+  EXPECT_EQ(std::set<int>({1, 3}),
+            UniqueIds(*group->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE)));
+  EXPECT_EQ(std::set<int>({2}),
+            UniqueIds(*group->GetMembers(CPVRChannelGroup::Include::ONLY_HIDDEN)));
+}
+
+TEST(TestPVRChannelGroup, DISABLED_BenchmarkReaders)
+{
+  // readers listing the members of a group while it changes now and then
+  static constexpr unsigned int THREADS = 8;
+  static constexpr int MEMBERS = 1000;
+  static constexpr int READS = 20000;
+
+  const auto group = MakeGroup();
+  for (int i = 1; i <= MEMBERS; ++i)
+    group->AppendToGroup(MakeMember(i));
+
+  // the baseline copies the members under a lock held by readers and the writer, as GetMembers
+  // did before the snapshots
+  std::mutex lock;
+  const auto read = [&group, &lock](CPVRChannelGroup::Include filter, bool lockAndCopy)
+  {
+    std::atomic<int> nextId{MEMBERS + 1};
+    std::atomic<size_t> total{0};
+    const auto reader = [&](unsigned int thread)
+    {
+      size_t sum = 0;
+      for (int j = 0; j < READS; ++j)
+      {
+        // the first reader also is the writer
+        if (thread == 0 && j % 1000 == 0)
+        {
+          std::unique_lock<std::mutex> writeLock(lock, std::defer_lock);
+          if (lockAndCopy)
+            writeLock.lock();
+          group->AppendToGroup(MakeMember(nextId++));
+        }
+
+        if (lockAndCopy)
+        {
+          std::vector<std::shared_ptr<CPVRChannelGroupMember>> members;
+          {
+            std::unique_lock<std::mutex> readLock(lock);
+            members = *group->GetMembers(filter);
+          }
+          for (const auto& member : members)
+            sum += member->Channel()->UniqueID();
+        }
+        else
+        {
+          for (const auto& member : *group->GetMembers(filter))
+            sum += member->Channel()->UniqueID();
+        }
+      }
+      total += sum;
+    };
+    const auto time = Benchmark::TimeThreads(THREADS, reader);
+    EXPECT_GT(total, 0u);
+    return time;
+  };
+
+  for (const bool lockAndCopy : {true, false})
+  {
+    const char* variant = lockAndCopy ? "lock and copy" : "snapshot";
+    Benchmark::Report(
+        fmt::format("{} readers, {} members, all members, {}", THREADS, MEMBERS, variant),
+        Benchmark::Milliseconds(read(CPVRChannelGroup::Include::ALL, lockAndCopy)), "ms");
+    Benchmark::Report(
+        fmt::format("{} readers, {} members, visible members, {}", THREADS, MEMBERS, variant),
+        Benchmark::Milliseconds(read(CPVRChannelGroup::Include::ONLY_VISIBLE, lockAndCopy)),
+        "ms");
+  }
+}
@@ -653,9 +653,8 @@ void CGUIDialogPVRGroupManager::Update()
         CONTROL_IN_GROUP_LABEL,
         StringUtils::Format("{} {}", g_localizeStrings.Get(19220), m_selectedGroup->GroupName()));
 
-    const std::vector<std::shared_ptr<CPVRChannelGroupMember>> groupMembers =
-        m_selectedGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
-    for (const auto& groupMember : groupMembers)
+    const auto groupMembers = m_selectedGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
+    for (const auto& groupMember : *groupMembers)
     {
       m_groupMembers->Add(std::make_shared<CFileItem>(groupMember));
     }
@@ -726,7 +725,8 @@ void CGUIDialogPVRGroupManager::ClearGroupThumbnails(const CFileItem& changedIte
       if (!group)
         continue;
 
-      for (const auto& member : group->GetMembers())
+      const auto members{group->GetMembersSnapshot()};
+      for (const auto& member : members->sortedMembers)
       {
         // If this channel group member is a member of the changed group, update this group's thumb.
         if (changedGroup->IsGroupMember(member))
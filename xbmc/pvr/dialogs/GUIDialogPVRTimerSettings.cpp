@@ -985,9 +985,8 @@ void CGUIDialogPVRTimerSettings::InitializeChannelsList()
   // Add regular channels
   const std::shared_ptr<const CPVRChannelGroup> allGroup =
       CServiceBroker::GetPVRManager().ChannelGroups()->GetGroupAll(m_bIsRadio);
-  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> groupMembers =
-      allGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
-  for (const auto& groupMember : groupMembers)
+  const auto groupMembers = allGroup->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
+  for (const auto& groupMember : *groupMembers)
   {
     const std::shared_ptr<const CPVRChannel> channel = groupMember->Channel();
     const std::string channelDescription = StringUtils::Format(
@@ -70,6 +70,7 @@ void CPVREpg::Clear()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_tags.Clear();
+  m_ingestState.Clear();
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -82,6 +83,10 @@ void CPVREpg::Cleanup(const CDateTime& time)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_tags.Cleanup(time);
+
+  time_t cleanupTime;
+  time.GetAsTime(cleanupTime);
+  m_ingestState.Cleanup(cleanupTime);
 }
 
 std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagNow() const
@@ -146,7 +151,10 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagBetween(const CDateTime& beginTim
       tag = tmpEpg->GetTagBetween(beginTime, endTime, false);
 
     if (tag)
+    {
       m_tags.UpdateEntry(tag);
+      InvalidateIngestState(*tag);
+    }
   }
 
   return tag;
@@ -169,6 +177,12 @@ bool CPVREpg::UpdateEntries(const CPVREpg& epg)
   /* copy over tags */
   m_tags.UpdateEntries(epg.m_tags);
 
+  if (epg.m_ingestState.GetSkippedCount() > 0)
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Skipped {} unchanged events of table '{}'",
+                epg.m_ingestState.GetSkippedCount(), Name());
+
+  m_ingestState.Apply(epg.m_ingestState);
+
   /* update the last scan time of this table */
   m_lastScanTime = CDateTime::GetUTCDateTime();
   m_bUpdateLastScanTime = true;
@@ -192,11 +206,24 @@ bool IsTagExpired(const std::shared_ptr<const CPVREpgInfoTag>& tag)
 
 } // unnamed namespace
 
+void CPVREpg::InvalidateIngestState(const CPVREpgInfoTag& tag)
+{
+  time_t start;
+  tag.StartAsUTC().GetAsTime(start);
+  time_t end;
+  tag.EndAsUTC().GetAsTime(end);
+  m_ingestState.Invalidate(start, end);
+}
+
 bool CPVREpg::UpdateEntry(const EPG_TAG* data, int iClientId)
 {
   if (!data)
     return false;
 
+  // unchanged since the last update, the stored tag is still valid
+  if (m_ingestState.Receive(*data))
+    return true;
+
   const std::shared_ptr<CPVREpgInfoTag> tag =
       std::make_shared<CPVREpgInfoTag>(*data, iClientId, m_channelData, m_iEpgID);
 
@@ -212,6 +239,7 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
     bRet = !IsTagExpired(tag) && m_tags.UpdateEntry(tag);
+    InvalidateIngestState(*tag);
   }
   else if (newState == EPG_EVENT_DELETED)
   {
@@ -227,6 +255,7 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_
       if ((existingTag->StartAsUTC() > CDateTime::GetUTCDateTime()) || IsTagExpired(existingTag))
       {
         m_tags.DeleteEntry(existingTag);
+        InvalidateIngestState(*existingTag);
       }
       else
       {
@@ -296,6 +325,7 @@ bool CPVREpg::Update(time_t start,
     {
       tmpEpg = std::make_shared<CPVREpg>(m_iEpgID, m_strName, m_strScraperName, m_channelData,
                                          std::shared_ptr<CPVREpgDatabase>());
+      tmpEpg->m_ingestState.BeginUpdate(m_ingestState);
     }
   }
 
@@ -385,6 +415,24 @@ std::pair<CDateTime, CDateTime> CPVREpg::GetFirstAndLastUncommitedEPGDate() cons
   return m_tags.GetFirstAndLastUncommitedEPGDate();
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetUncommittedTags() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_tags.GetUncommittedTags();
+}
+
+void CPVREpg::ResetAfterFailedPersist()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  m_ingestState.Clear();
+  m_tags.ReloadCommittedTags();
+
+  // update with the next run of the epg container, not after the regular update interval
+  m_lastScanTime.SetFromUTCDateTime(time_t(0));
+  m_bUpdateLastScanTime = true;
+}
+
 bool CPVREpg::UpdateFromScraper(time_t start, time_t end, bool bForceUpdate)
 {
   if (m_strScraperName.empty())
@@ -10,6 +10,7 @@
 
 #include "XBDateTime.h"
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "pvr/epg/EpgIngestState.h"
 #include "pvr/epg/EpgTagsContainer.h"
 #include "threads/CriticalSection.h"
 #include "utils/EventStream.h"
@@ -230,6 +231,19 @@ namespace PVR
      */
     std::pair<CDateTime, CDateTime> GetFirstAndLastUncommitedEPGDate() const;
 
+    /*!
+     * @brief Get all EPG tags of this table not yet committed to the database.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetUncommittedTags() const;
+
+    /*!
+     * @brief Reconcile this table with the database after committing its queued changes failed.
+     * The broadcasts stored so far are forgotten, so that the next update stores all of them
+     * again, and the tags are reloaded from the database on next use.
+     */
+    void ResetAfterFailedPersist();
+
     /*!
      * @brief Notify observers when the currently active tag changed.
      * @return True if the playing tag has changed, false otherwise.
@@ -305,6 +319,13 @@ namespace PVR
      */
     bool UpdateEntries(const CPVREpg& epg);
 
+    /*!
+     * @brief Forget the client data of all broadcasts overlapping the given tag, so that the
+     * next update does not skip them.
+     * @param tag The tag that was changed.
+     */
+    void InvalidateIngestState(const CPVREpgInfoTag& tag);
+
     /*!
      * @brief Remove all entries from this EPG that finished before the given amount of days.
      * @param iPastDays Delete entries with an end time before the given amount of days from now on.
@@ -321,6 +342,7 @@ namespace PVR
     bool m_bUpdateLastScanTime = false;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
     CPVREpgTagsContainer m_tags;
+    CPVREpgIngestState m_ingestState; /*!< broadcasts delivered by the client, for differential updates */
 
     CEventSource<PVREvent> m_events;
   };
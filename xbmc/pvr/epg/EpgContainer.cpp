@@ -25,7 +25,10 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -264,6 +267,22 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
 
   if (!changedEpgs.empty())
   {
+    // tables whose changes are queued but not committed yet
+    std::vector<std::shared_ptr<CPVREpg>> queuedEpgs;
+    std::vector<std::shared_ptr<CPVREpg>> failedEpgs;
+
+    const auto commit = [&database, &queuedEpgs, &failedEpgs]()
+    {
+      // run both, deletes must be committed before the inserts
+      const bool bDeleted = database->CommitDeleteQueries();
+      const bool bInserted = database->CommitInsertQueries();
+      if (!bDeleted || !bInserted)
+        failedEpgs.insert(failedEpgs.end(), queuedEpgs.cbegin(), queuedEpgs.cend());
+
+      queuedEpgs.clear();
+      return bDeleted && bInserted;
+    };
+
     // Note: We must lock the db the whole time, otherwise races may occur.
     database->Lock();
 
@@ -276,14 +295,14 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
                     epg->GetChannelData()->ChannelName());
 
         bReturn &= epg->QueuePersistQuery(database);
+        queuedEpgs.emplace_back(epg);
 
         size_t queryCount = database->GetInsertQueriesCount() + database->GetDeleteQueriesCount();
         if (queryCount > EPG_COMMIT_QUERY_COUNT_LIMIT)
         {
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committing {} queries in loop.",
                       queryCount);
-          database->CommitDeleteQueries();
-          database->CommitInsertQueries();
+          bReturn &= commit();
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committed {} queries in loop.", queryCount);
         }
       }
@@ -292,12 +311,16 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     }
 
     if (bReturn)
-    {
-      database->CommitDeleteQueries();
-      database->CommitInsertQueries();
-    }
+      bReturn = commit();
+    else
+      failedEpgs.insert(failedEpgs.end(), queuedEpgs.cbegin(), queuedEpgs.cend());
 
     database->Unlock();
+
+    // the queued tags are gone from memory, but did not make it into the database. the tables
+    // must not consider them stored. lock order is epg before db, so this needs the db unlocked.
+    for (const auto& epg : failedEpgs)
+      epg->ResetAfterFailedPersist();
   }
 
   return bReturn;
@@ -744,39 +767,75 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
     progressHandler = std::make_unique<CPVRGUIProgressHandler>(
         g_localizeStrings.Get(19004)); // Loading programme guide
 
-  size_t counter = 0;
+  // Clients are queried in parallel, the channels of a client one after another, as add-ons
+  // are not required to handle concurrent requests.
+  std::map<int, std::vector<std::shared_ptr<CPVREpg>>> epgsByClient;
   for (const auto& epgEntry : epgsToUpdate)
   {
-    if (InterruptUpdate())
-    {
-      bInterrupted = true;
-      break;
-    }
+    if (epgEntry.second)
+      epgsByClient[epgEntry.second->GetChannelData()->ClientId()].emplace_back(epgEntry.second);
+  }
 
-    const std::shared_ptr<CPVREpg> epg = epgEntry.second;
-    if (!epg)
-      continue;
-
-    if (progressHandler)
-      progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++counter,
-                                      epgsToUpdate.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
-    {
-      iUpdatedTables++;
-    }
-    else if (!epg->IsValid())
+  // the tables of different clients are updated in parallel. progress is reported under a lock,
+  // so that it never goes backwards.
+  std::mutex progressMutex;
+  size_t counter = 0;
+  std::atomic<unsigned int> updatedTables{0};
+  std::atomic<bool> interrupted{false};
+
+  const auto updateEpgs = [&](const std::vector<std::shared_ptr<CPVREpg>>& epgs)
+  {
+    std::vector<std::shared_ptr<CPVREpg>> invalid;
+    for (const auto& epg : epgs)
     {
-      invalidTables.push_back(epg);
+      if (InterruptUpdate())
+      {
+        interrupted = true;
+        break;
+      }
+
+      if (progressHandler)
+      {
+        std::unique_lock<std::mutex> lock(progressMutex);
+        progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++counter,
+                                        epgsToUpdate.size());
+      }
+
+      if ((!bOnlyPending || epg->UpdatePending()) &&
+          epg->Update(start, end, m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
+                      m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
+                      database, bOnlyPending))
+      {
+        updatedTables++;
+      }
+      else if (!epg->IsValid())
+      {
+        invalid.emplace_back(epg);
+      }
     }
+    return invalid;
+  };
+
+  std::vector<std::future<std::vector<std::shared_ptr<CPVREpg>>>> clientUpdates;
+  for (auto it = epgsByClient.cbegin(); it != epgsByClient.cend(); ++it)
+  {
+    // the last client is updated by this thread
+    if (std::next(it) == epgsByClient.cend())
+      invalidTables = updateEpgs((*it).second);
+    else
+      clientUpdates.emplace_back(
+          std::async(std::launch::async, updateEpgs, std::cref((*it).second)));
   }
 
+  for (auto& clientUpdate : clientUpdates)
+  {
+    const std::vector<std::shared_ptr<CPVREpg>> invalid = clientUpdate.get();
+    invalidTables.insert(invalidTables.end(), invalid.cbegin(), invalid.cend());
+  }
+
+  bInterrupted = interrupted;
+  iUpdatedTables = updatedTables;
+
   progressHandler.reset();
 
   QueueDeleteEpgs(invalidTables);
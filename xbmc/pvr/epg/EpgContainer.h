@@ -295,7 +295,8 @@ namespace PVR
     bool UpdateEPG(bool bOnlyPending = false);
 
     /*!
-     * @brief Check whether a running update should be interrupted.
+     * @brief Check whether a running update should be interrupted. Thread safe, it is called by
+     * the threads updating the tables of different clients in parallel.
      * @return True if a running update should be interrupted, false otherwise.
      */
     bool InterruptUpdate() const;
@@ -343,7 +344,7 @@ namespace PVR
     std::map<int, std::shared_ptr<CPVREpg>> m_epgIdToEpgMap; /*!< the EPGs in this container. maps epg ids to epgs */
     std::map<std::pair<int, int>, std::shared_ptr<CPVREpg>> m_channelUidToEpgMap; /*!< the EPGs in this container. maps channel uids to epgs */
 
-    mutable CCriticalSection m_critSection; /*!< a critical section for changes to this container */
+    mutable CCriticalSection m_critSection{"PVREpgContainer"}; /*!< a critical section for changes to this container */
     CEvent m_updateEvent; /*!< trigger when an update finishes */
 
     std::list<CEpgUpdateRequest> m_updateRequests; /*!< list of update requests triggered by addon */
@@ -14,6 +14,7 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
 #include "pvr/epg/EpgSearchFilter.h"
+#include "pvr/epg/EpgSearchTermConverter.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/StringUtils.h"
@@ -27,10 +28,35 @@
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+// rows per multi-row REPLACE statement. sqlite < 3.8.8 limits a VALUES list to 500 rows.
+constexpr size_t EPG_PERSIST_BATCH_SIZE = 100;
+
+constexpr const char* EPG_PERSIST_QUERY =
+    "REPLACE INTO epgtags (idEpg, iStartTime, "
+    "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
+    "sIMDBNumber, "
+    "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
+    "iSeriesId, "
+    "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
+    "iBroadcastUid, idBroadcast, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo) "
+    "VALUES ";
+} // unnamed namespace
+
 bool CPVREpgDatabase::Open()
+{
+  return Open(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg);
+}
+
+bool CPVREpgDatabase::Open(const DatabaseSettings& settings)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return CDatabase::Open(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg);
+  if (!CDatabase::Open(settings))
+    return false;
+
+  m_bHasFullTextIndex = ProbeFullTextIndex();
+  return true;
 }
 
 void CPVREpgDatabase::Close()
@@ -144,6 +170,113 @@ void CPVREpgDatabase::CreateAnalytics()
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+
+  if (m_sqlite)
+    CreateFullTextIndex();
+}
+
+void CPVREpgDatabase::CreateFullTextIndex()
+{
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating EPG full text index");
+
+  // The index is an external content fts5 table, it stores only the trigrams of the searchable
+  // columns. Trigram tokenization keeps the substring semantics of the LIKE based search.
+  // Triggers are dropped together with the other analytics on database upgrades, so the index
+  // is rebuilt from scratch here.
+  try
+  {
+    m_pDS->exec("DROP TABLE IF EXISTS epgtags_fts");
+    m_pDS->exec("CREATE VIRTUAL TABLE epgtags_fts USING fts5("
+                "sTitle, sPlotOutline, sPlot, sEpisodeName, sGenre, "
+                "content='epgtags', content_rowid='idBroadcast', tokenize='trigram')");
+    m_pDS->exec("INSERT INTO epgtags_fts(epgtags_fts) VALUES('rebuild')");
+
+    // REPLACE INTO does not fire delete triggers for the rows it replaces, so remove them
+    // from the index before the insert.
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_bi BEFORE INSERT ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot, "
+                "sEpisodeName, sGenre) "
+                "SELECT 'delete', idBroadcast, sTitle, sPlotOutline, sPlot, sEpisodeName, sGenre "
+                "FROM epgtags WHERE idBroadcast = new.idBroadcast OR "
+                "(idEpg = new.idEpg AND iStartTime = new.iStartTime); "
+                "END");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_ai AFTER INSERT ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot, sEpisodeName, sGenre) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot, "
+                "new.sEpisodeName, new.sGenre); "
+                "END");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_ad AFTER DELETE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot, "
+                "sEpisodeName, sGenre) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot, "
+                "old.sEpisodeName, old.sGenre); "
+                "END");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_au AFTER UPDATE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot, "
+                "sEpisodeName, sGenre) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot, "
+                "old.sEpisodeName, old.sGenre); "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot, sEpisodeName, sGenre) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot, "
+                "new.sEpisodeName, new.sGenre); "
+                "END");
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "EPG full text index not supported by the sqlite library, searching "
+                          "the EPG will be slower");
+    DropFullTextIndex();
+  }
+}
+
+void CPVREpgDatabase::DropFullTextIndex()
+{
+  for (const char* trigger :
+       {"epgtags_fts_bi", "epgtags_fts_ai", "epgtags_fts_ad", "epgtags_fts_au"})
+  {
+    try
+    {
+      m_pDS->exec(PrepareSQL("DROP TRIGGER IF EXISTS %s", trigger));
+    }
+    catch (...)
+    {
+    }
+  }
+
+  try
+  {
+    m_pDS->exec("DROP TABLE IF EXISTS epgtags_fts");
+  }
+  catch (...)
+  {
+    // needs the fts5 module, the orphaned table is harmless without its triggers
+  }
+}
+
+bool CPVREpgDatabase::ProbeFullTextIndex()
+{
+  if (!m_sqlite ||
+      GetSingleValue("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'epgtags_fts'")
+          .empty())
+    return false;
+
+  try
+  {
+    // fails if the database was created by a sqlite library with fts5 support, but the one in
+    // use now has none
+    if (m_pDS->query("SELECT rowid FROM epgtags_fts WHERE epgtags_fts MATCH '\"kodi\"' LIMIT 1"))
+    {
+      m_pDS->close();
+      return true;
+    }
+  }
+  catch (...)
+  {
+  }
+
+  CLog::Log(LOGWARNING, "EPG full text index not usable, removing it");
+  DropFullTextIndex();
+  return false;
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -572,133 +705,6 @@ CDateTime CPVREpgDatabase::GetMaxEndTime(int iEpgID, const CDateTime& maxEnd) co
   return {};
 }
 
-namespace
-{
-
-class CSearchTermConverter
-{
-public:
-  explicit CSearchTermConverter(const std::string& strSearchTerm) { Parse(strSearchTerm); }
-
-  bool HasSearchTerm() const { return !m_fragments.empty(); }
-
-  std::string ToSQL(const std::string& strFieldName) const
-  {
-    std::string result = "(";
-
-    for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
-    {
-      result += (*it);
-
-      ++it;
-      if (it != m_fragments.cend())
-        result += strFieldName;
-    }
-
-    StringUtils::TrimRight(result);
-    result += ")";
-    return result;
-  }
-
-private:
-  void Parse(const std::string& strSearchTerm)
-  {
-    std::string strParsedSearchTerm(strSearchTerm);
-    StringUtils::Trim(strParsedSearchTerm);
-
-    std::string strFragment;
-
-    bool bNextOR = false;
-    while (!strParsedSearchTerm.empty())
-    {
-      StringUtils::TrimLeft(strParsedSearchTerm);
-
-      if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
-          StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " NOT ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " AND ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " OR ";
-        bNextOR = false;
-      }
-      else
-      {
-        std::string strTerm;
-        GetAndCutNextTerm(strParsedSearchTerm, strTerm);
-        if (!strTerm.empty())
-        {
-          if (bNextOR && !m_fragments.empty())
-            strFragment += " OR "; // default operator
-
-          strFragment += "(UPPER(";
-
-          m_fragments.emplace_back(strFragment);
-          strFragment.clear();
-
-          strFragment += ") LIKE UPPER('%";
-          StringUtils::Replace(strTerm, "'", "''"); // escape '
-          strFragment += strTerm;
-          strFragment += "%')) ";
-
-          bNextOR = true;
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      StringUtils::TrimLeft(strParsedSearchTerm);
-    }
-
-    if (!strFragment.empty())
-      m_fragments.emplace_back(strFragment);
-  }
-
-  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm)
-  {
-    std::string strFindNext(" ");
-
-    if (StringUtils::EndsWith(strSearchTerm, "\""))
-    {
-      strSearchTerm.erase(0, 1);
-      strFindNext = "\"";
-    }
-
-    const size_t iNextPos = strSearchTerm.find(strFindNext);
-    if (iNextPos != std::string::npos)
-    {
-      strNextTerm = strSearchTerm.substr(0, iNextPos);
-      strSearchTerm.erase(0, iNextPos + 1);
-    }
-    else
-    {
-      strNextTerm = strSearchTerm;
-      strSearchTerm.clear();
-    }
-  }
-
-  std::vector<std::string> m_fragments;
-};
-
-} // unnamed namespace
-
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
     const PVREpgSearchData& searchData) const
 {
@@ -800,24 +806,32 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   // search term
   /////////////////////////////////////////////////////////////////////////////////////////////
 
-  const CSearchTermConverter conv{searchData.m_strSearchTerm};
+  const CPVREpgSearchTermConverter conv{searchData.m_strSearchTerm};
   if (conv.HasSearchTerm())
   {
-    // title
-    std::string strWhere = conv.ToSQL("sTitle");
-
-    // plot outline
-    strWhere += " OR ";
-    strWhere += conv.ToSQL("sPlotOutline");
-
+    // title, plot outline, episode name, genre and optionally plot
+    std::vector<std::string> fields{"sTitle", "sPlotOutline", "sEpisodeName", "sGenre"};
     if (searchData.m_bSearchInDescription)
+      fields.emplace_back("sPlot");
+
+    const std::string strMatch = m_bHasFullTextIndex ? conv.ToFullTextQuery(fields) : "";
+    if (!strMatch.empty())
     {
-      // plot
-      strWhere += " OR ";
-      strWhere += conv.ToSQL("sPlot");
+      filter.AppendWhere(PrepareSQL("idBroadcast IN (SELECT rowid FROM epgtags_fts "
+                                    "WHERE epgtags_fts MATCH '%s')",
+                                    strMatch.c_str()));
+    }
+    else
+    {
+      std::string strWhere;
+      for (const auto& field : fields)
+      {
+        if (!strWhere.empty())
+          strWhere += " OR ";
+        strWhere += conv.ToSQL(field);
+      }
+      filter.AppendWhere(strWhere);
     }
-
-    filter.AppendWhere(strWhere);
   }
 
   if (BuildSQL(strQuery, filter, strQuery))
@@ -845,6 +859,12 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   return {};
 }
 
+bool CPVREpgDatabase::HasFullTextIndex() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_bHasFullTextIndex;
+}
+
 std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::GetEpgTagByUniqueBroadcastID(
     int iEpgID, unsigned int iUniqueBroadcastId) const
 {
@@ -1095,6 +1115,45 @@ bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(int iEpgID,
   return false;
 }
 
+bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQueries(
+    int iEpgID, const std::vector<std::pair<CDateTime, CDateTime>>& ranges)
+{
+  if (ranges.empty())
+    return true;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  bool bReturn = true;
+  for (size_t i = 0; i < ranges.size(); i += EPG_PERSIST_BATCH_SIZE)
+  {
+    std::string strRanges;
+    for (size_t j = i; j < ranges.size() && j < i + EPG_PERSIST_BATCH_SIZE; ++j)
+    {
+      time_t minEnd;
+      ranges[j].first.GetAsTime(minEnd);
+
+      time_t maxStart;
+      ranges[j].second.GetAsTime(maxStart);
+
+      if (!strRanges.empty())
+        strRanges += " OR ";
+      strRanges += PrepareSQL("(iEndTime >= %u AND iStartTime <= %u)",
+                              static_cast<unsigned int>(minEnd),
+                              static_cast<unsigned int>(maxStart));
+    }
+
+    Filter filter;
+    filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgID));
+    filter.AppendWhere(strRanges);
+
+    std::string strQuery;
+    if (!BuildSQL("DELETE FROM epgtags", filter, strQuery) || !QueueDeleteQuery(strQuery))
+      bReturn = false;
+  }
+
+  return bReturn;
+}
+
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetAllEpgTags(int iEpgID) const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -1285,14 +1344,8 @@ bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
   return QueueDeleteQuery(strQuery);
 }
 
-bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
+std::string CPVREpgDatabase::GetPersistValues(const CPVREpgInfoTag& tag) const
 {
-  if (tag.EpgID() <= 0)
-  {
-    CLog::LogF(LOGERROR, "Tag '{}' does not have a valid table", tag.Title());
-    return false;
-  }
-
   time_t iStartTime, iEndTime;
   tag.StartAsUTC().GetAsTime(iStartTime);
   tag.EndAsUTC().GetAsTime(iEndTime);
@@ -1301,60 +1354,69 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
   if (tag.FirstAired().IsValid())
     sFirstAired = tag.FirstAired().GetAsW3CDate();
 
-  int iBroadcastId = tag.DatabaseID();
-  std::string strQuery;
-
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  // new tags get their id assigned by the database
+  const int iBroadcastId = tag.DatabaseID();
+  const std::string strBroadcastId = iBroadcastId < 0 ? "NULL" : std::to_string(iBroadcastId);
+
+  return PrepareSQL(
+      "(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
+      "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %s, '%s', '%s', '%s')",
+      tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
+      tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
+      tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
+      tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
+      tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
+      tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
+      tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
+      tag.UniqueBroadcastID(), strBroadcastId.c_str(), tag.ClientParentalRatingIconPath().c_str(),
+      tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str());
+}
 
-  if (iBroadcastId < 0)
+bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
+{
+  if (tag.EpgID() <= 0)
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, '%s', '%s', '%s');",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID(), tag.ClientParentalRatingIconPath().c_str(),
-        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str());
+    CLog::LogF(LOGERROR, "Tag '{}' does not have a valid table", tag.Title());
+    return false;
   }
-  else
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  QueueInsertQuery(EPG_PERSIST_QUERY + GetPersistValues(tag) + ";");
+  return true;
+}
+
+bool CPVREpgDatabase::QueuePersistQueries(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  bool bReturn = true;
+  std::string strQuery;
+  size_t iRows = 0;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (const auto& tag : tags)
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, idBroadcast, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %i, '%s', '%s', '%s');",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID(), iBroadcastId, tag.ClientParentalRatingIconPath().c_str(),
-        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str());
+    if (tag->EpgID() <= 0)
+    {
+      CLog::LogF(LOGERROR, "Tag '{}' does not have a valid table", tag->Title());
+      bReturn = false;
+      continue;
+    }
+
+    strQuery += iRows == 0 ? EPG_PERSIST_QUERY : ", ";
+    strQuery += GetPersistValues(*tag);
+
+    if (++iRows == EPG_PERSIST_BATCH_SIZE)
+    {
+      QueueInsertQuery(strQuery + ";");
+      strQuery.clear();
+      iRows = 0;
+    }
   }
 
-  QueueInsertQuery(strQuery);
-  return true;
+  if (iRows > 0)
+    QueueInsertQuery(strQuery + ";");
+
+  return bReturn;
 }
 
 int CPVREpgDatabase::GetLastEPGId() const
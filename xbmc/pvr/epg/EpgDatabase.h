@@ -12,6 +12,8 @@
 #include "threads/CriticalSection.h"
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 class CDateTime;
@@ -47,6 +49,13 @@ namespace PVR
      */
     bool Open() override;
 
+    /*!
+     * @brief Open the database with the given settings instead of the ones from advancedsettings.
+     * @param settings The database settings.
+     * @return True if it was opened successfully, false otherwise.
+     */
+    bool Open(const DatabaseSettings& settings);
+
     /*!
      * @brief Close the database.
      */
@@ -66,7 +75,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion() const override { return 20; }
+    int GetSchemaVersion() const override { return 21; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -170,6 +179,12 @@ namespace PVR
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTags(
         const PVREpgSearchData& searchData) const;
 
+    /*!
+     * @brief Check whether search terms are looked up in a full text index.
+     * @return True if the index is available, false if searches scan the tags table.
+     */
+    bool HasFullTextIndex() const;
+
     /*!
      * @brief Get an EPG tag given its EPG id and unique broadcast ID.
      * @param iEpgID The ID of the EPG for the tag to get.
@@ -246,6 +261,17 @@ namespace PVR
                                                      const CDateTime& minEndTime,
                                                      const CDateTime& maxStartTime);
 
+    /*!
+     * @brief Write the queries to delete all EPG tags in any of the given ranges of min end time
+     * and max start time of the given EPG id to db query queue. Ranges are combined into few
+     * queries.
+     * @param iEpgID The ID of the EPG for the tags to delete.
+     * @param ranges The min end and max start times for the tags to delete.
+     * @return True if it was queued successfully, false otherwise.
+     */
+    bool QueueDeleteEpgTagsByMinEndMaxStartTimeQueries(
+        int iEpgID, const std::vector<std::pair<CDateTime, CDateTime>>& ranges);
+
     /*!
      * @brief Get the last stored EPG scan time.
      * @param iEpgId The table to update the time for. Use 0 for a global value.
@@ -306,6 +332,14 @@ namespace PVR
      */
     bool QueuePersistQuery(const CPVREpgInfoTag& tag);
 
+    /*!
+     * @brief Write the queries to persist the given EPG tags to db query queue. Multiple tags
+     * are persisted per query.
+     * @param tags The tags to persist.
+     * @return True on success, false otherwise.
+     */
+    bool QueuePersistQueries(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -377,8 +411,30 @@ namespace PVR
      */
     void UpdateTables(int version) override;
 
+    /*!
+     * @brief Create the full text index of the EPG tags. Requires sqlite with fts5 and trigram
+     * tokenizer support, does nothing but log a warning otherwise.
+     */
+    void CreateFullTextIndex();
+
+    /*!
+     * @brief Remove the full text index of the EPG tags and the triggers maintaining it.
+     */
+    void DropFullTextIndex();
+
+    /*!
+     * @brief Check whether the full text index exists and can be queried.
+     * @return True if the index is usable, false otherwise.
+     */
+    bool ProbeFullTextIndex();
+
     int GetMinSchemaVersion() const override { return 4; }
 
+    /*!
+     * @brief Get the VALUES tuple to persist a tag.
+     */
+    std::string GetPersistValues(const CPVREpgInfoTag& tag) const;
+
     std::shared_ptr<CPVREpgInfoTag> CreateEpgTag(
         const std::unique_ptr<dbiplus::Dataset>& pDS) const;
 
@@ -386,5 +442,6 @@ namespace PVR
         bool bRadio, const std::unique_ptr<dbiplus::Dataset>& pDS) const;
 
     mutable CCriticalSection m_critSection;
+    bool m_bHasFullTextIndex = false;
   };
 }
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgIngestState.h"
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace PVR;
+
+namespace
+{
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+template<typename T>
+void HashValue(uint64_t& hash, T value)
+{
+  HashBytes(hash, &value, sizeof(value));
+}
+
+void HashString(uint64_t& hash, const char* value)
+{
+  // the terminating zero separates consecutive strings
+  if (value)
+    HashBytes(hash, value, std::strlen(value) + 1);
+  else
+    HashBytes(hash, "", 1);
+}
+
+// zero length broadcasts still occupy their start time
+time_t EndOf(time_t start, time_t end)
+{
+  return end > start ? end : start + 1;
+}
+
+} // unnamed namespace
+
+uint64_t CPVREpgIngestState::Hash(const EPG_TAG& data)
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  HashValue(hash, data.iUniqueBroadcastId);
+  HashValue(hash, data.iUniqueChannelId);
+  HashString(hash, data.strTitle);
+  HashString(hash, data.strTitleExtraInfo);
+  HashValue(hash, data.iSeriesNumber);
+  HashValue(hash, data.iEpisodeNumber);
+  HashValue(hash, data.iEpisodePartNumber);
+  HashString(hash, data.strEpisodeName);
+  HashValue(hash, data.startTime);
+  HashValue(hash, data.endTime);
+  HashString(hash, data.strPlotOutline);
+  HashString(hash, data.strPlot);
+  HashString(hash, data.strOriginalTitle);
+  HashString(hash, data.strCast);
+  HashString(hash, data.strDirector);
+  HashString(hash, data.strWriter);
+  HashValue(hash, data.iYear);
+  HashString(hash, data.strIMDBNumber);
+  HashString(hash, data.strIconPath);
+  HashValue(hash, data.iGenreType);
+  HashValue(hash, data.iGenreSubType);
+  HashString(hash, data.strGenreDescription);
+  HashString(hash, data.strFirstAired);
+  HashValue(hash, data.iParentalRating);
+  HashString(hash, data.strParentalRatingCode);
+  HashString(hash, data.strParentalRatingIcon);
+  HashString(hash, data.strParentalRatingSource);
+  HashValue(hash, data.iStarRating);
+  HashValue(hash, data.iFlags);
+  HashString(hash, data.strSeriesLink);
+  return hash;
+}
+
+void CPVREpgIngestState::BeginUpdate(const CPVREpgIngestState& current)
+{
+  m_known = current.m_known;
+  m_received.clear();
+  m_changed.clear();
+  m_iSkipped = 0;
+}
+
+bool CPVREpgIngestState::Receive(const EPG_TAG& data)
+{
+  const Broadcast broadcast{data.endTime, Hash(data)};
+  m_received[data.startTime] = broadcast;
+
+  const auto it = m_known.find(data.startTime);
+  if (it != m_known.end() && it->second.m_hash == broadcast.m_hash)
+  {
+    m_iSkipped++;
+    return true;
+  }
+
+  m_changed.emplace_back(data.startTime, EndOf(data.startTime, data.endTime));
+  return false;
+}
+
+void CPVREpgIngestState::Apply(const CPVREpgIngestState& update)
+{
+  m_known.clear();
+
+  std::vector<std::pair<time_t, time_t>> changed = update.m_changed;
+  std::sort(changed.begin(), changed.end());
+
+  // the max end of all changed broadcasts starting before the one at the same index
+  std::vector<time_t> maxEnds;
+  maxEnds.reserve(changed.size());
+  for (const auto& span : changed)
+    maxEnds.emplace_back(maxEnds.empty() ? span.second : std::max(maxEnds.back(), span.second));
+
+  for (const auto& [start, broadcast] : update.m_received)
+  {
+    const time_t end = EndOf(start, broadcast.m_end);
+
+    // a changed broadcast starting before this one reaches into it
+    const auto before =
+        std::lower_bound(changed.cbegin(), changed.cend(), std::make_pair(start, time_t(0)));
+    const size_t index = before - changed.cbegin();
+    if (index > 0 && maxEnds[index - 1] > start)
+      continue;
+
+    // a changed broadcast starts within this one
+    const auto after = std::upper_bound(before, changed.cend(), start,
+                                        [](time_t time, const auto& span)
+                                        { return time < span.first; });
+    if (after != changed.cend() && after->first < end)
+      continue;
+
+    m_known.emplace_hint(m_known.end(), start, broadcast);
+  }
+}
+
+void CPVREpgIngestState::Invalidate(time_t start, time_t end)
+{
+  end = EndOf(start, end);
+
+  for (auto it = m_known.begin(); it != m_known.end() && it->first < end;)
+  {
+    if (EndOf(it->first, it->second.m_end) > start)
+      it = m_known.erase(it);
+    else
+      ++it;
+  }
+}
+
+void CPVREpgIngestState::Cleanup(time_t time)
+{
+  for (auto it = m_known.begin(); it != m_known.end();)
+  {
+    if (it->second.m_end < time)
+      it = m_known.erase(it);
+    else
+      ++it;
+  }
+}
+
+void CPVREpgIngestState::Clear()
+{
+  m_known.clear();
+  m_received.clear();
+  m_changed.clear();
+  m_iSkipped = 0;
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <utility>
+#include <vector>
+
+struct EPG_TAG;
+
+namespace PVR
+{
+/*!
+ * @brief Remembers content hashes of the broadcasts a client delivered for an EPG, so that
+ * broadcasts which did not change since the last refresh can be skipped before an EPG tag is
+ * created for them.
+ *
+ * After a refresh, a hash is kept for every broadcast delivered by it, except for broadcasts
+ * overlapping another changed one. Storing the changed broadcast may remove them.
+ */
+class CPVREpgIngestState
+{
+public:
+  /*!
+   * @brief Start collecting a refresh, based on the broadcasts known by another state.
+   * @param current The state of the EPG being refreshed.
+   */
+  void BeginUpdate(const CPVREpgIngestState& current);
+
+  /*!
+   * @brief Record a broadcast delivered by the client.
+   * @param data The broadcast.
+   * @return True if it is identical to the last ingested version and can be skipped.
+   */
+  bool Receive(const EPG_TAG& data);
+
+  /*!
+   * @brief Take over the broadcasts collected by a refresh.
+   * @param update The state the refresh was collected in.
+   */
+  void Apply(const CPVREpgIngestState& update);
+
+  /*!
+   * @brief Forget all broadcasts overlapping the given time span, e.g. after a tag was
+   * changed by other means than a refresh.
+   */
+  void Invalidate(time_t start, time_t end);
+
+  /*!
+   * @brief Forget all broadcasts that ended before the given time.
+   */
+  void Cleanup(time_t time);
+
+  void Clear();
+
+  size_t GetKnownCount() const { return m_known.size(); }
+  size_t GetSkippedCount() const { return m_iSkipped; }
+
+  static uint64_t Hash(const EPG_TAG& data);
+
+private:
+  struct Broadcast
+  {
+    time_t m_end = 0;
+    uint64_t m_hash = 0;
+  };
+
+  std::map<time_t, Broadcast> m_known; /*!< ingested broadcasts, by start time */
+  std::map<time_t, Broadcast> m_received; /*!< broadcasts received by the current refresh */
+  std::vector<std::pair<time_t, time_t>> m_changed; /*!< spans of changed broadcasts */
+  size_t m_iSkipped = 0;
+};
+} // namespace PVR
@@ -346,6 +346,7 @@ bool CPVREpgSearchFilter::MatchSearchTerm(const std::shared_ptr<const CPVREpgInf
       CTextSearch search(m_searchData.m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
 
       bReturn = search.Search(tag->Title()) || search.Search(tag->PlotOutline()) ||
+                search.Search(tag->EpisodeName()) || search.Search(tag->GenreDescription()) ||
                 (m_searchData.m_bSearchInDescription && search.Search(tag->Plot()));
     }
   }
@@ -0,0 +1,198 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchTermConverter.h"
+
+#include "utils/StringUtils.h"
+
+using namespace PVR;
+
+namespace
+{
+// the trigram tokenizer cannot match substrings shorter than this
+constexpr size_t MIN_FULLTEXT_TERM_LENGTH = 3;
+} // unnamed namespace
+
+CPVREpgSearchTermConverter::CPVREpgSearchTermConverter(const std::string& strSearchTerm)
+{
+  Parse(strSearchTerm);
+}
+
+std::string CPVREpgSearchTermConverter::ToSQL(const std::string& strFieldName) const
+{
+  std::string result = "(";
+
+  for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
+  {
+    result += (*it);
+
+    ++it;
+    if (it != m_fragments.cend())
+      result += strFieldName;
+  }
+
+  StringUtils::TrimRight(result);
+  result += ")";
+  return result;
+}
+
+std::string CPVREpgSearchTermConverter::ToFullTextQuery(
+    const std::vector<std::string>& fieldNames) const
+{
+  if (m_terms.empty() || m_bTrailingOperator || fieldNames.empty())
+    return {};
+
+  std::string expression;
+  for (auto it = m_terms.cbegin(); it != m_terms.cend(); ++it)
+  {
+    if (StringUtils::utf8_strlen(it->m_strTerm.c_str()) < MIN_FULLTEXT_TERM_LENGTH)
+      return {};
+
+    if (it == m_terms.cbegin())
+    {
+      // fts5 has no unary NOT
+      if (!it->m_operators.empty())
+        return {};
+    }
+    else
+    {
+      // fts5 NOT is binary and means "and not", so "a and not b" maps to "a NOT b"
+      std::string strOperator;
+      if (it->m_operators.size() == 1)
+        strOperator = it->m_operators.front();
+      else if (it->m_operators.size() == 2 && it->m_operators[0] == "AND" &&
+               it->m_operators[1] == "NOT")
+        strOperator = "NOT";
+      else
+        return {};
+
+      expression += " " + strOperator + " ";
+    }
+
+    std::string strTerm = it->m_strTerm;
+    StringUtils::Replace(strTerm, "\"", "\"\""); // escape "
+    expression += "\"" + strTerm + "\"";
+  }
+
+  // match each column on its own, like the LIKE expressions do. "{a b} : (x AND y)" would also
+  // match x in column a and y in column b.
+  std::string result;
+  for (const auto& fieldName : fieldNames)
+  {
+    if (!result.empty())
+      result += " OR ";
+    result += fieldName + " : (" + expression + ")";
+  }
+  return result;
+}
+
+void CPVREpgSearchTermConverter::Parse(const std::string& strSearchTerm)
+{
+  std::string strParsedSearchTerm(strSearchTerm);
+  StringUtils::Trim(strParsedSearchTerm);
+
+  std::string strFragment;
+  std::vector<std::string> operators;
+
+  bool bNextOR = false;
+  while (!strParsedSearchTerm.empty())
+  {
+    StringUtils::TrimLeft(strParsedSearchTerm);
+
+    if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
+        StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " NOT ";
+      operators.emplace_back("NOT");
+      bNextOR = false;
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " AND ";
+      operators.emplace_back("AND");
+      bNextOR = false;
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " OR ";
+      operators.emplace_back("OR");
+      bNextOR = false;
+    }
+    else
+    {
+      std::string strTerm;
+      GetAndCutNextTerm(strParsedSearchTerm, strTerm);
+      if (!strTerm.empty())
+      {
+        if (bNextOR && !m_fragments.empty())
+        {
+          strFragment += " OR "; // default operator
+          operators.emplace_back("OR");
+        }
+
+        strFragment += "(UPPER(";
+
+        m_fragments.emplace_back(strFragment);
+        strFragment.clear();
+
+        m_terms.push_back({std::move(operators), strTerm});
+        operators.clear();
+
+        strFragment += ") LIKE UPPER('%";
+        StringUtils::Replace(strTerm, "'", "''"); // escape '
+        strFragment += strTerm;
+        strFragment += "%')) ";
+
+        bNextOR = true;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    StringUtils::TrimLeft(strParsedSearchTerm);
+  }
+
+  if (!strFragment.empty())
+    m_fragments.emplace_back(strFragment);
+
+  m_bTrailingOperator = !operators.empty();
+}
+
+void CPVREpgSearchTermConverter::GetAndCutNextTerm(std::string& strSearchTerm,
+                                                   std::string& strNextTerm)
+{
+  std::string strFindNext(" ");
+
+  if (StringUtils::EndsWith(strSearchTerm, "\""))
+  {
+    strSearchTerm.erase(0, 1);
+    strFindNext = "\"";
+  }
+
+  const size_t iNextPos = strSearchTerm.find(strFindNext);
+  if (iNextPos != std::string::npos)
+  {
+    strNextTerm = strSearchTerm.substr(0, iNextPos);
+    strSearchTerm.erase(0, iNextPos + 1);
+  }
+  else
+  {
+    strNextTerm = strSearchTerm;
+    strSearchTerm.clear();
+  }
+}
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Converts an EPG search term ("foo and not bar", "\"foo bar\" | baz", ...) into
+ * database query expressions.
+ */
+class CPVREpgSearchTermConverter
+{
+public:
+  explicit CPVREpgSearchTermConverter(const std::string& strSearchTerm);
+
+  bool HasSearchTerm() const { return !m_fragments.empty(); }
+
+  /*!
+   * @brief Get a case insensitive LIKE expression matching the search term against a column.
+   * @param strFieldName The column to match.
+   * @return The SQL expression.
+   */
+  std::string ToSQL(const std::string& strFieldName) const;
+
+  /*!
+   * @brief Get a FTS5 MATCH expression for a trigram tokenized full text index.
+   * @param fieldNames The indexed columns to match.
+   * @return The expression or an empty string if the search term cannot be expressed as full
+   * text query, for example because a term is shorter than a trigram. Callers must fall back
+   * to ToSQL in that case.
+   */
+  std::string ToFullTextQuery(const std::vector<std::string>& fieldNames) const;
+
+private:
+  struct Term
+  {
+    std::vector<std::string> m_operators; /*!< The operators preceding the term */
+    std::string m_strTerm;
+  };
+
+  void Parse(const std::string& strSearchTerm);
+  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm);
+
+  std::vector<std::string> m_fragments;
+  std::vector<Term> m_terms;
+  bool m_bTrailingOperator = false;
+};
+} // namespace PVR
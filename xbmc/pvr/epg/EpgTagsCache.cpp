@@ -12,19 +12,11 @@
 #include "pvr/PVRManager.h"
 #include "pvr/PVRPlaybackState.h"
 #include "pvr/epg/EpgChannelData.h"
-#include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
-#include "utils/log.h"
-
-#include <algorithm>
+#include "pvr/epg/EpgTagsIndex.h"
 
 using namespace PVR;
 
-namespace
-{
-const CDateTimeSpan ONE_SECOND(0, 0, 0, 1);
-}
-
 void CPVREpgTagsCache::SetChannelData(const std::shared_ptr<CPVREpgChannelData>& data)
 {
   m_channelData = data;
@@ -82,34 +74,16 @@ bool CPVREpgTagsCache::Refresh()
   m_nowActiveTag.reset();
   m_nextStartingTag.reset();
 
-  const auto it =
-      std::find_if(m_changedTags.cbegin(), m_changedTags.cend(), [&activeTime](const auto& tag) {
-        return tag.second->StartAsUTC() <= activeTime && tag.second->EndAsUTC() > activeTime;
-      });
+  m_nowActiveTag = m_changedTags.GetTagAt(activeTime);
+  if (!m_nowActiveTag)
+    m_nowActiveTag = m_committedTags.GetTagAt(activeTime);
 
-  if (it != m_changedTags.cend())
+  if (m_nowActiveTag)
   {
-    m_nowActiveTag = (*it).second;
     m_nowActiveStart = m_nowActiveTag->StartAsUTC();
     m_nowActiveEnd = m_nowActiveTag->EndAsUTC();
   }
 
-  if (!m_nowActiveTag && m_database)
-  {
-    const std::vector<std::shared_ptr<CPVREpgInfoTag>> tags =
-        m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, activeTime + ONE_SECOND, activeTime);
-    if (!tags.empty())
-    {
-      if (tags.size() > 1)
-        CLog::LogF(LOGWARNING, "Got multiple results. Picking up the first.");
-
-      m_nowActiveTag = tags.front();
-      m_nowActiveTag->SetChannelData(m_channelData);
-      m_nowActiveStart = m_nowActiveTag->StartAsUTC();
-      m_nowActiveEnd = m_nowActiveTag->EndAsUTC();
-    }
-  }
-
   RefreshLastEndedTag(activeTime);
   RefreshNextStartingTag(activeTime);
 
@@ -136,44 +110,20 @@ bool CPVREpgTagsCache::Refresh()
 
 void CPVREpgTagsCache::RefreshLastEndedTag(const CDateTime& activeTime)
 {
-  if (m_database)
-  {
-    m_lastEndedTag = m_database->GetEpgTagByMaxEndTime(m_iEpgID, activeTime);
-    if (m_lastEndedTag)
-      m_lastEndedTag->SetChannelData(m_channelData);
-  }
+  m_lastEndedTag = m_committedTags.GetLastEndedTag(activeTime);
 
-  for (auto it = m_changedTags.rbegin(); it != m_changedTags.rend(); ++it)
-  {
-    if (it->second->WasActive())
-    {
-      if (!m_lastEndedTag || m_lastEndedTag->EndAsUTC() < it->second->EndAsUTC())
-      {
-        m_lastEndedTag = it->second;
-        break;
-      }
-    }
-  }
+  const std::shared_ptr<CPVREpgInfoTag> lastEndedTag = m_changedTags.GetLastEndedTag(activeTime);
+  if (lastEndedTag && (!m_lastEndedTag || m_lastEndedTag->EndAsUTC() < lastEndedTag->EndAsUTC()))
+    m_lastEndedTag = lastEndedTag;
 }
 
 void CPVREpgTagsCache::RefreshNextStartingTag(const CDateTime& activeTime)
 {
-  if (m_database)
-  {
-    m_nextStartingTag = m_database->GetEpgTagByMinStartTime(m_iEpgID, activeTime + ONE_SECOND);
-    if (m_nextStartingTag)
-      m_nextStartingTag->SetChannelData(m_channelData);
-  }
+  m_nextStartingTag = m_committedTags.GetNextStartingTag(activeTime);
 
-  for (const auto& tag : m_changedTags)
-  {
-    if (tag.second->IsUpcoming())
-    {
-      if (!m_nextStartingTag || m_nextStartingTag->StartAsUTC() > tag.second->StartAsUTC())
-      {
-        m_nextStartingTag = tag.second;
-        break;
-      }
-    }
-  }
+  const std::shared_ptr<CPVREpgInfoTag> nextStartingTag =
+      m_changedTags.GetNextStartingTag(activeTime);
+  if (nextStartingTag &&
+      (!m_nextStartingTag || m_nextStartingTag->StartAsUTC() > nextStartingTag->StartAsUTC()))
+    m_nextStartingTag = nextStartingTag;
 }
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 using namespace PVR;
 
@@ -30,7 +31,7 @@ CPVREpgTagsContainer::CPVREpgTagsContainer(int iEpgID,
   : m_iEpgID(iEpgID),
     m_channelData(channelData),
     m_database(database),
-    m_tagsCache(new CPVREpgTagsCache(iEpgID, channelData, database, m_changedTags))
+    m_tagsCache(new CPVREpgTagsCache(channelData, m_committedTags, m_changedTags))
 {
 }
 
@@ -39,6 +40,8 @@ CPVREpgTagsContainer::~CPVREpgTagsContainer() = default;
 void CPVREpgTagsContainer::SetEpgID(int iEpgID)
 {
   m_iEpgID = iEpgID;
+  for (const auto& tag : m_committedTags)
+    tag.second->SetEpgID(iEpgID);
   for (const auto& tag : m_changedTags)
     tag.second->SetEpgID(iEpgID);
 }
@@ -47,6 +50,8 @@ void CPVREpgTagsContainer::SetChannelData(const std::shared_ptr<CPVREpgChannelDa
 {
   m_channelData = data;
   m_tagsCache->SetChannelData(data);
+  for (const auto& tag : m_committedTags)
+    tag.second->SetChannelData(data);
   for (const auto& tag : m_changedTags)
     tag.second->SetChannelData(data);
 }
@@ -91,7 +96,8 @@ void ResolveConflictingTags(const std::shared_ptr<CPVREpgInfoTag>& changedTag,
 }
 
 bool FixOverlap(const std::shared_ptr<CPVREpgInfoTag>& previousTag,
-                const std::shared_ptr<CPVREpgInfoTag>& currentTag)
+                const std::shared_ptr<CPVREpgInfoTag>& currentTag,
+                bool& bTruncated)
 {
   if (!previousTag)
     return true;
@@ -125,10 +131,29 @@ bool FixOverlap(const std::shared_ptr<CPVREpgInfoTag>& previousTag,
                currentTag->EndAsUTC().GetAsDBDateTime());
 
     previousTag->SetEndFromUTC(currentTag->StartAsUTC());
+    bTruncated = true;
   }
   return true;
 }
 
+CDateTime GetMaxEndTime(const CPVREpgTagsIndex& tags, const CDateTime& maxEnd)
+{
+  const std::shared_ptr<CPVREpgInfoTag> tag = tags.GetLastEndedTag(maxEnd);
+  if (tag)
+    return tag->EndAsUTC();
+
+  return {};
+}
+
+CDateTime GetMinStartTime(const CPVREpgTagsIndex& tags, const CDateTime& minStart)
+{
+  const std::shared_ptr<CPVREpgInfoTag> tag = tags.GetNextStartingTag(minStart);
+  if (tag)
+    return tag->StartAsUTC();
+
+  return {};
+}
+
 } // unnamed namespace
 
 bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
@@ -142,23 +167,22 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
     const CDateTime maxEventStart = (*tags.m_changedTags.crbegin()).second->EndAsUTC();
 
     std::vector<std::shared_ptr<CPVREpgInfoTag>> existingTags =
-        m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+        GetCommittedTagsBetween(minEventEnd, maxEventStart);
 
     if (!m_changedTags.empty())
     {
       // Fix data inconsistencies
-      for (const auto& changedTagsEntry : m_changedTags)
+      for (const auto& changedTag : m_changedTags.GetTagsBetween(minEventEnd, maxEventStart))
       {
-        const auto& changedTag = changedTagsEntry.second;
-
-        if (changedTag->EndAsUTC() > minEventEnd && changedTag->StartAsUTC() < maxEventStart)
-        {
-          // tag is in queried range, thus it could cause inconsistencies...
-          ResolveConflictingTags(changedTag, existingTags);
-        }
+        // tag is in queried range, thus it could cause inconsistencies...
+        ResolveConflictingTags(changedTag, existingTags);
       }
     }
 
+    std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> existingTagsByStart;
+    for (const auto& existingTag : existingTags)
+      existingTagsByStart.emplace(existingTag->StartAsUTC(), existingTag);
+
     bool bResetCache = false;
     for (const auto& tagsEntry : tags.m_changedTags)
     {
@@ -167,13 +191,10 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
       tag->SetChannelData(m_channelData);
       tag->SetEpgID(m_iEpgID);
 
-      const auto it =
-          std::find_if(existingTags.cbegin(), existingTags.cend(),
-                       [&tag](const auto& t) { return t->StartAsUTC() == tag->StartAsUTC(); });
-
-      if (it != existingTags.cend())
+      const auto it = existingTagsByStart.find(tag->StartAsUTC());
+      if (it != existingTagsByStart.cend())
       {
-        const std::shared_ptr<CPVREpgInfoTag>& existingTag = *it;
+        const std::shared_ptr<CPVREpgInfoTag>& existingTag = (*it).second;
 
         existingTag->SetChannelData(m_channelData);
         existingTag->SetEpgID(m_iEpgID);
@@ -182,6 +203,8 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
         {
           // tag differs from existing tag and must be persisted
           m_changedTags.insert({existingTag->StartAsUTC(), existingTag});
+          m_changedTags.Invalidate();
+          m_committedTags.Invalidate();
           bResetCache = true;
         }
       }
@@ -209,12 +232,13 @@ void CPVREpgTagsContainer::FixOverlappingEvents(
     std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
 {
   bool bResetCache = false;
+  bool bTruncated = false;
 
   std::shared_ptr<CPVREpgInfoTag> previousTag;
   for (auto it = tags.begin(); it != tags.end();)
   {
     const std::shared_ptr<CPVREpgInfoTag> currentTag = *it;
-    if (FixOverlap(previousTag, currentTag))
+    if (FixOverlap(previousTag, currentTag, bTruncated))
     {
       previousTag = currentTag;
       ++it;
@@ -226,20 +250,27 @@ void CPVREpgTagsContainer::FixOverlappingEvents(
     }
   }
 
+  if (bTruncated)
+  {
+    // the tags are shared with the indexes
+    m_committedTags.Invalidate();
+    m_changedTags.Invalidate();
+  }
+
   if (bResetCache)
     m_tagsCache->Reset();
 }
 
-void CPVREpgTagsContainer::FixOverlappingEvents(
-    std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tags) const
+void CPVREpgTagsContainer::FixOverlappingEvents(CPVREpgTagsIndex& tags) const
 {
   bool bResetCache = false;
+  bool bTruncated = false;
 
   std::shared_ptr<CPVREpgInfoTag> previousTag;
   for (auto it = tags.begin(); it != tags.end();)
   {
     const std::shared_ptr<CPVREpgInfoTag> currentTag = (*it).second;
-    if (FixOverlap(previousTag, currentTag))
+    if (FixOverlap(previousTag, currentTag, bTruncated))
     {
       previousTag = currentTag;
       ++it;
@@ -251,6 +282,13 @@ void CPVREpgTagsContainer::FixOverlappingEvents(
     }
   }
 
+  if (bTruncated)
+  {
+    // tags changed before may also be committed ones
+    m_committedTags.Invalidate();
+    tags.Invalidate();
+  }
+
   if (bResetCache)
     m_tagsCache->Reset();
 }
@@ -287,6 +325,8 @@ bool CPVREpgTagsContainer::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
     {
       // tag differs from existing tag and must be persisted
       m_changedTags.insert({existingTag->StartAsUTC(), existingTag});
+      m_changedTags.Invalidate();
+      m_committedTags.Invalidate();
       m_tagsCache->Reset();
     }
   }
@@ -311,7 +351,9 @@ bool CPVREpgTagsContainer::DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
 void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
 {
   bool bResetCache = false;
-  for (auto it = m_changedTags.begin(); it != m_changedTags.end();)
+
+  // tags are ordered by start time. only those starting before the given time can have ended.
+  for (auto it = m_changedTags.begin(); it != m_changedTags.end() && it->first < time;)
   {
     if (it->second->EndAsUTC() < time)
     {
@@ -328,11 +370,26 @@ void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
     }
   }
 
-  if (bResetCache)
-    m_tagsCache->Reset();
-
   if (m_database)
+  {
     m_database->DeleteEpgTags(m_iEpgID, time);
+
+    for (auto it = m_committedTags.begin(); it != m_committedTags.end() && it->first < time;)
+    {
+      if (it->second->EndAsUTC() < time)
+      {
+        it = m_committedTags.erase(it);
+        bResetCache = true;
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  if (bResetCache)
+    m_tagsCache->Reset();
 }
 
 void CPVREpgTagsContainer::Clear()
@@ -346,6 +403,9 @@ bool CPVREpgTagsContainer::IsEmpty() const
   if (!m_changedTags.empty())
     return false;
 
+  if (m_bCommittedTagsLoaded)
+    return m_committedTags.empty();
+
   if (m_database)
     return !m_database->HasTags(m_iEpgID);
 
@@ -358,8 +418,10 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTag(const CDateTime& st
   if (it != m_changedTags.cend())
     return (*it).second;
 
-  if (m_database)
-    return CreateEntry(m_database->GetEpgTagByStartTime(m_iEpgID, startTime));
+  const CPVREpgTagsIndex& committedTags = GetCommittedTags();
+  const auto it1 = committedTags.find(startTime);
+  if (it1 != committedTags.cend())
+    return (*it1).second;
 
   return {};
 }
@@ -405,50 +467,34 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTagByDatabaseID(int iDa
 std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTagBetween(const CDateTime& start,
                                                                     const CDateTime& end) const
 {
-  for (const auto& tag : m_changedTags)
-  {
-    if (tag.second->StartAsUTC() >= start)
-    {
-      if (tag.second->EndAsUTC() <= end)
-        return tag.second;
-      else
-        break;
-    }
-  }
-
-  if (m_database)
-  {
-    const std::vector<std::shared_ptr<CPVREpgInfoTag>> tags =
-        CreateEntries(m_database->GetEpgTagsByMinStartMaxEndTime(m_iEpgID, start, end));
-    if (!tags.empty())
-    {
-      if (tags.size() > 1)
-        CLog::LogF(LOGWARNING, "Got multiple tags. Picking up the first.");
-
-      return tags.front();
-    }
-  }
+  const std::shared_ptr<CPVREpgInfoTag> tag = m_changedTags.GetTagBetween(start, end);
+  if (tag)
+    return tag;
 
-  return {};
+  return GetCommittedTags().GetTagBetween(start, end);
 }
 
 bool CPVREpgTagsContainer::UpdateActiveTag()
 {
+  GetCommittedTags();
   return m_tagsCache->Refresh();
 }
 
 std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetActiveTag() const
 {
+  GetCommittedTags();
   return m_tagsCache->GetNowActiveTag();
 }
 
 std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetLastEndedTag() const
 {
+  GetCommittedTags();
   return m_tagsCache->GetLastEndedTag();
 }
 
 std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetNextStartingTag() const
 {
+  GetCommittedTags();
   return m_tagsCache->GetNextStartingTag();
 }
 
@@ -462,13 +508,9 @@ void CPVREpgTagsContainer::MergeTags(const CDateTime& minEventEnd,
                                      const CDateTime& maxEventStart,
                                      std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
 {
-  for (const auto& changedTagsEntry : m_changedTags)
-  {
-    const auto& changedTag = changedTagsEntry.second;
-
-    if (changedTag->EndAsUTC() > minEventEnd && changedTag->StartAsUTC() < maxEventStart)
-      tags.emplace_back(changedTag);
-  }
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> changedTags =
+      m_changedTags.GetTagsBetween(minEventEnd, maxEventStart);
+  tags.insert(tags.end(), changedTags.cbegin(), changedTags.cend());
 
   if (!tags.empty())
     FixOverlappingEvents(tags);
@@ -482,36 +524,32 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
 {
   if (m_database)
   {
+    const CPVREpgTagsIndex& committedTags = GetCommittedTags();
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
 
-    bool loadFromDb = true;
+    bool useCommittedTags = true;
     if (!m_changedTags.empty())
     {
-      const CDateTime lastEnd = m_database->GetLastEndTime(m_iEpgID);
-      if (!lastEnd.IsValid() || lastEnd < minEventEnd)
+      const std::shared_ptr<CPVREpgInfoTag> lastTag = committedTags.GetLastEndingTag();
+      if (!lastTag || lastTag->EndAsUTC() < minEventEnd)
       {
-        // nothing in the db yet. take what we have in memory.
-        loadFromDb = false;
+        // nothing committed yet. take what we have in memory.
+        useCommittedTags = false;
         MergeTags(minEventEnd, maxEventStart, tags);
       }
     }
 
-    if (loadFromDb)
+    if (useCommittedTags)
     {
-      tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+      tags = GetCommittedTagsBetween(minEventEnd, maxEventStart);
 
       if (!m_changedTags.empty())
       {
         // Fix data inconsistencies
-        for (const auto& changedTagsEntry : m_changedTags)
+        for (const auto& changedTag : m_changedTags.GetTagsBetween(minEventEnd, maxEventStart))
         {
-          const auto& changedTag = changedTagsEntry.second;
-
-          if (changedTag->EndAsUTC() > minEventEnd && changedTag->StartAsUTC() < maxEventStart)
-          {
-            // tag is in queried range, thus it could cause inconsistencies...
-            ResolveConflictingTags(changedTag, tags);
-          }
+          // tag is in queried range, thus it could cause inconsistencies...
+          ResolveConflictingTags(changedTag, tags);
         }
 
         // Append missing tags
@@ -542,11 +580,11 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     if (result.empty())
     {
       // create single gap tag
-      CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+      CDateTime maxEnd = GetMaxEndTime(committedTags, minEventEnd);
       if (!maxEnd.IsValid() || maxEnd < timelineStart)
         maxEnd = timelineStart;
 
-      CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+      CDateTime minStart = GetMinStartTime(committedTags, maxEventStart);
       if (!minStart.IsValid() || minStart > timelineEnd)
         minStart = timelineEnd;
 
@@ -557,7 +595,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.front()->StartAsUTC() > minEventEnd)
       {
         // prepend gap tag
-        CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+        CDateTime maxEnd = GetMaxEndTime(committedTags, minEventEnd);
         if (!maxEnd.IsValid() || maxEnd < timelineStart)
           maxEnd = timelineStart;
 
@@ -567,7 +605,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.back()->EndAsUTC() < maxEventStart)
       {
         // append gap tag
-        CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+        CDateTime minStart = GetMinStartTime(committedTags, maxEventStart);
         if (!minStart.IsValid() || minStart > timelineEnd)
           minStart = timelineEnd;
 
@@ -585,10 +623,11 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetAllTags()
 {
   if (m_database)
   {
+    const CPVREpgTagsIndex& committedTags = GetCommittedTags();
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    if (!m_changedTags.empty() && !m_database->HasTags(m_iEpgID))
+    if (!m_changedTags.empty() && committedTags.empty())
     {
-      // nothing in the db yet. take what we have in memory.
+      // nothing committed yet. take what we have in memory.
       std::transform(m_changedTags.cbegin(), m_changedTags.cend(), std::back_inserter(tags),
                      [](const auto& tag) { return tag.second; });
 
@@ -596,7 +635,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetAllTags()
     }
     else
     {
-      tags = m_database->GetAllEpgTags(m_iEpgID);
+      tags.reserve(committedTags.size());
+      std::transform(committedTags.cbegin(), committedTags.cend(), std::back_inserter(tags),
+                     [](const auto& tag) { return tag.second; });
 
       if (!m_changedTags.empty())
       {
@@ -614,6 +655,15 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetAllTags()
   return {};
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetUncommittedTags() const
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  tags.reserve(m_changedTags.size());
+  std::transform(m_changedTags.cbegin(), m_changedTags.cend(), std::back_inserter(tags),
+                 [](const auto& tag) { return tag.second; });
+  return tags;
+}
+
 std::pair<CDateTime, CDateTime> CPVREpgTagsContainer::GetFirstAndLastUncommitedEPGDate() const
 {
   if (m_changedTags.empty())
@@ -637,22 +687,37 @@ void CPVREpgTagsContainer::QueuePersistQuery()
     CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Tags Container: Updating {}, deleting {} events...",
                 m_changedTags.size(), m_deletedTags.size());
 
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> deletedTags;
+    deletedTags.reserve(m_deletedTags.size());
+
     for (const auto& tag : m_deletedTags)
+    {
       m_database->QueueDeleteTagQuery(*tag.second);
+      deletedTags.emplace_back(tag.second);
+    }
 
     m_deletedTags.clear();
 
     FixOverlappingEvents(m_changedTags);
 
+    std::vector<std::pair<CDateTime, CDateTime>> conflictRanges;
+    conflictRanges.reserve(m_changedTags.size());
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    tags.reserve(m_changedTags.size());
+
     for (const auto& tag : m_changedTags)
     {
-      // remove any conflicting events from database before persisting the new event
-      m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
-          m_iEpgID, tag.second->StartAsUTC() + ONE_SECOND, tag.second->EndAsUTC() - ONE_SECOND);
-
-      tag.second->QueuePersistQuery(m_database);
+      conflictRanges.emplace_back(tag.second->StartAsUTC() + ONE_SECOND,
+                                  tag.second->EndAsUTC() - ONE_SECOND);
+      tags.emplace_back(tag.second);
     }
 
+    // remove any conflicting events from database before persisting the new events. all deletes
+    // are committed before the inserts, so both can be batched.
+    m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQueries(m_iEpgID, conflictRanges);
+    m_database->QueuePersistQueries(tags);
+
+    CommitTags(deletedTags, tags);
     Clear();
 
     m_database->Unlock();
@@ -664,5 +729,63 @@ void CPVREpgTagsContainer::QueueDelete()
   if (m_database)
     m_database->QueueDeleteEpgTags(m_iEpgID);
 
+  m_committedTags.clear();
+  m_bCommittedTagsLoaded = true;
   Clear();
 }
+
+void CPVREpgTagsContainer::ReloadCommittedTags()
+{
+  m_committedTags.clear();
+  m_bCommittedTagsLoaded = false;
+  m_tagsCache->Reset();
+}
+
+const CPVREpgTagsIndex& CPVREpgTagsContainer::GetCommittedTags() const
+{
+  if (!m_bCommittedTagsLoaded)
+  {
+    if (m_database)
+    {
+      for (const auto& tag : CreateEntries(m_database->GetAllEpgTags(m_iEpgID)))
+        m_committedTags.insert({tag->StartAsUTC(), tag});
+    }
+    m_bCommittedTagsLoaded = true;
+  }
+  return m_committedTags;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetCommittedTagsBetween(
+    const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+{
+  // times are stored in seconds. widen the range by one to include its boundaries.
+  return GetCommittedTags().GetTagsBetween(minEventEnd - ONE_SECOND, maxEventStart + ONE_SECOND);
+}
+
+void CPVREpgTagsContainer::CommitTags(
+    const std::vector<std::shared_ptr<CPVREpgInfoTag>>& deletedTags,
+    const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  // not loaded yet, the tags will be loaded from the database once the queries were committed
+  if (!m_bCommittedTagsLoaded)
+    return;
+
+  // like in the database, all deletes precede the inserts
+  std::vector<CDateTime> deletedStartTimes;
+  for (const auto& tag : deletedTags)
+    deletedStartTimes.emplace_back(tag->StartAsUTC());
+
+  for (const auto& tag : tags)
+  {
+    const std::vector<std::shared_ptr<CPVREpgInfoTag>> conflictingTags =
+        m_committedTags.GetTagsBetween(tag->StartAsUTC(), tag->EndAsUTC());
+    for (const auto& conflictingTag : conflictingTags)
+      deletedStartTimes.emplace_back(conflictingTag->StartAsUTC());
+  }
+
+  for (const auto& startTime : deletedStartTimes)
+    m_committedTags.erase(startTime);
+
+  for (const auto& tag : tags)
+    m_committedTags.insert({tag->StartAsUTC(), tag});
+}
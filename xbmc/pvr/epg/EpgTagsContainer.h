@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/epg/EpgTagsIndex.h"
 
 #include <map>
 #include <memory>
@@ -152,6 +153,12 @@ public:
    */
   std::vector<std::shared_ptr<CPVREpgInfoTag>> GetAllTags() const;
 
+  /*!
+   * @brief Get all EPG tags not yet committed to the database.
+   * @return The tags, ordered by start time.
+   */
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> GetUncommittedTags() const;
+
   /*!
    * @brief Get the start and end time of the last not yet commited entry in this EPG.
    * @return The times; first: start time, second: end time.
@@ -174,6 +181,11 @@ public:
    */
   void QueueDelete();
 
+  /*!
+   * @brief Forget the committed tags, they are loaded from the database again on next use.
+   */
+  void ReloadCommittedTags();
+
 private:
   /*!
    * @brief Complete the instance data for the given tags.
@@ -213,14 +225,41 @@ private:
    * @param tags The events to check/fix.
    */
   void FixOverlappingEvents(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
-  void FixOverlappingEvents(std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+  void FixOverlappingEvents(CPVREpgTagsIndex& tags) const;
+
+  /*!
+   * @brief Get the tags committed to the database, loading them on first use.
+   * @return The tags.
+   */
+  const CPVREpgTagsIndex& GetCommittedTags() const;
+
+  /*!
+   * @brief Get the committed tags ending at or after minEventEnd and starting at or before
+   * maxEventStart.
+   * @param minEventEnd The minimum end time of the events to return
+   * @param maxEventStart The maximum start time of the events to return
+   * @return The tags, ordered by start time.
+   */
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> GetCommittedTagsBetween(
+      const CDateTime& minEventEnd, const CDateTime& maxEventStart) const;
+
+  /*!
+   * @brief Apply the queued deletions and insertions to the committed tags, the same way the
+   * database applies them.
+   * @param deletedTags The deleted tags.
+   * @param tags The inserted tags.
+   */
+  void CommitTags(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& deletedTags,
+                  const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
 
   int m_iEpgID = 0;
   std::shared_ptr<CPVREpgChannelData> m_channelData;
   const std::shared_ptr<CPVREpgDatabase> m_database;
   const std::unique_ptr<CPVREpgTagsCache> m_tagsCache;
 
-  std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_changedTags;
+  mutable CPVREpgTagsIndex m_committedTags;
+  mutable bool m_bCommittedTagsLoaded = false;
+  CPVREpgTagsIndex m_changedTags;
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_deletedTags;
 };
 
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTagsIndex.h"
+
+#include "pvr/epg/EpgInfoTag.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace PVR;
+
+std::pair<CPVREpgTagsIndex::iterator, bool> CPVREpgTagsIndex::insert(const value_type& value)
+{
+  const auto result = m_tags.insert(value);
+  if (result.second)
+    m_valid = false;
+
+  return result;
+}
+
+CPVREpgTagsIndex::iterator CPVREpgTagsIndex::erase(const_iterator it)
+{
+  m_valid = false;
+  return m_tags.erase(it);
+}
+
+size_t CPVREpgTagsIndex::erase(const CDateTime& startTime)
+{
+  const size_t result = m_tags.erase(startTime);
+  if (result > 0)
+    m_valid = false;
+
+  return result;
+}
+
+void CPVREpgTagsIndex::clear()
+{
+  m_tags.clear();
+  m_valid = false;
+}
+
+void CPVREpgTagsIndex::Build() const
+{
+  if (m_valid)
+    return;
+
+  m_byStart.clear();
+  m_byStart.reserve(m_tags.size());
+  for (const auto& tag : m_tags)
+    m_byStart.emplace_back(tag.second);
+
+  m_maxEnd.assign(4 * m_byStart.size(), CDateTime());
+  if (!m_byStart.empty())
+    BuildNode(1, 0, m_byStart.size());
+
+  // ties are kept in start time order, so the last of them started latest
+  m_byEnd = m_byStart;
+  std::stable_sort(m_byEnd.begin(), m_byEnd.end(), [](const auto& tag1, const auto& tag2) {
+    return tag1->EndAsUTC() < tag2->EndAsUTC();
+  });
+
+  m_valid = true;
+}
+
+const CDateTime& CPVREpgTagsIndex::BuildNode(size_t node, size_t first, size_t last) const
+{
+  if (last - first == 1)
+  {
+    m_maxEnd[node] = m_byStart[first]->EndAsUTC();
+  }
+  else
+  {
+    const size_t mid = first + (last - first) / 2;
+    const CDateTime& left = BuildNode(2 * node, first, mid);
+    const CDateTime& right = BuildNode(2 * node + 1, mid, last);
+    m_maxEnd[node] = left < right ? right : left;
+  }
+  return m_maxEnd[node];
+}
+
+size_t CPVREpgTagsIndex::FindEndingAfter(
+    size_t node, size_t first, size_t last, size_t count, const CDateTime& time) const
+{
+  // no leading tags in this subtree or none of them ends after the given time
+  if (first >= count || m_maxEnd[node] <= time)
+    return m_byStart.size();
+
+  if (last - first == 1)
+    return first;
+
+  const size_t mid = first + (last - first) / 2;
+  const size_t pos = FindEndingAfter(2 * node, first, mid, count, time);
+  if (pos != m_byStart.size())
+    return pos;
+
+  return FindEndingAfter(2 * node + 1, mid, last, count, time);
+}
+
+void CPVREpgTagsIndex::CollectEndingAfter(size_t node,
+                                          size_t first,
+                                          size_t last,
+                                          size_t count,
+                                          const CDateTime& time,
+                                          std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
+{
+  if (first >= count || m_maxEnd[node] <= time)
+    return;
+
+  if (last - first == 1)
+  {
+    tags.emplace_back(m_byStart[first]);
+    return;
+  }
+
+  const size_t mid = first + (last - first) / 2;
+  CollectEndingAfter(2 * node, first, mid, count, time, tags);
+  CollectEndingAfter(2 * node + 1, mid, last, count, time, tags);
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsIndex::GetTagAt(const CDateTime& time) const
+{
+  Build();
+
+  // the tags starting before or at the given time, the first of them ending after it is active
+  const auto it =
+      std::partition_point(m_byStart.cbegin(), m_byStart.cend(),
+                           [&time](const auto& tag) { return tag->StartAsUTC() <= time; });
+  if (it == m_byStart.cbegin())
+    return {};
+
+  const size_t count = it - m_byStart.cbegin();
+  const size_t pos = FindEndingAfter(1, 0, m_byStart.size(), count, time);
+  if (pos != m_byStart.size())
+    return m_byStart[pos];
+
+  return {};
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsIndex::GetTagBetween(const CDateTime& start,
+                                                                const CDateTime& end) const
+{
+  // tags starting after the end time cannot end before it
+  for (auto it = m_tags.lower_bound(start); it != m_tags.cend() && (*it).first <= end; ++it)
+  {
+    if ((*it).second->EndAsUTC() <= end)
+      return (*it).second;
+  }
+  return {};
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsIndex::GetTagsBetween(
+    const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+
+  Build();
+
+  const auto it = std::partition_point(
+      m_byStart.cbegin(), m_byStart.cend(),
+      [&maxEventStart](const auto& tag) { return tag->StartAsUTC() < maxEventStart; });
+  if (it != m_byStart.cbegin())
+    CollectEndingAfter(1, 0, m_byStart.size(), it - m_byStart.cbegin(), minEventEnd, tags);
+
+  return tags;
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsIndex::GetLastEndedTag(const CDateTime& time) const
+{
+  Build();
+
+  const auto it =
+      std::partition_point(m_byEnd.cbegin(), m_byEnd.cend(),
+                           [&time](const auto& tag) { return tag->EndAsUTC() <= time; });
+  if (it != m_byEnd.cbegin())
+    return *std::prev(it);
+
+  return {};
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsIndex::GetLastEndingTag() const
+{
+  Build();
+
+  if (!m_byEnd.empty())
+    return m_byEnd.back();
+
+  return {};
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsIndex::GetNextStartingTag(const CDateTime& time) const
+{
+  const auto it = m_tags.upper_bound(time);
+  if (it != m_tags.cend())
+    return (*it).second;
+
+  return {};
+}
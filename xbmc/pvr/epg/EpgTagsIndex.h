@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "XBDateTime.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+class CPVREpgInfoTag;
+
+/*!
+ * @brief A set of EPG tags, ordered by start time, answering time range queries in logarithmic
+ * time.
+ *
+ * Besides the tags ordered by start time, the index keeps a segment tree over the end times of
+ * the tags and the tags ordered by end time. Both are (re-)built on the first query after the
+ * index was modified, so a batch of modifications costs one rebuild. Tags may overlap each other
+ * and may be of any duration.
+ *
+ * Iteration and modification follow std::map, to allow it to be used as a drop-in replacement.
+ * Like std::map, the index is not thread safe.
+ */
+class CPVREpgTagsIndex
+{
+public:
+  using Container = std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>;
+  using value_type = Container::value_type;
+  using iterator = Container::iterator;
+  using const_iterator = Container::const_iterator;
+  using const_reverse_iterator = Container::const_reverse_iterator;
+
+  bool empty() const { return m_tags.empty(); }
+  size_t size() const { return m_tags.size(); }
+
+  iterator begin() { return m_tags.begin(); }
+  iterator end() { return m_tags.end(); }
+  const_iterator begin() const { return m_tags.cbegin(); }
+  const_iterator end() const { return m_tags.cend(); }
+  const_iterator cbegin() const { return m_tags.cbegin(); }
+  const_iterator cend() const { return m_tags.cend(); }
+  const_reverse_iterator crbegin() const { return m_tags.crbegin(); }
+  const_reverse_iterator crend() const { return m_tags.crend(); }
+
+  iterator find(const CDateTime& startTime) { return m_tags.find(startTime); }
+  const_iterator find(const CDateTime& startTime) const { return m_tags.find(startTime); }
+
+  /*!
+   * @brief Insert a tag, if there is no tag with the same start time yet.
+   * @param value The start time and the tag.
+   * @return The tag's position and whether it was inserted.
+   */
+  std::pair<iterator, bool> insert(const value_type& value);
+
+  iterator erase(const_iterator it);
+  size_t erase(const CDateTime& startTime);
+  void clear();
+
+  /*!
+   * @brief Must be called after the end time of a contained tag was changed.
+   */
+  void Invalidate() const { m_valid = false; }
+
+  /*!
+   * @brief Get the first tag that is active at the given time.
+   * @param time The time.
+   * @return The tag or nullptr if no tag is active at that time.
+   */
+  std::shared_ptr<CPVREpgInfoTag> GetTagAt(const CDateTime& time) const;
+
+  /*!
+   * @brief Get the first tag starting at or after the given start time and ending before or at
+   * the given end time.
+   * @param start The start time.
+   * @param end The end time.
+   * @return The tag or nullptr if there is none.
+   */
+  std::shared_ptr<CPVREpgInfoTag> GetTagBetween(const CDateTime& start, const CDateTime& end) const;
+
+  /*!
+   * @brief Get all tags ending after minEventEnd and starting before maxEventStart.
+   * @param minEventEnd The minimum end time.
+   * @param maxEventStart The maximum start time.
+   * @return The tags, ordered by start time.
+   */
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTagsBetween(const CDateTime& minEventEnd,
+                                                              const CDateTime& maxEventStart) const;
+
+  /*!
+   * @brief Get the tag with the latest end time before or at the given time.
+   * @param time The time.
+   * @return The tag or nullptr if there is none.
+   */
+  std::shared_ptr<CPVREpgInfoTag> GetLastEndedTag(const CDateTime& time) const;
+
+  /*!
+   * @brief Get the tag with the latest end time.
+   * @return The tag or nullptr if the index is empty.
+   */
+  std::shared_ptr<CPVREpgInfoTag> GetLastEndingTag() const;
+
+  /*!
+   * @brief Get the tag with the earliest start time after the given time.
+   * @param time The time.
+   * @return The tag or nullptr if there is none.
+   */
+  std::shared_ptr<CPVREpgInfoTag> GetNextStartingTag(const CDateTime& time) const;
+
+private:
+  /*!
+   * @brief Rebuild the segment tree and the end time order, if the index was modified.
+   */
+  void Build() const;
+  const CDateTime& BuildNode(size_t node, size_t first, size_t last) const;
+
+  /*!
+   * @brief Get the position of the first of the given number of leading tags ending after the
+   * given time.
+   * @return The position or m_byStart.size() if there is none.
+   */
+  size_t FindEndingAfter(size_t node,
+                         size_t first,
+                         size_t last,
+                         size_t count,
+                         const CDateTime& time) const;
+
+  /*!
+   * @brief Collect all of the given number of leading tags ending after the given time.
+   */
+  void CollectEndingAfter(size_t node,
+                          size_t first,
+                          size_t last,
+                          size_t count,
+                          const CDateTime& time,
+                          std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+
+  Container m_tags;
+
+  mutable bool m_valid = false;
+  mutable std::vector<std::shared_ptr<CPVREpgInfoTag>> m_byStart;
+  mutable std::vector<CDateTime> m_maxEnd; /*!< segment tree of the latest end time */
+  mutable std::vector<std::shared_ptr<CPVREpgInfoTag>> m_byEnd;
+};
+
+} // namespace PVR
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "pvr/epg/EpgIngestState.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+EPG_TAG CreateBroadcast(time_t start, time_t end, const char* title)
+{
+  EPG_TAG tag{};
+  tag.iUniqueBroadcastId = static_cast<unsigned int>(start);
+  tag.startTime = start;
+  tag.endTime = end;
+  tag.strTitle = title;
+  return tag;
+}
+
+// simulates a refresh delivering the given broadcasts, returns the number of skipped ones
+size_t Refresh(CPVREpgIngestState& state, const std::vector<EPG_TAG>& broadcasts)
+{
+  CPVREpgIngestState update;
+  update.BeginUpdate(state);
+  for (const auto& broadcast : broadcasts)
+    update.Receive(broadcast);
+  state.Apply(update);
+  return update.GetSkippedCount();
+}
+} // unnamed namespace
+
+TEST(TestEpgIngestState, Hash)
+{
+  const EPG_TAG tag = CreateBroadcast(100, 200, "News");
+  EXPECT_EQ(CPVREpgIngestState::Hash(tag), CPVREpgIngestState::Hash(tag));
+
+  EPG_TAG other = tag;
+  other.strPlot = "Headlines";
+  EXPECT_NE(CPVREpgIngestState::Hash(tag), CPVREpgIngestState::Hash(other));
+
+  other = tag;
+  other.endTime = 201;
+  EXPECT_NE(CPVREpgIngestState::Hash(tag), CPVREpgIngestState::Hash(other));
+
+  // string boundaries matter
+  EPG_TAG a = tag;
+  a.strTitle = "ab";
+  a.strTitleExtraInfo = "c";
+  EPG_TAG b = tag;
+  b.strTitle = "a";
+  b.strTitleExtraInfo = "bc";
+  EXPECT_NE(CPVREpgIngestState::Hash(a), CPVREpgIngestState::Hash(b));
+}
+
+TEST(TestEpgIngestState, SkipUnchanged)
+{
+  CPVREpgIngestState state;
+  const std::vector<EPG_TAG> broadcasts{CreateBroadcast(100, 200, "A"),
+                                        CreateBroadcast(200, 300, "B"),
+                                        CreateBroadcast(300, 400, "C")};
+
+  EXPECT_EQ(0u, Refresh(state, broadcasts));
+  EXPECT_EQ(3u, state.GetKnownCount());
+
+  EXPECT_EQ(3u, Refresh(state, broadcasts));
+  EXPECT_EQ(3u, state.GetKnownCount());
+
+  // a broadcast not delivered anymore is forgotten
+  EXPECT_EQ(2u, Refresh(state, {broadcasts[0], broadcasts[2]}));
+  EXPECT_EQ(2u, state.GetKnownCount());
+  EXPECT_EQ(2u, Refresh(state, broadcasts));
+}
+
+TEST(TestEpgIngestState, ChangedBroadcastInvalidatesOverlapping)
+{
+  CPVREpgIngestState state;
+  std::vector<EPG_TAG> broadcasts{CreateBroadcast(100, 200, "A"), CreateBroadcast(200, 300, "B"),
+                                  CreateBroadcast(300, 400, "C"), CreateBroadcast(400, 500, "D")};
+  Refresh(state, broadcasts);
+
+  // B is extended into C. Storing B may remove C, which must not be skipped next time.
+  broadcasts[1].endTime = 350;
+  EXPECT_EQ(3u, Refresh(state, broadcasts));
+  EXPECT_EQ(3u, state.GetKnownCount());
+  EXPECT_EQ(3u, Refresh(state, broadcasts));
+
+  // C is changed to start within B
+  broadcasts[2].startTime = 320;
+  EXPECT_EQ(2u, Refresh(state, broadcasts));
+  EXPECT_EQ(2u, Refresh(state, broadcasts));
+}
+
+TEST(TestEpgIngestState, Invalidate)
+{
+  CPVREpgIngestState state;
+  const std::vector<EPG_TAG> broadcasts{CreateBroadcast(100, 200, "A"),
+                                        CreateBroadcast(200, 300, "B"),
+                                        CreateBroadcast(300, 400, "C")};
+  Refresh(state, broadcasts);
+
+  state.Invalidate(250, 260);
+  EXPECT_EQ(2u, state.GetKnownCount());
+  EXPECT_EQ(2u, Refresh(state, broadcasts));
+
+  state.Invalidate(150, 350);
+  EXPECT_EQ(0u, state.GetKnownCount());
+
+  Refresh(state, broadcasts);
+  state.Cleanup(300);
+  EXPECT_EQ(2u, state.GetKnownCount());
+
+  state.Clear();
+  EXPECT_EQ(0u, Refresh(state, broadcasts));
+}
@@ -0,0 +1,214 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchData.h"
+#include "pvr/epg/EpgSearchTermConverter.h"
+#include "settings/AdvancedSettings.h"
+#include "test/Benchmark.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+const std::vector<std::string> FIELDS{"sTitle", "sPlotOutline"};
+
+class EpgSearchDatabase
+{
+public:
+  explicit EpgSearchDatabase(const std::string& name)
+  {
+    m_settings.type = "sqlite3";
+    m_settings.name = name;
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+
+    // start with an empty database, not with the one of a previous run
+    XFILE::CFile::Delete("special://temp/" + name + ".db");
+
+    // connecting creates the tables, opening the connected database checks for the index
+    m_database.Connect(name, m_settings, true);
+    m_database.Open(m_settings);
+  }
+
+  ~EpgSearchDatabase()
+  {
+    // once for Connect and once for Open
+    m_database.Close();
+    m_database.Close();
+  }
+
+  bool HasIndex() const { return m_database.HasFullTextIndex(); }
+
+  void Insert(int epg, int start, const std::string& title, const std::string& plotOutline)
+  {
+    EPG_TAG data{};
+    data.startTime = start;
+    data.endTime = start + 60;
+    data.strTitle = title.c_str();
+    data.strPlotOutline = plotOutline.c_str();
+    m_database.QueuePersistQuery(CPVREpgInfoTag(data, 1, nullptr, epg));
+  }
+
+  void Commit()
+  {
+    m_database.BeginTransaction();
+    m_database.CommitInsertQueries();
+    m_database.CommitTransaction();
+  }
+
+  std::set<int> Search(const std::string& term) const
+  {
+    PVREpgSearchData searchData;
+    searchData.Reset();
+    searchData.m_strSearchTerm = term;
+    searchData.m_bIgnoreFinishedBroadcasts = false;
+
+    std::set<int> ids;
+    for (const auto& tag : m_database.GetEpgTags(searchData))
+      ids.insert(tag->DatabaseID());
+    return ids;
+  }
+
+  // drop the index, searches fall back to matching the tags table with LIKE
+  void DropIndex()
+  {
+    // the triggers would fail any later change of the tags table
+    for (const std::string trigger :
+         {"epgtags_fts_bi", "epgtags_fts_ai", "epgtags_fts_ad", "epgtags_fts_au"})
+      m_database.ExecuteQuery("DROP TRIGGER " + trigger);
+    m_database.ExecuteQuery("DROP TABLE epgtags_fts");
+
+    // opening again checks for the index
+    m_database.Open(m_settings);
+    m_database.Close();
+  }
+
+private:
+  DatabaseSettings m_settings;
+  CPVREpgDatabase m_database;
+};
+} // unnamed namespace
+
+TEST(TestEpgSearchTermConverter, ToSQL)
+{
+  EXPECT_FALSE(CPVREpgSearchTermConverter("").HasSearchTerm());
+
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%news%')))",
+            CPVREpgSearchTermConverter("news").ToSQL("sTitle"));
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%foo%'))  OR (UPPER(sTitle) LIKE UPPER('%bar%')))",
+            CPVREpgSearchTermConverter("foo bar").ToSQL("sTitle"));
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%foo%'))  AND (UPPER(sTitle) LIKE UPPER('%it''s%')))",
+            CPVREpgSearchTermConverter("foo + it's").ToSQL("sTitle"));
+}
+
+TEST(TestEpgSearchTermConverter, ToFullTextQuery)
+{
+  EXPECT_EQ("sTitle : (\"news\") OR sPlotOutline : (\"news\")",
+            CPVREpgSearchTermConverter("news").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("sTitle : (\"foo\" OR \"bar\") OR sPlotOutline : (\"foo\" OR \"bar\")",
+            CPVREpgSearchTermConverter("foo bar").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("sTitle : (\"foo\" AND \"bar\") OR sPlotOutline : (\"foo\" AND \"bar\")",
+            CPVREpgSearchTermConverter("foo and bar").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("sTitle : (\"foo\" NOT \"bar\") OR sPlotOutline : (\"foo\" NOT \"bar\")",
+            CPVREpgSearchTermConverter("foo + ! bar").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("sTitle : (\"the news\") OR sPlotOutline : (\"the news\")",
+            CPVREpgSearchTermConverter("\"the news\"").ToFullTextQuery(FIELDS));
+
+  // not expressible using a trigram index
+  EXPECT_EQ("", CPVREpgSearchTermConverter("tv").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("", CPVREpgSearchTermConverter("news tv").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("", CPVREpgSearchTermConverter("not news").ToFullTextQuery(FIELDS));
+  EXPECT_EQ("", CPVREpgSearchTermConverter("news and").ToFullTextQuery(FIELDS));
+}
+
+TEST(TestEpgSearchTermConverter, IndexMatchesPatternSearch)
+{
+  EpgSearchDatabase database("epgsearchtest");
+  if (!database.HasIndex())
+    GTEST_SKIP() << "sqlite has no fts5 trigram support";
+
+  database.Insert(1, 100, "Evening News", "Today's headlines");
+  database.Insert(1, 200, "The Newsroom", "Drama series");
+  database.Insert(2, 100, "Football", "Live from the stadium");
+  database.Insert(2, 200, "Cooking Show", "Newcomers cook dinner");
+  database.Insert(3, 100, "Späte Nachrichten", "Ein Überblick");
+  database.Commit();
+
+  const std::vector<std::string> terms{"news",         "NEWS",
+                                       "news + drama", "news | football",
+                                       "new + ! room", "\"the stadium\"",
+                                       "ÜBERBLICK",    "today's"};
+  std::vector<std::set<int>> indexResults;
+  for (const auto& term : terms)
+    indexResults.emplace_back(database.Search(term));
+
+  EXPECT_EQ(std::set<int>({1, 2, 4}), database.Search("new"));
+
+  database.DropIndex();
+  ASSERT_FALSE(database.HasIndex());
+  for (size_t i = 0; i < terms.size(); ++i)
+    EXPECT_EQ(database.Search(terms[i]), indexResults[i]) << terms[i];
+}
+
+TEST(TestEpgSearchTermConverter, DISABLED_Benchmark)
+{
+  EpgSearchDatabase database("epgsearchbenchmark");
+  if (!database.HasIndex())
+    GTEST_SKIP() << "sqlite has no fts5 trigram support";
+
+  // two weeks of guide data for 500 channels
+  static constexpr int CHANNELS = 500;
+  static constexpr int BROADCASTS = 14 * 24;
+  const std::vector<std::string> words{"news",    "sport",  "weather", "drama",  "comedy",
+                                       "history", "nature", "science", "travel", "music"};
+
+  for (int channel = 0; channel < CHANNELS; ++channel)
+  {
+    for (int i = 0; i < BROADCASTS; ++i)
+    {
+      const std::string& word = words[(channel * 7 + i) % words.size()];
+      database.Insert(channel + 1, i * 3600, word + " " + std::to_string(i),
+                      "An episode about " + words[(channel + i) % words.size()] + " number " +
+                          std::to_string(channel * BROADCASTS + i));
+    }
+  }
+  database.Commit();
+
+  const std::vector<std::string> terms{"weather", "\"number 4711\"", "science + travel"};
+  std::vector<size_t> indexResults;
+  for (const auto& term : terms)
+  {
+    size_t results = 0;
+    const auto time = Benchmark::Time([&] { results = database.Search(term).size(); });
+    indexResults.emplace_back(results);
+    Benchmark::Report(fmt::format("search '{}' with full text index", term),
+                      Benchmark::Milliseconds(time), "ms");
+  }
+
+  database.DropIndex();
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    size_t results = 0;
+    const auto time = Benchmark::Time([&] { results = database.Search(terms[i]).size(); });
+    EXPECT_EQ(indexResults[i], results) << terms[i];
+    Benchmark::Report(fmt::format("search '{}' with LIKE", terms[i]),
+                      Benchmark::Milliseconds(time), "ms");
+  }
+}
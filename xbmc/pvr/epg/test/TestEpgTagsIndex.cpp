@@ -0,0 +1,246 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagsIndex.h"
+#include "test/Benchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+const CDateTime BASE_TIME(2024, 1, 1, 0, 0, 0);
+
+CDateTime Minutes(int minutes)
+{
+  return BASE_TIME + CDateTimeSpan(0, 0, minutes, 0);
+}
+
+void Add(CPVREpgTagsIndex& index, int start, int end)
+{
+  const auto tag =
+      std::make_shared<CPVREpgInfoTag>(std::shared_ptr<CPVREpgChannelData>(), 1, Minutes(start),
+                                       Minutes(end), false);
+  index.insert({tag->StartAsUTC(), tag});
+}
+
+bool StartsAt(const std::shared_ptr<CPVREpgInfoTag>& tag, int start)
+{
+  return tag && tag->StartAsUTC() == Minutes(start);
+}
+} // unnamed namespace
+
+TEST(TestEpgTagsIndex, GetTagAt)
+{
+  CPVREpgTagsIndex index;
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(0)));
+
+  Add(index, 0, 30);
+  Add(index, 30, 60);
+  Add(index, 90, 300); // long tag after a gap
+  Add(index, 300, 310);
+
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(0)), 0));
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(29)), 0));
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(30)), 30));
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(60)));
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(75)));
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(299)), 90));
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(305)), 300));
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(310)));
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(-10)));
+}
+
+TEST(TestEpgTagsIndex, GetTagsBetween)
+{
+  CPVREpgTagsIndex index;
+  Add(index, 0, 30);
+  Add(index, 30, 60);
+  Add(index, 90, 300);
+  Add(index, 300, 310);
+
+  auto tags = index.GetTagsBetween(Minutes(45), Minutes(120));
+  ASSERT_EQ(2u, tags.size());
+  EXPECT_TRUE(StartsAt(tags[0], 30));
+  EXPECT_TRUE(StartsAt(tags[1], 90));
+
+  tags = index.GetTagsBetween(Minutes(200), Minutes(300));
+  ASSERT_EQ(1u, tags.size());
+  EXPECT_TRUE(StartsAt(tags[0], 90));
+
+  EXPECT_TRUE(index.GetTagsBetween(Minutes(60), Minutes(90)).empty());
+  EXPECT_EQ(4u, index.GetTagsBetween(Minutes(-100), Minutes(1000)).size());
+
+  EXPECT_TRUE(StartsAt(index.GetTagBetween(Minutes(20), Minutes(60)), 30));
+  EXPECT_EQ(nullptr, index.GetTagBetween(Minutes(20), Minutes(59)));
+}
+
+TEST(TestEpgTagsIndex, LastEndedAndNextStarting)
+{
+  CPVREpgTagsIndex index;
+  Add(index, 0, 30);
+  Add(index, 10, 200); // overlapping, ends last
+  Add(index, 30, 60);
+  Add(index, 300, 310);
+
+  EXPECT_EQ(nullptr, index.GetLastEndedTag(Minutes(29)));
+  EXPECT_TRUE(StartsAt(index.GetLastEndedTag(Minutes(30)), 0));
+  EXPECT_TRUE(StartsAt(index.GetLastEndedTag(Minutes(100)), 30));
+  EXPECT_TRUE(StartsAt(index.GetLastEndedTag(Minutes(250)), 10));
+  EXPECT_TRUE(StartsAt(index.GetLastEndedTag(Minutes(1000)), 300));
+  EXPECT_TRUE(StartsAt(index.GetLastEndingTag(), 300));
+
+  EXPECT_TRUE(StartsAt(index.GetNextStartingTag(Minutes(0)), 10));
+  EXPECT_TRUE(StartsAt(index.GetNextStartingTag(Minutes(30)), 300));
+  EXPECT_EQ(nullptr, index.GetNextStartingTag(Minutes(300)));
+}
+
+TEST(TestEpgTagsIndex, Modify)
+{
+  CPVREpgTagsIndex index;
+  Add(index, 0, 30);
+  Add(index, 30, 60);
+  EXPECT_EQ(2u, index.size());
+
+  // extend an existing tag in place
+  const auto tag = index.GetTagAt(Minutes(0));
+  tag->SetEndFromUTC(Minutes(500));
+  index.Invalidate();
+  EXPECT_EQ(2u, index.size());
+  EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(400)), 0));
+  EXPECT_TRUE(StartsAt(index.GetLastEndingTag(), 0));
+
+  EXPECT_EQ(1u, index.erase(Minutes(0)));
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(400)));
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(nullptr, index.GetTagAt(Minutes(45)));
+}
+
+TEST(TestEpgTagsIndex, MatchesLinearScan)
+{
+  // overlapping tags of very different durations
+  CPVREpgTagsIndex index;
+  std::vector<std::pair<int, int>> tags;
+  for (int i = 0; i < 200; ++i)
+  {
+    const int start = (i * 37) % 1000; // unique
+    const int end = start + 1 + (i * i * 13) % (i % 10 == 0 ? 2000 : 40);
+    Add(index, start, end);
+    tags.emplace_back(start, end);
+  }
+  std::sort(tags.begin(), tags.end());
+
+  for (int time = -10; time < 3100; time += 7)
+  {
+    const auto active = std::find_if(tags.cbegin(), tags.cend(), [time](const auto& tag) {
+      return tag.first <= time && tag.second > time;
+    });
+    if (active == tags.cend())
+      EXPECT_EQ(nullptr, index.GetTagAt(Minutes(time)));
+    else
+      EXPECT_TRUE(StartsAt(index.GetTagAt(Minutes(time)), active->first));
+
+    const size_t overlapping =
+        std::count_if(tags.cbegin(), tags.cend(), [time](const auto& tag) {
+          return tag.second > time && tag.first < time + 60;
+        });
+    EXPECT_EQ(overlapping, index.GetTagsBetween(Minutes(time), Minutes(time + 60)).size());
+
+    int lastEnd = -1;
+    for (const auto& tag : tags)
+    {
+      if (tag.second <= time)
+        lastEnd = std::max(lastEnd, tag.second);
+    }
+    const auto lastEnded = index.GetLastEndedTag(Minutes(time));
+    if (lastEnd < 0)
+      EXPECT_EQ(nullptr, lastEnded);
+    else
+      EXPECT_TRUE(lastEnded && lastEnded->EndAsUTC() == Minutes(lastEnd));
+  }
+}
+
+TEST(TestEpgTagsIndex, DISABLED_BenchmarkNowNext)
+{
+  // two days of half hour broadcasts for 1000 channels
+  static constexpr int CHANNELS = 1000;
+  static constexpr int BROADCASTS = 2 * 24 * 2;
+  static constexpr int ROUNDS = 100;
+
+  std::vector<CPVREpgTagsIndex> indexes(CHANNELS);
+  for (int channel = 0; channel < CHANNELS; ++channel)
+  {
+    // shift the schedules a bit, so that not all channels switch at the same time
+    const int offset = channel % 30;
+    for (int i = 0; i < BROADCASTS; ++i)
+      Add(indexes[channel], offset + i * 30, offset + (i + 1) * 30);
+  }
+
+  const CDateTime now = Minutes(BROADCASTS * 30 / 2);
+
+  // what resolving now/next from the tags used to cost: a linear scan per channel
+  size_t linearHits = 0;
+  const auto linearTime = Benchmark::TimePerCall(ROUNDS, [&] {
+    for (const auto& index : indexes)
+    {
+      const auto it = std::find_if(index.cbegin(), index.cend(), [&now](const auto& tag) {
+        return tag.second->StartAsUTC() <= now && tag.second->EndAsUTC() > now;
+      });
+      const auto next = std::find_if(index.cbegin(), index.cend(), [&now](const auto& tag) {
+        return tag.second->StartAsUTC() > now;
+      });
+      if (it != index.cend() && next != index.cend())
+        linearHits++;
+    }
+  });
+
+  size_t indexHits = 0;
+  const auto indexTime = Benchmark::TimePerCall(ROUNDS, [&] {
+    for (const auto& index : indexes)
+    {
+      if (index.GetTagAt(now) && index.GetNextStartingTag(now))
+        indexHits++;
+    }
+  });
+
+  EXPECT_EQ(linearHits, indexHits);
+  EXPECT_EQ(static_cast<size_t>(CHANNELS * ROUNDS), indexHits);
+
+  // a tag spanning the whole guide must not slow down the lookups
+  for (auto& index : indexes)
+    Add(index, -1, BROADCASTS * 30 + 30);
+
+  size_t longTagHits = 0;
+  const auto longTagTime = Benchmark::TimePerCall(ROUNDS, [&] {
+    for (const auto& index : indexes)
+    {
+      if (index.GetTagAt(now) && index.GetNextStartingTag(now))
+        longTagHits++;
+    }
+  });
+
+  EXPECT_EQ(indexHits, longTagHits);
+
+  Benchmark::Report(fmt::format("now/next for {} channels, linear scan", CHANNELS),
+                    Benchmark::Microseconds(linearTime), "us");
+  Benchmark::Report(fmt::format("now/next for {} channels, index", CHANNELS),
+                    Benchmark::Microseconds(indexTime), "us");
+  Benchmark::Report(fmt::format("now/next for {} channels, index with a long tag", CHANNELS),
+                    Benchmark::Microseconds(longTagTime), "us");
+}
@@ -30,6 +30,12 @@ using namespace PVR;
 
 static const unsigned int GRID_START_PADDING = 30; // minutes
 
+namespace
+{
+// number of windows (active channels resp. blocks) to keep epg tags for around the active window
+constexpr int KEEP_WINDOWS = 2;
+} // unnamed namespace
+
 void CGUIEPGGridContainerModel::SetInvalid()
 {
   for (const auto& gridItem : m_gridIndex)
@@ -37,7 +43,7 @@ void CGUIEPGGridContainerModel::SetInvalid()
   for (const auto& channel : m_channelItems)
     channel->SetInvalid();
   for (const auto& ruler : m_rulerItems)
-    ruler->SetInvalid();
+    ruler.second->SetInvalid();
 }
 
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel) const
@@ -122,22 +128,18 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   }
 
   ////////////////////////////////////////////////////////////////////////
-  // Create ruler items
-  CDateTime ruler;
-  ruler.SetFromUTCDateTime(m_gridStart);
+  // Setup ruler. Items get created on demand.
+  m_rulerStart.SetFromUTCDateTime(m_gridStart);
   CDateTime rulerEnd;
   rulerEnd.SetFromUTCDateTime(m_gridEnd);
-  CFileItemPtr rulerItem(new CFileItem(ruler.GetAsLocalizedDate(true)));
-  rulerItem->SetProperty("DateLabel", true);
-  m_rulerItems.emplace_back(rulerItem);
+  m_iRulerUnitMinutes = iRulerUnit * MINSPERBLOCK;
 
-  const CDateTimeSpan unit(0, 0, iRulerUnit * MINSPERBLOCK, 0);
-  for (; ruler < rulerEnd; ruler += unit)
-  {
-    rulerItem = std::make_shared<CFileItem>(ruler.GetAsLocalizedTime("", false));
-    rulerItem->SetLabel2(ruler.GetAsLocalizedDate(true));
-    m_rulerItems.emplace_back(rulerItem);
-  }
+  // date label item, plus one item per ruler unit
+  const int iRulerSeconds = (rulerEnd - m_rulerStart).GetSecondsTotal();
+  const int iUnitSeconds = m_iRulerUnitMinutes * 60;
+  m_rulerItemsCount = 1;
+  if (iRulerSeconds > 0 && iUnitSeconds > 0)
+    m_rulerItemsCount += (iRulerSeconds + iUnitSeconds - 1) / iUnitSeconds;
 
   m_firstActiveChannel = iFirstChannel;
   m_lastActiveChannel = iFirstChannel + iChannelsPerPage - 1;
@@ -145,6 +147,30 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   m_lastActiveBlock = iFirstBlock + iBlocksPerPage - 1;
 }
 
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetRulerItem(int iIndex) const
+{
+  auto it = m_rulerItems.find(iIndex);
+  if (it == m_rulerItems.end())
+  {
+    std::shared_ptr<CFileItem> rulerItem;
+    if (iIndex == 0)
+    {
+      rulerItem = std::make_shared<CFileItem>(m_rulerStart.GetAsLocalizedDate(true));
+      rulerItem->SetProperty("DateLabel", true);
+    }
+    else
+    {
+      const CDateTime ruler =
+          m_rulerStart + CDateTimeSpan(0, 0, (iIndex - 1) * m_iRulerUnitMinutes, 0);
+
+      rulerItem = std::make_shared<CFileItem>(ruler.GetAsLocalizedTime("", false));
+      rulerItem->SetLabel2(ruler.GetAsLocalizedDate(true));
+    }
+    it = m_rulerItems.insert({iIndex, rulerItem}).first;
+  }
+  return (*it).second;
+}
+
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel, int iBlock) const
 {
   std::shared_ptr<CFileItem> result;
@@ -500,6 +526,28 @@ void CGUIEPGGridContainerModel::FreeChannelMemory(int keepStart, int keepEnd)
   }
 }
 
+void CGUIEPGGridContainerModel::TrimEpgTags(EpgTags& epgTags, int iFirstBlock, int iLastBlock) const
+{
+  auto& tags = epgTags.tags;
+
+  // tags are sorted, so it is sufficient to look at both ends
+  const auto first = std::find_if(tags.cbegin(), tags.cend(), [this, iFirstBlock](const auto& item) {
+    return GetLastEventBlock(item->GetEPGInfoTag()) >= iFirstBlock;
+  });
+  tags.erase(tags.cbegin(), first);
+
+  const auto last = std::find_if(tags.cbegin(), tags.cend(), [this, iLastBlock](const auto& item) {
+    return GetFirstEventBlock(item->GetEPGInfoTag()) > iLastBlock;
+  });
+  tags.erase(last, tags.cend());
+
+  if (!tags.empty())
+  {
+    epgTags.firstBlock = GetFirstEventBlock(tags.front()->GetEPGInfoTag());
+    epgTags.lastBlock = GetLastEventBlock(tags.back()->GetEPGInfoTag());
+  }
+}
+
 bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
                                                     int lastChannel,
                                                     int firstBlock,
@@ -511,63 +559,44 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   if (!channelsChanged && !blocksChanged)
     return false;
 
-  // clear the grid. it will be recreated on-demand.
-  m_gridIndex.clear();
-
-  bool newChannels = false;
-
-  if (channelsChanged)
+  // purge grid items outside the new window. they will be recreated on-demand.
+  for (auto it = m_gridIndex.begin(); it != m_gridIndex.end();)
   {
-    // purge epg tags for inactive channels
-    for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
+    const GridCoordinates& coordinates = (*it).first;
+    if (coordinates.channel < firstChannel || coordinates.channel > lastChannel ||
+        coordinates.block < firstBlock || coordinates.block > lastBlock)
     {
-      if ((*it).first < firstChannel || (*it).first > lastChannel)
-      {
-        it = m_epgItems.erase(it);
-        continue; // next channel
-      }
-      ++it;
+      it = m_gridIndex.erase(it);
+      continue; // next item
     }
-
-    newChannels = (firstChannel < m_firstActiveChannel) || (lastChannel > m_lastActiveChannel);
+    ++it;
   }
 
-  if (blocksChanged || newChannels)
+  // keep epg tags close to the new window, so that scrolling back and forth neither needs to
+  // refetch them from the database nor to recreate their items. purge everything else.
+  const int channelsPerWindow = lastChannel - firstChannel + 1;
+  const int blocksPerWindow = lastBlock - firstBlock + 1;
+  const int keepFirstChannel = firstChannel - KEEP_WINDOWS * channelsPerWindow;
+  const int keepLastChannel = lastChannel + KEEP_WINDOWS * channelsPerWindow;
+  const int keepFirstBlock = firstBlock - KEEP_WINDOWS * blocksPerWindow;
+  const int keepLastBlock = lastBlock + KEEP_WINDOWS * blocksPerWindow;
+
+  for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
   {
-    // clear and refetch epg tags for active channels
-    const CDateTime maxEnd = GetStartTimeForBlock(firstBlock);
-    const CDateTime minStart = GetStartTimeForBlock(lastBlock);
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    for (int i = firstChannel; i <= lastChannel; ++i)
+    if ((*it).first < keepFirstChannel || (*it).first > keepLastChannel)
     {
-      auto it = m_epgItems.find(i);
-      if (it == m_epgItems.end())
-        it = m_epgItems.insert({i, EpgTags()}).first;
-
-      if (blocksChanged || i < m_firstActiveChannel || i > m_lastActiveChannel)
-      {
-        EpgTags& epgTags = (*it).second;
-
-        (*it).second.tags.clear();
-
-        tags = GetEPGTimeline(i, maxEnd, minStart);
-        const int firstResultBlock = GetFirstEventBlock(tags.front());
-        const int lastResultBlock = GetLastEventBlock(tags.back());
-        if (firstResultBlock > lastResultBlock)
-          continue;
-
-        epgTags.firstBlock = firstResultBlock;
-        epgTags.lastBlock = lastResultBlock;
-
-        for (const auto& tag : tags)
-        {
-          if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-            continue;
+      it = m_epgItems.erase(it);
+      continue; // next channel
+    }
 
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
-        }
-      }
+    EpgTags& epgTags = (*it).second;
+    TrimEpgTags(epgTags, keepFirstBlock, keepLastBlock);
+    if (epgTags.tags.empty())
+    {
+      it = m_epgItems.erase(it);
+      continue; // next channel
     }
+    ++it;
   }
 
   m_firstActiveChannel = firstChannel;
@@ -575,29 +604,42 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   m_firstActiveBlock = firstBlock;
   m_lastActiveBlock = lastBlock;
 
+  // fetch missing epg tags for active channels. if the window was scrolled beyond the epg tags
+  // already present, fetch one more window in scroll direction, to avoid a database roundtrip
+  // for every scrolled block.
+  const int fetchFirstBlock = std::max(0, firstBlock - blocksPerWindow);
+  const int fetchLastBlock = std::min(GetLastBlock(), lastBlock + blocksPerWindow);
+  for (int i = firstChannel; i <= lastChannel; ++i)
+  {
+    const auto it = m_epgItems.find(i);
+    if (it == m_epgItems.end())
+    {
+      CreateEpgTags(i, firstBlock);
+      continue; // next channel
+    }
+
+    EpgTags& epgTags = (*it).second;
+    if (firstBlock < epgTags.firstBlock)
+      GetEpgTagsBefore(epgTags, i, fetchFirstBlock);
+    if (lastBlock > epgTags.lastBlock)
+      GetEpgTagsAfter(epgTags, i, fetchLastBlock);
+  }
+
   return true;
 }
 
 void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
 {
-  if (keepStart < keepEnd)
-  {
-    // remove before keepStart and after keepEnd
-    for (int i = 1; i < keepStart && i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
-    for (int i = keepEnd + 1; i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
-  }
-  else
+  // the date label item is always kept
+  for (auto it = m_rulerItems.begin(); it != m_rulerItems.end();)
   {
-    // wrapping
-    for (int i = keepEnd + 1; i < keepStart && i < RulerItemsSize(); ++i)
-    {
-      if (i == 0)
-        continue;
-
-      m_rulerItems[i]->FreeMemory();
-    }
+    const int i = (*it).first;
+    const bool keep = (keepStart < keepEnd) ? (i >= keepStart && i <= keepEnd) // not wrapping
+                                            : (i <= keepEnd || i >= keepStart); // wrapping
+    if (i != 0 && !keep)
+      it = m_rulerItems.erase(it);
+    else
+      ++it;
   }
 }
 
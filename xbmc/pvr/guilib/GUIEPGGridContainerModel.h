@@ -81,8 +81,8 @@ public:
     return m_channelItems.empty() ? -1 : static_cast<int>(m_channelItems.size()) - 1;
   }
 
-  std::shared_ptr<CFileItem> GetRulerItem(int iIndex) const { return m_rulerItems[iIndex]; }
-  int RulerItemsSize() const { return static_cast<int>(m_rulerItems.size()); }
+  std::shared_ptr<CFileItem> GetRulerItem(int iIndex) const;
+  int RulerItemsSize() const { return m_rulerItemsCount; }
 
   int GridItemsSize() const { return m_blocks; }
   bool IsSameGridItem(int iChannel, int iBlock1, int iBlock2) const;
@@ -135,6 +135,7 @@ private:
                                         int iBlock) const;
   std::shared_ptr<CFileItem> GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
   std::shared_ptr<CFileItem> GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+  void TrimEpgTags(EpgTags& epgTags, int iFirstBlock, int iLastBlock) const;
 
   mutable EpgTagsMap m_epgItems;
 
@@ -142,7 +143,10 @@ private:
   CDateTime m_gridEnd;
 
   std::vector<std::shared_ptr<CFileItem>> m_channelItems;
-  std::vector<std::shared_ptr<CFileItem>> m_rulerItems;
+  mutable std::map<int, std::shared_ptr<CFileItem>> m_rulerItems; // created on demand
+  CDateTime m_rulerStart; // local time
+  int m_iRulerUnitMinutes = 0;
+  int m_rulerItemsCount = 0;
 
   struct GridCoordinates
   {
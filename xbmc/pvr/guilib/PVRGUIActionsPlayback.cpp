@@ -362,11 +362,10 @@ bool CPVRGUIActionsPlayback::SwitchToChannel(PlaybackType type) const
     if (channelGroup)
     {
       // try to start playback of first channel in this group
-      const std::vector<std::shared_ptr<CPVRChannelGroupMember>> groupMembers =
-          channelGroup->GetMembers();
-      if (!groupMembers.empty())
+      const auto groupMembers = channelGroup->GetMembers();
+      if (!groupMembers->empty())
       {
-        return SwitchToChannel(CFileItem(*groupMembers.begin()), true);
+        return SwitchToChannel(CFileItem(groupMembers->front()), true);
       }
     }
   }
@@ -401,11 +400,11 @@ bool CPVRGUIActionsPlayback::PlayChannelOnStartup() const
   {
     const std::shared_ptr<const CPVRChannelGroup> group =
         CServiceBroker::GetPVRManager().ChannelGroups()->Get(playRadio)->GetGroupAll();
-    auto channels = group->GetMembers();
-    if (channels.empty())
+    const auto channels = group->GetMembers();
+    if (channels->empty())
       return false;
 
-    groupMember = channels.front();
+    groupMember = channels->front();
     if (!groupMember)
       return false;
   }
@@ -64,7 +64,8 @@ void CPVRGUIChannelIconUpdater::SearchAndUpdateMissingChannelIcons() const
 
   for (const auto& group : m_groups)
   {
-    const std::vector<std::shared_ptr<CPVRChannelGroupMember>> members = group->GetMembers();
+    const auto snapshot = group->GetMembersSnapshot();
+    const auto& members = snapshot->sortedMembers;
     size_t channelIndex = 0;
     for (const auto& member : members)
     {
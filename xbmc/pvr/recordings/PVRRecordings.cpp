@@ -39,19 +39,41 @@ CPVRRecordings::~CPVRRecordings()
 
 bool CPVRRecordings::UpdateFromClients(const std::vector<std::shared_ptr<CPVRClient>>& clients)
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const bool bUpdated = UpdateFromClients(
+      [this, &clients](bool deleted, std::vector<int>& failedClients)
+      {
+        CServiceBroker::GetPVRManager().Clients()->GetRecordings(clients, this, deleted,
+                                                                 failedClients);
+      });
 
-  if (m_bIsUpdating)
-    return false;
+  if (bUpdated)
+    CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
 
-  m_bIsUpdating = true;
+  return bUpdated;
+}
 
-  for (const auto& recording : m_recordings)
-    recording.second->SetDirty(true);
+bool CPVRRecordings::UpdateFromClients(
+    const std::function<void(bool deleted, std::vector<int>& failedClients)>& getRecordings)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    if (m_bIsUpdating)
+      return false;
+
+    m_bIsUpdating = true;
+
+    for (const auto& recording : m_recordings)
+      recording.second->SetDirty(true);
+  }
 
+  // the clients are queried in parallel and deliver through UpdateFromClient, which takes the
+  // lock for every recording. Holding it here would block them.
   std::vector<int> failedClients;
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(clients, this, false, failedClients);
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(clients, this, true, failedClients);
+  getRecordings(false, failedClients);
+  getRecordings(true, failedClients);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
 
   // remove recordings that were deleted at the backend
   for (auto it = m_recordings.begin(); it != m_recordings.end();)
@@ -64,7 +86,6 @@ bool CPVRRecordings::UpdateFromClients(const std::vector<std::shared_ptr<CPVRCli
   }
 
   m_bIsUpdating = false;
-  CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
   return true;
 }
 
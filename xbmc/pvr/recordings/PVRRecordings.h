@@ -10,6 +10,7 @@
 
 #include "threads/CriticalSection.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -131,6 +132,17 @@ public:
    */
   int CleanupCachedImages();
 
+protected:
+  /*!
+   * @brief Update data with the recordings delivered by the given function, sync with local data.
+   * @param getRecordings Called once for the active and once for the deleted recordings, without
+   * holding the lock. Hands the recordings to UpdateFromClient, possibly from several threads at
+   * once, and adds the ids of the clients that failed to failedClients.
+   * @return True on success, false if an update is already in progress.
+   */
+  bool UpdateFromClients(
+      const std::function<void(bool deleted, std::vector<int>& failedClients)>& getRecordings);
+
 private:
   /*!
    * @brief Get/Open the video database.
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/IAddon.h"
+#include "addons/addoninfo/AddonInfoBuilder.h"
+#include "addons/addoninfo/AddonType.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_recordings.h"
+#include "pvr/addons/PVRClient.h"
+#include "pvr/recordings/PVRRecording.h"
+#include "pvr/recordings/PVRRecordings.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int RECORDINGS_PER_CLIENT = 50;
+
+class TestRecordings : public CPVRRecordings
+{
+public:
+  using CPVRRecordings::UpdateFromClients;
+};
+
+std::shared_ptr<CPVRClient> MakeClient(int clientId)
+{
+  const auto addonInfo = ADDON::CAddonInfoBuilder::Generate(
+      "pvr.test" + std::to_string(clientId), ADDON::AddonType::PVRDLL);
+  return std::make_shared<CPVRClient>(addonInfo, ADDON::ADDON_SINGLETON_INSTANCE_ID, clientId);
+}
+
+std::shared_ptr<CPVRRecording> MakeRecording(int clientId, int index)
+{
+  const std::string recordingId = std::to_string(index);
+  PVR_RECORDING data{};
+  data.strRecordingId = recordingId.c_str();
+  data.strTitle = "Test";
+  data.iGenreType = EPG_GENRE_USE_STRING;
+  data.strGenreDescription = "Test";
+  data.channelType = PVR_RECORDING_CHANNEL_TYPE_TV;
+  data.sizeInBytes = -1;
+  return std::make_shared<CPVRRecording>(data, clientId);
+}
+
+/*!
+ * Delivers the recordings of every client from a thread of its own, the way CPVRClients queries
+ * them. A fetch that does not finish in time is reported instead of waited for, so a lock held
+ * across it fails the test rather than hanging it. The futures are kept by the caller and only
+ * joined after the update returned.
+ */
+class ParallelFetch
+{
+public:
+  ParallelFetch(TestRecordings& recordings, std::vector<std::shared_ptr<CPVRClient>> clients)
+    : m_recordings(recordings), m_clients(std::move(clients))
+  {
+  }
+
+  void SetCount(int clientId, int count) { m_counts[clientId] = count; }
+  void SetFailed(int clientId) { m_failed.emplace_back(clientId); }
+
+  bool Update()
+  {
+    return m_recordings.UpdateFromClients(
+        [this](bool deleted, std::vector<int>& failedClients)
+        {
+          if (deleted)
+            return;
+
+          std::vector<std::future<void>> calls;
+          for (const auto& client : m_clients)
+          {
+            const int clientId = client->GetID();
+            if (std::find(m_failed.begin(), m_failed.end(), clientId) != m_failed.end())
+            {
+              failedClients.emplace_back(clientId);
+              continue;
+            }
+
+            const int count = m_counts.count(clientId) ? m_counts[clientId] : RECORDINGS_PER_CLIENT;
+            calls.emplace_back(std::async(std::launch::async,
+                                          [this, client, clientId, count]
+                                          {
+                                            for (int i = 0; i < count; ++i)
+                                              m_recordings.UpdateFromClient(
+                                                  MakeRecording(clientId, i), *client);
+                                          }));
+          }
+
+          for (auto& call : calls)
+          {
+            if (call.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+              m_timedOut = true;
+            m_pending.emplace_back(std::move(call));
+          }
+        });
+  }
+
+  bool TimedOut() const { return m_timedOut; }
+
+private:
+  TestRecordings& m_recordings;
+  std::vector<std::shared_ptr<CPVRClient>> m_clients;
+  std::map<int, int> m_counts;
+  std::vector<int> m_failed;
+  std::vector<std::future<void>> m_pending;
+  bool m_timedOut = false;
+};
+} // unnamed namespace
+
+TEST(TestPVRRecordings, UpdateFromParallelClients)
+{
+  TestRecordings recordings;
+  ParallelFetch fetch(recordings, {MakeClient(1), MakeClient(2)});
+
+  ASSERT_TRUE(fetch.Update());
+  ASSERT_FALSE(fetch.TimedOut());
+
+  EXPECT_EQ(2 * RECORDINGS_PER_CLIENT, recordings.GetNumTVRecordings());
+  EXPECT_EQ(2u * RECORDINGS_PER_CLIENT, recordings.GetAll().size());
+  EXPECT_NE(nullptr, recordings.GetById(1, "0"));
+  EXPECT_NE(nullptr, recordings.GetById(2, std::to_string(RECORDINGS_PER_CLIENT - 1)));
+}
+
+TEST(TestPVRRecordings, UpdateRemovesRecordingsGoneFromTheBackend)
+{
+  TestRecordings recordings;
+  ParallelFetch fetch(recordings, {MakeClient(1), MakeClient(2)});
+  ASSERT_TRUE(fetch.Update());
+
+  const auto kept = recordings.GetById(1, "0");
+  ASSERT_NE(nullptr, kept);
+
+  // recordings of a failed client are kept, the ones its backend no longer has are removed
+  fetch.SetFailed(1);
+  fetch.SetCount(2, RECORDINGS_PER_CLIENT / 2);
+  ASSERT_TRUE(fetch.Update());
+  ASSERT_FALSE(fetch.TimedOut());
+
+  EXPECT_EQ(kept, recordings.GetById(1, "0"));
+  EXPECT_NE(nullptr, recordings.GetById(2, std::to_string(RECORDINGS_PER_CLIENT / 2 - 1)));
+  EXPECT_EQ(nullptr, recordings.GetById(2, std::to_string(RECORDINGS_PER_CLIENT / 2)));
+  EXPECT_EQ(3u * RECORDINGS_PER_CLIENT / 2, recordings.GetAll().size());
+}
@@ -79,6 +79,24 @@ bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<const CPVREpgInfoTag>&
          MatchEnd(epgTag) && MatchDayOfWeek(epgTag) && MatchSearchText(epgTag);
 }
 
+std::string CPVRTimerRuleMatcher::GetLiteralSearchText() const
+{
+  if (!IsFullTextSearch() && !m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
+    return {};
+
+  const std::string& searchString = m_timerRule->EpgSearchString();
+  if (searchString.find_first_of("\\^$.|?*+()[]{}\"") != std::string::npos)
+    return {};
+
+  return searchString;
+}
+
+bool CPVRTimerRuleMatcher::IsFullTextSearch() const
+{
+  return m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
+         m_timerRule->IsFullTextEpgSearch();
+}
+
 bool CPVRTimerRuleMatcher::MatchSeriesLink(
     const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
@@ -174,7 +192,7 @@ bool CPVRTimerRuleMatcher::MatchDayOfWeek(const std::shared_ptr<const CPVREpgInf
 bool CPVRTimerRuleMatcher::MatchSearchText(
     const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
-  if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() && m_timerRule->IsFullTextEpgSearch())
+  if (IsFullTextSearch())
   {
     if (!m_textSearch)
     {
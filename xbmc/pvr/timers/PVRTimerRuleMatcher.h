@@ -11,6 +11,7 @@
 #include "XBDateTime.h"
 
 #include <memory>
+#include <string>
 
 class CRegExp;
 
@@ -32,6 +33,19 @@ public:
   CDateTime GetNextTimerStart() const;
   bool Matches(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
 
+  /*!
+   * @brief Get the text epg tags must contain to match the rule, for pre-selecting candidate
+   * tags with a (case insensitive) text search.
+   * @return The search text or an empty string if the rule does not match text or its search
+   * string is a regular expression that is not a plain literal.
+   */
+  std::string GetLiteralSearchText() const;
+
+  /*!
+   * @brief Whether the rule matches the search text against the description of tags too.
+   */
+  bool IsFullTextSearch() const;
+
 private:
   bool MatchSeriesLink(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
   bool MatchChannel(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
@@ -18,7 +18,9 @@
 #include "pvr/channels/PVRChannel.h"
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgContainer.h"
+#include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchData.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "pvr/timers/PVRTimerRuleMatcher.h"
 #include "settings/Settings.h"
@@ -424,9 +426,52 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(
   }
   else
   {
+    const CPVREpgContainer& epgContainer = CServiceBroker::GetPVRManager().EpgContainer();
+    const std::shared_ptr<const CPVREpgDatabase> database = epgContainer.GetEpgDatabase();
+    const std::string searchText = matcher.GetLiteralSearchText();
+    if (!searchText.empty() && database && database->HasFullTextIndex())
+    {
+      // the index only knows the committed tags. match the others directly, they replace the
+      // committed tags they overlap.
+      std::map<int, std::vector<std::shared_ptr<CPVREpgInfoTag>>> uncommittedTags;
+      for (const auto& epg : epgContainer.GetAllEpgs())
+      {
+        std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = epg->GetUncommittedTags();
+        std::copy_if(tags.cbegin(), tags.cend(), std::back_inserter(matches),
+                     [&matcher](const auto& tag) { return matcher.Matches(tag); });
+        if (!tags.empty())
+          uncommittedTags.emplace(epg->EpgID(), std::move(tags));
+      }
+
+      // pre-select committed candidates using the full text index instead of matching all tags
+      PVREpgSearchData searchData;
+      searchData.Reset();
+      searchData.m_strSearchTerm = "\"" + searchText + "\"";
+      searchData.m_bSearchInDescription = matcher.IsFullTextSearch();
+      searchData.m_bIgnoreFinishedBroadcasts = false; // left to the matcher
+
+      for (const auto& tag : database->GetEpgTags(searchData))
+      {
+        const auto it = uncommittedTags.find(tag->EpgID());
+        if (it != uncommittedTags.cend() &&
+            std::any_of((*it).second.cbegin(), (*it).second.cend(), [&tag](const auto& other) {
+              return other->StartAsUTC() < tag->EndAsUTC() && other->EndAsUTC() > tag->StartAsUTC();
+            }))
+          continue;
+
+        const std::shared_ptr<const CPVREpg> epg = epgContainer.GetById(tag->EpgID());
+        if (!epg)
+          continue;
+
+        tag->SetChannelData(epg->GetChannelData());
+        if (matcher.Matches(tag))
+          matches.emplace_back(tag);
+      }
+      return matches;
+    }
+
     // match any channel
-    const std::vector<std::shared_ptr<CPVREpg>> epgs =
-        CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
+    const std::vector<std::shared_ptr<CPVREpg>> epgs = epgContainer.GetAllEpgs();
 
     for (const auto& epg : epgs)
     {
@@ -60,7 +60,7 @@ public:
 protected:
   void InsertEntry(const std::shared_ptr<CPVRTimerInfoTag>& newTimer);
 
-  mutable CCriticalSection m_critSection;
+  mutable CCriticalSection m_critSection{"PVRTimers"};
   unsigned int m_iLastId = 0;
   MapTags m_tags;
 };
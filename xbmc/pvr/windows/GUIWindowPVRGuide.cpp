@@ -742,12 +742,11 @@ bool CGUIWindowPVRGuideBase::RefreshTimelineItems()
         endDate = maxFutureDate;
 
       std::unique_ptr<CFileItemList> channels(new CFileItemList);
-      const std::vector<std::shared_ptr<CPVRChannelGroupMember>> groupMembers =
-          group->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
-
-      for (const auto& groupMember : groupMembers)
+      const auto groupMembers = group->GetMembers();
+      for (const auto& groupMember : *groupMembers)
       {
-        channels->Add(std::make_shared<CFileItem>(groupMember));
+        if (!groupMember->Channel()->IsHidden())
+          channels->Add(std::make_shared<CFileItem>(groupMember));
       }
 
       if (m_guiState)
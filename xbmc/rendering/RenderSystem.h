@@ -34,6 +34,12 @@ class CGUITextLayout;
 class CRenderSystemBase
 {
 public:
+  struct DrawStatistics
+  {
+    unsigned int drawCalls = 0;
+    unsigned int quads = 0;
+  };
+
   CRenderSystemBase();
   virtual ~CRenderSystemBase();
 
@@ -62,6 +68,12 @@ public:
   virtual void CaptureStateBlock() = 0;
   virtual void ApplyStateBlock() = 0;
 
+  /**
+   * Draw the GUI quads queued so far. Called before rendering which doesn't go through the
+   * render system, e.g. video, so it ends up on top of the GUI rendered before it.
+   */
+  virtual void FlushBatch() {}
+
   virtual void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor = 0.f) = 0;
   virtual void SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
   {
@@ -87,6 +99,16 @@ public:
 
   virtual void ShowSplash(const std::string& message);
 
+  /**
+   * Count draw calls of the GUI, the statistics are reset when rendering a frame begins
+   */
+  void AddDrawCalls(unsigned int drawCalls, unsigned int quads)
+  {
+    m_drawStatistics.drawCalls += drawCalls;
+    m_drawStatistics.quads += quads;
+  }
+  const DrawStatistics& GetDrawStatistics() const { return m_drawStatistics; }
+
 protected:
   bool                m_bRenderCreated;
   bool                m_bVSync;
@@ -102,6 +124,7 @@ protected:
   RENDER_STEREO_MODE m_stereoMode = RENDER_STEREO_MODE_OFF;
   bool m_limitedColorRange = false;
   bool m_transferPQ{false};
+  DrawStatistics m_drawStatistics;
 
   std::unique_ptr<CGUIImage> m_splashImage;
   std::unique_ptr<CGUITextLayout> m_splashMessageLayout;
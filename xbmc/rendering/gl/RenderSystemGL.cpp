@@ -22,7 +22,11 @@
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <optional>
+#include <utility>
 
 #if defined(TARGET_LINUX)
 #include "utils/EGLUtils.h"
@@ -30,6 +34,22 @@
 
 using namespace std::chrono_literals;
 
+namespace
+{
+bool IsEqual(const CMatrixGL& first, const CMatrixGL& second)
+{
+  return std::memcmp(static_cast<const float*>(first), static_cast<const float*>(second),
+                     16 * sizeof(float)) == 0;
+}
+} // unnamed namespace
+
+bool CRenderSystemGL::GUIDrawState::operator==(const GUIDrawState& other) const
+{
+  return textures == other.textures && shader == other.shader && blending == other.blending &&
+         color == other.color && depth == other.depth && IsEqual(projection, other.projection) &&
+         IsEqual(modelView, other.modelView) && scissor == other.scissor;
+}
+
 CRenderSystemGL::CRenderSystemGL() : CRenderSystemBase()
 {
 }
@@ -245,6 +265,15 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  FlushBatch();
+  if (m_batchVertexBuffer != GL_NONE)
+  {
+    glDeleteBuffers(1, &m_batchVertexBuffer);
+    glDeleteBuffers(1, &m_batchIndexBuffer);
+    m_batchVertexBuffer = GL_NONE;
+    m_batchIndexBuffer = GL_NONE;
+  }
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -270,6 +299,8 @@ bool CRenderSystemGL::BeginRender()
   }
 
   m_limitedColorRange = useLimited;
+  m_batchGUI = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiBatchRendering;
+  m_drawStatistics = {};
   return true;
 }
 
@@ -278,6 +309,7 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
   return true;
 }
 
@@ -286,6 +318,8 @@ void CRenderSystemGL::InvalidateColorBuffer()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   /* clear is not affected by stipple pattern, so we can only clear on first frame */
   if (m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return;
@@ -310,6 +344,8 @@ bool CRenderSystemGL::ClearBuffers(KODI::UTILS::COLOR::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
+
   /* clear is not affected by stipple pattern, so we can only clear on first frame */
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
@@ -370,6 +406,8 @@ void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   PresentRenderImpl(rendered);
 
   if (!rendered)
@@ -400,6 +438,8 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -426,6 +466,191 @@ void CRenderSystemGL::ApplyStateBlock()
   glEnable(GL_SCISSOR_TEST);
 }
 
+void CRenderSystemGL::FlushBatch()
+{
+  m_guiBatch.Flush(
+      [this](const std::vector<GUIVertex>& vertices, const std::vector<GUIQuadBatch::Draw>& draws)
+      { DrawGUIBatch(vertices, draws); });
+}
+
+void CRenderSystemGL::SetGUIBatchState(GUIDrawState& state)
+{
+  state.projection = glMatrixProject.Get();
+  state.modelView = glMatrixModview.Get();
+  state.scissor = m_scissor;
+
+  // the coordinates of quads drawn with different matrices can't be checked for overlaps
+  if (!IsEqual(state.projection, m_batchProjection) || !IsEqual(state.modelView, m_batchModelView))
+  {
+    m_guiBatch.Barrier();
+    m_batchProjection = state.projection;
+    m_batchModelView = state.modelView;
+  }
+}
+
+void CRenderSystemGL::DrawGUIQuads(const GUIDrawState& state,
+                                   const GUIVertex* vertices,
+                                   size_t quads)
+{
+  GUIDrawState batchState = state;
+  SetGUIBatchState(batchState);
+
+  m_guiBatch.Add(batchState, vertices, quads);
+  if (!m_batchGUI)
+    FlushBatch();
+}
+
+void CRenderSystemGL::DrawGUICustom(const CRect& bounds, std::function<void()> draw)
+{
+  GUIDrawState batchState;
+  SetGUIBatchState(batchState);
+  batchState.draw = std::move(draw);
+
+  m_guiBatch.AddCustom(batchState, bounds);
+  if (!m_batchGUI)
+    FlushBatch();
+}
+
+void CRenderSystemGL::DrawGUIBatch(const std::vector<GUIVertex>& vertices,
+                                   const std::vector<GUIQuadBatch::Draw>& draws)
+{
+  if (!m_bRenderCreated)
+    return;
+
+  if (m_batchVertexBuffer == GL_NONE)
+  {
+    glGenBuffers(1, &m_batchVertexBuffer);
+    glGenBuffers(1, &m_batchIndexBuffer);
+
+    const std::vector<uint16_t> indices = GUIQuadBatch::GetIndices();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_batchIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(),
+                 GL_STATIC_DRAW);
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_batchVertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(GUIVertex) * vertices.size(), vertices.data(),
+               GL_STREAM_DRAW);
+
+  const GUIDrawState* previous = nullptr;
+  CGLShader* shader = nullptr;
+  std::optional<CRect> scissor = m_scissor;
+  for (const auto& draw : draws)
+  {
+    const GUIDrawState& state = *draw.state;
+    if (!scissor || *scissor != state.scissor)
+    {
+      ApplyScissors(state.scissor);
+      scissor = state.scissor;
+    }
+
+    if (draw.quads == 0)
+    {
+      // the custom draw sets up its own state and may change the scissors
+      const CRect current = m_scissor;
+      state.draw();
+      m_scissor = current;
+      scissor.reset();
+      previous = nullptr;
+      continue;
+    }
+
+    if (!previous)
+    {
+      glBindBuffer(GL_ARRAY_BUFFER, m_batchVertexBuffer);
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_batchIndexBuffer);
+      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    }
+
+    if (!previous || previous->shader != state.shader ||
+        !IsEqual(previous->projection, state.projection) ||
+        !IsEqual(previous->modelView, state.modelView))
+    {
+      shader = m_pShader[state.shader].get();
+      if (!shader)
+      {
+        CLog::Log(LOGERROR, "Invalid GUI Shader selected {}", state.shader);
+        previous = nullptr;
+        continue;
+      }
+
+      // the shader loads the matrices when it's enabled
+      glMatrixProject.Push();
+      glMatrixModview.Push();
+      glMatrixProject.Get() = state.projection;
+      glMatrixModview.Get() = state.modelView;
+      shader->Enable();
+      glMatrixProject.Pop();
+      glMatrixModview.Pop();
+      m_method = state.shader;
+    }
+
+    for (unsigned int unit = 0; unit < state.textures.size(); unit++)
+    {
+      if (state.textures[unit] && (!previous || previous->textures[unit] != state.textures[unit]))
+      {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, state.textures[unit]);
+      }
+    }
+
+    if (!previous || previous->blending != state.blending)
+    {
+      if (state.blending)
+        glEnable(GL_BLEND);
+      else
+        glDisable(GL_BLEND);
+    }
+
+    if (shader->GetUniColLoc() >= 0)
+    {
+      glUniform4f(shader->GetUniColLoc(), state.color[0] / 255.0f, state.color[1] / 255.0f,
+                  state.color[2] / 255.0f, state.color[3] / 255.0f);
+    }
+    glUniform1f(shader->GetDepthLoc(), state.depth);
+
+    const GLint posLoc = shader->GetPosLoc();
+    const GLint tex0Loc = shader->GetCord0Loc();
+    const GLint tex1Loc = shader->GetCord1Loc();
+    const size_t offset = draw.firstVertex * sizeof(GUIVertex);
+
+    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(GUIVertex),
+                          reinterpret_cast<const GLvoid*>(offset + offsetof(GUIVertex, x)));
+    glEnableVertexAttribArray(posLoc);
+    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                          reinterpret_cast<const GLvoid*>(offset + offsetof(GUIVertex, u1)));
+    glEnableVertexAttribArray(tex0Loc);
+    if (state.textures[1])
+    {
+      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                            reinterpret_cast<const GLvoid*>(offset + offsetof(GUIVertex, u2)));
+      glEnableVertexAttribArray(tex1Loc);
+    }
+
+    glDrawElements(GL_TRIANGLES, draw.quads * 6, GL_UNSIGNED_SHORT, 0);
+    AddDrawCalls(1, draw.quads);
+
+    glDisableVertexAttribArray(posLoc);
+    glDisableVertexAttribArray(tex0Loc);
+    if (state.textures[1])
+      glDisableVertexAttribArray(tex1Loc);
+
+    previous = &state;
+  }
+
+  if (!scissor || *scissor != m_scissor)
+    ApplyScissors(m_scissor);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  if (previous && shader)
+    shader->Disable();
+  m_method = ShaderMethodGL::SM_DEFAULT;
+}
+
 void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
 {
   if (!m_bRenderCreated)
@@ -506,8 +731,11 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
+  m_scissor = viewPort;
   m_viewPort[0] = viewPort.x1;
   m_viewPort[1] = m_height - viewPort.y1 - viewPort.Height();
   m_viewPort[2] = viewPort.Width();
@@ -540,6 +768,14 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  // the queued GUI quads keep the scissors they were queued with
+  m_scissor = rect;
+  ApplyScissors(rect);
+}
+
+void CRenderSystemGL::ApplyScissors(const CRect& rect)
+{
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -554,6 +790,8 @@ void CRenderSystemGL::ResetScissors()
 
 void CRenderSystemGL::SetDepthCulling(DEPTH_CULLING culling)
 {
+  FlushBatch();
+
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -633,6 +871,8 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  FlushBatch();
+
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -826,6 +1066,10 @@ void CRenderSystemGL::ReleaseShaders()
 
 void CRenderSystemGL::EnableShader(ShaderMethodGL method)
 {
+  // text is queued with the GUI quads, see CGUIFontTTFGL::LastEnd
+  if (method != ShaderMethodGL::SM_FONTS && method != ShaderMethodGL::SM_FONTS_SHADER_CLIP)
+    FlushBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
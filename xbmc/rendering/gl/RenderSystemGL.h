@@ -9,12 +9,17 @@
 #pragma once
 
 #include "GLShader.h"
+#include "guilib/GUIQuadBatch.h"
+#include "rendering/MatrixGL.h"
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 #include "utils/Map.h"
 
+#include <array>
+#include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -66,6 +71,28 @@ private:
 class CRenderSystemGL : public CRenderSystemBase
 {
 public:
+  struct GUIVertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  struct GUIDrawState
+  {
+    std::array<GLuint, 2> textures{}; //!< the textures of unit 0 and 1, 0 if unused
+    ShaderMethodGL shader = ShaderMethodGL::SM_TEXTURE;
+    bool blending = true;
+    std::array<GLubyte, 4> color{};
+    float depth = 0.0f;
+    CMatrixGL projection{}; //!< set by DrawGUIQuads
+    CMatrixGL modelView{}; //!< set by DrawGUIQuads
+    CRect scissor; //!< set by DrawGUIQuads
+    std::function<void()> draw; //!< set by DrawGUICustom, not compared
+
+    bool operator==(const GUIDrawState& other) const;
+  };
+
   CRenderSystemGL();
   ~CRenderSystemGL() override;
   bool InitRenderSystem() override;
@@ -95,6 +122,8 @@ public:
   void CaptureStateBlock() override;
   void ApplyStateBlock() override;
 
+  void FlushBatch() override;
+
   void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor = 0.0f) override;
 
   void SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view) override;
@@ -124,6 +153,26 @@ public:
   GLint ShaderGetClip();
   GLint ShaderGetCoordStep();
 
+  /*!
+   * \brief Queue textured quads, which are drawn with the quads of other textures on the next flush.
+   * Changing any state of the render system or enabling a shader other than the font shaders
+   * flushes the queue.
+   * \param state the state to draw the quads with, the matrices and scissors are taken from the
+   * render system
+   * \param vertices four vertices per quad
+   * \param quads the number of quads
+   */
+  void DrawGUIQuads(const GUIDrawState& state, const GUIVertex* vertices, size_t quads);
+
+  /*!
+   * \brief Queue a draw of the caller's own, e.g. of text, which is issued in order with the quads
+   * it overlaps on the next flush.
+   * \param bounds the area drawn to, in the coordinates of the GUI quads drawn with the current
+   * matrices
+   * \param draw sets up all the state it needs and draws, the scissors are restored afterwards
+   */
+  void DrawGUICustom(const CRect& bounds, std::function<void()> draw);
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
@@ -131,6 +180,12 @@ protected:
   void InitialiseShaders();
   void ReleaseShaders();
 
+  using GUIQuadBatch = CGUIQuadBatch<GUIDrawState, GUIVertex>;
+  void SetGUIBatchState(GUIDrawState& state);
+  void DrawGUIBatch(const std::vector<GUIVertex>& vertices,
+                    const std::vector<GUIQuadBatch::Draw>& draws);
+  void ApplyScissors(const CRect& rect);
+
   bool m_bVsyncInit = false;
   int m_width;
   int m_height;
@@ -145,4 +200,12 @@ protected:
   std::map<ShaderMethodGL, std::unique_ptr<CGLShader>> m_pShader;
   ShaderMethodGL m_method = ShaderMethodGL::SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  GUIQuadBatch m_guiBatch;
+  bool m_batchGUI = true;
+  CMatrixGL m_batchProjection{};
+  CMatrixGL m_batchModelView{};
+  GLuint m_batchVertexBuffer = GL_NONE;
+  GLuint m_batchIndexBuffer = GL_NONE;
+  CRect m_scissor;
 };
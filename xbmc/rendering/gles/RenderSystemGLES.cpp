@@ -24,12 +24,34 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <utility>
+
 #if defined(TARGET_LINUX)
 #include "utils/EGLUtils.h"
 #endif
 
 using namespace std::chrono_literals;
 
+namespace
+{
+bool IsEqual(const CMatrixGL& first, const CMatrixGL& second)
+{
+  return std::memcmp(static_cast<const float*>(first), static_cast<const float*>(second),
+                     16 * sizeof(float)) == 0;
+}
+} // unnamed namespace
+
+bool CRenderSystemGLES::GUIDrawState::operator==(const GUIDrawState& other) const
+{
+  return textures == other.textures && shader == other.shader && blending == other.blending &&
+         swapCoords == other.swapCoords && color == other.color && depth == other.depth &&
+         IsEqual(projection, other.projection) && IsEqual(modelView, other.modelView) &&
+         scissor == other.scissor;
+}
+
 CRenderSystemGLES::CRenderSystemGLES()
  : CRenderSystemBase()
 {
@@ -186,6 +208,8 @@ bool CRenderSystemGLES::BeginRender()
     InitialiseShaders();
   }
 
+  m_batchGUI = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiBatchRendering;
+  m_drawStatistics = {};
   return true;
 }
 
@@ -194,6 +218,7 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
   return true;
 }
 
@@ -202,6 +227,8 @@ void CRenderSystemGLES::InvalidateColorBuffer()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   // some platforms prefer a clear, instead of rendering over
   if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiGeometryClear)
     ClearBuffers(0);
@@ -219,6 +246,8 @@ bool CRenderSystemGLES::ClearBuffers(KODI::UTILS::COLOR::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
+
   float r = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color) / 255.0f;
   float g = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color) / 255.0f;
   float b = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color) / 255.0f;
@@ -265,6 +294,8 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -295,6 +326,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -319,6 +352,175 @@ void CRenderSystemGLES::ApplyStateBlock()
   glClear(GL_DEPTH_BUFFER_BIT);
 }
 
+void CRenderSystemGLES::FlushBatch()
+{
+  m_guiBatch.Flush(
+      [this](const std::vector<GUIVertex>& vertices, const std::vector<GUIQuadBatch::Draw>& draws)
+      { DrawGUIBatch(vertices, draws); });
+}
+
+void CRenderSystemGLES::SetGUIBatchState(GUIDrawState& state)
+{
+  state.projection = glMatrixProject.Get();
+  state.modelView = glMatrixModview.Get();
+  state.scissor = m_scissor;
+
+  // the coordinates of quads drawn with different matrices can't be checked for overlaps
+  if (!IsEqual(state.projection, m_batchProjection) || !IsEqual(state.modelView, m_batchModelView))
+  {
+    m_guiBatch.Barrier();
+    m_batchProjection = state.projection;
+    m_batchModelView = state.modelView;
+  }
+}
+
+void CRenderSystemGLES::DrawGUIQuads(const GUIDrawState& state,
+                                     const GUIVertex* vertices,
+                                     size_t quads)
+{
+  GUIDrawState batchState = state;
+  SetGUIBatchState(batchState);
+
+  m_guiBatch.Add(batchState, vertices, quads);
+  if (!m_batchGUI)
+    FlushBatch();
+}
+
+void CRenderSystemGLES::DrawGUICustom(const CRect& bounds, std::function<void()> draw)
+{
+  GUIDrawState batchState;
+  SetGUIBatchState(batchState);
+  batchState.draw = std::move(draw);
+
+  m_guiBatch.AddCustom(batchState, bounds);
+  if (!m_batchGUI)
+    FlushBatch();
+}
+
+void CRenderSystemGLES::DrawGUIBatch(const std::vector<GUIVertex>& vertices,
+                                     const std::vector<GUIQuadBatch::Draw>& draws)
+{
+  if (!m_bRenderCreated)
+    return;
+
+  if (m_batchIndices.empty())
+    m_batchIndices = GUIQuadBatch::GetIndices();
+
+  const GUIDrawState* previous = nullptr;
+  CGLESShader* shader = nullptr;
+  std::optional<CRect> scissor = m_scissor;
+  for (const auto& draw : draws)
+  {
+    const GUIDrawState& state = *draw.state;
+    if (!scissor || *scissor != state.scissor)
+    {
+      ApplyScissors(state.scissor);
+      scissor = state.scissor;
+    }
+
+    if (draw.quads == 0)
+    {
+      // the custom draw sets up its own state and may change the scissors
+      const CRect current = m_scissor;
+      state.draw();
+      m_scissor = current;
+      scissor.reset();
+      previous = nullptr;
+      continue;
+    }
+
+    if (!previous)
+      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+
+    if (!previous || previous->shader != state.shader ||
+        !IsEqual(previous->projection, state.projection) ||
+        !IsEqual(previous->modelView, state.modelView))
+    {
+      shader = m_pShader[state.shader].get();
+      if (!shader)
+      {
+        CLog::Log(LOGERROR, "Invalid GUI Shader selected - {}", state.shader);
+        previous = nullptr;
+        continue;
+      }
+
+      // the shader loads the matrices when it's enabled
+      glMatrixProject.Push();
+      glMatrixModview.Push();
+      glMatrixProject.Get() = state.projection;
+      glMatrixModview.Get() = state.modelView;
+      shader->Enable();
+      glMatrixProject.Pop();
+      glMatrixModview.Pop();
+      m_method = state.shader;
+    }
+
+    for (unsigned int unit = 0; unit < state.textures.size(); unit++)
+    {
+      if (state.textures[unit] && (!previous || previous->textures[unit] != state.textures[unit]))
+      {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, state.textures[unit]);
+      }
+    }
+
+    if (!previous || previous->blending != state.blending)
+    {
+      if (state.blending)
+        glEnable(GL_BLEND);
+      else
+        glDisable(GL_BLEND);
+    }
+
+    if (shader->GetUniColLoc() >= 0)
+    {
+      glUniform4f(shader->GetUniColLoc(), state.color[0] / 255.0f, state.color[1] / 255.0f,
+                  state.color[2] / 255.0f, state.color[3] / 255.0f);
+    }
+    glUniform1f(shader->GetDepthLoc(), state.depth);
+
+    const GLint posLoc = shader->GetPosLoc();
+    GLint tex0Loc = shader->GetCord0Loc();
+    GLint tex1Loc = shader->GetCord1Loc();
+    if (state.swapCoords)
+      std::swap(tex0Loc, tex1Loc);
+    const char* first = reinterpret_cast<const char*>(vertices.data() + draw.firstVertex);
+
+    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(GUIVertex),
+                          first + offsetof(GUIVertex, x));
+    glEnableVertexAttribArray(posLoc);
+    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                          first + offsetof(GUIVertex, u1));
+    glEnableVertexAttribArray(tex0Loc);
+    if (state.textures[1])
+    {
+      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                            first + offsetof(GUIVertex, u2));
+      glEnableVertexAttribArray(tex1Loc);
+    }
+
+    glDrawElements(GL_TRIANGLES, draw.quads * 6, GL_UNSIGNED_SHORT, m_batchIndices.data());
+    AddDrawCalls(1, draw.quads);
+
+    glDisableVertexAttribArray(posLoc);
+    glDisableVertexAttribArray(tex0Loc);
+    if (state.textures[1])
+      glDisableVertexAttribArray(tex1Loc);
+
+    previous = &state;
+  }
+
+  if (!scissor || *scissor != m_scissor)
+    ApplyScissors(m_scissor);
+
+  glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  if (previous && shader)
+    shader->Disable();
+  m_method = ShaderMethodGLES::SM_DEFAULT;
+}
+
 void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
 {
   if (!m_bRenderCreated)
@@ -372,8 +574,11 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
+  m_scissor = viewPort;
   m_viewPort[0] = viewPort.x1;
   m_viewPort[1] = m_height - viewPort.y1 - viewPort.Height();
   m_viewPort[2] = viewPort.Width();
@@ -406,6 +611,14 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  // the queued GUI quads keep the scissors they were queued with
+  m_scissor = rect;
+  ApplyScissors(rect);
+}
+
+void CRenderSystemGLES::ApplyScissors(const CRect& rect)
+{
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -420,6 +633,8 @@ void CRenderSystemGLES::ResetScissors()
 
 void CRenderSystemGLES::SetDepthCulling(DEPTH_CULLING culling)
 {
+  FlushBatch();
+
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -687,6 +902,10 @@ void CRenderSystemGLES::ReleaseShaders()
 
 void CRenderSystemGLES::EnableGUIShader(ShaderMethodGLES method)
 {
+  // text is queued with the GUI quads, see CGUIFontTTFGLES::LastEnd
+  if (method != ShaderMethodGLES::SM_FONTS && method != ShaderMethodGLES::SM_FONTS_SHADER_CLIP)
+    FlushBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
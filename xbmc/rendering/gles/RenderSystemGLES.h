@@ -9,11 +9,16 @@
 #pragma once
 
 #include "GLESShader.h"
+#include "guilib/GUIQuadBatch.h"
+#include "rendering/MatrixGL.h"
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 #include "utils/Map.h"
 
+#include <array>
+#include <functional>
 #include <map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -85,6 +90,29 @@ private:
 class CRenderSystemGLES : public CRenderSystemBase
 {
 public:
+  struct GUIVertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  struct GUIDrawState
+  {
+    std::array<GLuint, 2> textures{}; //!< the textures of unit 0 and 1, 0 if unused
+    ShaderMethodGLES shader = ShaderMethodGLES::SM_TEXTURE;
+    bool blending = true;
+    bool swapCoords = false; //!< the coordinates of the textures are swapped with their units
+    std::array<GLubyte, 4> color{};
+    float depth = 0.0f;
+    CMatrixGL projection{}; //!< set by DrawGUIQuads
+    CMatrixGL modelView{}; //!< set by DrawGUIQuads
+    CRect scissor; //!< set by DrawGUIQuads
+    std::function<void()> draw; //!< set by DrawGUICustom, not compared
+
+    bool operator==(const GUIDrawState& other) const;
+  };
+
   CRenderSystemGLES();
   ~CRenderSystemGLES() override = default;
 
@@ -115,6 +143,8 @@ public:
   void CaptureStateBlock() override;
   void ApplyStateBlock() override;
 
+  void FlushBatch() override;
+
   void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor = 0.0f) override;
 
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
@@ -144,11 +174,37 @@ public:
   GLint GUIShaderGetCoordStep();
   GLint GUIShaderGetDepth();
 
+  /*!
+   * \brief Queue textured quads, which are drawn with the quads of other textures on the next flush.
+   * Changing any state of the render system or enabling a shader other than the font shaders
+   * flushes the queue.
+   * \param state the state to draw the quads with, the matrices and scissors are taken from the
+   * render system
+   * \param vertices four vertices per quad
+   * \param quads the number of quads
+   */
+  void DrawGUIQuads(const GUIDrawState& state, const GUIVertex* vertices, size_t quads);
+
+  /*!
+   * \brief Queue a draw of the caller's own, e.g. of text, which is issued in order with the quads
+   * it overlaps on the next flush.
+   * \param bounds the area drawn to, in the coordinates of the GUI quads drawn with the current
+   * matrices
+   * \param draw sets up all the state it needs and draws, the scissors are restored afterwards
+   */
+  void DrawGUICustom(const CRect& bounds, std::function<void()> draw);
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
   void CalculateMaxTexturesize();
 
+  using GUIQuadBatch = CGUIQuadBatch<GUIDrawState, GUIVertex>;
+  void SetGUIBatchState(GUIDrawState& state);
+  void DrawGUIBatch(const std::vector<GUIVertex>& vertices,
+                    const std::vector<GUIQuadBatch::Draw>& draws);
+  void ApplyScissors(const CRect& rect);
+
   bool m_bVsyncInit{false};
   int m_width;
   int m_height;
@@ -159,4 +215,11 @@ protected:
   ShaderMethodGLES m_method = ShaderMethodGLES::SM_DEFAULT;
 
   GLint      m_viewPort[4];
+
+  GUIQuadBatch m_guiBatch;
+  bool m_batchGUI = true;
+  CMatrixGL m_batchProjection{};
+  CMatrixGL m_batchModelView{};
+  std::vector<GLushort> m_batchIndices;
+  CRect m_scissor;
 };
@@ -19,6 +19,7 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "threads/LockProfiler.h"
 #include "utils/FileUtils.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/StringUtils.h"
@@ -560,6 +561,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "defaultplayer", m_audioDefaultPlayer);
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_audioPlayCountMinimumPercent, 0.0f, 101.0f);
+    XMLUtils::GetUInt(pElement, "prefetchtracks", m_audioPrefetchTracks, 0, 8);
+    XMLUtils::GetUInt(pElement, "prefetchmemory", m_audioPrefetchMemory, 0, 1024);
 
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_musicUseTimeSeeking);
     XMLUtils::GetInt(pElement, "timeseekforward", m_musicTimeSeekForward, 0, 6000);
@@ -1230,6 +1233,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "anisotropicfiltering", m_guiAnisotropicFiltering);
     XMLUtils::GetBoolean(pElement, "fronttobackrendering", m_guiFrontToBackRendering);
     XMLUtils::GetBoolean(pElement, "geometryclear", m_guiGeometryClear);
+    XMLUtils::GetBoolean(pElement, "batchrendering", m_guiBatchRendering);
     XMLUtils::GetBoolean(pElement, "asynctextureupload", m_guiAsyncTextureUpload);
     XMLUtils::GetBoolean(pElement, "transparentvideolayout", m_guiVideoLayoutTransparent);
   }
@@ -1246,6 +1250,20 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
   XMLUtils::GetBoolean(pRootElement, "opengldebugging", m_openGlDebugging);
 
+  XMLUtils::GetBoolean(pRootElement, "lockprofiling", m_lockProfiling);
+  XbmcThreads::CLockProfiler::SetEnabled(m_lockProfiling);
+
+  XMLUtils::GetBoolean(pRootElement, "startuptrace", m_startupTrace);
+
+  pElement = pRootElement->FirstChildElement("asynclogging");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pRootElement, "asynclogging", m_asyncLogging);
+    const char* overflow = pElement->Attribute("overflow");
+    m_asyncLoggingBlock = overflow != nullptr && StringUtils::EqualsNoCase(overflow, "block");
+  }
+  CServiceBroker::GetLogging().SetAsyncLogging(m_asyncLogging, m_asyncLoggingBlock);
+
   // load in the settings overrides
   CServiceBroker::GetSettingsComponent()->GetSettings()->LoadHidden(pRootElement);
 }
@@ -122,6 +122,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     std::string m_audioDefaultPlayer;
     float m_audioPlayCountMinimumPercent;
+    unsigned int m_audioPrefetchTracks = 2; // upcoming tracks PAPlayer decodes ahead, 0 disables
+    unsigned int m_audioPrefetchMemory = 32; // memory budget of the decode-ahead in MB
     float m_limiterHold;
     float m_limiterRelease;
 
@@ -340,6 +342,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int32_t m_guiAnisotropicFiltering{0};
     bool m_guiFrontToBackRendering{false};
     bool m_guiGeometryClear{true};
+    bool m_guiBatchRendering{true};
     bool m_guiAsyncTextureUpload{false};
     bool m_guiVideoLayoutTransparent{false};
 
@@ -375,6 +378,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::string m_stereoscopicregex_tab;
 
     bool m_openGlDebugging;
+    bool m_lockProfiling{false};
+    bool m_startupTrace{false}; ///< write the startup timeline to the log folder
+    bool m_asyncLogging{false}; ///< write the log from a background thread
+    bool m_asyncLoggingBlock{false}; ///< block instead of dropping messages if the queue is full
 
     std::string m_userAgent;
     uint32_t m_nfsTimeout;
@@ -547,8 +547,9 @@ private:
   using SettingOptionsFillerMap = std::map<std::string, SettingOptionsFiller>;
   SettingOptionsFillerMap m_optionsFillers;
 
-  mutable CSharedSection m_critical;
-  mutable CSharedSection m_settingsCritical;
+  // read by every setting lookup, from many threads
+  mutable CSharedSection m_critical{CSharedSection::ReaderCounting::STRIPED};
+  mutable CSharedSection m_settingsCritical{CSharedSection::ReaderCounting::STRIPED};
 
   Logger m_logger;
 };
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+/*!
+ * Helpers for timing runs in the unit tests.
+ *
+ * Benchmarks are disabled gtest cases with Benchmark in their name, so they don't slow down the
+ * regular test run. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* and
+ * compare the reported lines between builds.
+ */
+namespace Benchmark
+{
+using Duration = std::chrono::duration<double>;
+
+/*!
+ * Get the wall time of a single call of func.
+ */
+template<typename F>
+inline Duration Time(F&& func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::steady_clock::now() - start;
+}
+
+/*!
+ * Call func the given number of times and get the average time of one call.
+ */
+template<typename F>
+inline Duration TimePerCall(unsigned int iterations, F&& func)
+{
+  const Duration total = Time(
+      [&]
+      {
+        for (unsigned int i = 0; i < iterations; ++i)
+          func();
+      });
+  return total / iterations;
+}
+
+/*!
+ * Call func(thread) on the given number of threads, started together, and get the wall time until
+ * the last one returned.
+ */
+template<typename F>
+inline Duration TimeThreads(unsigned int threads, F&& func)
+{
+  std::atomic<bool> go{false};
+  std::atomic<unsigned int> ready{0};
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (unsigned int i = 0; i < threads; ++i)
+  {
+    workers.emplace_back(
+        [&, i]
+        {
+          ready++;
+          while (!go)
+            std::this_thread::yield();
+          func(i);
+        });
+  }
+
+  while (ready < threads)
+    std::this_thread::yield();
+
+  const auto start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& worker : workers)
+    worker.join();
+  return std::chrono::steady_clock::now() - start;
+}
+
+/*!
+ * Print a result in the common format, e.g. "[ BENCHMARK] ClampArray 2ch x 1024: 0.42 ns/sample".
+ */
+inline void Report(const std::string& name, double value, const std::string& unit)
+{
+  std::cout << fmt::format("[ BENCHMARK] {}: {:.3f} {}\n", name, value, unit);
+}
+
+inline double Nanoseconds(Duration duration)
+{
+  return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+inline double Microseconds(Duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+inline double Milliseconds(Duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // namespace Benchmark
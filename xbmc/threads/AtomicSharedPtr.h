@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace XbmcThreads
+{
+
+/*!
+ * @brief A shared_ptr that can be loaded and stored concurrently. Meant for publishing
+ * immutable snapshots of data, which readers can use without holding the writer's lock.
+ */
+template<typename T>
+class CAtomicSharedPtr
+{
+public:
+  CAtomicSharedPtr() = default;
+  explicit CAtomicSharedPtr(std::shared_ptr<T> ptr) : m_ptr(std::move(ptr)) {}
+
+  CAtomicSharedPtr(const CAtomicSharedPtr&) = delete;
+  CAtomicSharedPtr& operator=(const CAtomicSharedPtr&) = delete;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::shared_ptr<T> Load() const { return m_ptr.load(std::memory_order_acquire); }
+  void Store(std::shared_ptr<T> ptr) { m_ptr.store(std::move(ptr), std::memory_order_release); }
+
+private:
+  std::atomic<std::shared_ptr<T>> m_ptr;
+#else
+  // the lock is only held for copying the pointer
+  std::shared_ptr<T> Load() const
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_ptr;
+  }
+
+  void Store(std::shared_ptr<T> ptr)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ptr.swap(ptr);
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::shared_ptr<T> m_ptr;
+#endif
+};
+
+} // namespace XbmcThreads
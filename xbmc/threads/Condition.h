@@ -37,7 +37,10 @@ namespace XbmcThreads
     {
       int count = lock.count;
       lock.count = 0;
+      const bool timed = lock.profile && lock.stopHold();
       cond.wait(lock.get_underlying(), std::move(predicate));
+      if (timed)
+        lock.startHold();
       lock.count = count;
     }
 
@@ -45,7 +48,10 @@ namespace XbmcThreads
     {
       int count  = lock.count;
       lock.count = 0;
+      const bool timed = lock.profile && lock.stopHold();
       cond.wait(lock.get_underlying());
+      if (timed)
+        lock.startHold();
       lock.count = count;
     }
 
@@ -56,7 +62,10 @@ namespace XbmcThreads
     {
       int count = lock.count;
       lock.count = 0;
+      const bool timed = lock.profile && lock.stopHold();
       bool ret = cond.wait_for(lock.get_underlying(), duration, predicate);
+      if (timed)
+        lock.startHold();
       lock.count = count;
       return ret;
     }
@@ -66,7 +75,10 @@ namespace XbmcThreads
     {
       int count  = lock.count;
       lock.count = 0;
+      const bool timed = lock.profile && lock.stopHold();
       std::cv_status res = cond.wait_for(lock.get_underlying(), duration);
+      if (timed)
+        lock.startHold();
       lock.count = count;
       return res == std::cv_status::no_timeout;
     }
@@ -15,6 +15,9 @@
 
 class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex>
 {
+public:
+  CCriticalSection() = default;
+  explicit CCriticalSection(const char* name) : CountingLockable(name) {}
 };
 
 #elif defined(TARGET_WINDOWS)
@@ -22,6 +25,9 @@ class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecu
 
 class CCriticalSection : public XbmcThreads::CountingLockable<std::recursive_mutex>
 {
+public:
+  CCriticalSection() = default;
+  explicit CCriticalSection(const char* name) : CountingLockable(name) {}
 };
 
 #endif
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LockProfiler.h"
+
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace XbmcThreads;
+
+namespace
+{
+struct ProfileRegistry
+{
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<CLockProfile>, std::less<>> profiles;
+};
+
+ProfileRegistry& GetRegistry()
+{
+  // never destroyed, static locks may still be unlocked after it would have been
+  static ProfileRegistry* registry = new ProfileRegistry;
+  return *registry;
+}
+
+void UpdateMax(std::atomic<int64_t>& max, int64_t value, const std::function<void()>& onNewMax)
+{
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current)
+  {
+    if (max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+      if (onNewMax)
+        onNewMax();
+      return;
+    }
+  }
+}
+
+std::string GetCurrentThreadName()
+{
+  const CThread* thread = CThread::GetCurrentThread();
+  if (thread)
+    return thread->GetName();
+
+  std::ostringstream name;
+  name << "thread " << std::this_thread::get_id();
+  return name.str();
+}
+
+double ToMilliseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // unnamed namespace
+
+void CLockProfile::AddWait(std::chrono::steady_clock::duration wait)
+{
+  const int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+  m_contentions.fetch_add(1, std::memory_order_relaxed);
+  m_waitTime.fetch_add(nanoseconds, std::memory_order_relaxed);
+  UpdateMax(m_maxWait, nanoseconds, {});
+}
+
+void CLockProfile::AddHold(std::chrono::steady_clock::duration hold)
+{
+  const int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(hold).count();
+  m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+  m_holdTime.fetch_add(nanoseconds, std::memory_order_relaxed);
+  UpdateMax(m_maxHold, nanoseconds,
+            [this]()
+            {
+              std::string holder = GetCurrentThreadName();
+              std::unique_lock<std::mutex> lock(m_holderMutex);
+              m_longestHolder = std::move(holder);
+            });
+}
+
+void CLockProfile::Reset()
+{
+  m_acquisitions = 0;
+  m_contentions = 0;
+  m_waitTime = 0;
+  m_maxWait = 0;
+  m_holdTime = 0;
+  m_maxHold = 0;
+
+  std::unique_lock<std::mutex> lock(m_holderMutex);
+  m_longestHolder.clear();
+}
+
+void CLockProfiler::SetEnabled(bool enabled)
+{
+  if (s_enabled.exchange(enabled) != enabled)
+    CLog::Log(LOGINFO, "Lock profiling {}", enabled ? "enabled" : "disabled");
+}
+
+CLockProfile* CLockProfiler::GetProfile(const std::string& name)
+{
+  ProfileRegistry& registry = GetRegistry();
+  std::unique_lock<std::mutex> lock(registry.mutex);
+  auto& profile = registry.profiles[name];
+  if (!profile)
+    profile = std::make_unique<CLockProfile>(name);
+  return profile.get();
+}
+
+std::vector<LockStatistics> CLockProfiler::GetStatistics(size_t count)
+{
+  std::vector<LockStatistics> statistics;
+  {
+    ProfileRegistry& registry = GetRegistry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+    statistics.reserve(registry.profiles.size());
+    for (const auto& [name, profile] : registry.profiles)
+    {
+      LockStatistics lockStatistics;
+      lockStatistics.name = name;
+      lockStatistics.acquisitions = profile->m_acquisitions;
+      lockStatistics.contentions = profile->m_contentions;
+      lockStatistics.waitTime = std::chrono::nanoseconds(profile->m_waitTime);
+      lockStatistics.maxWait = std::chrono::nanoseconds(profile->m_maxWait);
+      lockStatistics.holdTime = std::chrono::nanoseconds(profile->m_holdTime);
+      lockStatistics.maxHold = std::chrono::nanoseconds(profile->m_maxHold);
+      {
+        std::unique_lock<std::mutex> holderLock(profile->m_holderMutex);
+        lockStatistics.longestHolder = profile->m_longestHolder;
+      }
+
+      if (lockStatistics.acquisitions > 0 || lockStatistics.contentions > 0)
+        statistics.emplace_back(std::move(lockStatistics));
+    }
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const LockStatistics& a, const LockStatistics& b)
+            {
+              if (a.waitTime != b.waitTime)
+                return a.waitTime > b.waitTime;
+              return a.holdTime > b.holdTime;
+            });
+
+  if (count > 0 && statistics.size() > count)
+    statistics.resize(count);
+
+  return statistics;
+}
+
+void CLockProfiler::Reset()
+{
+  ProfileRegistry& registry = GetRegistry();
+  std::unique_lock<std::mutex> lock(registry.mutex);
+  for (const auto& [name, profile] : registry.profiles)
+    profile->Reset();
+}
+
+void CLockProfiler::LogReport(size_t count)
+{
+  const std::vector<LockStatistics> statistics = GetStatistics(count);
+  if (statistics.empty())
+    return;
+
+  CLog::Log(LOGINFO, "Lock contention, top {} locks by wait time:", statistics.size());
+  for (const auto& lock : statistics)
+  {
+    CLog::Log(LOGINFO,
+              "  {}: held {} times for {:.3f} ms (max {:.3f} ms by {}), waited {} times for {:.3f} "
+              "ms (max {:.3f} ms)",
+              lock.name, lock.acquisitions, ToMilliseconds(lock.holdTime),
+              ToMilliseconds(lock.maxHold), lock.longestHolder, lock.contentions,
+              ToMilliseconds(lock.waitTime), ToMilliseconds(lock.maxWait));
+  }
+}
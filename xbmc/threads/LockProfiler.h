@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace XbmcThreads
+{
+
+/**
+ * Wait and hold times of all locks created with the same name.
+ */
+class CLockProfile
+{
+public:
+  explicit CLockProfile(std::string name) : m_name(std::move(name)) {}
+
+  const std::string& GetName() const { return m_name; }
+
+  /**
+   * Account the time a thread waited to get the lock.
+   */
+  void AddWait(std::chrono::steady_clock::duration wait);
+
+  /**
+   * Account the time a thread held the lock (outermost lock to last unlock).
+   */
+  void AddHold(std::chrono::steady_clock::duration hold);
+
+private:
+  friend class CLockProfiler;
+
+  void Reset();
+
+  const std::string m_name;
+  std::atomic<uint64_t> m_acquisitions{0};
+  std::atomic<uint64_t> m_contentions{0};
+  std::atomic<int64_t> m_waitTime{0};
+  std::atomic<int64_t> m_maxWait{0};
+  std::atomic<int64_t> m_holdTime{0};
+  std::atomic<int64_t> m_maxHold{0};
+
+  std::mutex m_holderMutex;
+  std::string m_longestHolder;
+};
+
+/**
+ * Statistics of a named lock, as reported by CLockProfiler.
+ */
+struct LockStatistics
+{
+  std::string name;
+  uint64_t acquisitions = 0; ///< number of times the lock was held
+  uint64_t contentions = 0; ///< number of times a thread had to wait for the lock
+  std::chrono::nanoseconds waitTime{}; ///< total time threads waited for the lock
+  std::chrono::nanoseconds maxWait{}; ///< longest time a thread waited for the lock
+  std::chrono::nanoseconds holdTime{}; ///< total time the lock was held
+  std::chrono::nanoseconds maxHold{}; ///< longest time the lock was held
+  std::string longestHolder; ///< the thread which held the lock the longest
+};
+
+/**
+ * Opt-in contention profiler for named locks.
+ *
+ * Locks are named when they are created, e.g. CCriticalSection m_critSection{"PVRTimers"}, all
+ * locks sharing a name are accounted together. Unnamed locks are never profiled. While the
+ * profiler is disabled a named lock costs one relaxed atomic load per lock and unlock.
+ */
+class CLockProfiler
+{
+public:
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Get the profile of the locks with the given name. Profiles are kept for the lifetime of the
+   * process.
+   */
+  static CLockProfile* GetProfile(const std::string& name);
+
+  /**
+   * Get the statistics of the locks threads waited for the longest.
+   * \param count the maximum number of locks to return, 0 for all
+   */
+  static std::vector<LockStatistics> GetStatistics(size_t count);
+
+  static void Reset();
+
+  /**
+   * Log the statistics of the locks threads waited for the longest, if any were recorded.
+   */
+  static void LogReport(size_t count);
+
+private:
+  static inline std::atomic<bool> s_enabled{false};
+};
+
+}
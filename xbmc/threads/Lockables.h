@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include "threads/LockProfiler.h"
+
+#include <chrono>
+
 namespace XbmcThreads
 {
 
@@ -32,6 +36,9 @@ namespace XbmcThreads
    * undo it, and then restore that (See class CSingleExit).
    *
    * All xbmc code expects Lockables to be recursive.
+   *
+   * Lockables created with a name record their contention while the
+   * CLockProfiler is enabled.
    */
   template<class L> class CountingLockable
   {
@@ -42,14 +49,38 @@ namespace XbmcThreads
   protected:
     L mutex;
     unsigned int count = 0;
+    CLockProfile* profile = nullptr;
+    std::chrono::steady_clock::time_point acquired; // set while the outermost lock is timed
 
   public:
     inline CountingLockable() = default;
+    inline explicit CountingLockable(const char* name) : profile(CLockProfiler::GetProfile(name))
+    {
+    }
 
     // STL Lockable concept
-    inline void lock() { mutex.lock(); count++; }
-    inline bool try_lock() { return mutex.try_lock() ? count++, true : false; }
-    inline void unlock() { count--; mutex.unlock(); }
+    inline void lock()
+    {
+      if (profile && CLockProfiler::IsEnabled())
+        return profiledLock();
+      mutex.lock();
+      count++;
+    }
+    inline bool try_lock()
+    {
+      if (!mutex.try_lock())
+        return false;
+      if (count++ == 0 && profile && CLockProfiler::IsEnabled())
+        startHold();
+      return true;
+    }
+    inline void unlock()
+    {
+      if (count == 1 && profile)
+        stopHold();
+      count--;
+      mutex.unlock();
+    }
 
     /*!
      * \brief Check if have a lock owned
@@ -102,6 +133,38 @@ namespace XbmcThreads
      *  to call this method.
      */
     inline L& get_underlying() { return mutex; }
+
+    /**
+     * The profile contention of this lock is recorded in, nullptr if it is
+     * not named.
+     */
+    inline CLockProfile* GetProfile() const { return profile; }
+
+  private:
+    void profiledLock()
+    {
+      if (!mutex.try_lock())
+      {
+        const auto start = std::chrono::steady_clock::now();
+        mutex.lock();
+        profile->AddWait(std::chrono::steady_clock::now() - start);
+      }
+      if (count++ == 0)
+        startHold();
+    }
+
+    inline void startHold() { acquired = std::chrono::steady_clock::now(); }
+
+    // returns whether the hold was timed
+    inline bool stopHold()
+    {
+      if (acquired == std::chrono::steady_clock::time_point())
+        return false;
+
+      profile->AddHold(std::chrono::steady_clock::now() - acquired);
+      acquired = {};
+      return true;
+    }
   };
 
 }
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SharedSection.h"
+
+#include "threads/LockProfiler.h"
+
+#include <array>
+#include <cassert>
+#include <vector>
+
+using XbmcThreads::CLockProfiler;
+
+namespace
+{
+struct HeldSection
+{
+  const CSharedSection* section = nullptr;
+  unsigned int count = 0;
+};
+
+// the shared locks held by the current thread. A thread holds only a few of them at once, so a
+// small array does without allocating and is quick to search. Threads holding more spill over
+// into a list.
+constexpr size_t MAX_HELD_SECTIONS = 16;
+thread_local std::array<HeldSection, MAX_HELD_SECTIONS> heldSections;
+thread_local std::vector<HeldSection> heldSectionsOverflow;
+
+HeldSection* FindHeldSection(const CSharedSection* section)
+{
+  for (auto& held : heldSections)
+  {
+    if (held.section == section)
+      return &held;
+  }
+  for (auto& held : heldSectionsOverflow)
+  {
+    if (held.section == section)
+      return &held;
+  }
+  return nullptr;
+}
+} // unnamed namespace
+
+CSharedSection::CSharedSection(ReaderCounting counting)
+{
+  if (counting == ReaderCounting::STRIPED)
+    m_stripes = std::make_unique<std::array<Stripe, STRIPES>>();
+}
+
+CSharedSection::CSharedSection(const char* name, ReaderCounting counting)
+  : CSharedSection(counting)
+{
+  m_profile = CLockProfiler::GetProfile(name);
+}
+
+void CSharedSection::lock()
+{
+  if (IsOwner())
+  {
+    m_recursion++;
+    return;
+  }
+
+  const bool profile = m_profile && CLockProfiler::IsEnabled();
+  const auto start =
+      profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  bool waited = false;
+
+  // announce the writer first, so that no new readers get in
+  m_writers.fetch_add(1);
+  if (!m_writerMutex.try_lock())
+  {
+    waited = true;
+    m_writerMutex.lock();
+  }
+
+  if (HasReaders())
+  {
+    waited = true;
+    std::unique_lock<CCriticalSection> lock(m_waitSection);
+    m_waitCondition.wait(lock, [this]() { return !HasReaders(); });
+  }
+
+  m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  m_recursion = 1;
+
+  if (profile)
+  {
+    m_acquired = std::chrono::steady_clock::now();
+    if (waited)
+      m_profile->AddWait(m_acquired - start);
+  }
+}
+
+bool CSharedSection::try_lock()
+{
+  if (IsOwner())
+  {
+    m_recursion++;
+    return true;
+  }
+
+  if (!m_writerMutex.try_lock())
+    return false;
+
+  m_writers.fetch_add(1);
+  if (HasReaders())
+  {
+    m_writerMutex.unlock();
+    if (m_writers.fetch_sub(1) == 1)
+      NotifyWaiters();
+    return false;
+  }
+
+  m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  m_recursion = 1;
+
+  if (m_profile && CLockProfiler::IsEnabled())
+    m_acquired = std::chrono::steady_clock::now();
+
+  return true;
+}
+
+void CSharedSection::unlock()
+{
+  if (--m_recursion > 0)
+    return;
+
+  if (m_acquired != std::chrono::steady_clock::time_point())
+  {
+    m_profile->AddHold(std::chrono::steady_clock::now() - m_acquired);
+    m_acquired = {};
+  }
+
+  m_owner.store(std::thread::id(), std::memory_order_relaxed);
+  m_writerMutex.unlock();
+
+  // the last writer lets the waiting readers in
+  if (m_writers.fetch_sub(1) == 1)
+    NotifyWaiters();
+}
+
+void CSharedSection::lock_shared()
+{
+  std::atomic<unsigned int>& readers = GetReaders();
+  readers.fetch_add(1);
+
+  // the owner and threads already reading must not wait for a writer which waits for them
+  if (m_writers.load() > 0 && !IsOwner() && !IsReader())
+  {
+    const auto start = std::chrono::steady_clock::now();
+    do
+    {
+      readers.fetch_sub(1);
+      NotifyWaiters();
+      {
+        std::unique_lock<CCriticalSection> lock(m_waitSection);
+        m_waitCondition.wait(lock, [this]() { return m_writers.load() == 0; });
+      }
+      readers.fetch_add(1);
+    } while (m_writers.load() > 0);
+
+    if (m_profile && CLockProfiler::IsEnabled())
+      m_profile->AddWait(std::chrono::steady_clock::now() - start);
+  }
+
+  AddReader();
+}
+
+bool CSharedSection::try_lock_shared()
+{
+  std::atomic<unsigned int>& readers = GetReaders();
+  readers.fetch_add(1);
+
+  if (m_writers.load() > 0 && !IsOwner() && !IsReader())
+  {
+    readers.fetch_sub(1);
+    NotifyWaiters();
+    return false;
+  }
+
+  AddReader();
+  return true;
+}
+
+void CSharedSection::unlock_shared()
+{
+  RemoveReader();
+  GetReaders().fetch_sub(1);
+
+  if (m_writers.load() > 0)
+    NotifyWaiters();
+}
+
+std::atomic<unsigned int>& CSharedSection::GetReaders()
+{
+  if (!m_stripes)
+    return m_readers;
+
+  static std::atomic<size_t> threads{0};
+  thread_local const size_t stripe = threads.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+  return (*m_stripes)[stripe].readers;
+}
+
+bool CSharedSection::HasReaders() const
+{
+  unsigned int readers = m_readers.load();
+  if (m_stripes)
+  {
+    for (const auto& stripe : *m_stripes)
+      readers += stripe.readers.load();
+  }
+  return readers != 0;
+}
+
+bool CSharedSection::IsOwner() const
+{
+  return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+bool CSharedSection::IsReader() const
+{
+  return FindHeldSection(this) != nullptr;
+}
+
+void CSharedSection::AddReader()
+{
+  HeldSection* held = FindHeldSection(this);
+  if (!held)
+    held = FindHeldSection(nullptr);
+  if (!held)
+    held = &heldSectionsOverflow.emplace_back();
+
+  held->section = this;
+  held->count++;
+}
+
+void CSharedSection::RemoveReader()
+{
+  // a shared lock released on another thread than the one that took it is not found
+  HeldSection* held = FindHeldSection(this);
+  assert(held);
+  if (held && --held->count == 0)
+    held->section = nullptr;
+}
+
+void CSharedSection::NotifyWaiters()
+{
+  std::unique_lock<CCriticalSection> lock(m_waitSection);
+  m_waitCondition.notifyAll();
+}
@@ -10,45 +10,94 @@
 
 #include "threads/Condition.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
+
+namespace XbmcThreads
+{
+class CLockProfile;
+}
 
 /**
  * A CSharedSection is a mutex that satisfies the Shared Lockable concept (see Lockables.h).
+ *
+ * Readers only touch an atomic counter and take no mutex unless a writer is active. Writers are
+ * preferred: once a writer waits for the lock, new readers wait for it to finish. Threads already
+ * holding a shared lock may take it again without waiting, so recursive reads can't deadlock with
+ * a waiting writer.
+ *
+ * The few sections that many threads read all the time, like the one of the settings manager, can
+ * spread the counter over stripes, each on a cache line of its own, so that readers on different
+ * threads don't share a cache line. The stripes take 256 bytes, so sections embedded in many
+ * objects, like the one of each setting, keep a single counter.
+ *
+ * The exclusive lock is recursive and its owner may take shared locks, taking the exclusive lock
+ * while holding a shared one deadlocks.
+ *
+ * A shared lock must be released on the thread that took it, as each thread keeps track of the
+ * shared locks it holds.
  */
 class CSharedSection
 {
-  CCriticalSection sec;
-  XbmcThreads::ConditionVariable actualCv;
+public:
+  /**
+   * How readers are counted.
+   */
+  enum class ReaderCounting
+  {
+    SINGLE, ///< a single counter
+    STRIPED, ///< a counter per stripe of threads, for sections read by many threads at once
+  };
 
-  unsigned int sharedCount = 0;
+  CSharedSection() = default;
+  explicit CSharedSection(ReaderCounting counting);
+  explicit CSharedSection(const char* name, ReaderCounting counting = ReaderCounting::SINGLE);
 
-public:
-  inline CSharedSection() = default;
+  void lock();
+  bool try_lock();
+  void unlock();
 
-  inline void lock()
-  {
-    std::unique_lock<CCriticalSection> l(sec);
-    while (sharedCount)
-      actualCv.wait(l, [this]() { return sharedCount == 0; });
-    sec.lock();
-  }
-  inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? true : (sec.unlock(), false)) : false); }
-  inline void unlock() { sec.unlock(); }
-
-  inline void lock_shared()
-  {
-    std::unique_lock<CCriticalSection> l(sec);
-    sharedCount++;
-  }
-  inline bool try_lock_shared() { return (sec.try_lock() ? sharedCount++, sec.unlock(), true : false); }
-  inline void unlock_shared()
+  void lock_shared();
+  bool try_lock_shared();
+  void unlock_shared();
+
+private:
+  CSharedSection(const CSharedSection&) = delete;
+  CSharedSection& operator=(const CSharedSection&) = delete;
+
+  static constexpr size_t STRIPES = 4;
+
+  struct alignas(64) Stripe
   {
-    std::unique_lock<CCriticalSection> l(sec);
-    sharedCount--;
-    if (!sharedCount)
-    {
-      actualCv.notifyAll();
-    }
-  }
+    std::atomic<unsigned int> readers{0};
+  };
+
+  std::atomic<unsigned int>& GetReaders();
+  bool HasReaders() const;
+  bool IsOwner() const;
+  bool IsReader() const;
+  void AddReader();
+  void RemoveReader();
+  void NotifyWaiters();
+
+  std::atomic<unsigned int> m_readers{0}; ///< the readers, unless they are striped
+  std::unique_ptr<std::array<Stripe, STRIPES>> m_stripes;
+
+  std::atomic<unsigned int> m_writers{0}; ///< writers holding or waiting for the lock
+  std::mutex m_writerMutex;
+  std::atomic<std::thread::id> m_owner;
+  unsigned int m_recursion = 0;
+
+  // only used if a reader or writer has to wait
+  CCriticalSection m_waitSection;
+  XbmcThreads::ConditionVariable m_waitCondition;
+
+  XbmcThreads::CLockProfile* m_profile = nullptr;
+  std::chrono::steady_clock::time_point m_acquired;
 };
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TaskGraph.h"
+
+#include "threads/IRunnable.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/StartupTrace.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+class CTaskGraph::CWorker : public IRunnable
+{
+public:
+  explicit CWorker(CTaskGraph& graph) : m_graph(graph) {}
+
+  void Run() override { m_graph.Work(false); }
+
+private:
+  CTaskGraph& m_graph;
+};
+
+CTaskGraph::CTaskGraph(std::string name) : m_name(std::move(name))
+{
+}
+
+bool CTaskGraph::AddTask(const std::string& name,
+                         Task task,
+                         const std::vector<std::string>& dependencies,
+                         TaskThread thread)
+{
+  std::vector<size_t> dependencyIndices;
+  for (const auto& dependency : dependencies)
+  {
+    auto it = std::find_if(m_nodes.begin(), m_nodes.end(),
+                           [&dependency](const Node& node) { return node.name == dependency; });
+    if (it == m_nodes.end())
+    {
+      CLog::Log(LOGERROR, "CTaskGraph[{}]: task {} depends on unknown task {}", m_name, name,
+                dependency);
+      return false;
+    }
+    dependencyIndices.push_back(it - m_nodes.begin());
+  }
+
+  const size_t index = m_nodes.size();
+  for (size_t dependency : dependencyIndices)
+    m_nodes[dependency].dependents.push_back(index);
+
+  Node node;
+  node.name = name;
+  node.task = std::move(task);
+  node.pendingDependencies = static_cast<unsigned int>(dependencyIndices.size());
+  node.thread = thread;
+  m_nodes.emplace_back(std::move(node));
+  return true;
+}
+
+bool CTaskGraph::Run(unsigned int maxThreads)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_ready.clear();
+    m_readyForCaller.clear();
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+      if (m_nodes[i].pendingDependencies == 0)
+        SetReady(i);
+    }
+    m_remaining = m_nodes.size();
+    m_failed = false;
+  }
+
+  if (maxThreads == 0)
+    maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // the calling thread works as well
+  const size_t threadCount = std::min<size_t>(maxThreads, m_nodes.size());
+  CWorker worker(*this);
+  std::vector<std::unique_ptr<CThread>> threads;
+  for (size_t i = 1; i < threadCount; i++)
+  {
+    threads.emplace_back(std::make_unique<CThread>(&worker, m_name.c_str()));
+    threads.back()->Create();
+  }
+
+  Work(true);
+
+  for (auto& thread : threads)
+    thread->StopThread(true);
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return !m_failed;
+}
+
+void CTaskGraph::SetReady(size_t index)
+{
+  if (m_nodes[index].thread == TaskThread::CALLER)
+    m_readyForCaller.push_back(index);
+  else
+    m_ready.push_back(index);
+}
+
+void CTaskGraph::Work(bool callingThread)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  while (m_remaining > 0)
+  {
+    // the calling thread prefers the tasks only it can run
+    std::deque<size_t>* ready = nullptr;
+    if (callingThread && !m_readyForCaller.empty())
+      ready = &m_readyForCaller;
+    else if (!m_ready.empty())
+      ready = &m_ready;
+
+    if (!ready)
+    {
+      m_condition.wait(lock);
+      continue;
+    }
+
+    Node& node = m_nodes[ready->front()];
+    ready->pop_front();
+
+    bool success = false;
+    if (node.skipped)
+    {
+      CLog::Log(LOGERROR, "CTaskGraph[{}]: skipping {}, a task it depends on failed", m_name,
+                node.name);
+    }
+    else
+    {
+      CSingleExit exit(m_section);
+      success = RunTask(node);
+    }
+
+    if (!success)
+      m_failed = true;
+
+    for (size_t dependent : node.dependents)
+    {
+      Node& dependentNode = m_nodes[dependent];
+      if (!success)
+        dependentNode.skipped = true;
+      if (--dependentNode.pendingDependencies == 0)
+        SetReady(dependent);
+    }
+
+    m_remaining--;
+    m_condition.notifyAll();
+  }
+}
+
+bool CTaskGraph::RunTask(Node& node)
+{
+  CStartupTrace::CScope trace(node.name);
+  try
+  {
+    if (node.task())
+      return true;
+
+    CLog::Log(LOGERROR, "CTaskGraph[{}]: {} failed", m_name, node.name);
+  }
+  catch (const std::exception& e)
+  {
+    CLog::Log(LOGERROR, "CTaskGraph[{}]: {} failed with exception: {}", m_name, node.name,
+              e.what());
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "CTaskGraph[{}]: {} failed with an unknown exception", m_name, node.name);
+  }
+  return false;
+}
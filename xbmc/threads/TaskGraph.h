@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Runs tasks concurrently, each one once the tasks it depends on succeeded.
+ *
+ * Meant for initialization steps which are independent of each other but have to run before
+ * something else can start, e.g. the database upgrades. Every task is recorded in the startup
+ * timeline.
+ */
+class CTaskGraph
+{
+public:
+  using Task = std::function<bool()>;
+
+  /*!
+   * \brief The thread a task runs on.
+   */
+  enum class TaskThread
+  {
+    ANY, //!< any thread of the graph
+    CALLER, //!< the thread calling Run(), e.g. for tasks registering with its run loop
+  };
+
+  /*!
+   * \param name the name of the worker threads
+   */
+  explicit CTaskGraph(std::string name);
+
+  /*!
+   * \brief Add a task.
+   * \param name the name of the task, as it is logged and traced
+   * \param task the task, returning whether it succeeded
+   * \param dependencies the names of the tasks which have to succeed before this one can run, they
+   *        have to be added before
+   * \param thread the thread the task has to run on
+   * \return false if a dependency is unknown, the task isn't added then
+   */
+  bool AddTask(const std::string& name,
+               Task task,
+               const std::vector<std::string>& dependencies = {},
+               TaskThread thread = TaskThread::ANY);
+
+  /*!
+   * \brief Run all tasks and wait for them to finish, only once. Tasks depending on a failed task
+   *        are skipped.
+   * \param maxThreads the maximum number of threads to use including the calling thread, 0 for the
+   *        number of CPU cores
+   * \return true if all tasks succeeded
+   */
+  bool Run(unsigned int maxThreads = 0);
+
+private:
+  CTaskGraph(const CTaskGraph&) = delete;
+  CTaskGraph& operator=(const CTaskGraph&) = delete;
+
+  struct Node
+  {
+    std::string name;
+    Task task;
+    std::vector<size_t> dependents;
+    unsigned int pendingDependencies = 0;
+    TaskThread thread = TaskThread::ANY;
+    bool skipped = false;
+  };
+
+  class CWorker;
+
+  void Work(bool callingThread);
+  void SetReady(size_t index);
+  bool RunTask(Node& node);
+
+  const std::string m_name;
+  std::vector<Node> m_nodes;
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_condition;
+  std::deque<size_t> m_ready;
+  std::deque<size_t> m_readyForCaller; //!< ready tasks which have to run on the calling thread
+  size_t m_remaining = 0;
+  bool m_failed = false;
+};
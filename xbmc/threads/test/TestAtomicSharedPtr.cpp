@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/AtomicSharedPtr.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XbmcThreads;
+
+namespace
+{
+struct Snapshot
+{
+  std::vector<int> values;
+  unsigned int version = 0;
+};
+} // unnamed namespace
+
+TEST(TestAtomicSharedPtr, LoadStore)
+{
+  CAtomicSharedPtr<const Snapshot> ptr;
+  EXPECT_EQ(nullptr, ptr.Load());
+
+  const auto first = std::make_shared<const Snapshot>(Snapshot{{1, 2, 3}, 1});
+  ptr.Store(first);
+  EXPECT_EQ(first, ptr.Load());
+
+  // readers keep their snapshot alive, even if a new one was published meanwhile
+  const auto held = ptr.Load();
+  ptr.Store(std::make_shared<const Snapshot>(Snapshot{{4}, 2}));
+  EXPECT_EQ(3u, held->values.size());
+  EXPECT_EQ(2u, ptr.Load()->version);
+}
+
+TEST(TestAtomicSharedPtr, ConcurrentReaders)
+{
+  static constexpr unsigned int VERSIONS = 1000;
+
+  CAtomicSharedPtr<const Snapshot> ptr(std::make_shared<const Snapshot>(Snapshot{{0}, 0}));
+  std::atomic<bool> failed{false};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+  {
+    readers.emplace_back(
+        [&ptr, &failed]()
+        {
+          unsigned int lastVersion = 0;
+          while (lastVersion < VERSIONS)
+          {
+            const auto snapshot = ptr.Load();
+            // versions are published in order and each snapshot is consistent
+            if (snapshot->version < lastVersion || snapshot->values.size() != 1 ||
+                snapshot->values[0] != static_cast<int>(snapshot->version))
+              failed = true;
+            lastVersion = snapshot->version;
+          }
+        });
+  }
+
+  for (unsigned int version = 1; version <= VERSIONS; ++version)
+    ptr.Store(std::make_shared<const Snapshot>(Snapshot{{static_cast<int>(version)}, version}));
+
+  for (auto& reader : readers)
+    reader.join();
+
+  EXPECT_FALSE(failed);
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/IRunnable.h"
+#include "threads/LockProfiler.h"
+#include "threads/SharedSection.h"
+#include "threads/test/TestHelpers.h"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std::chrono_literals;
+using XbmcThreads::CLockProfiler;
+using XbmcThreads::LockStatistics;
+
+namespace
+{
+class TestLockProfiler : public testing::Test
+{
+protected:
+  TestLockProfiler()
+  {
+    CLockProfiler::Reset();
+    CLockProfiler::SetEnabled(true);
+  }
+  ~TestLockProfiler() override { CLockProfiler::SetEnabled(false); }
+
+  static LockStatistics Get(const std::string& name)
+  {
+    const std::vector<LockStatistics> statistics = CLockProfiler::GetStatistics(0);
+    auto it = std::find_if(statistics.begin(), statistics.end(),
+                           [&name](const LockStatistics& lock) { return lock.name == name; });
+    return it != statistics.end() ? *it : LockStatistics{};
+  }
+};
+
+class Holder : public IRunnable
+{
+public:
+  Holder(CCriticalSection& sec, CEvent& locked) : m_sec(sec), m_locked(locked) {}
+
+  void Run() override
+  {
+    std::unique_lock<CCriticalSection> lock(m_sec);
+    m_locked.Set();
+    std::this_thread::sleep_for(50ms);
+  }
+
+private:
+  CCriticalSection& m_sec;
+  CEvent& m_locked;
+};
+} // unnamed namespace
+
+TEST_F(TestLockProfiler, Contention)
+{
+  CCriticalSection sec{"TestLockProfiler.Contention"};
+  CEvent locked;
+  Holder holder(sec, locked);
+
+  thread holderThread(holder);
+  ASSERT_TRUE(locked.Wait(10000ms));
+  {
+    // blocks until the holder released the lock
+    std::unique_lock<CCriticalSection> lock(sec);
+    std::unique_lock<CCriticalSection> recursive(sec);
+  }
+  holderThread.join();
+
+  const LockStatistics statistics = Get("TestLockProfiler.Contention");
+  EXPECT_EQ(2u, statistics.acquisitions);
+  EXPECT_EQ(1u, statistics.contentions);
+  EXPECT_GE(statistics.waitTime, 10ms);
+  EXPECT_GE(statistics.maxHold, 40ms);
+  EXPECT_EQ("DumbThread", statistics.longestHolder);
+
+  CLockProfiler::Reset();
+  EXPECT_EQ(0u, Get("TestLockProfiler.Contention").acquisitions);
+}
+
+TEST_F(TestLockProfiler, ConditionWaitIsNotHeld)
+{
+  CCriticalSection sec{"TestLockProfiler.Condition"};
+  XbmcThreads::ConditionVariable cv;
+  {
+    std::unique_lock<CCriticalSection> lock(sec);
+    cv.wait(lock, 50ms);
+  }
+
+  const LockStatistics statistics = Get("TestLockProfiler.Condition");
+  EXPECT_EQ(2u, statistics.acquisitions);
+  EXPECT_LT(statistics.holdTime, 40ms);
+}
+
+TEST_F(TestLockProfiler, SharedSection)
+{
+  CSharedSection sec{"TestLockProfiler.Shared"};
+  {
+    std::shared_lock<CSharedSection> reader(sec);
+  }
+  {
+    std::unique_lock<CSharedSection> writer(sec);
+  }
+
+  // only exclusive locks are held from the profiler's point of view
+  const LockStatistics statistics = Get("TestLockProfiler.Shared");
+  EXPECT_EQ(1u, statistics.acquisitions);
+  EXPECT_EQ(0u, statistics.contentions);
+}
+
+TEST_F(TestLockProfiler, Disabled)
+{
+  CLockProfiler::SetEnabled(false);
+  CCriticalSection sec{"TestLockProfiler.Disabled"};
+  {
+    std::unique_lock<CCriticalSection> lock(sec);
+  }
+
+  EXPECT_EQ(0u, Get("TestLockProfiler.Disabled").acquisitions);
+}
@@ -6,14 +6,22 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "test/Benchmark.h"
 #include "threads/Event.h"
 #include "threads/IRunnable.h"
 #include "threads/SharedSection.h"
 #include "threads/test/TestHelpers.h"
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <stdio.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
 
 using namespace std::chrono_literals;
 
@@ -66,7 +74,7 @@ TEST(TestSharedSection, General)
   std::shared_lock<CSharedSection> l2(sec);
 }
 
-TEST(TestSharedSection, GetSharedLockWhileTryingExclusiveLock)
+TEST(TestSharedSection, SharedLockWaitsForWaitingWriter)
 {
   std::atomic<long> mutex(0L);
   CEvent event;
@@ -84,18 +92,17 @@ TEST(TestSharedSection, GetSharedLockWhileTryingExclusiveLock)
   EXPECT_TRUE(!l2.haslock);  // this thread is waiting ...
   EXPECT_TRUE(!l2.obtainedlock);  // this thread is waiting ...
 
-  // now try and get a SharedLock
+  // now try and get a SharedLock, writers are preferred so it has to wait
   locker<std::shared_lock<CSharedSection>> l3(sec, &mutex, &event);
   thread waitThread3(l3); // try to get a shared lock
   EXPECT_TRUE(waitForThread(mutex, 2, 10000ms));
   std::this_thread::sleep_for(10ms);
-  EXPECT_TRUE(l3.haslock);
+  EXPECT_TRUE(!l3.obtainedlock);
 
-  event.Set();
-  EXPECT_TRUE(waitThread3.timed_join(10000ms));
-
-  // l3 should have released.
-  EXPECT_TRUE(!l3.haslock);
+  // a thread already holding a shared lock may take it again
+  {
+    std::shared_lock<CSharedSection> l4(sec);
+  }
 
   // but the exclusive lock should still not have happened
   EXPECT_TRUE(!l2.haslock);  // this thread is waiting ...
@@ -108,6 +115,81 @@ TEST(TestSharedSection, GetSharedLockWhileTryingExclusiveLock)
 
   EXPECT_TRUE(l2.obtainedlock);  // the exclusive lock was captured
   EXPECT_TRUE(!l2.haslock);  // ... but it doesn't have it anymore
+
+  // now the shared lock is given
+  EXPECT_TRUE(waitForWaiters(event, 1, 10000ms));
+  EXPECT_TRUE(l3.haslock);
+
+  event.Set();
+  EXPECT_TRUE(waitThread3.timed_join(10000ms));
+
+  // l3 should have released.
+  EXPECT_TRUE(!l3.haslock);
+}
+
+TEST(TestSharedSection, TryLock)
+{
+  CSharedSection sec;
+
+  {
+    std::shared_lock<CSharedSection> l1(sec);
+    EXPECT_TRUE(sec.try_lock_shared());
+    sec.unlock_shared();
+    EXPECT_FALSE(sec.try_lock()); // readers are in
+  }
+
+  std::unique_lock<CSharedSection> l2(sec);
+  EXPECT_TRUE(sec.try_lock()); // recursive
+  sec.unlock();
+  EXPECT_TRUE(sec.try_lock_shared()); // the owner may read
+  sec.unlock_shared();
+}
+
+TEST(TestSharedSection, ManyHeldSections)
+{
+  // more sections than a thread tracks without allocating
+  constexpr int SECTIONS = 40;
+  std::vector<std::unique_ptr<CSharedSection>> sections;
+  std::vector<std::shared_lock<CSharedSection>> locks;
+  for (int i = 0; i < SECTIONS; i++)
+  {
+    sections.emplace_back(std::make_unique<CSharedSection>());
+    locks.emplace_back(*sections.back());
+  }
+
+  // a waiting writer must not keep this thread from reading a section it already reads
+  std::atomic<long> mutex(0L);
+  locker<std::unique_lock<CSharedSection>> writer(*sections.back(), &mutex);
+  thread writerThread(writer);
+  EXPECT_TRUE(waitForThread(mutex, 1, 10000ms));
+  std::this_thread::sleep_for(10ms);
+
+  EXPECT_TRUE(sections.back()->try_lock_shared());
+  sections.back()->unlock_shared();
+  EXPECT_FALSE(writer.obtainedlock);
+
+  locks.clear();
+  EXPECT_TRUE(writerThread.timed_join(10000ms));
+  EXPECT_TRUE(writer.obtainedlock);
+}
+
+TEST(TestSharedSection, Striped)
+{
+  CSharedSection sec(CSharedSection::ReaderCounting::STRIPED);
+
+  std::atomic<long> mutex(0L);
+  CEvent event;
+  locker<std::shared_lock<CSharedSection>> reader(sec, &mutex, &event);
+  thread readerThread(reader);
+  EXPECT_TRUE(waitForWaiters(event, 1, 10000ms));
+  EXPECT_TRUE(reader.haslock);
+
+  // readers on any stripe keep writers out
+  EXPECT_FALSE(sec.try_lock());
+  event.Set();
+  EXPECT_TRUE(readerThread.timed_join(10000ms));
+  EXPECT_TRUE(sec.try_lock());
+  sec.unlock();
 }
 
 TEST(TestSharedSection, TwoCase)
@@ -213,3 +295,35 @@ TEST(TestMultipleSharedSection, General)
   }
 }
 
+// Shared lock throughput with increasing numbers of readers, compared to std::shared_mutex
+TEST(TestSharedSection, DISABLED_ReaderScalingBenchmark)
+{
+  constexpr int LOCKS = 1000000;
+
+  const auto measure = [](auto& section, unsigned int threads)
+  {
+    const auto elapsed = Benchmark::TimeThreads(
+        threads,
+        [&section](unsigned int)
+        {
+          for (int j = 0; j < LOCKS; j++)
+            std::shared_lock<std::remove_reference_t<decltype(section)>> lock(section);
+        });
+    return threads * LOCKS / elapsed.count() / 1000000;
+  };
+
+  const unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int threads = 1; threads <= std::max(8u, cpus); threads *= 2)
+  {
+    CSharedSection sharedSection;
+    CSharedSection stripedSection(CSharedSection::ReaderCounting::STRIPED);
+    std::shared_mutex sharedMutex;
+    const double section = measure(sharedSection, threads);
+    const double striped = measure(stripedSection, threads);
+    const double mutex = measure(sharedMutex, threads);
+    Benchmark::Report(fmt::format("CSharedSection {} readers", threads), section, "M locks/s");
+    Benchmark::Report(fmt::format("CSharedSection striped {} readers", threads), striped,
+                      "M locks/s");
+    Benchmark::Report(fmt::format("std::shared_mutex {} readers", threads), mutex, "M locks/s");
+  }
+}
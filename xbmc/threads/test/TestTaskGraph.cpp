@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "threads/TaskGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(TestTaskGraph, Dependencies)
+{
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto task = [&mutex, &order](const std::string& name)
+  {
+    return [&mutex, &order, name]()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      order.push_back(name);
+      return true;
+    };
+  };
+
+  CTaskGraph graph("TestTaskGraph");
+  EXPECT_TRUE(graph.AddTask("a", task("a")));
+  EXPECT_TRUE(graph.AddTask("b", task("b"), {"a"}));
+  EXPECT_TRUE(graph.AddTask("c", task("c")));
+  EXPECT_TRUE(graph.AddTask("d", task("d"), {"b", "c"}));
+  EXPECT_FALSE(graph.AddTask("e", task("e"), {"unknown"}));
+  EXPECT_TRUE(graph.Run(4));
+
+  auto position = [&order](const std::string& name)
+  { return std::find(order.begin(), order.end(), name) - order.begin(); };
+  ASSERT_EQ(4u, order.size());
+  EXPECT_LT(position("a"), position("b"));
+  EXPECT_LT(position("b"), position("d"));
+  EXPECT_LT(position("c"), position("d"));
+}
+
+TEST(TestTaskGraph, Concurrency)
+{
+  // both tasks only finish if they run at the same time
+  CEvent first;
+  CEvent second;
+
+  CTaskGraph graph("TestTaskGraph");
+  graph.AddTask("first",
+                [&first, &second]()
+                {
+                  first.Set();
+                  return second.Wait(10000ms);
+                });
+  graph.AddTask("second",
+                [&first, &second]()
+                {
+                  second.Set();
+                  return first.Wait(10000ms);
+                });
+  EXPECT_TRUE(graph.Run(2));
+}
+
+TEST(TestTaskGraph, FailureSkipsDependents)
+{
+  std::atomic<int> runs{0};
+
+  CTaskGraph graph("TestTaskGraph");
+  graph.AddTask("fails",
+                [&runs]()
+                {
+                  runs++;
+                  return false;
+                });
+  graph.AddTask("throws",
+                [&runs]() -> bool
+                {
+                  runs++;
+                  throw std::runtime_error("error");
+                });
+  graph.AddTask("skipped",
+                [&runs]()
+                {
+                  runs++;
+                  return true;
+                },
+                {"fails"});
+  graph.AddTask("independent",
+                [&runs]()
+                {
+                  runs++;
+                  return true;
+                });
+  EXPECT_FALSE(graph.Run(1));
+  EXPECT_EQ(3, runs);
+}
+
+TEST(TestTaskGraph, CallerThread)
+{
+  const std::thread::id caller = std::this_thread::get_id();
+  std::atomic<int> onCaller{0};
+  auto task = [&onCaller, caller]()
+  {
+    if (std::this_thread::get_id() == caller)
+      onCaller++;
+    return true;
+  };
+
+  // the other tasks keep the workers busy, but must not take the ones bound to the caller
+  CTaskGraph graph("TestTaskGraph");
+  for (int i = 0; i < 8; i++)
+    graph.AddTask("any" + std::to_string(i), task);
+  graph.AddTask("caller", task, {}, CTaskGraph::TaskThread::CALLER);
+  graph.AddTask("dependent caller", task, {"any0"}, CTaskGraph::TaskThread::CALLER);
+  EXPECT_TRUE(graph.Run(4));
+  EXPECT_GE(onCaller, 2);
+}
@@ -0,0 +1,228 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AsyncLogSink.h"
+
+#include <mutex>
+#include <utility>
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+
+namespace
+{
+size_t RoundUpToPowerOfTwo(size_t value)
+{
+  size_t result = 2;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+} // unnamed namespace
+
+CAsyncLogSink::CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target, size_t capacity)
+  : m_target(std::move(target)), m_mask(RoundUpToPowerOfTwo(capacity) - 1)
+{
+}
+
+CAsyncLogSink::~CAsyncLogSink()
+{
+  Stop();
+}
+
+void CAsyncLogSink::Start(OverflowPolicy policy)
+{
+  std::unique_lock<CCriticalSection> lock(m_startStopSection);
+  m_policy = policy;
+  if (m_async)
+    return;
+
+  // the ring is only allocated once asynchronous logging is used
+  if (m_slots.empty())
+    m_slots = std::vector<Slot>(m_mask + 1);
+
+  for (size_t i = 0; i < m_slots.size(); i++)
+    m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  m_enqueuePos.store(0, std::memory_order_relaxed);
+  m_dequeuePos = 0;
+
+  m_stop = false;
+  m_flusher = std::thread(&CAsyncLogSink::Process, this);
+  m_async = true;
+}
+
+void CAsyncLogSink::Stop()
+{
+  std::unique_lock<CCriticalSection> lock(m_startStopSection);
+  if (!m_async.exchange(false))
+    return;
+
+  // wait for the threads which already decided to queue their message
+  while (m_producers.load() > 0)
+    std::this_thread::yield();
+
+  m_stop = true;
+  m_wakeup.Set();
+  m_flusher.join();
+}
+
+void CAsyncLogSink::log(const spdlog::details::log_msg& msg)
+{
+  if (!m_async.load(std::memory_order_relaxed))
+  {
+    m_target->log(msg);
+    return;
+  }
+
+  m_producers.fetch_add(1);
+  if (!m_async.load())
+  {
+    // stopped in the meantime
+    m_producers.fetch_sub(1);
+    m_target->log(msg);
+    return;
+  }
+
+  while (!Enqueue(msg))
+  {
+    if (m_policy.load(std::memory_order_relaxed) == OverflowPolicy::DROP)
+    {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      m_droppedTotal.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+
+    WakeFlusher();
+    std::this_thread::yield();
+  }
+
+  m_producers.fetch_sub(1, std::memory_order_release);
+}
+
+void CAsyncLogSink::flush()
+{
+  // the flusher flushes the target after every batch of messages
+  if (!m_async.load(std::memory_order_relaxed))
+    m_target->flush();
+}
+
+void CAsyncLogSink::set_pattern(const std::string& pattern)
+{
+  m_target->set_pattern(pattern);
+}
+
+void CAsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+  m_target->set_formatter(std::move(formatter));
+}
+
+bool CAsyncLogSink::Enqueue(const spdlog::details::log_msg& msg)
+{
+  // bounded queue as described by Dmitry Vyukov, each slot's sequence tells whether it is free for
+  // the producer at a position or holds a message for the consumer
+  Slot* slot;
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  while (true)
+  {
+    slot = &m_slots[pos & m_mask];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0)
+    {
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // full
+      return false;
+    }
+    else
+    {
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->time = msg.time;
+  slot->threadId = msg.thread_id;
+  slot->level = msg.level;
+  slot->loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+  slot->payload.assign(msg.payload.data(), msg.payload.size());
+  slot->sequence.store(pos + 1, std::memory_order_release);
+
+  WakeFlusher();
+  return true;
+}
+
+bool CAsyncLogSink::Dequeue()
+{
+  Slot& slot = m_slots[m_dequeuePos & m_mask];
+  if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+    return false;
+
+  spdlog::details::log_msg msg(slot.time, spdlog::source_loc{}, slot.loggerName, slot.level,
+                               slot.payload);
+  msg.thread_id = slot.threadId;
+  m_target->log(msg);
+
+  slot.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+  m_dequeuePos++;
+  return true;
+}
+
+bool CAsyncLogSink::IsEmpty() const
+{
+  const Slot& slot = m_slots[m_dequeuePos & m_mask];
+  return slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+}
+
+void CAsyncLogSink::WakeFlusher()
+{
+  // pairs with the fence in Process(), either the flusher sees the new message or we see it waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_flusherWaiting.load(std::memory_order_relaxed))
+    m_wakeup.Set();
+}
+
+void CAsyncLogSink::Process()
+{
+  while (true)
+  {
+    bool written = false;
+    while (Dequeue())
+      written = true;
+
+    LogDroppedMessages();
+
+    if (written)
+    {
+      m_target->flush();
+      continue;
+    }
+
+    if (m_stop)
+      break;
+
+    m_flusherWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (IsEmpty() && !m_stop)
+      m_wakeup.Wait();
+    m_flusherWaiting.store(false, std::memory_order_relaxed);
+  }
+}
+
+void CAsyncLogSink::LogDroppedMessages()
+{
+  const uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+  if (dropped == 0)
+    return;
+
+  const std::string message =
+      fmt::format("{} log messages were dropped, the log queue was full", dropped);
+  m_target->log(spdlog::details::log_msg("general", spdlog::level::warn, message));
+}
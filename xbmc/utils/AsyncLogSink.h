@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/sink.h>
+
+/**
+ * A sink forwarding log messages to another sink, either synchronously or through a background
+ * flusher thread.
+ *
+ * In asynchronous mode logging threads copy the already formatted message into a slot of a
+ * bounded lock-free ring and return, the flusher writes the queued messages to the target sink and
+ * flushes it once per batch. Slots keep their buffers, so once a slot has seen a message of a
+ * given size no further allocations are needed. What happens if the ring is full is decided by the
+ * overflow policy.
+ */
+class CAsyncLogSink : public spdlog::sinks::sink
+{
+public:
+  enum class OverflowPolicy
+  {
+    DROP, ///< drop the message, the number of dropped messages is logged later
+    BLOCK, ///< wait until the flusher made room
+  };
+
+  static constexpr size_t DEFAULT_CAPACITY = 2048;
+
+  /**
+   * \param target the sink to write the messages to, it has to be thread safe
+   * \param capacity the number of messages which can be queued, rounded up to a power of two
+   */
+  explicit CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target,
+                         size_t capacity = DEFAULT_CAPACITY);
+  ~CAsyncLogSink() override;
+
+  /**
+   * Switch to asynchronous mode and start the flusher, or only change the overflow policy if it
+   * is running already.
+   */
+  void Start(OverflowPolicy policy);
+
+  /**
+   * Write all queued messages, stop the flusher and switch back to synchronous mode.
+   */
+  void Stop();
+
+  bool IsAsync() const { return m_async.load(std::memory_order_relaxed); }
+
+  /**
+   * Get the number of messages dropped because the ring was full, since the sink was created.
+   */
+  uint64_t GetDroppedMessages() const { return m_droppedTotal.load(std::memory_order_relaxed); }
+
+  // implementation of spdlog::sinks::sink
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override;
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+private:
+  CAsyncLogSink(const CAsyncLogSink&) = delete;
+  CAsyncLogSink& operator=(const CAsyncLogSink&) = delete;
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence{0};
+    spdlog::log_clock::time_point time;
+    size_t threadId = 0;
+    spdlog::level::level_enum level = spdlog::level::off;
+    std::string loggerName;
+    std::string payload;
+  };
+
+  bool Enqueue(const spdlog::details::log_msg& msg);
+  bool Dequeue();
+  bool IsEmpty() const;
+  void WakeFlusher();
+  void Process();
+  void LogDroppedMessages();
+
+  const std::shared_ptr<spdlog::sinks::sink> m_target;
+
+  std::vector<Slot> m_slots;
+  const size_t m_mask;
+  alignas(64) std::atomic<size_t> m_enqueuePos{0};
+  alignas(64) size_t m_dequeuePos = 0; ///< only accessed by the flusher
+
+  std::atomic<bool> m_async{false};
+  std::atomic<OverflowPolicy> m_policy{OverflowPolicy::DROP};
+  std::atomic<unsigned int> m_producers{0}; ///< threads currently queueing a message
+  std::atomic<uint64_t> m_dropped{0}; ///< dropped messages not yet reported
+  std::atomic<uint64_t> m_droppedTotal{0};
+
+  // a plain thread as opposed to a CThread, which would log from the flusher itself
+  std::thread m_flusher;
+  std::atomic<bool> m_flusherWaiting{false};
+  std::atomic<bool> m_stop{false};
+  CEvent m_wakeup;
+
+  CCriticalSection m_startStopSection;
+};
@@ -9,6 +9,7 @@
 #include "JobManager.h"
 
 #include "ServiceBroker.h"
+#include "utils/Trace.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
@@ -52,6 +53,7 @@ void CJobWorker::Process()
     bool success = false;
     try
     {
+      KODI_TRACE_SCOPE("job", *job->GetType() ? job->GetType() : "CJob");
       success = job->DoWork();
     }
     catch (...)
@@ -12,11 +12,14 @@
 #include "SortFileItem.h"
 #include "URL.h"
 #include "Util.h"
+#include "dbwrappers/dataset.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -1383,3 +1386,120 @@ const std::string& SortUtils::SortOrderToString(SortOrder sortOrder)
 {
   return TypeToString<SortOrder>(sortOrders, sortOrder);
 }
+
+bool CSortedIdsCache::IsPaged(const SortDescription& sortDescription)
+{
+  return sortDescription.sortBy != SortByNone &&
+         (sortDescription.limitStart > 0 || sortDescription.limitEnd > 0);
+}
+
+std::string CSortedIdsCache::GetKey(const std::string& sql, const SortDescription& sortDescription)
+{
+  return StringUtils::Format("{} {} {} {}", static_cast<int>(sortDescription.sortBy),
+                             static_cast<int>(sortDescription.sortOrder),
+                             static_cast<int>(sortDescription.sortAttributes), sql);
+}
+
+bool CSortedIdsCache::GetPage(const std::string& key,
+                              const SortDescription& sortDescription,
+                              std::vector<int>& ids,
+                              int& total) const
+{
+  if (!IsPaged(sortDescription) || sortDescription.limitStart <= 0)
+    return false;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto it = std::find_if(m_listings.cbegin(), m_listings.cend(),
+                               [&key](const auto& listing) { return listing.first == key; });
+  if (it == m_listings.cend())
+    return false;
+
+  const std::vector<int>& sortedIds = it->second;
+  const size_t start = std::min(static_cast<size_t>(sortDescription.limitStart), sortedIds.size());
+  size_t end = sortedIds.size();
+  if (sortDescription.limitEnd > 0)
+    end = std::clamp(static_cast<size_t>(sortDescription.limitEnd), start, sortedIds.size());
+
+  ids.assign(sortedIds.begin() + start, sortedIds.begin() + end);
+  total = static_cast<int>(sortedIds.size());
+  return true;
+}
+
+bool CSortedIdsCache::SortFromDataset(const std::string& key,
+                                      const SortDescription& sortDescription,
+                                      const MediaType& mediaType,
+                                      const std::unique_ptr<dbiplus::Dataset>& dataset,
+                                      int idField,
+                                      DatabaseResults& results)
+{
+  if (!IsPaged(sortDescription))
+    return SortUtils::SortFromDataset(sortDescription, mediaType, dataset, results);
+
+  SortDescription sorting = sortDescription;
+  sorting.limitStart = 0;
+  sorting.limitEnd = -1;
+  if (!SortUtils::SortFromDataset(sorting, mediaType, dataset, results))
+    return false;
+
+  const dbiplus::query_data& data = dataset->get_result_set().records;
+  std::vector<int> ids;
+  ids.reserve(results.size());
+  for (const auto& result : results)
+    ids.emplace_back(data.at(result.at(FieldRow).asInteger())->at(idField).get_asInt());
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    const auto it = std::find_if(m_listings.begin(), m_listings.end(),
+                                 [&key](const auto& listing) { return listing.first == key; });
+    if (it != m_listings.end())
+      m_listings.erase(it);
+    else if (m_listings.size() == MAX_LISTINGS)
+      m_listings.pop_back();
+
+    m_listings.emplace(m_listings.begin(), key, std::move(ids));
+  }
+
+  // only cut the page, the rows are sorted already
+  SortUtils::Sort(SortByNone, sortDescription.sortOrder, sortDescription.sortAttributes, results,
+                  sortDescription.limitEnd, sortDescription.limitStart);
+  return true;
+}
+
+std::string CSortedIdsCache::GetWhereClause(const std::string& idField,
+                                            const std::vector<int>& ids)
+{
+  std::string where = idField + " IN (";
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (i > 0)
+      where += ',';
+    where += std::to_string(ids[i]);
+  }
+  return where + ")";
+}
+
+void CSortedIdsCache::OrderFromDataset(const std::vector<int>& ids,
+                                       const std::unique_ptr<dbiplus::Dataset>& dataset,
+                                       int idField,
+                                       DatabaseResults& results)
+{
+  const dbiplus::query_data& data = dataset->get_result_set().records;
+
+  std::unordered_map<int, unsigned int> rows;
+  for (unsigned int row = 0; row < data.size(); ++row)
+    rows.emplace(data[row]->at(idField).get_asInt(), row);
+
+  results.reserve(ids.size());
+  for (int id : ids)
+  {
+    const auto it = rows.find(id);
+    if (it == rows.end())
+      continue;
+
+    DatabaseResult result;
+    result[FieldRow] = it->second;
+    results.emplace_back(std::move(result));
+  }
+}
@@ -10,10 +10,12 @@
 
 #include "DatabaseUtils.h"
 #include "LabelFormatter.h"
+#include "threads/CriticalSection.h"
 
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 enum class SortMethod;
@@ -232,3 +234,74 @@ private:
   static std::map<SortBy, SortPreparator> m_preparators;
   static std::map<SortBy, Fields> m_sortingFields;
 };
+
+/*!
+ \brief Ids of the items of recently paged database listings, in sort order.
+
+ Listings the database can't sort itself are sorted in memory, which needs all of their rows. The
+ first page of such a listing keeps the ids of all rows, so that its further pages only fetch the
+ rows of their ids instead of querying and sorting the whole listing again.
+ */
+class CSortedIdsCache
+{
+public:
+  /*!
+   \brief Whether a sort description asks for a page of a sorted listing.
+   */
+  static bool IsPaged(const SortDescription& sortDescription);
+
+  /*!
+   \brief Get the key of a listing.
+   \param sql the query of the listing, without limits
+   \param sortDescription the sort description of the listing
+   */
+  static std::string GetKey(const std::string& sql, const SortDescription& sortDescription);
+
+  /*!
+   \brief Get the ids of a further page of a listing. The first page is never taken from the cache,
+   so that opening a listing again picks up changes of the library.
+   \param key the key of the listing
+   \param sortDescription the sort description with the limits of the page
+   \param[out] ids the ids of the page, in sort order
+   \param[out] total the number of items of the whole listing
+   \return true if the page was taken from the cache, false otherwise.
+   */
+  bool GetPage(const std::string& key,
+               const SortDescription& sortDescription,
+               std::vector<int>& ids,
+               int& total) const;
+
+  /*!
+   \brief Sort the rows of a dataset like SortUtils::SortFromDataset(). The ids of all rows of a
+   paged listing are kept for its further pages.
+   \param key the key of the listing
+   \param idField the column of the dataset holding the id
+   */
+  bool SortFromDataset(const std::string& key,
+                       const SortDescription& sortDescription,
+                       const MediaType& mediaType,
+                       const std::unique_ptr<dbiplus::Dataset>& dataset,
+                       int idField,
+                       DatabaseResults& results);
+
+  /*!
+   \brief Get the condition selecting the rows of the given ids.
+   */
+  static std::string GetWhereClause(const std::string& idField, const std::vector<int>& ids);
+
+  /*!
+   \brief Order the rows of a page fetched by id like the ids. Ids without a row, i.e. items
+   removed from the library since the listing was sorted, are skipped.
+   \param idField the column of the dataset holding the id
+   */
+  static void OrderFromDataset(const std::vector<int>& ids,
+                               const std::unique_ptr<dbiplus::Dataset>& dataset,
+                               int idField,
+                               DatabaseResults& results);
+
+private:
+  static constexpr size_t MAX_LISTINGS = 4;
+
+  mutable CCriticalSection m_critSection;
+  std::vector<std::pair<std::string, std::vector<int>>> m_listings; // most recently used first
+};
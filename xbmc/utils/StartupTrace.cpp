@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "StartupTrace.h"
+
+#include "threads/CriticalSection.h"
+#include "utils/Trace.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// static initialization runs on the main thread, shortly after the process started
+const std::chrono::steady_clock::time_point ProcessStart = std::chrono::steady_clock::now();
+
+struct Step
+{
+  std::string name;
+  size_t thread;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+};
+
+struct Timeline
+{
+  CCriticalSection section;
+  std::vector<Step> steps;
+  std::map<std::thread::id, size_t> threadIndices;
+  std::vector<std::string> threadNames;
+};
+
+Timeline& GetTimelineData()
+{
+  static Timeline timeline;
+  return timeline;
+}
+
+int64_t ToMilliseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+} // unnamed namespace
+
+CStartupTrace::CScope::CScope(std::string name)
+{
+  if (IsRecording())
+  {
+    m_name = std::move(name);
+    m_start = std::chrono::steady_clock::now();
+  }
+}
+
+CStartupTrace::CScope::~CScope()
+{
+  if (m_start != std::chrono::steady_clock::time_point() && IsRecording())
+    AddStep(std::move(m_name), m_start, std::chrono::steady_clock::now());
+}
+
+void CStartupTrace::Finish(bool writeTimeline)
+{
+  if (!s_recording.exchange(false))
+    return;
+
+  const auto duration = std::chrono::steady_clock::now() - ProcessStart;
+  CLog::Log(LOGINFO, "Startup finished after {} ms", ToMilliseconds(duration));
+
+  Timeline& timeline = GetTimelineData();
+  {
+    std::unique_lock<CCriticalSection> lock(timeline.section);
+    std::sort(timeline.steps.begin(), timeline.steps.end(),
+              [](const Step& a, const Step& b) { return a.start < b.start; });
+    for (const auto& step : timeline.steps)
+    {
+      CLog::Log(LOGDEBUG, "  {} ms: {} took {} ms on {}", ToMilliseconds(step.start - ProcessStart),
+                step.name, ToMilliseconds(step.end - step.start),
+                timeline.threadNames[step.thread]);
+    }
+  }
+
+  if (writeTimeline)
+    CTrace::WriteJson(GetTimeline(), "", "startup");
+}
+
+std::string CStartupTrace::GetTimeline()
+{
+  Timeline& timeline = GetTimelineData();
+  std::unique_lock<CCriticalSection> lock(timeline.section);
+
+  std::vector<CTrace::ThreadEvents> threads;
+  threads.reserve(timeline.threadNames.size());
+  for (const auto& threadName : timeline.threadNames)
+    threads.push_back({threadName, {}});
+
+  for (const auto& step : timeline.steps)
+  {
+    threads[step.thread].events.push_back(
+        {"startup", step.name,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(step.start - ProcessStart),
+         std::chrono::duration_cast<std::chrono::nanoseconds>(step.end - step.start)});
+  }
+
+  // the events refer to the names of the steps, so they are formatted while holding the lock
+  return CTrace::ToJson(threads);
+}
+
+void CStartupTrace::AddStep(std::string name,
+                            std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point end)
+{
+  Timeline& timeline = GetTimelineData();
+  std::unique_lock<CCriticalSection> lock(timeline.section);
+
+  auto it = timeline.threadIndices.find(std::this_thread::get_id());
+  if (it == timeline.threadIndices.end())
+  {
+    it = timeline.threadIndices.emplace(std::this_thread::get_id(), timeline.threadNames.size())
+             .first;
+    timeline.threadNames.emplace_back(CTrace::GetCurrentThreadName());
+  }
+
+  timeline.steps.push_back({std::move(name), it->second, start, end});
+}
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/*!
+ * \brief Records the timeline of the application startup.
+ *
+ * Initialization steps are recorded as scopes, on whatever thread they run on, until Finish() is
+ * called once the application is initialized. The timeline can then be written in the Chrome trace
+ * event format, which can be loaded into chrome://tracing or https://ui.perfetto.dev. Once the
+ * startup is finished a scope only costs a relaxed atomic load.
+ */
+class CStartupTrace
+{
+public:
+  /*!
+   * \brief Records the time from its construction to its destruction as an initialization step.
+   */
+  class CScope
+  {
+  public:
+    explicit CScope(std::string name);
+    ~CScope();
+
+  private:
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+    std::string m_name;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Stop recording and log how long the startup took.
+   * \param writeTimeline whether to write the timeline to the log folder
+   */
+  static void Finish(bool writeTimeline);
+
+  /*!
+   * \brief Get the timeline recorded so far in the Chrome trace event format.
+   */
+  static std::string GetTimeline();
+
+private:
+  static void AddStep(std::string name,
+                      std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end);
+
+  static inline std::atomic<bool> s_recording{true};
+};
@@ -0,0 +1,289 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "Trace.h"
+
+#include "CompileInfo.h"
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const std::thread::id MainThread = std::this_thread::get_id();
+
+struct Event
+{
+  std::atomic<const char*> category{nullptr};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<int64_t> start{0};
+  std::atomic<int64_t> duration{0};
+};
+
+/*!
+ * Only written by its thread. An event is claimed before it is written and counted as written
+ * afterwards, which lets a reader detect events that were overwritten while it read them.
+ */
+struct RingBuffer
+{
+  explicit RingBuffer(std::string name) : threadName(std::move(name)) {}
+
+  const std::string threadName;
+  std::array<Event, CTrace::RING_BUFFER_SIZE> events;
+  std::atomic<uint64_t> claimed{0};
+  std::atomic<uint64_t> written{0};
+  std::atomic<bool> threadExited{false};
+};
+
+struct Registry
+{
+  CCriticalSection section;
+  std::vector<std::shared_ptr<RingBuffer>> buffers;
+  int64_t recordingStart = 0;
+};
+
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+int64_t ToNanoseconds(std::chrono::steady_clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+double ToMicroseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+class CThreadRingBuffer
+{
+public:
+  ~CThreadRingBuffer()
+  {
+    if (m_buffer)
+      m_buffer->threadExited = true;
+  }
+
+  RingBuffer& Get()
+  {
+    if (!m_buffer)
+    {
+      m_buffer = std::make_shared<RingBuffer>(CTrace::GetCurrentThreadName());
+
+      Registry& registry = GetRegistry();
+      std::unique_lock<CCriticalSection> lock(registry.section);
+      registry.buffers.push_back(m_buffer);
+    }
+    return *m_buffer;
+  }
+
+private:
+  std::shared_ptr<RingBuffer> m_buffer;
+};
+
+thread_local CThreadRingBuffer threadRingBuffer;
+} // unnamed namespace
+
+void CTrace::Start()
+{
+  Registry& registry = GetRegistry();
+  {
+    std::unique_lock<CCriticalSection> lock(registry.section);
+    registry.buffers.erase(std::remove_if(registry.buffers.begin(), registry.buffers.end(),
+                                          [](const std::shared_ptr<RingBuffer>& buffer)
+                                          { return buffer->threadExited.load(); }),
+                           registry.buffers.end());
+    registry.recordingStart = ToNanoseconds(std::chrono::steady_clock::now());
+  }
+
+  s_recording = true;
+#ifdef HAS_TRACING
+  CLog::Log(LOGINFO, "CTrace: recording started");
+#else
+  CLog::Log(LOGWARNING, "CTrace: recording started, but trace events aren't compiled in");
+#endif
+}
+
+void CTrace::Stop()
+{
+  if (s_recording.exchange(false))
+    CLog::Log(LOGINFO, "CTrace: recording stopped");
+}
+
+std::string CTrace::GetEvents()
+{
+  struct RecordedEvent
+  {
+    uint64_t index;
+    const char* category;
+    const char* name;
+    int64_t start;
+    int64_t duration;
+  };
+
+  std::vector<std::shared_ptr<RingBuffer>> buffers;
+  int64_t recordingStart;
+  {
+    Registry& registry = GetRegistry();
+    std::unique_lock<CCriticalSection> lock(registry.section);
+    buffers = registry.buffers;
+    recordingStart = registry.recordingStart;
+  }
+
+  std::vector<ThreadEvents> threads;
+  threads.reserve(buffers.size());
+  std::vector<RecordedEvent> recorded;
+  for (const auto& buffer : buffers)
+  {
+    ThreadEvents& thread = threads.emplace_back();
+    thread.threadName = buffer->threadName;
+
+    recorded.clear();
+    const uint64_t written = buffer->written.load(std::memory_order_acquire);
+    for (uint64_t index = written > RING_BUFFER_SIZE ? written - RING_BUFFER_SIZE : 0;
+         index < written; index++)
+    {
+      const Event& event = buffer->events[index % RING_BUFFER_SIZE];
+      recorded.push_back({index, event.category.load(std::memory_order_relaxed),
+                          event.name.load(std::memory_order_relaxed),
+                          event.start.load(std::memory_order_relaxed),
+                          event.duration.load(std::memory_order_relaxed)});
+    }
+
+    // pairs with the release fence in AddEvent, events claimed since then may have been torn
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = buffer->claimed.load(std::memory_order_relaxed);
+
+    for (const auto& event : recorded)
+    {
+      if (event.index + RING_BUFFER_SIZE < claimed || event.start < recordingStart)
+        continue;
+
+      thread.events.push_back({event.category, event.name,
+                               std::chrono::nanoseconds(event.start - recordingStart),
+                               std::chrono::nanoseconds(event.duration)});
+    }
+  }
+
+  return ToJson(threads);
+}
+
+std::string CTrace::Dump(const std::string& path)
+{
+  return WriteJson(GetEvents(), path, "trace");
+}
+
+std::string CTrace::GetCurrentThreadName()
+{
+  if (std::this_thread::get_id() == MainThread)
+    return "main";
+
+  const CThread* thread = CThread::GetCurrentThread();
+  if (thread)
+    return thread->GetName();
+
+  std::ostringstream name;
+  name << "thread " << std::this_thread::get_id();
+  return name.str();
+}
+
+std::string CTrace::ToJson(const std::vector<ThreadEvents>& threads)
+{
+  CVariant events(CVariant::VariantTypeArray);
+  for (size_t thread = 0; thread < threads.size(); thread++)
+  {
+    CVariant threadName(CVariant::VariantTypeObject);
+    threadName["name"] = "thread_name";
+    threadName["ph"] = "M";
+    threadName["pid"] = 1;
+    threadName["tid"] = static_cast<uint64_t>(thread);
+    threadName["args"]["name"] = threads[thread].threadName;
+    events.push_back(std::move(threadName));
+
+    for (const auto& event : threads[thread].events)
+    {
+      CVariant traceEvent(CVariant::VariantTypeObject);
+      traceEvent["name"] = std::string(event.name);
+      traceEvent["cat"] = std::string(event.category);
+      traceEvent["ph"] = "X";
+      traceEvent["ts"] = ToMicroseconds(event.start);
+      traceEvent["dur"] = ToMicroseconds(event.duration);
+      traceEvent["pid"] = 1;
+      traceEvent["tid"] = static_cast<uint64_t>(thread);
+      events.push_back(std::move(traceEvent));
+    }
+  }
+
+  CVariant trace(CVariant::VariantTypeObject);
+  trace["traceEvents"] = std::move(events);
+  trace["displayTimeUnit"] = "ms";
+
+  std::string json;
+  CJSONVariantWriter::Write(trace, json, true);
+  return json;
+}
+
+std::string CTrace::WriteJson(const std::string& json,
+                              const std::string& path,
+                              const std::string& name)
+{
+  std::string file = path;
+  if (file.empty())
+  {
+    std::string appName = CCompileInfo::GetAppName();
+    StringUtils::ToLower(appName);
+    file = "special://logpath/" + appName + "-" + name + ".json";
+  }
+
+  XFILE::CFile trace;
+  if (!trace.OpenForWrite(file, true) ||
+      trace.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTrace: failed to write the trace events to {}", file);
+    return "";
+  }
+
+  CLog::Log(LOGINFO, "CTrace: trace events written to {}", file);
+  return file;
+}
+
+void CTrace::AddEvent(const char* category,
+                      const char* name,
+                      std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end)
+{
+  RingBuffer& buffer = threadRingBuffer.Get();
+
+  const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  buffer.claimed.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Event& event = buffer.events[index % RING_BUFFER_SIZE];
+  event.category.store(category, std::memory_order_relaxed);
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(ToNanoseconds(start), std::memory_order_relaxed);
+  event.duration.store(ToNanoseconds(end) - ToNanoseconds(start), std::memory_order_relaxed);
+
+  buffer.written.store(index + 1, std::memory_order_release);
+}
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+ * \brief Records trace events of instrumented code paths across all threads.
+ *
+ * Events are recorded by KODI_TRACE_SCOPE while recording is started, into a ring buffer per thread
+ * which keeps the most recent RING_BUFFER_SIZE events of the thread. Recording an event doesn't
+ * take a lock and doesn't allocate, apart from the ring buffer for the first event of a thread.
+ * While not recording a scope only costs a relaxed atomic load, and without HAS_TRACING the scopes
+ * are compiled out entirely.
+ *
+ * The events can be written in the Chrome trace event format, which can be loaded into
+ * https://ui.perfetto.dev or chrome://tracing.
+ */
+class CTrace
+{
+public:
+  static constexpr size_t RING_BUFFER_SIZE = 4096;
+
+  /*!
+   * \brief Records the time from its construction to its destruction as a trace event.
+   *
+   * The category and the name aren't copied, they have to be string literals or otherwise outlive
+   * the application.
+   */
+  class CScope
+  {
+  public:
+    CScope(const char* category, const char* name) : m_category(category), m_name(name)
+    {
+      if (IsRecording())
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    ~CScope()
+    {
+      if (m_start != std::chrono::steady_clock::time_point())
+        AddEvent(m_category, m_name, m_start, std::chrono::steady_clock::now());
+    }
+
+  private:
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+    const char* m_category;
+    const char* m_name;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Start recording, events recorded before are discarded.
+   */
+  static void Start();
+
+  /*!
+   * \brief Stop recording, the events recorded so far are kept until recording is started again.
+   */
+  static void Stop();
+
+  /*!
+   * \brief Get the recorded events in the Chrome trace event format.
+   */
+  static std::string GetEvents();
+
+  /*!
+   * \brief Write the recorded events in the Chrome trace event format.
+   * \param path the file to write, empty for the default file in the log folder
+   * \return the path of the written file, empty on failure
+   */
+  static std::string Dump(const std::string& path = "");
+
+  /*!
+   * \brief An event as it is written in the Chrome trace event format.
+   */
+  struct TraceEvent
+  {
+    std::string_view category;
+    std::string_view name;
+    std::chrono::nanoseconds start; ///< since the start of the trace
+    std::chrono::nanoseconds duration;
+  };
+
+  /*!
+   * \brief The events of one thread.
+   */
+  struct ThreadEvents
+  {
+    std::string threadName;
+    std::vector<TraceEvent> events;
+  };
+
+  /*!
+   * \brief Get the name of the calling thread, as it is shown in a trace.
+   */
+  static std::string GetCurrentThreadName();
+
+  /*!
+   * \brief Format the events of the given threads in the Chrome trace event format.
+   */
+  static std::string ToJson(const std::vector<ThreadEvents>& threads);
+
+  /*!
+   * \brief Write events in the Chrome trace event format.
+   * \param json the events, see ToJson()
+   * \param path the file to write, empty for the default file in the log folder
+   * \param name the name of the default file, e.g. "trace" for kodi-trace.json
+   * \return the path of the written file, empty on failure
+   */
+  static std::string WriteJson(const std::string& json,
+                               const std::string& path,
+                               const std::string& name);
+
+private:
+  static void AddEvent(const char* category,
+                       const char* name,
+                       std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end);
+
+  static inline std::atomic<bool> s_recording{false};
+};
+
+#define KODI_TRACE_CONCAT_IMPL(a, b) a##b
+#define KODI_TRACE_CONCAT(a, b) KODI_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef HAS_TRACING
+/*!
+ * \brief Record the rest of the enclosing scope as a trace event.
+ */
+#define KODI_TRACE_SCOPE(category, name) \
+  CTrace::CScope KODI_TRACE_CONCAT(traceScope, __LINE__)(category, name)
+#else
+#define KODI_TRACE_SCOPE(category, name) \
+  do \
+  { \
+  } while (false)
+#endif
@@ -17,9 +17,11 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "utils/AsyncLogSink.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
+#include <algorithm>
 #include <cstring>
 #include <set>
 
@@ -32,11 +34,13 @@ namespace
 static constexpr unsigned char Utf8Bom[3] = {0xEF, 0xBB, 0xBF};
 static const std::string LogFileExtension = ".log";
 static const std::string LogPattern = "%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v";
+static constexpr size_t MaxFormatBufferSize = 64 * 1024;
 } // namespace
 
 CLog::CLog()
   : m_platform(IPlatformLog::CreatePlatformLog()),
     m_sinks(std::make_shared<spdlog::sinks::dist_sink_mt>()),
+    m_asyncSink(std::make_shared<CAsyncLogSink>(m_sinks)),
     m_defaultLogger(CreateLogger("general")),
     m_logLevel(LOG_LEVEL_DEBUG)
 {
@@ -146,6 +150,9 @@ void CLog::Deinitialize()
   if (m_fileSink == nullptr)
     return;
 
+  // write all queued messages, logging is synchronous from here on
+  m_asyncSink->Stop();
+
   // flush all loggers
   spdlog::apply_all([](const std::shared_ptr<spdlog::logger>& logger) { logger->flush(); });
 
@@ -188,6 +195,26 @@ bool CLog::IsLogLevelLogged(int loglevel)
   return (loglevel & LOGMASK) >= LOGINFO;
 }
 
+void CLog::SetAsyncLogging(bool enabled, bool blockOnOverflow)
+{
+  if (!enabled)
+  {
+    if (m_asyncSink->IsAsync())
+    {
+      m_asyncSink->Stop();
+      Log(LOGINFO, "Asynchronous logging disabled");
+    }
+    return;
+  }
+
+  const bool wasAsync = m_asyncSink->IsAsync();
+  m_asyncSink->Start(blockOnOverflow ? CAsyncLogSink::OverflowPolicy::BLOCK
+                                     : CAsyncLogSink::OverflowPolicy::DROP);
+  if (!wasAsync)
+    Log(LOGINFO, "Asynchronous logging enabled, {} messages on overflow",
+        blockOnOverflow ? "blocking" : "dropping");
+}
+
 bool CLog::CanLogComponent(uint32_t component) const
 {
   if (!m_componentLogEnabled || component == 0)
@@ -274,8 +301,8 @@ spdlog::level::level_enum CLog::MapLogLevel(int level)
 
 Logger CLog::CreateLogger(const std::string& loggerName)
 {
-  // create the logger
-  auto logger = std::make_shared<spdlog::logger>(loggerName, m_sinks);
+  // create the logger, the asynchronous sink forwards to m_sinks
+  auto logger = std::make_shared<spdlog::logger>(loggerName, m_asyncSink);
 
   // initialize the logger
   spdlog::initialize_logger(logger);
@@ -295,6 +322,36 @@ void CLog::SetComponentLogLevel(const std::vector<CVariant>& components)
   }
 }
 
+void CLog::FormatAndLogInternal(spdlog::level::level_enum level,
+                                fmt::string_view format,
+                                fmt::format_args args)
+{
+  if (!m_defaultLogger->should_log(level))
+    return;
+
+  // format into a buffer owned by the thread, so that only long messages allocate
+  thread_local fmt::memory_buffer buffer;
+  buffer.clear();
+  fmt::vformat_to(fmt::appender(buffer), format, args);
+
+  const spdlog::string_view_t message(buffer.data(), buffer.size());
+  if (std::find(message.begin(), message.end(), '\n') == message.end())
+  {
+    m_defaultLogger->log(level, message);
+  }
+  else
+  {
+    // fixup newline alignment, number of spaces should equal prefix length
+    std::string multiLineMessage(message.data(), message.size());
+    FormatLineBreaks(multiLineMessage);
+    m_defaultLogger->log(level, spdlog::string_view_t(multiLineMessage));
+  }
+
+  // don't keep the memory of an exceptionally long message around
+  if (buffer.capacity() > MaxFormatBufferSize)
+    buffer = fmt::memory_buffer();
+}
+
 void CLog::FormatLineBreaks(std::string& message)
 {
   StringUtils::Replace(message, "\n", "\n                                                   ");
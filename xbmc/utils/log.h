@@ -35,6 +35,8 @@
 
 #include <spdlog/spdlog.h>
 
+class CAsyncLogSink;
+
 namespace spdlog
 {
 namespace sinks
@@ -78,6 +80,14 @@ public:
   int GetLogLevel() { return m_logLevel; }
   bool IsLogLevelLogged(int loglevel);
 
+  /*!
+   * \brief Write log messages from a background thread instead of the logging thread.
+   * \param enabled whether messages are queued and written asynchronously
+   * \param blockOnOverflow whether logging threads wait if the queue is full, instead of dropping
+   *        the message
+   */
+  void SetAsyncLogging(bool enabled, bool blockOnOverflow);
+
   bool CanLogComponent(uint32_t component) const;
   static void SettingOptionsLoggingComponentsFiller(const std::shared_ptr<const CSetting>& setting,
                                                     std::vector<IntegerSettingOption>& list,
@@ -132,15 +142,7 @@ private:
 
   void FormatAndLogInternal(spdlog::level::level_enum level,
                             fmt::string_view format,
-                            fmt::format_args args)
-  {
-    auto message = fmt::vformat(format, args);
-
-    // fixup newline alignment, number of spaces should equal prefix length
-    FormatLineBreaks(message);
-
-    m_defaultLogger->log(level, message);
-  }
+                            fmt::format_args args);
 
   Logger CreateLogger(const std::string& loggerName);
 
@@ -150,6 +152,7 @@ private:
 
   std::unique_ptr<IPlatformLog> m_platform;
   std::shared_ptr<spdlog::sinks::dist_sink<std::mutex>> m_sinks;
+  std::shared_ptr<CAsyncLogSink> m_asyncSink;
   Logger m_defaultLogger;
 
   std::shared_ptr<spdlog::sinks::sink> m_fileSink;
@@ -0,0 +1,234 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/SpecialProtocol.h"
+#include "test/Benchmark.h"
+#include "threads/Event.h"
+#include "utils/AsyncLogSink.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/sinks/dup_filter_sink.h>
+
+namespace
+{
+struct Message
+{
+  std::string logger;
+  spdlog::level::level_enum level;
+  std::string payload;
+};
+
+class CollectingSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  std::vector<Message> GetMessages()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return m_messages;
+  }
+
+  // blocks the sink until Release() is called
+  void Hold() { m_released.Reset(); }
+  void Release() { m_released.Set(); }
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    m_released.Wait();
+    m_messages.push_back({std::string(msg.logger_name.data(), msg.logger_name.size()), msg.level,
+                          std::string(msg.payload.data(), msg.payload.size())});
+  }
+  void flush_() override {}
+
+private:
+  std::vector<Message> m_messages;
+  CEvent m_released{true, true};
+};
+} // unnamed namespace
+
+TEST(TestAsyncLogSink, Synchronous)
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target);
+  spdlog::logger logger("test", sink);
+
+  logger.info("synchronous");
+  EXPECT_FALSE(sink->IsAsync());
+  ASSERT_EQ(1u, target->GetMessages().size());
+  EXPECT_EQ("synchronous", target->GetMessages()[0].payload);
+}
+
+TEST(TestAsyncLogSink, Order)
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target, 16);
+  spdlog::logger logger("test", sink);
+  logger.set_level(spdlog::level::trace);
+
+  sink->Start(CAsyncLogSink::OverflowPolicy::BLOCK);
+  EXPECT_TRUE(sink->IsAsync());
+  for (int i = 0; i < 1000; i++)
+    logger.log(i % 2 ? spdlog::level::debug : spdlog::level::err, "message {}", i);
+  sink->Stop();
+
+  const std::vector<Message> messages = target->GetMessages();
+  ASSERT_EQ(1000u, messages.size());
+  for (int i = 0; i < 1000; i++)
+  {
+    EXPECT_EQ("test", messages[i].logger);
+    EXPECT_EQ(i % 2 ? spdlog::level::debug : spdlog::level::err, messages[i].level);
+    EXPECT_EQ("message " + std::to_string(i), messages[i].payload);
+  }
+  EXPECT_EQ(0u, sink->GetDroppedMessages());
+}
+
+TEST(TestAsyncLogSink, BlockLosesNothing)
+{
+  constexpr int THREADS = 8;
+  constexpr int MESSAGES = 5000;
+
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target, 64);
+  spdlog::logger logger("test", sink);
+
+  sink->Start(CAsyncLogSink::OverflowPolicy::BLOCK);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREADS; thread++)
+  {
+    threads.emplace_back(
+        [&logger, thread]()
+        {
+          for (int i = 0; i < MESSAGES; i++)
+            logger.info("{} {}", thread, i);
+        });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  sink->Stop();
+
+  // every thread's messages arrive in the order they were logged
+  std::vector<int> next(THREADS, 0);
+  const std::vector<Message> messages = target->GetMessages();
+  ASSERT_EQ(static_cast<size_t>(THREADS * MESSAGES), messages.size());
+  for (const auto& message : messages)
+  {
+    const size_t separator = message.payload.find(' ');
+    const int thread = std::stoi(message.payload.substr(0, separator));
+    EXPECT_EQ(next[thread]++, std::stoi(message.payload.substr(separator + 1)));
+  }
+  EXPECT_EQ(0u, sink->GetDroppedMessages());
+}
+
+TEST(TestAsyncLogSink, DropWhenFull)
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target, 16);
+  spdlog::logger logger("test", sink);
+
+  target->Hold();
+  sink->Start(CAsyncLogSink::OverflowPolicy::DROP);
+  for (int i = 0; i < 100; i++)
+    logger.info("message {}", i);
+
+  // the ring and the message held by the flusher, everything else is dropped
+  EXPECT_GE(sink->GetDroppedMessages(), 100u - 16u - 1u);
+
+  target->Release();
+  sink->Stop();
+
+  const std::vector<Message> messages = target->GetMessages();
+  ASSERT_FALSE(messages.empty());
+  EXPECT_EQ(100u, messages.size() - 1 + sink->GetDroppedMessages());
+  EXPECT_EQ(spdlog::level::warn, messages.back().level);
+  EXPECT_EQ(std::to_string(sink->GetDroppedMessages()) +
+                " log messages were dropped, the log queue was full",
+            messages.back().payload);
+}
+
+TEST(TestAsyncLogSink, Restart)
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target, 16);
+  spdlog::logger logger("test", sink);
+
+  for (int i = 0; i < 3; i++)
+  {
+    sink->Start(CAsyncLogSink::OverflowPolicy::DROP);
+    logger.info("async {}", i);
+    sink->Stop();
+    logger.info("sync {}", i);
+  }
+
+  const std::vector<Message> messages = target->GetMessages();
+  ASSERT_EQ(6u, messages.size());
+  EXPECT_EQ("async 2", messages[4].payload);
+  EXPECT_EQ("sync 2", messages[5].payload);
+}
+
+TEST(TestAsyncLogSink, DISABLED_ThroughputBenchmark)
+{
+  // log throughput of 16 threads into a file, with the sinks CLog sets up
+  constexpr unsigned int THREADS = 16;
+  constexpr int MESSAGES = 20000;
+
+  const std::string path = CSpecialProtocol::TranslatePath("special://temp/asynclogsink.log");
+
+  auto run = [&](const std::string& name, bool async, CAsyncLogSink::OverflowPolicy policy)
+  {
+    auto sinks = std::make_shared<spdlog::sinks::dist_sink_mt>();
+    auto fileSink = std::make_shared<spdlog::sinks::dup_filter_sink_st>(std::chrono::seconds(10));
+    auto basicFileSink = std::make_shared<spdlog::sinks::basic_file_sink_st>(path, true);
+    basicFileSink->set_pattern("%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v");
+    fileSink->add_sink(basicFileSink);
+    sinks->add_sink(fileSink);
+
+    auto sink = std::make_shared<CAsyncLogSink>(sinks);
+    spdlog::logger logger("general", sink);
+    logger.set_level(spdlog::level::trace);
+    logger.flush_on(spdlog::level::debug);
+    if (async)
+      sink->Start(policy);
+
+    Benchmark::Duration logged;
+    const Benchmark::Duration written = Benchmark::Time(
+        [&]
+        {
+          logged = Benchmark::TimeThreads(
+              THREADS,
+              [&logger](unsigned int thread)
+              {
+                for (int i = 0; i < MESSAGES; i++)
+                  logger.debug("thread {} logs message {} of a benchmark run", thread, i);
+              });
+          sink->Stop();
+        });
+
+    const double total = THREADS * MESSAGES / 1000000.0;
+    Benchmark::Report(name + " logged", total / logged.count(), "M messages/s");
+    Benchmark::Report(name + " written", total / written.count(), "M messages/s");
+    Benchmark::Report(name + " dropped", sink->GetDroppedMessages(), "messages");
+  };
+
+  run("CAsyncLogSink synchronous", false, CAsyncLogSink::OverflowPolicy::DROP);
+  run("CAsyncLogSink drop", true, CAsyncLogSink::OverflowPolicy::DROP);
+  run("CAsyncLogSink block", true, CAsyncLogSink::OverflowPolicy::BLOCK);
+
+  std::remove(path.c_str());
+}
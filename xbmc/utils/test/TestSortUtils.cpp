@@ -6,9 +6,17 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "dbwrappers/dataset.h"
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "utils/SortUtils.h"
 #include "utils/Variant.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestSortUtils, Sort_SortBy)
@@ -121,3 +129,73 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)5, fields.size());
 }
+
+TEST(TestSortUtils, SortedIdsCache)
+{
+  XFILE::CFile::Delete("special://temp/sortedidstest.db");
+  dbiplus::SqliteDatabase database;
+  database.setHostName(CSpecialProtocol::TranslatePath("special://temp/").c_str());
+  database.setDatabase("sortedidstest.db");
+  ASSERT_EQ(DB_CONNECTION_OK, database.connect(true));
+  std::unique_ptr<dbiplus::Dataset> dataset(database.CreateDataset());
+
+  // the leading columns of songview, ids and titles sort in opposite order
+  dataset->exec("CREATE TABLE songview (idSong INTEGER, strArtists TEXT, strArtistSort TEXT, "
+                "strGenres TEXT, strTitle TEXT, iTrack INTEGER)");
+  for (int id = 1; id <= 10; ++id)
+    dataset->exec("INSERT INTO songview VALUES (" + std::to_string(id) + ", '', '', '', 'Song " +
+                  std::string(1, static_cast<char>('k' - id)) + "', 0)");
+
+  SortDescription sorting;
+  sorting.sortBy = SortByTitle;
+  sorting.limitEnd = 4;
+
+  const std::string key = CSortedIdsCache::GetKey("FROM songview", sorting);
+  CSortedIdsCache cache;
+  std::vector<int> ids;
+  int total = 0;
+
+  // the first page is always sorted from the dataset
+  EXPECT_FALSE(cache.GetPage(key, sorting, ids, total));
+
+  ASSERT_TRUE(dataset->query("SELECT * FROM songview"));
+  DatabaseResults results;
+  ASSERT_TRUE(cache.SortFromDataset(key, sorting, MediaTypeSong, dataset, 0, results));
+  ASSERT_EQ(4u, results.size());
+  EXPECT_EQ(9, results.front().at(FieldRow).asInteger());
+  dataset->close();
+
+  sorting.limitStart = 4;
+  sorting.limitEnd = 8;
+  EXPECT_FALSE(cache.GetPage(CSortedIdsCache::GetKey("FROM songview WHERE 0", sorting), sorting,
+                             ids, total));
+  ASSERT_TRUE(cache.GetPage(key, sorting, ids, total));
+  EXPECT_EQ(std::vector<int>({6, 5, 4, 3}), ids);
+  EXPECT_EQ(10, total);
+
+  // the page is fetched in any order, and item 4 is gone since the listing was sorted
+  dataset->exec("DELETE FROM songview WHERE idSong = 4");
+  EXPECT_EQ("idSong IN (6,5,4,3)", CSortedIdsCache::GetWhereClause("idSong", ids));
+  ASSERT_TRUE(dataset->query("SELECT * FROM songview WHERE " +
+                             CSortedIdsCache::GetWhereClause("idSong", ids) +
+                             " ORDER BY idSong"));
+  results.clear();
+  CSortedIdsCache::OrderFromDataset(ids, dataset, 0, results);
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(2, results[0].at(FieldRow).asInteger());
+  EXPECT_EQ(1, results[1].at(FieldRow).asInteger());
+  EXPECT_EQ(0, results[2].at(FieldRow).asInteger());
+  dataset->close();
+
+  sorting.limitStart = 8;
+  sorting.limitEnd = 12;
+  ASSERT_TRUE(cache.GetPage(key, sorting, ids, total));
+  EXPECT_EQ(std::vector<int>({2, 1}), ids);
+
+  sorting.limitStart = 12;
+  sorting.limitEnd = 16;
+  ASSERT_TRUE(cache.GetPage(key, sorting, ids, total));
+  EXPECT_TRUE(ids.empty());
+
+  database.disconnect();
+}
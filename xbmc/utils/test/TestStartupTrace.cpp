@@ -0,0 +1,44 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/StartupTrace.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+TEST(TestStartupTrace, Timeline)
+{
+  // the test runner never finishes the startup
+  ASSERT_TRUE(CStartupTrace::IsRecording());
+  {
+    CStartupTrace::CScope trace("TestStartupTrace.Timeline");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  CVariant timeline;
+  ASSERT_TRUE(CJSONVariantParser::Parse(CStartupTrace::GetTimeline(), timeline));
+  ASSERT_TRUE(timeline["traceEvents"].isArray());
+
+  bool found = false;
+  for (auto it = timeline["traceEvents"].begin_array(); it != timeline["traceEvents"].end_array();
+       ++it)
+  {
+    if ((*it)["name"].asString() != "TestStartupTrace.Timeline")
+      continue;
+
+    found = true;
+    EXPECT_EQ("X", (*it)["ph"].asString());
+    EXPECT_EQ("startup", (*it)["cat"].asString());
+    EXPECT_GE((*it)["dur"].asDouble(), 2000.0);
+  }
+  EXPECT_TRUE(found);
+}
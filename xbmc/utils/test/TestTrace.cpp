@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/Trace.h"
+#include "utils/Variant.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<CVariant> GetEvents(const std::string& name)
+{
+  CVariant trace;
+  EXPECT_TRUE(CJSONVariantParser::Parse(CTrace::GetEvents(), trace));
+
+  std::vector<CVariant> events;
+  for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+  {
+    if ((*it)["ph"].asString() == "X" && (*it)["name"].asString() == name)
+      events.push_back(*it);
+  }
+  return events;
+}
+} // unnamed namespace
+
+TEST(TestTrace, Recording)
+{
+  CTrace::Start();
+  {
+    CTrace::CScope trace("test", "TestTrace.Recording");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  CTrace::Stop();
+  {
+    CTrace::CScope trace("test", "TestTrace.Recording");
+  }
+
+  const auto events = GetEvents("TestTrace.Recording");
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ("test", events[0]["cat"].asString());
+  EXPECT_GE(events[0]["dur"].asDouble(), 2000.0);
+
+  // starting again discards the events recorded before
+  CTrace::Start();
+  CTrace::Stop();
+  EXPECT_TRUE(GetEvents("TestTrace.Recording").empty());
+}
+
+TEST(TestTrace, Threads)
+{
+  CTrace::Start();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back(
+        []()
+        {
+          for (int j = 0; j < 10; j++)
+            CTrace::CScope trace("test", "TestTrace.Threads");
+        });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  CTrace::Stop();
+
+  const auto events = GetEvents("TestTrace.Threads");
+  ASSERT_EQ(40u, events.size());
+
+  std::vector<uint64_t> threadIds;
+  for (const auto& event : events)
+  {
+    if (std::find(threadIds.begin(), threadIds.end(), event["tid"].asUnsignedInteger()) ==
+        threadIds.end())
+      threadIds.push_back(event["tid"].asUnsignedInteger());
+  }
+  EXPECT_EQ(4u, threadIds.size());
+}
+
+TEST(TestTrace, RingBuffer)
+{
+  CTrace::Start();
+  for (size_t i = 0; i < CTrace::RING_BUFFER_SIZE + 100; i++)
+    CTrace::CScope trace("test", "TestTrace.RingBuffer");
+  CTrace::Stop();
+
+  // only the most recent events of a thread are kept
+  EXPECT_EQ(CTrace::RING_BUFFER_SIZE, GetEvents("TestTrace.RingBuffer").size());
+}
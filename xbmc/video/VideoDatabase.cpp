@@ -8369,6 +8369,25 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
       return false;
 
+    // Fetch further pages of a sorted listing by the ids sorted for its first page
+    static CSortedIdsCache sortedIds;
+    const std::string sortedIdsKey = CSortedIdsCache::GetKey(strSQLExtra, sortDescription);
+    std::vector<int> pageIds;
+    if (extFilter.limit.empty() && sortedIds.GetPage(sortedIdsKey, sortDescription, pageIds, total))
+    {
+      if (pageIds.empty())
+      {
+        items.SetProperty("total", total);
+        return true;
+      }
+
+      Filter pageFilter = extFilter;
+      pageFilter.AppendWhere(CSortedIdsCache::GetWhereClause("movie_view.idMovie", pageIds));
+      strSQLExtra.clear();
+      if (!CDatabase::BuildSQL(strSQLExtra, pageFilter, strSQLExtra))
+        return false;
+    }
+
     // Apply the limiting directly here if there's no special sorting but limiting
     if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
         (sorting.limitStart > 0 || sorting.limitEnd > 0 ||
@@ -8393,7 +8412,10 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     DatabaseResults results;
     results.reserve(iRowsFound);
 
-    if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, m_pDS, results))
+    if (!pageIds.empty())
+      CSortedIdsCache::OrderFromDataset(pageIds, m_pDS, 0, results);
+    else if (!sortedIds.SortFromDataset(sortedIdsKey, sortDescription, MediaTypeMovie, m_pDS, 0,
+                                        results))
       return false;
 
     // get data from returned rows
@@ -8500,6 +8522,25 @@ bool CVideoDatabase::GetTvShowsByWhere(const std::string& strBaseDir, const Filt
     if (!BuildSQL(strBaseDir, strSQLExtra, extFilter, strSQLExtra, videoUrl, sorting))
       return false;
 
+    // Fetch further pages of a sorted listing by the ids sorted for its first page
+    static CSortedIdsCache sortedIds;
+    const std::string sortedIdsKey = CSortedIdsCache::GetKey(strSQLExtra, sorting);
+    std::vector<int> pageIds;
+    if (extFilter.limit.empty() && sortedIds.GetPage(sortedIdsKey, sorting, pageIds, total))
+    {
+      if (pageIds.empty())
+      {
+        items.SetProperty("total", total);
+        return true;
+      }
+
+      Filter pageFilter = extFilter;
+      pageFilter.AppendWhere(CSortedIdsCache::GetWhereClause("tvshow_view.idShow", pageIds));
+      strSQLExtra.clear();
+      if (!CDatabase::BuildSQL(strSQLExtra, pageFilter, strSQLExtra))
+        return false;
+    }
+
     // Apply the limiting directly here if there's no special sorting but limiting
     if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
         (sorting.limitStart > 0 || sorting.limitEnd > 0 ||
@@ -8523,7 +8564,9 @@ bool CVideoDatabase::GetTvShowsByWhere(const std::string& strBaseDir, const Filt
 
     DatabaseResults results;
     results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeTvShow, m_pDS, results))
+    if (!pageIds.empty())
+      CSortedIdsCache::OrderFromDataset(pageIds, m_pDS, 0, results);
+    else if (!sortedIds.SortFromDataset(sortedIdsKey, sorting, MediaTypeTvShow, m_pDS, 0, results))
       return false;
 
     // get data from returned rows
@@ -8629,6 +8672,25 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
     if (!BuildSQL(strBaseDir, strSQLExtra, extFilter, strSQLExtra, videoUrl, sorting))
       return false;
 
+    // Fetch further pages of a sorted listing by the ids sorted for its first page
+    static CSortedIdsCache sortedIds;
+    const std::string sortedIdsKey = CSortedIdsCache::GetKey(strSQLExtra, sorting);
+    std::vector<int> pageIds;
+    if (extFilter.limit.empty() && sortedIds.GetPage(sortedIdsKey, sorting, pageIds, total))
+    {
+      if (pageIds.empty())
+      {
+        items.SetProperty("total", total);
+        return true;
+      }
+
+      Filter pageFilter = extFilter;
+      pageFilter.AppendWhere(CSortedIdsCache::GetWhereClause("episode_view.idEpisode", pageIds));
+      strSQLExtra.clear();
+      if (!CDatabase::BuildSQL(strSQLExtra, pageFilter, strSQLExtra))
+        return false;
+    }
+
     // Apply the limiting directly here if there's no special sorting but limiting
     if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
         (sorting.limitStart > 0 || sorting.limitEnd > 0 ||
@@ -8652,7 +8714,9 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
 
     DatabaseResults results;
     results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeEpisode, m_pDS, results))
+    if (!pageIds.empty())
+      CSortedIdsCache::OrderFromDataset(pageIds, m_pDS, 0, results);
+    else if (!sortedIds.SortFromDataset(sortedIdsKey, sorting, MediaTypeEpisode, m_pDS, 0, results))
       return false;
 
     // get data from returned rows
@@ -9606,6 +9670,25 @@ bool CVideoDatabase::GetMusicVideosByWhere(const std::string &baseDir, const Fil
     if (!BuildSQL(baseDir, strSQLExtra, extFilter, strSQLExtra, videoUrl, sorting))
       return false;
 
+    // Fetch further pages of a sorted listing by the ids sorted for its first page
+    static CSortedIdsCache sortedIds;
+    const std::string sortedIdsKey = CSortedIdsCache::GetKey(strSQLExtra, sorting);
+    std::vector<int> pageIds;
+    if (extFilter.limit.empty() && sortedIds.GetPage(sortedIdsKey, sorting, pageIds, total))
+    {
+      if (pageIds.empty())
+      {
+        items.SetProperty("total", total);
+        return true;
+      }
+
+      Filter pageFilter = extFilter;
+      pageFilter.AppendWhere(CSortedIdsCache::GetWhereClause("musicvideo_view.idMVideo", pageIds));
+      strSQLExtra.clear();
+      if (!CDatabase::BuildSQL(strSQLExtra, pageFilter, strSQLExtra))
+        return false;
+    }
+
     // Apply the limiting directly here if there's no special sorting but limiting
     if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
         (sorting.limitStart > 0 || sorting.limitEnd > 0 ||
@@ -9629,7 +9712,10 @@ bool CVideoDatabase::GetMusicVideosByWhere(const std::string &baseDir, const Fil
 
     DatabaseResults results;
     results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeMusicVideo, m_pDS, results))
+    if (!pageIds.empty())
+      CSortedIdsCache::OrderFromDataset(pageIds, m_pDS, 0, results);
+    else if (!sortedIds.SortFromDataset(sortedIdsKey, sorting, MediaTypeMusicVideo, m_pDS, 0,
+                                        results))
       return false;
 
     // get data from returned rows
@@ -473,7 +473,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
     m_videoDatabase->Close();
   }
   item.SetProperty("libraryartfilled", true);
-  return !item.GetArt().empty();
+  return item.HasArt();
 }
 
 bool CVideoThumbLoader::FillThumb(CFileItem &item)
@@ -128,6 +128,16 @@ void CGUIViewControl::SetItems(CFileItemList &items)
   UpdateView();
 }
 
+void CGUIViewControl::AppendItems()
+{
+  if (m_currentView < 0 || m_currentView >= (int)m_visibleViews.size() || !m_fileItems)
+    return;
+
+  CGUIMessage msg(GUI_MSG_LABEL_APPEND, m_parentWindow, m_visibleViews[m_currentView]->GetID(), 0,
+                  0, m_fileItems);
+  CServiceBroker::GetGUI()->GetWindowManager().SendMessage(msg, m_parentWindow);
+}
+
 void CGUIViewControl::UpdateContents(const CGUIControl *control, int currentItem) const
 {
   if (!control || !m_fileItems) return;
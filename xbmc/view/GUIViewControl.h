@@ -30,6 +30,7 @@ public:
   void SetCurrentView(int viewMode, bool bRefresh = false);
 
   void SetItems(CFileItemList &items);
+  void AppendItems();
 
   void SetSelectedItem(int item);
   void SetSelectedItem(const std::string &itemPath);
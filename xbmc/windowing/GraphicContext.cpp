@@ -31,7 +31,10 @@
 
 using KODI::UTILS::COLOR::Color;
 
-CGraphicContext::CGraphicContext() = default;
+CGraphicContext::CGraphicContext() : CCriticalSection("GUI")
+{
+}
+
 CGraphicContext::~CGraphicContext() = default;
 
 void CGraphicContext::SetOrigin(float x, float y)
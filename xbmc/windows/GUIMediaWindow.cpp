@@ -36,8 +36,10 @@
 #include "dialogs/GUIDialogSmartPlaylistEditor.h"
 #include "filesystem/FileDirectoryFactory.h"
 #include "filesystem/MultiPathDirectory.h"
+#include "filesystem/MusicDatabaseDirectory.h"
 #include "filesystem/PluginDirectory.h"
 #include "filesystem/SmartPlaylistDirectory.h"
+#include "filesystem/VideoDatabaseDirectory.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIEditControl.h"
 #include "guilib/GUIKeyboardFactory.h"
@@ -112,6 +114,43 @@ protected:
   CFileItemList &m_items;
   bool m_useDir;
 };
+
+// number of library items fetched at once when a listing is paged
+constexpr int LIBRARY_PAGE_SIZE = 500;
+
+bool GetLibraryPage(const CURL& url, const SortDescription& sorting, CFileItemList& items)
+{
+  if (url.IsProtocol("musicdb"))
+    return XFILE::CMusicDatabaseDirectory::GetDirectoryPage(url, sorting, items);
+  if (url.IsProtocol("videodb"))
+    return XFILE::CVideoDatabaseDirectory::GetDirectoryPage(url, sorting, items);
+  return false;
+}
+
+void RemoveExcludedItems(int windowId, CFileItemList& items)
+{
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  std::vector<std::string> regexps;
+
+  //! @todo Do we want to limit the directories we apply the video ones to?
+  if (windowId == WINDOW_VIDEO_NAV)
+    regexps = advancedSettings->m_videoExcludeFromListingRegExps;
+  if (windowId == WINDOW_MUSIC_NAV)
+    regexps = advancedSettings->m_audioExcludeFromListingRegExps;
+  if (windowId == WINDOW_PICTURES)
+    regexps = advancedSettings->m_pictureExcludeFromListingRegExps;
+
+  if (regexps.empty())
+    return;
+
+  for (int i = 0; i < items.Size();)
+  {
+    if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), regexps))
+      items.Remove(i);
+    else
+      i++;
+  }
+}
 }
 
 CGUIMediaWindow::CGUIMediaWindow(int id, const char *xmlFile)
@@ -519,6 +558,16 @@ bool CGUIMediaWindow::OnMessage(CGUIMessage& message)
       return true;
     }
     break;
+  case GUI_MSG_LOAD_MORE_ITEMS:
+    {
+      // a container asks for more items, or LoadMoreItems() answers with them
+      if (!message.GetItem())
+        LoadMoreItems();
+      else if (message.GetParam1() == static_cast<int>(m_pageRequest))
+        OnMoreItems(*std::static_pointer_cast<CFileItemList>(message.GetItem()));
+      return true;
+    }
+    break;
   case GUI_MSG_WINDOW_INIT:
     {
       if (m_vecItems->GetPath() == "?")
@@ -634,6 +683,136 @@ void CGUIMediaWindow::ClearFileItems()
   m_viewControl.Clear();
   m_vecItems->Clear();
   m_unfilteredItems->Clear();
+  m_pagePath.clear();
+  m_pageRequest++;
+  m_pageLoading = false;
+}
+
+bool CGUIMediaWindow::GetFirstItems(const CURL& url, CFileItemList& items)
+{
+  // filtered nodes, smart playlists and the like are listed as a whole
+  if (!url.GetOptions().empty() || !CanPageDirectory(url))
+    return false;
+
+  // the view state of library nodes only depends on their path, so it can be asked before any
+  // item is retrieved
+  CFileItemList node(url.Get());
+  std::unique_ptr<CGUIViewState> viewState(CGUIViewState::GetViewState(GetID(), node));
+  if (!viewState)
+    return false;
+
+  SortDescription sorting = viewState->GetSortMethod();
+  sorting.sortOrder = viewState->GetSortOrder();
+  if (sorting.sortBy == SortByNone || sorting.sortBy == SortByRandom ||
+      sorting.sortBy == SortByPlaylistOrder)
+    return false;
+
+  sorting.limitStart = 0;
+  sorting.limitEnd = LIBRARY_PAGE_SIZE;
+  if (!GetLibraryPage(url, sorting, items))
+  {
+    items.Clear();
+    return false;
+  }
+
+  const int total = static_cast<int>(items.GetProperty("total").asInteger());
+  if (total > items.Size())
+  {
+    CLog::Log(LOGDEBUG, "CGUIMediaWindow::GetFirstItems - got {} of {} items of {}", items.Size(),
+              total, url.GetRedacted());
+
+    // a partial listing must never be used in place of the whole one
+    items.SetCacheToDisc(CFileItemList::CacheType::NEVER);
+    items.SetProperty("moreitems", true);
+
+    m_pagePath = url.Get();
+    m_nextPage = sorting;
+    m_nextPage.limitStart = items.Size();
+    m_pageTotal = total;
+  }
+  return true;
+}
+
+void CGUIMediaWindow::LoadMoreItems()
+{
+  if (m_pagePath.empty() || m_pageLoading)
+    return;
+
+  SortDescription sorting = m_nextPage;
+  sorting.limitEnd = std::min(sorting.limitStart + LIBRARY_PAGE_SIZE, m_pageTotal);
+
+  m_pageLoading = true;
+  CServiceBroker::GetJobManager()->Submit(
+      [path = m_pagePath, sorting, window = GetID(), request = m_pageRequest]()
+      {
+        auto items = std::make_shared<CFileItemList>();
+        GetLibraryPage(CURL(path), sorting, *items);
+
+        CGUIMessage msg(GUI_MSG_LOAD_MORE_ITEMS, window, window, static_cast<int>(request));
+        msg.SetItem(items);
+        CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg, window);
+      },
+      nullptr, CJob::PRIORITY_NORMAL);
+}
+
+void CGUIMediaWindow::LoadAllItems()
+{
+  if (m_pagePath.empty())
+    return;
+
+  SortDescription sorting = m_nextPage;
+  sorting.limitEnd = m_pageTotal;
+
+  // a page that is still being loaded is part of these
+  m_pageRequest++;
+  m_pageLoading = false;
+
+  CFileItemList items;
+  GetLibraryPage(CURL(m_pagePath), sorting, items);
+  OnMoreItems(items);
+}
+
+void CGUIMediaWindow::OnMoreItems(CFileItemList& items)
+{
+  m_pageLoading = false;
+  if (m_pagePath.empty())
+    return;
+
+  if (items.IsEmpty())
+  {
+    CLog::Log(LOGERROR, "CGUIMediaWindow::OnMoreItems - failed to get items {} to {} of {}",
+              m_nextPage.limitStart, m_pageTotal, CURL::GetRedacted(m_pagePath));
+    m_pagePath.clear();
+  }
+  else
+  {
+    m_nextPage.limitStart += items.Size();
+    if (m_nextPage.limitStart >= m_pageTotal)
+      m_pagePath.clear();
+
+    // the same steps as the first items took in GetDirectory() and Update()
+    for (const auto& item : items)
+      item->SetProperty("ParentPath", m_vecItems->GetPath());
+    RemoveExcludedItems(GetID(), items);
+    OnPrepareFileItems(items);
+    items.FillInDefaultIcons();
+    m_unfilteredItems->Append(items);
+
+    GetFilteredItems(GetProperty("filter").asString(), items);
+    if (m_guiState)
+    {
+      LABEL_MASKS labelMasks;
+      m_guiState->GetSortMethodLabelMasks(labelMasks);
+      FormatItemLabels(items, labelMasks);
+    }
+
+    // the database sorted these after the ones we have, so they are appended as they are
+    m_vecItems->Append(items);
+  }
+
+  m_vecItems->SetProperty("moreitems", !m_pagePath.empty());
+  m_unfilteredItems->SetProperty("moreitems", !m_pagePath.empty());
+  m_viewControl.AppendItems();
 }
 
 /*!
@@ -739,6 +918,11 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
   if (pathToUrl.IsProtocol("plugin") && !pathToUrl.GetHostName().empty())
     CServiceBroker::GetAddonMgr().UpdateLastUsed(pathToUrl.GetHostName());
 
+  // forget about the rest of a previous partially loaded listing
+  m_pagePath.clear();
+  m_pageRequest++;
+  m_pageLoading = false;
+
   // see if we can load a previously cached folder
   CFileItemList cachedItems(strDirectory);
   if (!strDirectory.empty() && cachedItems.Load(GetID()))
@@ -753,7 +937,8 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
       SetupShares();
 
     CFileItemList dirItems;
-    if (!GetDirectoryItems(pathToUrl, dirItems, UseFileDirectories()))
+    if (!GetFirstItems(pathToUrl, dirItems) &&
+        !GetDirectoryItems(pathToUrl, dirItems, UseFileDirectories()))
       return false;
 
     // assign fetched directory items
@@ -796,27 +981,7 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
     items.AddFront(pItem, 0);
   }
 
-  int iWindow = GetID();
-  std::vector<std::string> regexps;
-
-  //! @todo Do we want to limit the directories we apply the video ones to?
-  if (iWindow == WINDOW_VIDEO_NAV)
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoExcludeFromListingRegExps;
-  if (iWindow == WINDOW_MUSIC_NAV)
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromListingRegExps;
-  if (iWindow == WINDOW_PICTURES)
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExps;
-
-  if (regexps.size())
-  {
-    for (int i=0; i < items.Size();)
-    {
-      if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), regexps))
-        items.Remove(i);
-      else
-        i++;
-    }
-  }
+  RemoveExcludedItems(GetID(), items);
 
   // clear the filter
   SetProperty("filter", "");
@@ -1535,6 +1700,8 @@ bool CGUIMediaWindow::OnPlayAndQueueMedia(const CFileItemPtr& item, const std::s
   PLAYLIST::Id playlistId = m_guiState->GetPlaylist();
   if (playlistId != PLAYLIST::Id::TYPE_NONE)
   {
+    LoadAllItems();
+
     // Remove ZIP, RAR files and folders
     CFileItemList playlist;
     playlist.Copy(*m_vecItems, true);
@@ -1596,6 +1763,13 @@ bool CGUIMediaWindow::OnPlayAndQueueMedia(const CFileItemPtr& item, const std::s
  */
 void CGUIMediaWindow::UpdateFileList()
 {
+  // only the database can sort a partially loaded list
+  if (!m_pagePath.empty())
+  {
+    Refresh();
+    return;
+  }
+
   int nItem = m_viewControl.GetSelectedItem();
   std::string strSelected;
   if (nItem >= 0)
@@ -1909,6 +2083,9 @@ void CGUIMediaWindow::UpdateFilterPath(const std::string &strDirectory, const CF
 
 void CGUIMediaWindow::OnFilterItems(const std::string &filter)
 {
+  if (!filter.empty() || !m_filter.IsEmpty())
+    LoadAllItems();
+
   m_viewControl.Clear();
 
   CFileItemList items;
@@ -13,6 +13,7 @@
 #include "filesystem/VirtualDirectory.h"
 #include "guilib/GUIWindow.h"
 #include "playlists/SmartPlayList.h"
+#include "utils/SortUtils.h"
 #include "view/GUIViewControl.h"
 
 #include <atomic>
@@ -112,6 +113,30 @@ protected:
   void ClearFileItems();
   virtual void SortItems(CFileItemList &items);
 
+  /*! \brief Check if the items of the given library node may be loaded page by page as the view
+   is scrolled instead of all at once
+   \param url the library node, without any options
+   \return true if the window can show a partially loaded list of the node, otherwise false
+   \sa GetFirstItems
+   */
+  virtual bool CanPageDirectory(const CURL& url) const { return false; }
+  /*! \brief Get the first items of a library node, sorted by the database like the view will show
+   them. The rest is loaded by LoadMoreItems() when a container asks for it.
+   \param url the library node
+   \param items the first items of the node, with the "moreitems" property set if there are more
+   \return false if the node can't be paged, in which case all of its items have to be retrieved
+   */
+  bool GetFirstItems(const CURL& url, CFileItemList& items);
+  void LoadMoreItems();
+  /*! \brief Load all items of a partially loaded list, e.g. before it is filtered
+   \sa GetFirstItems
+   */
+  void LoadAllItems();
+  /*! \brief Prepare the next items of a partially loaded list and add them to the view
+   \param items the next items from the database
+   */
+  virtual void OnMoreItems(CFileItemList& items);
+
   /*! \brief Check if the given list can be advance filtered or not
    \param items List of items to check
    \return true if the list can be advance filtered otherwise false
@@ -227,4 +252,10 @@ protected:
    */
   std::string m_strFilterPath;
   bool m_backgroundLoad = false;
+
+  std::string m_pagePath; ///< \brief library node of a partially loaded m_vecItems, empty otherwise
+  SortDescription m_nextPage; ///< \brief sorting and start of the items still to be loaded
+  int m_pageTotal = 0;
+  unsigned int m_pageRequest = 0; ///< \brief changes with the listing, older pages are dropped
+  bool m_pageLoading = false;
 };